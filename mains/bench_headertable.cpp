@@ -0,0 +1,106 @@
+/**
+ * @file bench_headertable.cpp
+ * @author Derek Tan
+ * @brief Benchmarks the HPACK indexing table: insertion with eviction churn, index lookup and name search.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "bench/alloccount.hpp"
+#include "bench/headercorpus.hpp"
+#include "hpack/headertable.hpp"
+
+/// @brief Every corpus field that a browser-side encoder would index, i.e. all but the pseudo-headers that change per request.
+static std::vector<HeaderTablePair> collect_fields() {
+    std::vector<HeaderTablePair> fields {};
+
+    for (size_t set_i = 0UL; set_i < REQUEST_CORPUS_COUNT; set_i++) {
+        const CorpusHeaderSet& header_set = REQUEST_CORPUS[set_i];
+
+        for (size_t field_i = 0UL; field_i < header_set.count; field_i++) {
+            fields.emplace_back(std::string {header_set.fields[field_i].name}, std::string {header_set.fields[field_i].value});
+        }
+    }
+
+    return fields;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options {};
+
+    if (!options.parse(argc, argv)) {
+        std::cerr << "usage: bench_headertable [--threads=1,2,4] [--min-ms=200]" << std::endl;
+        return 1;
+    }
+
+    const std::vector<HeaderTablePair> fields = collect_fields();
+    BenchSuite suite {"headertable", options};
+
+    // One op is one insertion; a 4096 octet table holds only part of the corpus, so inserts keep evicting.
+    suite.run("put_entry", [&fields]() {
+        auto table = std::make_shared<HeaderIndexingTable>();
+
+        return BenchBody {[&fields, table](uint64_t iterations) {
+            uint64_t bytes = 0UL;
+
+            for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                const HeaderTablePair& field = fields[op_i % fields.size()];
+
+                table->put_entry(field);
+                bytes += field.get_name().length() + field.get_value().length();
+            }
+
+            return bytes;
+        }};
+    });
+
+    auto make_full_table = [&fields]() {
+        auto table = std::make_shared<HeaderIndexingTable>();
+
+        for (const auto& field : fields) {
+            table->put_entry(field);
+        }
+
+        return table;
+    };
+
+    suite.run("get_entry", [&make_full_table]() {
+        auto table = make_full_table();
+
+        return BenchBody {[table](uint64_t iterations) {
+            uint64_t bytes = 0UL;
+            const uint32_t total_length = table->get_total_length();
+
+            for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                const HeaderTablePair& entry = table->get_entry(1U + static_cast<uint32_t>((op_i * 7UL) % total_length));
+
+                bytes += entry.get_name().length() + entry.get_value().length();
+            }
+
+            return bytes;
+        }};
+    });
+
+    suite.run("has_entry", [&fields, &make_full_table]() {
+        auto table = make_full_table();
+
+        return BenchBody {[&fields, table](uint64_t iterations) {
+            uint64_t bytes = 0UL;
+
+            for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                const std::string& name = fields[op_i % fields.size()].get_name();
+
+                bench_keep(table->has_entry(name));
+                bytes += name.length();
+            }
+
+            return bytes;
+        }};
+    });
+
+    suite.print_json(std::cout);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file bench_hpack.cpp
+ * @author Derek Tan
+ * @brief Benchmarks whole header block encoding and decoding over the request and response corpora. One op is one header block. Encoding runs once per indexing policy, each with a compression ratio.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "bench/alloccount.hpp"
+#include "bench/headercorpus.hpp"
+#include "hpack/hpackdecoder.hpp"
+#include "hpack/hpackencoder.hpp"
+
+constexpr uint32_t RATIO_PASSES = 4U;   // page loads over one connection when measuring compression
+
+struct PolicyCase {
+    const char* suffix;
+    IndexingPolicy policy;
+};
+
+static constexpr PolicyCase POLICY_CASES[] = {
+    {"", IndexingPolicy::never},
+    {"_always", IndexingPolicy::always},
+    {"_size", IndexingPolicy::size_threshold},
+    {"_frequency", IndexingPolicy::frequency}
+};
+
+static void measure_ratio(BenchSuite& suite, const std::string& ratio_name, const CorpusHeaderSet* corpus, size_t corpus_count, IndexingPolicy policy) {
+    HpackEncoder encoder {};
+    std::vector<uint8_t> block {};
+    uint64_t plain_bytes = 0UL;
+    uint64_t block_bytes = 0UL;
+
+    encoder.set_indexing_policy(policy);
+
+    // Stateful policies only pay off over repeats, so the whole corpus goes through one encoder a few times.
+    for (uint32_t pass_i = 0U; pass_i < RATIO_PASSES; pass_i++) {
+        for (size_t set_i = 0UL; set_i < corpus_count; set_i++) {
+            block.clear();
+
+            for (size_t field_i = 0UL; field_i < corpus[set_i].count; field_i++) {
+                encoder.encode_field(block, corpus[set_i].fields[field_i].name, corpus[set_i].fields[field_i].value);
+            }
+
+            plain_bytes += get_corpus_octets(corpus[set_i]);
+            block_bytes += block.size();
+        }
+    }
+
+    suite.add_ratio(ratio_name.c_str(), plain_bytes, block_bytes);
+}
+
+static void run_corpus(BenchSuite& suite, const char* label, const CorpusHeaderSet* corpus, size_t corpus_count) {
+    std::string decode_name = std::string {"decode_"} + label;
+
+    for (const PolicyCase& policy_case : POLICY_CASES) {
+        std::string encode_name = std::string {"encode_"} + label + policy_case.suffix;
+        const IndexingPolicy policy = policy_case.policy;
+
+        measure_ratio(suite, std::string {"ratio_"} + label + policy_case.suffix, corpus, corpus_count, policy);
+
+        suite.run(encode_name.c_str(), [corpus, corpus_count, policy]() {
+            auto encoder = std::make_shared<HpackEncoder>();
+            auto block = std::make_shared<std::vector<uint8_t>>();
+
+            encoder->set_indexing_policy(policy);
+
+            return BenchBody {[corpus, corpus_count, encoder, block](uint64_t iterations) {
+                uint64_t bytes = 0UL;
+
+                for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                    const CorpusHeaderSet& header_set = corpus[op_i % corpus_count];
+
+                    block->clear();
+
+                    for (size_t field_i = 0UL; field_i < header_set.count; field_i++) {
+                        encoder->encode_field(*block, header_set.fields[field_i].name, header_set.fields[field_i].value);
+                    }
+
+                    bench_keep(block->size());
+                    bytes += get_corpus_octets(header_set);
+                }
+
+                return bytes;
+            }};
+        });
+    }
+
+    // Decoding replays fixed blocks in a loop, which only stays valid for stateless ones.
+    auto blocks = std::make_shared<std::vector<std::vector<uint8_t>>>();
+    HpackEncoder setup_encoder {};
+
+    for (size_t set_i = 0UL; set_i < corpus_count; set_i++) {
+        std::vector<uint8_t> block {};
+
+        for (size_t field_i = 0UL; field_i < corpus[set_i].count; field_i++) {
+            setup_encoder.encode_field(block, corpus[set_i].fields[field_i].name, corpus[set_i].fields[field_i].value);
+        }
+
+        blocks->push_back(std::move(block));
+    }
+
+    suite.run(decode_name.c_str(), [corpus, corpus_count, blocks]() {
+        auto decoder = std::make_shared<HpackDecoder>();
+        auto fields = std::make_shared<HeaderList>();
+
+        return BenchBody {[corpus, corpus_count, blocks, decoder, fields](uint64_t iterations) {
+            uint64_t bytes = 0UL;
+
+            for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                size_t set_i = op_i % corpus_count;
+                const std::vector<uint8_t>& block = (*blocks)[set_i];
+
+                bench_keep(decoder->decode_block(block.data(), static_cast<uint32_t>(block.size()), *fields));
+                bytes += get_corpus_octets(corpus[set_i]);
+            }
+
+            return bytes;
+        }};
+    });
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options {};
+
+    if (!options.parse(argc, argv)) {
+        std::cerr << "usage: bench_hpack [--threads=1,2,4] [--min-ms=200]" << std::endl;
+        return 1;
+    }
+
+    BenchSuite suite {"hpack", options};
+
+    run_corpus(suite, "requests", REQUEST_CORPUS, REQUEST_CORPUS_COUNT);
+    run_corpus(suite, "responses", RESPONSE_CORPUS, RESPONSE_CORPUS_COUNT);
+    suite.print_json(std::cout);
+
+    return 0;
+}
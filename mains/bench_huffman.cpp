@@ -0,0 +1,110 @@
+/**
+ * @file bench_huffman.cpp
+ * @author Derek Tan
+ * @brief Benchmarks static Huffman encoding and decoding over the header corpus. One op is every name and value of one header set.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bench/alloccount.hpp"
+#include "bench/headercorpus.hpp"
+#include "hpack/huffxcoders.hpp"
+
+/// @brief All corpus header sets, requests first.
+static std::vector<const CorpusHeaderSet*> collect_sets() {
+    std::vector<const CorpusHeaderSet*> sets {};
+
+    for (size_t set_i = 0UL; set_i < REQUEST_CORPUS_COUNT; set_i++) {
+        sets.push_back(&REQUEST_CORPUS[set_i]);
+    }
+
+    for (size_t set_i = 0UL; set_i < RESPONSE_CORPUS_COUNT; set_i++) {
+        sets.push_back(&RESPONSE_CORPUS[set_i]);
+    }
+
+    return sets;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options {};
+
+    if (!options.parse(argc, argv)) {
+        std::cerr << "usage: bench_huffman [--threads=1,2,4] [--min-ms=200]" << std::endl;
+        return 1;
+    }
+
+    const std::vector<const CorpusHeaderSet*> sets = collect_sets();
+    BenchSuite suite {"huffman", options};
+
+    suite.run("encode", [&sets]() {
+        return BenchBody {[&sets, encoder = HuffmanEncoder {STATIC_HUFFMAN_CODES}, bits = std::make_shared<BitArray>()](uint64_t iterations) mutable {
+            uint64_t bytes = 0UL;
+
+            for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                const CorpusHeaderSet& header_set = *sets[op_i % sets.size()];
+
+                for (size_t field_i = 0UL; field_i < header_set.count; field_i++) {
+                    bits->clear();
+                    encoder.encode(*bits, header_set.fields[field_i].name);
+                    bits->clear();
+                    encoder.encode(*bits, header_set.fields[field_i].value);
+                    bench_keep(bits->length());
+                }
+
+                bytes += get_corpus_octets(header_set);
+            }
+
+            return bytes;
+        }};
+    });
+
+    // Pre-encode every string once so the decode case times decoding only.
+    std::vector<std::vector<std::vector<uint8_t>>> encoded_sets {};
+    HuffmanEncoder setup_encoder {STATIC_HUFFMAN_CODES};
+
+    for (const CorpusHeaderSet* header_set : sets) {
+        std::vector<std::vector<uint8_t>> strings {};
+
+        for (size_t field_i = 0UL; field_i < header_set->count; field_i++) {
+            for (std::string_view text : {header_set->fields[field_i].name, header_set->fields[field_i].value}) {
+                BitArray bits {};
+                uint32_t bit_count = setup_encoder.encode(bits, text);
+
+                strings.emplace_back(bits.get_octets(), bits.get_octets() + bit_count / 8U);
+            }
+        }
+
+        encoded_sets.push_back(std::move(strings));
+    }
+
+    suite.run("decode", [&sets, &encoded_sets]() {
+        auto decoder = std::make_shared<HuffmanDecoder>(STATIC_HUFFMAN_CODES);
+
+        return BenchBody {[&sets, &encoded_sets, decoder, scratch = std::string {}](uint64_t iterations) mutable {
+            uint64_t bytes = 0UL;
+
+            scratch.reserve(1024UL);
+
+            for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                size_t set_i = op_i % sets.size();
+
+                for (const auto& encoded : encoded_sets[set_i]) {
+                    scratch.clear();
+                    decoder->decode(scratch, encoded.data(), static_cast<uint32_t>(encoded.size()), scratch.capacity());
+                    bench_keep(scratch.length());
+                }
+
+                bytes += get_corpus_octets(*sets[set_i]);
+            }
+
+            return bytes;
+        }};
+    });
+
+    suite.print_json(std::cout);
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file bench_intxcoder.cpp
+ * @author Derek Tan
+ * @brief Benchmarks HPACK prefix integer encoding and decoding. One op is one integer, drawn from a mix of table indexes, string lengths and table size updates.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "bench/alloccount.hpp"
+#include "bench/headercorpus.hpp"
+#include "hpack/intxcoder.hpp"
+
+constexpr size_t INT_SAMPLE_COUNT = 4096UL;
+
+struct IntSample {
+    uint32_t value;
+    uint8_t prefix;
+};
+
+/// @brief Deterministic sample mix: mostly small indexes and lengths, with a tail of multi-octet values.
+static std::vector<IntSample> make_samples() {
+    std::vector<IntSample> samples {};
+    uint32_t lcg_state = 12345U;
+
+    for (size_t sample_i = 0UL; sample_i < INT_SAMPLE_COUNT; sample_i++) {
+        lcg_state = lcg_state * 1103515245U + 12345U;
+        uint32_t roll = (lcg_state >> 16) % 100U;
+
+        if (roll < 55U) {
+            samples.push_back({1U + (lcg_state >> 8) % 61U, 7U});       // static table index
+        } else if (roll < 85U) {
+            samples.push_back({(lcg_state >> 8) % 160U, 7U});           // string length
+        } else if (roll < 97U) {
+            samples.push_back({62U + (lcg_state >> 8) % 40U, 6U});      // dynamic table name index
+        } else {
+            samples.push_back({4096U + (lcg_state >> 8) % 65536U, 5U}); // table size update
+        }
+    }
+
+    return samples;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options {};
+
+    if (!options.parse(argc, argv)) {
+        std::cerr << "usage: bench_intxcoder [--threads=1,2,4] [--min-ms=200]" << std::endl;
+        return 1;
+    }
+
+    const std::vector<IntSample> samples = make_samples();
+    BenchSuite suite {"intxcoder", options};
+
+    suite.run("encode", [&samples]() {
+        auto buffer = std::make_shared<OctetArray>(16U);
+
+        return BenchBody {[&samples, buffer, encoder = IntegerEncoder {}](uint64_t iterations) mutable {
+            uint64_t bytes = 0UL;
+
+            for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                const IntSample& sample = samples[op_i % samples.size()];
+
+                encoder.reset();
+                encoder.set_prefix(sample.prefix);
+                bytes += encoder.encode_int(*buffer, sample.value);
+            }
+
+            return bytes;
+        }};
+    });
+
+    // Encode the samples back to back once, remembering where each starts.
+    std::vector<uint8_t> encoded {};
+    std::vector<uint32_t> offsets {};
+    OctetArray setup_buffer {16U};
+    IntegerEncoder setup_encoder {};
+
+    for (const IntSample& sample : samples) {
+        setup_encoder.reset();
+        setup_encoder.set_prefix(sample.prefix);
+
+        uint32_t octet_count = setup_encoder.encode_int(setup_buffer, sample.value);
+
+        offsets.push_back(static_cast<uint32_t>(encoded.size()));
+        encoded.insert(encoded.end(), setup_buffer.get_octets(), setup_buffer.get_octets() + octet_count);
+    }
+
+    suite.run("decode", [&samples, &encoded, &offsets]() {
+        return BenchBody {[&samples, &encoded, &offsets, decoder = IntegerDecoder {}](uint64_t iterations) mutable {
+            uint64_t bytes = 0UL;
+            const uint32_t encoded_length = static_cast<uint32_t>(encoded.size());
+
+            for (uint64_t op_i = 0UL; op_i < iterations; op_i++) {
+                size_t sample_i = op_i % samples.size();
+
+                decoder.set_prefix(samples[sample_i].prefix);
+                decoder.set_offset(offsets[sample_i]);
+                bench_keep(decoder.decode_int(encoded.data(), encoded_length));
+                bytes += decoder.get_relative_offset() - offsets[sample_i];
+            }
+
+            return bytes;
+        }};
+    });
+
+    suite.print_json(std::cout);
+
+    return 0;
+}
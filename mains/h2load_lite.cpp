@@ -0,0 +1,750 @@
+/**
+ * @file h2load_lite.cpp
+ * @author Derek Tan
+ * @brief Implements a small h2c (prior knowledge) load generator built on the project's own frame and HPACK code.
+ * @note Usage: `h2load_lite [-c conns] [-m streams] [-n requests | -d seconds] [-t threads] [-r METHOD,path,weight]... [--json] host:port`
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "hpack/hpackdecoder.hpp"
+#include "hpack/hpackencoder.hpp"
+#include "http1/h1parser.hpp"
+#include "http2/frames.hpp"
+#include "http2/settings.hpp"
+#include "utils/hdrhistogram.hpp"
+
+constexpr uint32_t CLIENT_WINDOW_SIZE = 1U << 30;          // advertised so the server is never stalled by our windows
+constexpr uint32_t CLIENT_WINDOW_REFILL = 1U << 28;        // replenish the connection window after this many octets
+constexpr size_t CLIENT_READ_CHUNK = 65536UL;
+constexpr uint64_t LATENCY_HIGHEST_US = 60UL * 1000UL * 1000UL;
+constexpr uint32_t LATENCY_SIG_FIGURES = 3U;
+
+/* Options */
+
+struct RequestTemplate {
+    std::string method;
+    std::string path;
+    uint32_t weight;
+};
+
+struct LoadOptions {
+    std::string host;
+    std::string port;
+    std::string authority;
+    std::vector<RequestTemplate> mix;
+    uint32_t connections;
+    uint32_t streams;
+    uint32_t threads;
+    uint64_t total_requests;  // 0 with a duration set
+    uint32_t duration_s;
+    std::string cookie;       // sent on every request when set
+    uint32_t body_size;       // octets sent with non-GET requests
+    bool split_cookies;       // send cookie crumbs as separate indexed fields
+    bool as_json;
+};
+
+static void print_usage() {
+    std::cerr << "usage: h2load_lite [-c conns] [-m streams] [-n requests | -d seconds] [-t threads]\n"
+              << "                   [-r METHOD,path,weight]... [-b body_octets] [--cookie text [--split-cookies]]\n"
+              << "                   [--json] host:port" << std::endl;
+}
+
+static bool parse_mix_entry(const char* text, RequestTemplate& entry) {
+    std::string spec {text};
+    size_t first_comma = spec.find(',');
+    size_t second_comma = (first_comma == std::string::npos) ? std::string::npos : spec.find(',', first_comma + 1UL);
+
+    if (first_comma == std::string::npos) {
+        entry = {"GET", spec, 1U};
+    } else {
+        entry.method = spec.substr(0, first_comma);
+        entry.path = spec.substr(first_comma + 1UL, (second_comma == std::string::npos) ? std::string::npos : second_comma - first_comma - 1UL);
+        entry.weight = (second_comma == std::string::npos) ? 1U : static_cast<uint32_t>(std::strtoul(spec.c_str() + second_comma + 1UL, nullptr, 10));
+    }
+
+    return !entry.path.empty() && entry.path[0] == '/' && entry.weight > 0U;
+}
+
+static bool parse_options(int argc, char** argv, LoadOptions& options) {
+    options = {"", "", "", {}, 1U, 10U, 1U, 1000UL, 0U, "", 0U, false, false};
+
+    for (int arg_i = 1; arg_i < argc; arg_i++) {
+        std::string arg {argv[arg_i]};
+        bool has_value = arg_i + 1 < argc;
+
+        if (arg == "--json") {
+            options.as_json = true;
+        } else if (arg == "--split-cookies") {
+            options.split_cookies = true;
+        } else if (arg == "--cookie" && has_value) {
+            options.cookie = argv[++arg_i];
+        } else if (arg == "-c" && has_value) {
+            options.connections = static_cast<uint32_t>(std::strtoul(argv[++arg_i], nullptr, 10));
+        } else if (arg == "-m" && has_value) {
+            options.streams = static_cast<uint32_t>(std::strtoul(argv[++arg_i], nullptr, 10));
+        } else if (arg == "-t" && has_value) {
+            options.threads = static_cast<uint32_t>(std::strtoul(argv[++arg_i], nullptr, 10));
+        } else if (arg == "-n" && has_value) {
+            options.total_requests = std::strtoull(argv[++arg_i], nullptr, 10);
+        } else if (arg == "-d" && has_value) {
+            options.duration_s = static_cast<uint32_t>(std::strtoul(argv[++arg_i], nullptr, 10));
+        } else if (arg == "-b" && has_value) {
+            options.body_size = static_cast<uint32_t>(std::strtoul(argv[++arg_i], nullptr, 10));
+        } else if (arg == "-r" && has_value) {
+            RequestTemplate entry {};
+
+            if (!parse_mix_entry(argv[++arg_i], entry)) {
+                return false;
+            }
+
+            options.mix.push_back(entry);
+        } else if (arg[0] != '-' && options.host.empty()) {
+            size_t colon_pos = arg.rfind(':');
+
+            if (colon_pos == std::string::npos) {
+                return false;
+            }
+
+            options.host = arg.substr(0, colon_pos);
+            options.port = arg.substr(colon_pos + 1UL);
+            options.authority = arg;
+        } else {
+            return false;
+        }
+    }
+
+    if (options.duration_s > 0U) {
+        options.total_requests = 0UL;
+    }
+
+    if (options.mix.empty()) {
+        options.mix.push_back({"GET", "/", 1U});
+    }
+
+    options.threads = std::min(std::max(options.threads, 1U), std::max(options.connections, 1U));
+
+    return !options.host.empty() && options.connections > 0U && options.streams > 0U
+        && options.body_size <= FRAME_DEFAULT_MAX_SIZE && (options.total_requests > 0UL || options.duration_s > 0U);
+}
+
+/* Shared Run State */
+
+struct RunState {
+    std::atomic<int64_t> requests_left;   // unused with a duration
+    std::atomic<bool> stop_flag;
+    uint64_t deadline_ns;
+};
+
+struct WorkerStats {
+    HdrHistogram latency_us;
+    uint64_t completed;
+    uint64_t failed;         // non 2xx/3xx status or reset stream
+    uint64_t data_octets;
+    uint64_t header_octets;
+    uint64_t sent_header_octets;   // request header blocks, to compare encoder options
+    uint32_t broken_connections;
+
+    WorkerStats() : latency_us {1UL, LATENCY_HIGHEST_US, LATENCY_SIG_FIGURES}, completed {0UL}, failed {0UL}, data_octets {0UL}, header_octets {0UL}, sent_header_octets {0UL}, broken_connections {0U} {}
+};
+
+static uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static bool claim_request(RunState& state) {
+    if (state.stop_flag.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    if (state.deadline_ns > 0UL) {
+        return now_ns() < state.deadline_ns;
+    }
+
+    return state.requests_left.fetch_sub(1, std::memory_order_relaxed) > 0;
+}
+
+/* Client Connection */
+
+struct StreamSlot {
+    uint32_t stream_id;   // 0 when free
+    uint64_t start_ns;
+    bool failed;
+};
+
+class ClientConnection {
+private:
+    const LoadOptions& options;
+    const std::vector<uint32_t>& mix_table;
+    RunState& state;
+    WorkerStats& stats;
+    HpackEncoder encoder;
+    HpackDecoder decoder;
+    HeaderList fields;
+    Http2Settings peer_settings;
+    std::vector<StreamSlot> slots;
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> header_block;  // HEADERS plus CONTINUATION fragments
+    std::vector<uint8_t> body;
+    size_t out_sent;
+    uint64_t unacked_octets;
+    uint32_t header_stream_id;
+    uint32_t next_stream_id;
+    uint32_t active_count;
+    uint32_t mix_cursor;
+    uint8_t header_flags;
+    int fd;
+    bool is_broken;
+    bool is_draining;   // no new requests: budget spent or GOAWAY received
+
+    void put_frame(FrameType type, uint8_t flags, uint32_t stream_id, const uint8_t* payload, uint32_t length);
+    void put_window_update(uint32_t stream_id, uint32_t increment);
+    void issue_requests();
+    void finish_stream(uint32_t stream_id, bool failed);
+    StreamSlot* find_slot(uint32_t stream_id);
+    bool on_frame(const FrameHeader& header, const uint8_t* payload);
+    bool on_header_block(uint32_t stream_id, bool end_stream);
+
+public:
+    ClientConnection(const LoadOptions& load_options, const std::vector<uint32_t>& weighted_mix, RunState& run_state, WorkerStats& worker_stats);
+    ~ClientConnection();
+
+    bool connect_to(const addrinfo* address);
+    int get_fd() const;
+    bool wants_write() const;
+    bool is_done() const;
+    bool on_readable();
+    bool on_writable();
+    void mark_broken();
+};
+
+ClientConnection::ClientConnection(const LoadOptions& load_options, const std::vector<uint32_t>& weighted_mix, RunState& run_state, WorkerStats& worker_stats)
+: options {load_options}, mix_table {weighted_mix}, state {run_state}, stats {worker_stats}, encoder {}, decoder {},
+  fields {}, peer_settings {}, slots(load_options.streams, StreamSlot {0U, 0UL, false}), out {}, in {}, header_block {},
+  body(load_options.body_size, 'x') {
+    this->out_sent = 0UL;
+    this->unacked_octets = 0UL;
+    this->header_stream_id = 0U;
+    this->next_stream_id = 1U;
+    this->active_count = 0U;
+    this->mix_cursor = 0U;
+    this->encoder.set_split_cookies(load_options.split_cookies);
+    this->header_flags = 0;
+    this->fd = -1;
+    this->is_broken = false;
+    this->is_draining = false;
+    this->in.reserve(CLIENT_READ_CHUNK * 2UL);
+}
+
+ClientConnection::~ClientConnection() {
+    if (this->fd != -1) {
+        close(this->fd);
+    }
+}
+
+void ClientConnection::put_frame(FrameType type, uint8_t flags, uint32_t stream_id, const uint8_t* payload, uint32_t length) {
+    uint8_t raw_header[FRAME_HEADER_SIZE];
+
+    pack_frame_header(raw_header, FrameHeader {length, type, flags, stream_id});
+    this->out.insert(this->out.end(), raw_header, raw_header + FRAME_HEADER_SIZE);
+
+    if (length > 0U) {
+        this->out.insert(this->out.end(), payload, payload + length);
+    }
+}
+
+void ClientConnection::put_window_update(uint32_t stream_id, uint32_t increment) {
+    const uint8_t payload[4] = {
+        static_cast<uint8_t>((increment >> 24) & 0x7f), static_cast<uint8_t>(increment >> 16),
+        static_cast<uint8_t>(increment >> 8), static_cast<uint8_t>(increment)
+    };
+
+    put_frame(FrameType::window_update, 0, stream_id, payload, 4U);
+}
+
+void ClientConnection::issue_requests() {
+    const uint32_t max_active = std::min(this->options.streams, this->peer_settings.max_concurrent_streams);
+
+    while (!this->is_draining && this->active_count < max_active) {
+        if (!claim_request(this->state)) {
+            this->is_draining = true;
+            break;
+        }
+
+        const RequestTemplate& request = this->options.mix[this->mix_table[this->mix_cursor]];
+        const bool has_body = request.method != "GET" && request.method != "HEAD" && !this->body.empty();
+        StreamSlot* slot = find_slot(0U);
+        std::vector<uint8_t> block {};
+
+        this->mix_cursor = (this->mix_cursor + 1U) % static_cast<uint32_t>(this->mix_table.size());
+
+        this->encoder.encode_field(block, ":method", request.method);
+        this->encoder.encode_field(block, ":scheme", "http");
+        this->encoder.encode_field(block, ":authority", this->options.authority);
+        this->encoder.encode_field(block, ":path", request.path);
+        this->encoder.encode_field(block, "user-agent", "h2load_lite/0.1");
+
+        if (!this->options.cookie.empty()) {
+            this->encoder.encode_field(block, "cookie", this->options.cookie);
+        }
+
+        if (has_body) {
+            this->encoder.encode_field(block, "content-length", std::to_string(this->body.size()));
+        }
+
+        this->stats.sent_header_octets += block.size();
+
+        /// @note Request blocks stay far below the 16384 octet default frame size, so no CONTINUATION is needed.
+        uint8_t flags = static_cast<uint8_t>(FLAG_END_HEADERS | (has_body ? 0 : FLAG_END_STREAM));
+
+        put_frame(FrameType::headers, flags, this->next_stream_id, block.data(), static_cast<uint32_t>(block.size()));
+
+        // Bodies are capped at one default-sized frame, which fits the RFC default stream window of any server.
+        if (has_body) {
+            put_frame(FrameType::data, FLAG_END_STREAM, this->next_stream_id, this->body.data(), static_cast<uint32_t>(this->body.size()));
+        }
+
+        *slot = StreamSlot {this->next_stream_id, now_ns(), false};
+        this->next_stream_id += 2U;
+        this->active_count++;
+    }
+}
+
+StreamSlot* ClientConnection::find_slot(uint32_t stream_id) {
+    for (auto& slot : this->slots) {
+        if (slot.stream_id == stream_id) {
+            return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+void ClientConnection::finish_stream(uint32_t stream_id, bool failed) {
+    StreamSlot* slot = find_slot(stream_id);
+
+    if (!slot || stream_id == 0U) {
+        return;
+    }
+
+    uint64_t latency_ns = now_ns() - slot->start_ns;
+
+    this->stats.latency_us.record((latency_ns + 500UL) / 1000UL);
+    this->stats.completed++;
+
+    if (failed || slot->failed) {
+        this->stats.failed++;
+    }
+
+    slot->stream_id = 0U;
+    this->active_count--;
+}
+
+bool ClientConnection::on_header_block(uint32_t stream_id, bool end_stream) {
+    HpackStatus status = this->decoder.decode_block(this->header_block.data(), static_cast<uint32_t>(this->header_block.size()), this->fields);
+
+    this->stats.header_octets += this->header_block.size();
+    this->header_block.clear();
+
+    if (status == HpackStatus::compression_error) {
+        return false;
+    }
+
+    StreamSlot* slot = find_slot(stream_id);
+    std::string_view response_status = this->fields.get_status();
+
+    if (slot && (status != HpackStatus::ok || response_status.empty() || (response_status[0] != '2' && response_status[0] != '3'))) {
+        slot->failed = true;
+    }
+
+    if (end_stream) {
+        finish_stream(stream_id, false);
+    }
+
+    return true;
+}
+
+bool ClientConnection::on_frame(const FrameHeader& header, const uint8_t* payload) {
+    switch (header.type) {
+    case FrameType::data:
+        this->stats.data_octets += header.length;
+        this->unacked_octets += header.length;
+
+        if (this->unacked_octets >= CLIENT_WINDOW_REFILL) {
+            put_window_update(0U, static_cast<uint32_t>(this->unacked_octets));
+            this->unacked_octets = 0UL;
+        }
+
+        if ((header.flags & FLAG_END_STREAM) != 0) {
+            finish_stream(header.stream_id, false);
+        }
+
+        return true;
+    case FrameType::headers: {
+        uint32_t skip_front = 0U;
+        uint32_t pad_length = 0U;
+
+        if ((header.flags & FLAG_PADDED) != 0) {
+            if (header.length < 1U) {
+                return false;
+            }
+
+            pad_length = payload[0];
+            skip_front = 1U;
+        }
+
+        if ((header.flags & FLAG_PRIORITY) != 0) {
+            skip_front += 5U;
+        }
+
+        if (skip_front + pad_length > header.length) {
+            return false;
+        }
+
+        this->header_block.assign(payload + skip_front, payload + header.length - pad_length);
+        this->header_stream_id = header.stream_id;
+        this->header_flags = header.flags;
+
+        return ((header.flags & FLAG_END_HEADERS) == 0) || on_header_block(header.stream_id, (header.flags & FLAG_END_STREAM) != 0);
+    }
+    case FrameType::continuation:
+        if (header.stream_id != this->header_stream_id) {
+            return false;
+        }
+
+        this->header_block.insert(this->header_block.end(), payload, payload + header.length);
+
+        return ((header.flags & FLAG_END_HEADERS) == 0) || on_header_block(header.stream_id, (this->header_flags & FLAG_END_STREAM) != 0);
+    case FrameType::settings:
+        if ((header.flags & FLAG_ACK) != 0) {
+            return true;
+        }
+
+        if (parse_settings_payload(this->peer_settings, payload, header.length) != H2Error::no_error) {
+            return false;
+        }
+
+        put_frame(FrameType::settings, FLAG_ACK, 0U, nullptr, 0U);
+        return true;
+    case FrameType::ping:
+        if ((header.flags & FLAG_ACK) == 0) {
+            put_frame(FrameType::ping, FLAG_ACK, 0U, payload, header.length);
+        }
+
+        return true;
+    case FrameType::rst_stream:
+        finish_stream(header.stream_id, true);
+        return true;
+    case FrameType::goaway:
+        // Streams above the last processed ID were never handled; count them as failures and stop issuing.
+        this->is_draining = true;
+
+        for (auto& slot : this->slots) {
+            if (slot.stream_id != 0U) {
+                finish_stream(slot.stream_id, true);
+            }
+        }
+
+        return true;
+    default:
+        // WINDOW_UPDATE, PRIORITY and unknown frames need no action from a client that only sends tiny bodies.
+        return true;
+    }
+}
+
+bool ClientConnection::connect_to(const addrinfo* address) {
+    this->fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+
+    if (this->fd == -1 || connect(this->fd, address->ai_addr, address->ai_addrlen) == -1) {
+        return false;
+    }
+
+    int enable = 1;
+
+    setsockopt(this->fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    fcntl(this->fd, F_SETFL, fcntl(this->fd, F_GETFL) | O_NONBLOCK);
+
+    const uint8_t settings_payload[] = {
+        0x00, 0x02, 0x00, 0x00, 0x00, 0x00,    // ENABLE_PUSH = 0
+        0x00, 0x04,                            // INITIAL_WINDOW_SIZE
+        static_cast<uint8_t>(CLIENT_WINDOW_SIZE >> 24), static_cast<uint8_t>(CLIENT_WINDOW_SIZE >> 16),
+        static_cast<uint8_t>(CLIENT_WINDOW_SIZE >> 8), static_cast<uint8_t>(CLIENT_WINDOW_SIZE)
+    };
+
+    this->out.insert(this->out.end(), H2_CLIENT_PREFACE, H2_CLIENT_PREFACE + H2_PREFACE_LENGTH);
+    put_frame(FrameType::settings, 0, 0U, settings_payload, sizeof(settings_payload));
+    put_window_update(0U, CLIENT_WINDOW_SIZE - DEFAULT_INITIAL_WINDOW_SIZE);
+    issue_requests();
+
+    return true;
+}
+
+int ClientConnection::get_fd() const {
+    return this->fd;
+}
+
+bool ClientConnection::wants_write() const {
+    return this->out_sent < this->out.size();
+}
+
+bool ClientConnection::is_done() const {
+    return this->is_broken || (this->is_draining && this->active_count == 0U && !wants_write());
+}
+
+bool ClientConnection::on_readable() {
+    uint8_t chunk[CLIENT_READ_CHUNK];
+
+    while (true) {
+        ssize_t got = recv(this->fd, chunk, sizeof(chunk), 0);
+
+        if (got == 0) {
+            return false;
+        }
+
+        if (got == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+
+            return false;
+        }
+
+        this->in.insert(this->in.end(), chunk, chunk + got);
+    }
+
+    size_t cursor = 0UL;
+    FrameHeader header {};
+
+    while (this->in.size() - cursor >= FRAME_HEADER_SIZE) {
+        if (!unpack_frame_header(header, this->in.data() + cursor, FRAME_HEADER_SIZE)) {
+            return false;
+        }
+
+        if (this->in.size() - cursor - FRAME_HEADER_SIZE < header.length) {
+            break;
+        }
+
+        if (!on_frame(header, this->in.data() + cursor + FRAME_HEADER_SIZE)) {
+            return false;
+        }
+
+        cursor += FRAME_HEADER_SIZE + header.length;
+    }
+
+    this->in.erase(this->in.begin(), this->in.begin() + static_cast<ptrdiff_t>(cursor));
+    issue_requests();
+
+    return true;
+}
+
+bool ClientConnection::on_writable() {
+    while (this->out_sent < this->out.size()) {
+        ssize_t sent = send(this->fd, this->out.data() + this->out_sent, this->out.size() - this->out_sent, MSG_NOSIGNAL);
+
+        if (sent == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        this->out_sent += static_cast<size_t>(sent);
+    }
+
+    this->out.clear();
+    this->out_sent = 0UL;
+
+    return true;
+}
+
+void ClientConnection::mark_broken() {
+    // Whatever was in flight on a dead connection never completed.
+    for (auto& slot : this->slots) {
+        if (slot.stream_id != 0U) {
+            finish_stream(slot.stream_id, true);
+        }
+    }
+
+    this->is_broken = true;
+    this->stats.broken_connections++;
+}
+
+/* Worker */
+
+static void run_worker(const LoadOptions& options, const std::vector<uint32_t>& mix_table, const addrinfo* address, uint32_t connection_count, RunState& state, WorkerStats& stats) {
+    std::vector<std::unique_ptr<ClientConnection>> connections {};
+    std::vector<pollfd> poll_fds {};
+
+    for (uint32_t conn_i = 0U; conn_i < connection_count; conn_i++) {
+        auto connection = std::make_unique<ClientConnection>(options, mix_table, state, stats);
+
+        if (!connection->connect_to(address)) {
+            stats.broken_connections++;
+            continue;
+        }
+
+        connections.push_back(std::move(connection));
+    }
+
+    while (true) {
+        poll_fds.clear();
+
+        for (auto& connection : connections) {
+            if (!connection->is_done()) {
+                poll_fds.push_back(pollfd {connection->get_fd(), static_cast<short>(POLLIN | (connection->wants_write() ? POLLOUT : 0)), 0});
+            }
+        }
+
+        if (poll_fds.empty()) {
+            break;
+        }
+
+        if (poll(poll_fds.data(), poll_fds.size(), 100) == -1 && errno != EINTR) {
+            break;
+        }
+
+        size_t poll_i = 0UL;
+
+        for (auto& connection : connections) {
+            if (connection->is_done()) {
+                continue;
+            }
+
+            short revents = poll_fds[poll_i++].revents;
+            bool conn_ok = true;
+
+            if ((revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+                conn_ok = connection->on_readable();
+            }
+
+            if (conn_ok && connection->wants_write()) {
+                conn_ok = connection->on_writable();
+            }
+
+            if (!conn_ok) {
+                connection->mark_broken();
+            }
+        }
+    }
+}
+
+/* Report */
+
+static void print_report(const LoadOptions& options, const WorkerStats& totals, double elapsed_s) {
+    const HdrHistogram& latency = totals.latency_us;
+    const double request_rate = static_cast<double>(totals.completed) / elapsed_s;
+    const double data_rate = static_cast<double>(totals.data_octets) / elapsed_s;
+
+    if (options.as_json) {
+        std::cout << "{\"connections\":" << options.connections << ",\"streams\":" << options.streams
+                  << ",\"threads\":" << options.threads << ",\"elapsed_s\":" << elapsed_s
+                  << ",\"completed\":" << totals.completed << ",\"failed\":" << totals.failed
+                  << ",\"broken_connections\":" << totals.broken_connections
+                  << ",\"requests_per_sec\":" << request_rate << ",\"data_bytes_per_sec\":" << data_rate
+                  << ",\"header_bytes\":" << totals.header_octets << ",\"sent_header_bytes\":" << totals.sent_header_octets
+                  << ",\"latency_us\":{\"min\":" << latency.get_min() << ",\"mean\":" << latency.get_mean()
+                  << ",\"p50\":" << latency.get_value_at_percentile(50.0) << ",\"p90\":" << latency.get_value_at_percentile(90.0)
+                  << ",\"p99\":" << latency.get_value_at_percentile(99.0) << ",\"p999\":" << latency.get_value_at_percentile(99.9)
+                  << ",\"max\":" << latency.get_max() << "}}" << std::endl;
+        return;
+    }
+
+    std::cout << "finished in " << elapsed_s << " s, " << request_rate << " req/s, " << data_rate / (1024.0 * 1024.0) << " MiB/s of DATA\n"
+              << "requests: " << totals.completed << " done, " << totals.failed << " failed, "
+              << totals.broken_connections << " broken connections\n"
+              << "header octets: " << totals.sent_header_octets << " sent, " << totals.header_octets << " received\n"
+              << "latency (us): min " << latency.get_min() << ", mean " << latency.get_mean()
+              << ", p50 " << latency.get_value_at_percentile(50.0) << ", p90 " << latency.get_value_at_percentile(90.0)
+              << ", p99 " << latency.get_value_at_percentile(99.0) << ", p99.9 " << latency.get_value_at_percentile(99.9)
+              << ", max " << latency.get_max() << std::endl;
+}
+
+int main(int argc, char** argv) {
+    LoadOptions options {};
+
+    if (!parse_options(argc, argv, options)) {
+        print_usage();
+        return 1;
+    }
+
+    addrinfo hints {};
+    addrinfo* address = nullptr;
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    if (getaddrinfo(options.host.c_str(), options.port.c_str(), &hints, &address) != 0 || !address) {
+        std::cerr << "Could not resolve " << options.authority << std::endl;
+        return 1;
+    }
+
+    // Expand weights into a cycle, so each connection walks the same deterministic mix.
+    std::vector<uint32_t> mix_table {};
+
+    for (uint32_t entry_i = 0U; entry_i < options.mix.size(); entry_i++) {
+        mix_table.insert(mix_table.end(), options.mix[entry_i].weight, entry_i);
+    }
+
+    RunState state {};
+    std::vector<std::unique_ptr<WorkerStats>> worker_stats {};
+    std::vector<std::thread> workers {};
+    const uint64_t start_ns = now_ns();
+
+    state.requests_left.store(static_cast<int64_t>(options.total_requests));
+    state.stop_flag.store(false);
+    state.deadline_ns = (options.duration_s > 0U) ? start_ns + static_cast<uint64_t>(options.duration_s) * 1000000000UL : 0UL;
+
+    for (uint32_t thread_i = 0U; thread_i < options.threads; thread_i++) {
+        uint32_t connection_count = options.connections / options.threads + ((thread_i < options.connections % options.threads) ? 1U : 0U);
+
+        worker_stats.push_back(std::make_unique<WorkerStats>());
+        workers.emplace_back(run_worker, std::cref(options), std::cref(mix_table), address, connection_count, std::ref(state), std::ref(*worker_stats.back()));
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    const double elapsed_s = static_cast<double>(now_ns() - start_ns) / 1e9;
+    WorkerStats totals {};
+
+    for (const auto& stats : worker_stats) {
+        totals.latency_us.merge(stats->latency_us);
+        totals.completed += stats->completed;
+        totals.failed += stats->failed;
+        totals.data_octets += stats->data_octets;
+        totals.header_octets += stats->header_octets;
+        totals.sent_header_octets += stats->sent_header_octets;
+        totals.broken_connections += stats->broken_connections;
+    }
+
+    freeaddrinfo(address);
+    print_report(options, totals, elapsed_s);
+
+    return (totals.completed > 0UL && totals.broken_connections == 0U) ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file h2pack.cpp
+ * @author Derek Tan
+ * @brief Offline packer: bundles a document root into one memory-mappable asset archive.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include "server/assetpack.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <doc-root> <archive-out>\n";
+        return 1;
+    }
+
+    int32_t packed_count = pack_asset_directory(argv[1], argv[2]);
+
+    if (packed_count < 0) {
+        std::cerr << "Failed to pack " << argv[1] << " into " << argv[2] << '\n';
+        return 1;
+    }
+
+    // Re-open the result, so a broken archive is caught here rather than at server startup.
+    AssetPack archive {};
+
+    if (!archive.open_archive(argv[2])) {
+        std::cerr << "Packed archive failed validation: " << argv[2] << '\n';
+        return 1;
+    }
+
+    std::cout << "Packed " << packed_count << " assets into " << argv[2] << '\n';
+
+    return 0;
+}
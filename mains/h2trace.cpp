@@ -0,0 +1,42 @@
+/**
+ * @file h2trace.cpp
+ * @author Derek Tan
+ * @brief Offline converter: turns a tracer dump into Chrome trace event JSON for Perfetto or `chrome://tracing`.
+ * @date 2026-10-19
+ */
+
+#include <cstdio>
+#include <iostream>
+#include "utils/tracer.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc != 2 && argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <trace-dump> [json-out]\n";
+        return 1;
+    }
+
+    double tick_ns = 0.0;
+    std::vector<TraceThread> threads {};
+    std::string json {};
+
+    if (!load_trace_dump(argv[1], tick_ns, threads)) {
+        std::cerr << "Not a readable trace dump: " << argv[1] << '\n';
+        return 1;
+    }
+
+    render_chrome_trace(json, tick_ns, threads);
+
+    if (argc == 2) {
+        std::cout << json;
+        return 0;
+    }
+
+    FILE* json_out = std::fopen(argv[2], "wb");
+
+    if (!json_out || std::fwrite(json.data(), 1UL, json.size(), json_out) != json.size() || std::fclose(json_out) != 0) {
+        std::cerr << "Failed to write " << argv[2] << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -2,11 +2,323 @@
  * @file main.cpp
  * @author Derek Tan
  * @brief Implements startup code for my h2c server.
- * @version 0.0.1
+ * @note Usage: `h2plus [port] [loop count] [document root] [asset pack]`. Serves assets from the pack (see `h2pack`) first, then files under the root, and Prometheus metrics at `/metrics`. `SIGUSR1` dumps the stage latency summaries to stderr, `SIGUSR2` writes a trace dump to `h2plus.trace` in tracing builds.
+ * @version 0.0.2
  * @date 2023-11-18
  */
 
-int main () {
-    // TODO implement after all other utils are done.
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include "server/assetpack.hpp"
+#include "server/h2server.hpp"
+#include "server/respcache.hpp"
+#include "server/router.hpp"
+#include "server/staticfile.hpp"
+#include "utils/metrics.hpp"
+#include "utils/stagetimes.hpp"
+#include "utils/tracer.hpp"
+
+constexpr uint16_t DEFAULT_PORT = 8080U;
+constexpr const char* TRACE_DUMP_PATH = "h2plus.trace";
+constexpr size_t PACK_CACHE_MEMORY = 4UL * 1024UL * 1024UL;  // per loop
+constexpr uint64_t PACK_CACHE_BODY_MAX = 16UL * 1024UL;        // one default size DATA frame
+
+enum RouteTarget : int32_t {
+    route_metrics,
+    route_files,
+    route_upload
+};
+
+// Fixed paths skip the trie: a hashed lookup settled at compile time. HEAD shares the GET routes; the connection leaves the body out.
+constexpr StaticRoute FIXED_ROUTES[] = {
+    {HttpMethod::get, "/metrics", route_metrics},
+    {HttpMethod::head, "/metrics", route_metrics},
+    {HttpMethod::post, "/upload", route_upload}
+};
+
+constexpr StaticRouteTable<3> FIXED_TABLE {FIXED_ROUTES};
+
+static_assert(FIXED_TABLE.find(HttpMethod::get, "/metrics").target == route_metrics);
+static_assert(FIXED_TABLE.find(HttpMethod::post, "/upload?size=1").target == route_upload);
+
+struct MimeType {
+    std::string_view extension;
+    std::string_view type;
+};
+
+constexpr MimeType MIME_TYPES[] = {
+    {".html", "text/html; charset=utf-8"},
+    {".css", "text/css"},
+    {".js", "text/javascript"},
+    {".json", "application/json"},
+    {".txt", "text/plain; charset=utf-8"},
+    {".png", "image/png"},
+    {".svg", "image/svg+xml"}
+};
+
+static std::string_view find_mime_type(std::string_view path) {
+    for (const auto& mime : MIME_TYPES) {
+        if (path.length() >= mime.extension.length() && path.substr(path.length() - mime.extension.length()) == mime.extension) {
+            return mime.type;
+        }
+    }
+
+    return "application/octet-stream";
+}
+
+/// @brief Replays a small packed asset pre-framed from this loop's cache, filling the entry on first use. The pack never changes while serving, so entries need no invalidation.
+static bool serve_cached(Http2Connection& connection, uint32_t stream_id, const AssetPack& pack, const PackedAssetEntry& entry, ContentCoding coding, const HeaderField* fields, uint32_t field_count) {
+    // One cache per loop thread, as `ResponseCache` is not thread safe.
+    thread_local ResponseCache loop_cache {PACK_CACHE_MEMORY};
+    std::string key {pack.get_path(entry)};
+
+    key.push_back(' ');
+    key.append(get_coding_token(coding));
+
+    const CachedResponse* hit = loop_cache.find(key);
+
+    if (!hit) {
+        std::string_view body = pack.get_body(entry, coding);
+        std::vector<HeaderTablePair> headers {{":status", "200"}};
+
+        for (uint32_t field_i = 0U; field_i < field_count; field_i++) {
+            headers.emplace_back(std::string {fields[field_i].name}, std::string {fields[field_i].value});
+        }
+
+        headers.emplace_back("content-length", std::to_string(body.length()));
+
+        if (!loop_cache.insert(key, headers, reinterpret_cast<const uint8_t*>(body.data()), body.length())) {
+            return false;
+        }
+
+        hit = loop_cache.find(key);
+    }
+
+    return connection.send_cached_response(stream_id, *hit);
+}
+
+/// @brief Answers from the pack when it holds the path. The body goes out with `sendfile` from the shared archive fd, so nothing is opened or copied per request.
+static bool serve_packed(Http2Connection& connection, uint32_t stream_id, const AssetPack& pack, std::string_view normalized, const HeaderList& request) {
+    const std::string index_path = (normalized.back() == '/') ? std::string {normalized}.append("index.html") : std::string {};
+    const PackedAssetEntry* entry = pack.find((index_path.empty()) ? normalized : std::string_view {index_path});
+
+    if (!entry) {
+        return false;
+    }
+
+    const HeaderField* accept_encoding = request.find_field("accept-encoding");
+    const HeaderField* if_none_match = request.find_field("if-none-match");
+    const ContentCoding coding = pack.negotiate(*entry, (accept_encoding) ? accept_encoding->value : std::string_view {});
+    HeaderField fields[2U + CONTENT_CODING_FIELD_MAX] {{"etag", pack.get_etag(*entry, coding)}, {"content-type", pack.get_content_type(*entry)}};
+
+    if (if_none_match && pack.is_not_modified(*entry, coding, if_none_match->value)) {
+        // A 304 repeats the Vary the 200 would carry, like `AssetPack::encode_not_modified`.
+        const uint32_t field_count = 1U + put_coding_fields(fields + 1, ContentCoding::identity, entry->variant_mask);
+
+        connection.send_response(stream_id, 304U, fields, field_count, "");
+        return true;
+    }
+
+    const PackedAssetVariant& variant = entry->variants[static_cast<uint32_t>(coding)];
+    const uint32_t field_count = 2U + put_coding_fields(fields + 2, coding, entry->variant_mask);
+
+    // Small assets skip HPACK and framing altogether; a window too small for the whole body falls through to `sendfile`.
+    if (variant.data_length <= PACK_CACHE_BODY_MAX && serve_cached(connection, stream_id, pack, *entry, coding, fields, field_count)) {
+        return true;
+    }
+
+    auto file = std::make_unique<StaticFileSender>();
+
+    file->attach_range(pack.get_fd(), variant.data_offset, variant.data_length);
+    connection.send_file_response(stream_id, 200U, fields, field_count, std::move(file));
+
+    return true;
+}
+
+/// @brief A file opened on the offload pool, shared by the job and its completion.
+struct FileOpen {
+    std::string path;
+    std::string accept_encoding;   // copied, since the request's fields are reused before the job runs
+    std::unique_ptr<StaticFileSender> file;
+    bool is_found;
+};
+
+static void serve_file(Http2Connection& connection, uint32_t stream_id, const std::string& doc_root, const AssetPack& pack, const HeaderList& request) {
+    auto file_open = std::make_shared<FileOpen>();
+    const HeaderField* accept_encoding = request.find_field("accept-encoding");
+    std::string_view request_path = request.get_path();
+    std::string normalized {};
+
+    // Resolved before it meets the filesystem, so no spelling of `..` walks out of the document root.
+    if (!normalize_request_path(request_path, normalized)) {
+        connection.send_response(stream_id, 404U, nullptr, 0U, "not found\n");
+        return;
+    }
+
+    if (pack.is_open() && serve_packed(connection, stream_id, pack, normalized, request)) {
+        return;
+    }
+
+    file_open->path = doc_root + normalized;
+    file_open->accept_encoding = (accept_encoding) ? accept_encoding->value : std::string_view {};
+    file_open->file = std::make_unique<StaticFileSender>();
+    file_open->is_found = false;
+
+    if (normalized.back() == '/') {
+        file_open->path.append("index.html");
+    }
+
+    // A cold dentry or inode cache turns the open into disk waits, which must not hold up the loop's other connections.
+    connection.offload([file_open]() {
+        // A precompressed `.br`, `.zst` or `.gz` sidecar is sent instead when the client takes it.
+        file_open->is_found = file_open->file->open_negotiated(file_open->path.c_str(), file_open->accept_encoding);
+    }, [&connection, stream_id, file_open]() {
+        if (!file_open->is_found) {
+            connection.send_response(stream_id, 404U, nullptr, 0U, "not found\n");
+            return;
+        }
+
+        const StaticFileSender& file = *file_open->file;
+        HeaderField fields[1U + CONTENT_CODING_FIELD_MAX] {{"content-type", find_mime_type(file_open->path)}};
+        const uint32_t field_count = 1U + put_coding_fields(fields + 1, file.get_coding(), file.get_available_mask());
+
+        connection.send_file_response(stream_id, 200U, fields, field_count, std::move(file_open->file));
+    });
+}
+
+/// @brief Tries the fixed table, then the trie. A path both know allows the methods of either, since `/*file` also covers the fixed paths.
+static RouteMatch match_route(const Router& router, HttpMethod method, std::string_view path) {
+    RouteMatch match = FIXED_TABLE.find(method, path);
+
+    if (match.status == RouteStatus::found) {
+        return match;
+    }
+
+    const uint32_t fixed_mask = match.allowed_mask;
+
+    match = router.match(method, path);
+    match.allowed_mask |= fixed_mask;
+
+    if (match.status == RouteStatus::not_found && match.allowed_mask != 0U) {
+        match.status = RouteStatus::method_not_allowed;
+    }
+
+    return match;
+}
+
+static void serve_metrics(Http2Connection& connection, uint32_t stream_id) {
+    const HeaderField fields[] = {{"content-type", "text/plain; version=0.0.4"}};
+    std::string body {};
+
+    render_metrics(body);
+    render_stage_times(body);
+    connection.send_response(stream_id, 200U, fields, 1U, body);
+}
+
+int main (int argc, char** argv) {
+    ServerConfig config {"", DEFAULT_PORT, 1U, H2_DEFAULT_RECV_WINDOW_LIMIT, SERVER_IDLE_TIMEOUT_MS, SERVER_HANDSHAKE_TIMEOUT_MS, SERVER_HEADER_TIMEOUT_MS, SERVER_POOL_WORKERS};
+    std::string doc_root {(argc > 3) ? argv[3] : "."};
+    AssetPack pack {};
+    Router router {};
+    sigset_t stop_signals {};
+    int caught_signal = 0;
+
+    if (argc > 1) {
+        config.port = static_cast<uint16_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    if (argc > 2) {
+        config.loop_count = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+    }
+
+    if (argc > 4 && !pack.open_archive(argv[4])) {
+        std::cerr << "Could not open asset pack " << argv[4] << std::endl;
+        return 1;
+    }
+
+    for (auto method : {HttpMethod::get, HttpMethod::head}) {
+        router.add_route(method, "/", route_files);
+        router.add_route(method, "/*file", route_files);
+    }
+
+    // Block the stop signals before any loop thread exists, so only the sigwait below sees them.
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    sigaddset(&stop_signals, SIGUSR1);
+    sigaddset(&stop_signals, SIGUSR2);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+    Server server {[&router, &doc_root, &pack](Http2Connection& connection, uint32_t stream_id, const HeaderList& request) {
+        const uint64_t route_ticks = stage_clock_ticks();
+        RouteMatch match = match_route(router, parse_http_method(request.get_method()), request.get_path());
+
+        record_stage(Stage::routing, stage_clock_ticks() - route_ticks);
+
+        switch (match.status) {
+        case RouteStatus::found:
+            if (match.target == route_metrics) {
+                serve_metrics(connection, stream_id);
+            } else if (match.target == route_upload) {
+                // The body handler answers once the upload ends.
+                if (!connection.read_body(stream_id)) {
+                    connection.send_response(stream_id, 204U, nullptr, 0U, "");
+                }
+            } else {
+                serve_file(connection, stream_id, doc_root, pack, request);
+            }
+            break;
+        case RouteStatus::method_not_allowed: {
+            const std::string allowed_methods = format_allowed_methods(match.allowed_mask);
+            const HeaderField fields[] = {{"allow", allowed_methods}};
+
+            connection.send_response(stream_id, 405U, fields, 1U, "");
+            break;
+        }
+        default:
+            connection.send_response(stream_id, 404U, nullptr, 0U, "not found\n");
+            break;
+        }
+    }, [](Http2Connection& connection, uint32_t stream_id, std::string_view data, bool is_last) {
+        // `/upload` is a sink for load tests: drain each chunk as it comes so the upload runs at line rate.
+        connection.consume_body(stream_id, static_cast<uint32_t>(data.length()));
+
+        if (is_last) {
+            connection.send_response(stream_id, 204U, nullptr, 0U, "");
+        }
+    }};
+
+    if (config.loop_count == 0U || !server.start(config)) {
+        std::cerr << "Could not listen on port " << config.port << std::endl;
+        return 1;
+    }
+
+    std::cout << "Serving " << doc_root << " on port " << config.port << " with " << config.loop_count << " loops." << std::endl;
+
+    if (pack.is_open()) {
+        std::cout << "Serving " << pack.get_entry_count() << " packed assets from " << argv[4] << " ahead of the document root." << std::endl;
+    }
+
+    // SIGUSR1 and SIGUSR2 ask for reports without stopping, which is safe here since sigwait runs on a plain thread.
+    while (sigwait(&stop_signals, &caught_signal) == 0 && (caught_signal == SIGUSR1 || caught_signal == SIGUSR2)) {
+        if (caught_signal == SIGUSR1) {
+            std::string report {};
+
+            render_stage_times(report);
+            std::cerr << report << std::flush;
+        } else if (dump_traces(TRACE_DUMP_PATH)) {
+            std::cerr << "Wrote trace dump " << TRACE_DUMP_PATH << std::endl;
+        } else {
+            std::cerr << "Could not write trace dump " << TRACE_DUMP_PATH << std::endl;
+        }
+    }
+
+    server.stop();
+    server.wait();
+
     return 0;
 }
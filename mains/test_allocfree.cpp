@@ -0,0 +1,192 @@
+/**
+ * @file test_allocfree.cpp
+ * @author Derek Tan
+ * @brief Implements regression test asserting that warmed-up HPACK and request/response paths allocate nothing.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "bench/alloccount.hpp"
+#include "bench/headercorpus.hpp"
+#include "hpack/hpackdecoder.hpp"
+#include "hpack/hpackencoder.hpp"
+#include "http1/h1parser.hpp"
+#include "server/h2connection.hpp"
+
+constexpr uint32_t WARM_ROUNDS = 4U;   // enough for every scratch buffer to reach its high-water mark
+constexpr uint32_t CHECKED_ROUNDS = 16U;
+
+static bool check_no_allocs(const char* label, const AllocScope& scope) {
+    if (scope.get_count() != 0UL) {
+        std::cerr << label << " allocated " << scope.get_count() << " times (" << scope.get_bytes() << " octets) once warm!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+static void append_indexed_literal(std::vector<uint8_t>& block, std::string_view name, std::string_view value) {
+    // Literal with incremental indexing and a new name, both strings raw (RFC 7541 6.2.1). Lengths stay under the 7-bit prefix.
+    block.push_back(HPACK_LITERAL_INDEXING);
+    block.push_back(static_cast<uint8_t>(name.length()));
+    block.insert(block.end(), name.begin(), name.end());
+    block.push_back(static_cast<uint8_t>(value.length()));
+    block.insert(block.end(), value.begin(), value.end());
+}
+
+static void encode_corpus(HpackEncoder& encoder, std::vector<uint8_t>& block, const CorpusHeaderSet& header_set) {
+    block.clear();
+
+    for (size_t field_i = 0UL; field_i < header_set.count; field_i++) {
+        encoder.encode_field(block, header_set.fields[field_i].name, header_set.fields[field_i].value);
+    }
+}
+
+static int test_encoder() {
+    HpackEncoder encoder {};
+    std::vector<uint8_t> block {};
+
+    for (uint32_t round_i = 0U; round_i < WARM_ROUNDS; round_i++) {
+        for (size_t set_i = 0UL; set_i < REQUEST_CORPUS_COUNT; set_i++) {
+            encode_corpus(encoder, block, REQUEST_CORPUS[set_i]);
+        }
+    }
+
+    AllocScope scope {};
+
+    for (uint32_t round_i = 0U; round_i < CHECKED_ROUNDS; round_i++) {
+        for (size_t set_i = 0UL; set_i < REQUEST_CORPUS_COUNT; set_i++) {
+            encode_corpus(encoder, block, REQUEST_CORPUS[set_i]);
+        }
+    }
+
+    return check_no_allocs("HPACK encoding", scope) ? 0 : 1;
+}
+
+static int test_decoder() {
+    // RFC 7541 C.4: Huffman literals that insert into the dynamic table, then reference it.
+    const std::vector<std::vector<uint8_t>> blocks = {
+        {0x82, 0x86, 0x84, 0x41, 0x8c, 0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a, 0x6b, 0xa0, 0xab, 0x90, 0xf4, 0xff},
+        {0x82, 0x86, 0x84, 0xbe, 0x58, 0x86, 0xa8, 0xeb, 0x10, 0x64, 0x9c, 0xbf},
+        {0x82, 0x87, 0x85, 0xbf, 0x40, 0x88, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xa9, 0x7d, 0x7f, 0x89, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf}
+    };
+    std::vector<std::vector<uint8_t>> corpus_blocks {};
+    std::vector<std::vector<uint8_t>> long_blocks(3UL);
+    HpackEncoder encoder {};
+    HpackDecoder decoder {};
+    HeaderList fields {};
+
+    for (size_t set_i = 0UL; set_i < REQUEST_CORPUS_COUNT; set_i++) {
+        corpus_blocks.emplace_back();
+        encode_corpus(encoder, corpus_blocks.back(), REQUEST_CORPUS[set_i]);
+    }
+
+    // Values past the small-string buffer, so a slot that had to allocate its strings would show up.
+    append_indexed_literal(long_blocks[0], "x-request-id", "4f1c2b7e-9a3d-4e51-b8c6-0d2f7a91e3c4");
+    append_indexed_literal(long_blocks[1], "x-forwarded-for", "203.0.113.7, 198.51.100.23, 192.0.2.200");
+    append_indexed_literal(long_blocks[2], "x-trace-context", "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01");
+
+    // The C.4 and long blocks insert on every pass, so this also covers insertion and eviction once the table has filled.
+    auto decode_round = [&]() {
+        bool is_ok = true;
+
+        for (const auto& block : blocks) {
+            fields.clear();
+            is_ok = is_ok && decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), fields) == HpackStatus::ok;
+        }
+
+        for (const auto& block : long_blocks) {
+            fields.clear();
+            is_ok = is_ok && decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), fields) == HpackStatus::ok;
+        }
+
+        for (const auto& block : corpus_blocks) {
+            fields.clear();
+            is_ok = is_ok && decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), fields) == HpackStatus::ok;
+        }
+
+        return is_ok;
+    };
+
+    for (uint32_t round_i = 0U; round_i < WARM_ROUNDS * 16U; round_i++) {
+        if (!decode_round()) {
+            std::cerr << "Warm-up decode failed!" << std::endl;
+            return 1;
+        }
+    }
+
+    AllocScope scope {};
+
+    for (uint32_t round_i = 0U; round_i < CHECKED_ROUNDS; round_i++) {
+        decode_round();
+    }
+
+    return check_no_allocs("HPACK decoding", scope) ? 0 : 1;
+}
+
+static void append_frame(std::vector<uint8_t>& out, FrameType type, uint8_t flags, uint32_t stream_id, const std::vector<uint8_t>& payload) {
+    uint8_t raw_header[FRAME_HEADER_SIZE];
+
+    pack_frame_header(raw_header, FrameHeader {static_cast<uint32_t>(payload.size()), type, flags, stream_id});
+    out.insert(out.end(), raw_header, raw_header + FRAME_HEADER_SIZE);
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+static int test_request_cycle() {
+    const std::string body(200UL, 'x');
+    const HeaderField response_fields[] = {{"content-type", "text/plain; charset=utf-8"}, {"cache-control", "max-age=3600"}};
+    Http2Connection connection {[&body, &response_fields](Http2Connection& conn, uint32_t stream_id, const HeaderList& request) {
+        conn.send_response(stream_id, (request.get_path() == "/") ? 200U : 404U, response_fields, 2U, body);
+    }};
+    HpackEncoder encoder {};
+    CorpusHeaderSet request_set = REQUEST_CORPUS[0];
+    std::vector<uint8_t> request_block {};
+    std::vector<uint8_t> start {H2_CLIENT_PREFACE, H2_CLIENT_PREFACE + H2_PREFACE_LENGTH};
+    std::vector<uint8_t> request_frame {};
+    uint32_t stream_id = 1U;
+
+    encode_corpus(encoder, request_block, request_set);
+    append_frame(start, FrameType::settings, 0, 0U, {});
+    connection.feed(start.data(), start.size());
+    connection.consume_output(connection.get_output_size());
+
+    // One request per round on a fresh stream, drained like the event loop would.
+    auto run_round = [&]() {
+        request_frame.clear();
+        append_frame(request_frame, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, stream_id, request_block);
+        stream_id += 2U;
+
+        bool is_ok = connection.feed(request_frame.data(), request_frame.size()) && connection.get_output_size() > body.size();
+
+        connection.consume_output(connection.get_output_size());
+
+        return is_ok;
+    };
+
+    for (uint32_t round_i = 0U; round_i < WARM_ROUNDS * 16U; round_i++) {
+        if (!run_round()) {
+            std::cerr << "Warm-up request failed!" << std::endl;
+            return 1;
+        }
+    }
+
+    AllocScope scope {};
+
+    for (uint32_t round_i = 0U; round_i < CHECKED_ROUNDS; round_i++) {
+        run_round();
+    }
+
+    return (check_no_allocs("A request/response cycle", scope) && connection.get_stream_count() == 0U) ? 0 : 1;
+}
+
+int main() {
+    int failures = 0;
+
+    failures += test_encoder();
+    failures += test_decoder();
+    failures += test_request_cycle();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_assetpack.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the packed asset archive and its 304 fast path.
+ * @date 2026-10-19
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "server/assetpack.hpp"
+
+static bool write_text_file(const std::string& path, const std::string& text) {
+    FILE* out = std::fopen(path.c_str(), "wb");
+
+    if (!out) {
+        return false;
+    }
+
+    bool write_ok = std::fwrite(text.data(), 1UL, text.length(), out) == text.length();
+
+    return (std::fclose(out) == 0) && write_ok;
+}
+
+int main() {
+    char root_template[] = "/tmp/h2plus_rootXXXXXX";
+    char* doc_root = mkdtemp(root_template);
+
+    if (!doc_root) {
+        std::cerr << "Could not create a temp document root!" << std::endl;
+        return 1;
+    }
+
+    const std::string root {doc_root};
+    const std::string archive_path = root + ".h2pack";
+    const std::string site_css {"body { color: #222; }\n"};
+
+    mkdir((root + "/css").c_str(), 0700);
+
+    if (!write_text_file(root + "/index.html", "<!doctype html><p>hi</p>\n")
+        || !write_text_file(root + "/css/site.css", site_css)
+        || !write_text_file(root + "/css/site.css.gz", "fake-gzip-bytes")
+        || !write_text_file(root + "/robots.txt", "")) {
+        std::cerr << "Could not fill the temp document root!" << std::endl;
+        return 1;
+    }
+
+    // Three assets: the .gz sidecar becomes a variant of site.css instead of its own entry.
+    int status = 0;
+
+    if (pack_asset_directory(doc_root, archive_path.c_str()) != 3) {
+        std::cerr << "Packer found the wrong number of assets!" << std::endl;
+        status = 1;
+    }
+
+    AssetPack archive {};
+
+    if (status == 0 && (!archive.open_archive(archive_path.c_str()) || archive.get_entry_count() != 3U)) {
+        std::cerr << "Archive failed to map or validate!" << std::endl;
+        status = 1;
+    }
+
+    const PackedAssetEntry* css = (status == 0) ? archive.find("/css/site.css") : nullptr;
+
+    if (status == 0 && (!css || archive.get_content_type(*css) != "text/css; charset=utf-8"
+        || archive.get_body(*css, ContentCoding::identity) != site_css
+        || !archive.has_variant(*css, ContentCoding::gzip) || archive.has_variant(*css, ContentCoding::br)
+        || archive.get_body(*css, ContentCoding::gzip) != "fake-gzip-bytes")) {
+        std::cerr << "Lookup of /css/site.css returned wrong data!" << std::endl;
+        status = 1;
+    }
+
+    if (status == 0 && (!archive.find("/index.html") || !archive.find("/robots.txt")
+        || archive.find("/nope.html") != nullptr || archive.find("/css/site.css.gz") != nullptr)) {
+        std::cerr << "Perfect-hash lookups gave wrong hits or misses!" << std::endl;
+        status = 1;
+    }
+
+    if (status == 0) {
+        std::string_view etag = archive.get_etag(*css, ContentCoding::identity);
+        std::string weak_list = "\"0000000000000000\", W/" + std::string {etag};
+
+        if (etag.length() != 18UL || etag == archive.get_etag(*css, ContentCoding::gzip)
+            || !archive.is_not_modified(*css, ContentCoding::identity, etag)
+            || !archive.is_not_modified(*css, ContentCoding::identity, weak_list)
+            || !archive.is_not_modified(*css, ContentCoding::identity, "*")
+            || archive.is_not_modified(*css, ContentCoding::identity, "\"0000000000000000\"")) {
+            std::cerr << "ETag matching for If-None-Match is wrong!" << std::endl;
+            status = 1;
+        }
+    }
+
+    if (status == 0) {
+        HpackEncoder encoder {};
+        std::vector<uint8_t> block {};
+
+        archive.encode_not_modified(block, encoder, *css, ContentCoding::identity);
+
+        // Indexed :status 304 (static 11) then etag by static name reference (34).
+        if (block.size() < 3UL || block[0] != 0x8b || block[1] != 0x0f || block[2] != 0x13) {
+            std::cerr << "304 header block is malformed!" << std::endl;
+            status = 1;
+        }
+    }
+
+    archive.close_archive();
+    unlink(archive_path.c_str());
+    unlink((root + "/css/site.css.gz").c_str());
+    unlink((root + "/css/site.css").c_str());
+    rmdir((root + "/css").c_str());
+    unlink((root + "/index.html").c_str());
+    unlink((root + "/robots.txt").c_str());
+    rmdir(doc_root);
+
+    return status;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file test_backpressure.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for connection and stream buffer water marks.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include "server/backpressure.hpp"
+
+int main() {
+    BufferLimits limits {};
+    limits.conn_out_high = 1000UL;
+    limits.conn_out_low = 400UL;
+    limits.stream_out_high = 600UL;
+    limits.stream_out_low = 200UL;
+    limits.conn_in_high = 500UL;
+    limits.conn_in_low = 100UL;
+
+    ConnectionBudget budget {limits};
+    std::vector<uint32_t> resumed {};
+
+    // Stream 1 hits its own high mark first.
+    if (budget.reserve(1U, 500UL) != 500UL || budget.reserve(1U, 500UL) != 100UL || budget.reserve(1U, 10UL) != 0UL) {
+        std::cerr << "Stream high mark was not enforced!" << std::endl;
+        return 1;
+    }
+
+    // Stream 3 can only take what the connection has left.
+    if (budget.reserve(3U, 800UL) != 400UL || budget.get_outbound() != 1000UL) {
+        std::cerr << "Connection high mark was not enforced!" << std::endl;
+        return 1;
+    }
+
+    // Stream 1 was parked by its own mark, so draining it to its low mark is enough.
+    budget.on_flushed(1U, 400UL);
+
+    if (budget.collect_resumed(resumed) != 1U || resumed.back() != 1U) {
+        std::cerr << "Stream did not resume at its own low mark!" << std::endl;
+        return 1;
+    }
+
+    // Stream 3 was parked by the connection mark: it waits for the whole connection to drain.
+    budget.on_flushed(3U, 100UL);
+
+    if (budget.collect_resumed(resumed) != 0U) {
+        std::cerr << "Stream resumed before the connection drained!" << std::endl;
+        return 1;
+    }
+
+    budget.on_flushed(3U, 200UL);
+
+    if (budget.collect_resumed(resumed) != 1U || resumed.back() != 3U || budget.get_outbound() != 300UL) {
+        std::cerr << "Stream did not resume at the connection low mark!" << std::endl;
+        return 1;
+    }
+
+    // Closing a stream drops its queued octets from the total.
+    budget.close_stream(1U);
+
+    if (budget.get_outbound() != 100UL || budget.get_outbound(1U) != 0UL || budget.get_outbound_peak() != 1000UL) {
+        std::cerr << "Closed stream was not released from the budget!" << std::endl;
+        return 1;
+    }
+
+    // Inbound: stop reading at the high mark, resume at the low mark.
+    budget.on_inbound(300UL);
+    budget.on_inbound(250UL);
+
+    if (budget.should_read()) {
+        std::cerr << "Reading did not pause at the inbound high mark!" << std::endl;
+        return 1;
+    }
+
+    budget.on_consumed(400UL);
+
+    if (budget.should_read()) {
+        std::cerr << "Reading resumed above the inbound low mark!" << std::endl;
+        return 1;
+    }
+
+    budget.on_consumed(100UL);
+
+    if (!budget.should_read() || budget.get_inbound() != 50UL) {
+        std::cerr << "Reading did not resume at the inbound low mark!" << std::endl;
+        return 1;
+    }
+
+    // Stream 0 is the write queue: charges past the connection mark stop reading until it drains to the low mark.
+    budget.charge(0U, 1200UL);
+
+    if (budget.should_read() || !budget.is_outbound_full() || budget.reserve(5U, 10UL) != 0UL) {
+        std::cerr << "A full write queue did not stop reading and producers!" << std::endl;
+        return 1;
+    }
+
+    budget.on_flushed(0U, 700UL);
+
+    if (budget.should_read()) {
+        std::cerr << "Reading resumed above the connection low mark!" << std::endl;
+        return 1;
+    }
+
+    budget.on_flushed(0U, 500UL);
+
+    if (!budget.should_read() || budget.get_outbound(0U) != 0UL) {
+        std::cerr << "Reading did not resume once the write queue drained!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
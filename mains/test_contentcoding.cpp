@@ -0,0 +1,69 @@
+/**
+ * @file test_contentcoding.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for `accept-encoding` parsing and content coding negotiation.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include "server/contentcoding.hpp"
+
+constexpr uint32_t ALL_CODINGS = 0xfU;
+constexpr uint32_t IDENTITY_AND_GZIP = (1U << static_cast<uint32_t>(ContentCoding::identity)) | (1U << static_cast<uint32_t>(ContentCoding::gzip));
+
+int main() {
+    AcceptEncoding parsed {};
+
+    parsed.parse("gzip;q=0.8, BR ; q=0.955, identity;q=0, x-unknown");
+
+    if (parsed.qvalues[static_cast<uint32_t>(ContentCoding::gzip)] != 800U || parsed.qvalues[static_cast<uint32_t>(ContentCoding::br)] != 955U
+        || parsed.is_acceptable(ContentCoding::identity) || parsed.is_acceptable(ContentCoding::zstd)) {
+        std::cerr << "AcceptEncoding parsed q-values incorrectly!" << std::endl;
+        return 1;
+    }
+
+    // Malformed weights drop just their item; "*" fills in the codings not named.
+    AcceptEncoding wildcard {};
+
+    wildcard.parse("br;q=1.5, gzip;q=0.25, *;q=0.1");
+
+    if (wildcard.qvalues[static_cast<uint32_t>(ContentCoding::br)] != 100U || wildcard.qvalues[static_cast<uint32_t>(ContentCoding::gzip)] != 250U
+        || wildcard.qvalues[static_cast<uint32_t>(ContentCoding::identity)] != 100U) {
+        std::cerr << "AcceptEncoding mishandled a wildcard or bad q-value!" << std::endl;
+        return 1;
+    }
+
+    // Equal weights go to the smallest coding, and unavailable codings are never chosen.
+    if (negotiate_coding("gzip, deflate, br, zstd", ALL_CODINGS) != ContentCoding::br
+        || negotiate_coding("gzip, deflate, br", IDENTITY_AND_GZIP) != ContentCoding::gzip
+        || negotiate_coding("br;q=0.9, gzip", ALL_CODINGS) != ContentCoding::gzip
+        || negotiate_coding("", ALL_CODINGS) != ContentCoding::identity
+        || negotiate_coding("zstd", IDENTITY_AND_GZIP) != ContentCoding::identity) {
+        std::cerr << "negotiate_coding picked the wrong coding!" << std::endl;
+        return 1;
+    }
+
+    HpackEncoder encoder {};
+    std::vector<uint8_t> plain_block {};
+    std::vector<uint8_t> varied_block {};
+
+    encode_coding_fields(plain_block, encoder, ContentCoding::identity, 1U);
+    encode_coding_fields(varied_block, encoder, ContentCoding::gzip, IDENTITY_AND_GZIP);
+
+    if (!plain_block.empty() || varied_block.empty()) {
+        std::cerr << "encode_coding_fields emitted the wrong fields!" << std::endl;
+        return 1;
+    }
+
+    HeaderField fields[CONTENT_CODING_FIELD_MAX] {};
+
+    // Identity with a gzip sidecar on disk still varies, since other clients get gzip.
+    if (put_coding_fields(fields, ContentCoding::identity, 1U) != 0U
+        || put_coding_fields(fields, ContentCoding::identity, IDENTITY_AND_GZIP) != 1U || fields[0].name != "vary"
+        || put_coding_fields(fields, ContentCoding::gzip, IDENTITY_AND_GZIP) != 2U || fields[0].value != "gzip" || fields[1].value != "accept-encoding") {
+        std::cerr << "put_coding_fields emitted the wrong fields!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
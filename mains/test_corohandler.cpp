@@ -0,0 +1,282 @@
+/**
+ * @file test_corohandler.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the frame arena and coroutine handler API, alone and driven by `Http2Connection`. The coroutine part only runs in `CPP20_BUILD=1` builds.
+ * @date 2026-10-19
+ */
+
+#include <poll.h>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "server/corohandler.hpp"
+#include "server/h2connection.hpp"
+#include "utils/framearena.hpp"
+
+#if defined(H2PLUS_COROUTINES)
+
+/// @brief Mock streaming handler: sums body octets, waits for send window, then offloads a "checksum" job.
+HandlerTask mock_upload_handler(FrameArena& arena, CoroStream& stream, uint32_t& result) {
+    (void)arena;
+    uint32_t octet_sum = 0U;
+
+    while (true) {
+        BodyChunk chunk = co_await stream.body.next_chunk();
+
+        for (uint32_t octet_i = 0U; octet_i < chunk.length; octet_i++) {
+            octet_sum += chunk.data[octet_i];
+        }
+
+        if (chunk.is_last) {
+            break;
+        }
+    }
+
+    uint32_t granted = co_await stream.send_window.reserve(100U);
+    uint32_t checksum = 0U;
+
+    bool offloaded = co_await stream.offload([&checksum, octet_sum]() {
+        checksum = octet_sum * 2U;
+    });
+
+    result = (offloaded) ? checksum + granted : 0U;
+}
+
+static int test_coroutines() {
+    FrameArena arena {};
+    ThreadPool pool {2U};
+    CompletionQueue replies {};
+    CoroStream stream {0, &pool, &replies};
+    uint32_t result = 0U;
+    const uint8_t body_part1[] = {1, 2, 3};
+    const uint8_t body_part2[] = {4, 5};
+
+    HandlerTask task = mock_upload_handler(arena, stream, result);
+
+    if (!task.is_valid() || task.done() || arena.get_live_count() != 1U || arena.get_fallback_count() != 0U) {
+        std::cerr << "Handler frame did not come from the connection arena!" << std::endl;
+        return 1;
+    }
+
+    stream.body.push_chunk(body_part1, sizeof(body_part1));
+    stream.body.push_chunk(body_part2, sizeof(body_part2));
+    stream.body.finish();
+
+    // The handler should now be parked on an empty send window.
+    if (task.done()) {
+        std::cerr << "Handler ignored an empty flow-control window!" << std::endl;
+        return 1;
+    }
+
+    stream.send_window.grant(60);
+
+    pollfd wakeup {replies.get_wakeup_fd(), POLLIN, 0};
+
+    while (!task.done()) {
+        if (poll(&wakeup, 1, 2000) <= 0) {
+            std::cerr << "Offloaded job never completed!" << std::endl;
+            return 1;
+        }
+
+        replies.drain();
+    }
+
+    if (result != 15U * 2U + 60U) {
+        std::cerr << "Handler produced an unexpected result: " << result << std::endl;
+        return 1;
+    }
+
+    task = HandlerTask {nullptr};
+
+    if (arena.get_live_count() != 0U) {
+        std::cerr << "Handler frame was not returned to the arena!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/// @brief Mock connection handler: counts an upload's octets, offloads a "digest" of them, then answers with it.
+HandlerTask mock_connection_handler(FrameArena& arena, CoroStream& stream, Http2Connection& connection, uint32_t stream_id, const HeaderList& request) {
+    (void)arena;
+    const bool is_upload = request.get_path() == "/upload";
+    uint32_t body_length = 0U;
+
+    while (is_upload) {
+        BodyChunk chunk = co_await stream.body.next_chunk();
+
+        body_length += chunk.length;
+        connection.consume_body(stream_id, chunk.length);
+
+        if (chunk.is_last) {
+            break;
+        }
+    }
+
+    uint32_t digest = 0U;
+
+    co_await stream.offload([&digest, body_length]() {
+        digest = body_length;
+    });
+
+    connection.send_response(stream_id, 200U, nullptr, 0U, std::to_string(digest));
+}
+
+static void append_frame(std::vector<uint8_t>& out, FrameType type, uint8_t flags, uint32_t stream_id, const std::vector<uint8_t>& payload) {
+    uint8_t raw_header[FRAME_HEADER_SIZE];
+
+    pack_frame_header(raw_header, FrameHeader {static_cast<uint32_t>(payload.size()), type, flags, stream_id});
+    out.insert(out.end(), raw_header, raw_header + FRAME_HEADER_SIZE);
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+static std::vector<uint8_t> make_request_block(const char* path) {
+    HpackEncoder encoder {};
+    std::vector<uint8_t> block {};
+
+    encoder.encode_field(block, ":method", "POST");
+    encoder.encode_field(block, ":scheme", "http");
+    encoder.encode_field(block, ":authority", "localhost");
+    encoder.encode_field(block, ":path", path);
+
+    return block;
+}
+
+/// @brief Takes the output, returning the DATA payload sent on `stream_id` and noting every stream that got HEADERS.
+static std::string take_reply(Http2Connection& connection, uint32_t stream_id, std::vector<uint32_t>& header_streams) {
+    const uint8_t* output = connection.get_output();
+    const size_t output_size = connection.get_output_size();
+    size_t cursor = 0UL;
+    std::string reply {};
+    FrameHeader header {};
+
+    while (output_size - cursor >= FRAME_HEADER_SIZE) {
+        unpack_frame_header(header, output + cursor, FRAME_HEADER_SIZE);
+        cursor += FRAME_HEADER_SIZE;
+
+        if (header.type == FrameType::headers) {
+            header_streams.push_back(header.stream_id);
+        } else if (header.stream_id == stream_id && header.type == FrameType::data) {
+            reply.append(reinterpret_cast<const char*>(output + cursor), header.length);
+        }
+
+        cursor += header.length;
+    }
+
+    connection.consume_output(output_size);
+
+    return reply;
+}
+
+static int test_connection_handler() {
+    std::vector<std::pair<std::function<void()>, std::function<void()>>> offloaded {};
+    bool plain_handler_ran = false;
+    Http2Connection connection {[&plain_handler_ran](Http2Connection&, uint32_t, const HeaderList&) {
+        plain_handler_ran = true;
+    }};
+    std::vector<uint8_t> client {H2_CLIENT_PREFACE, H2_CLIENT_PREFACE + H2_PREFACE_LENGTH};
+    std::vector<uint32_t> header_streams {};
+
+    // Completions wait here the way they would in the loop's completion queue.
+    connection.set_offloader([&offloaded](std::function<void()> work, std::function<void()> on_complete) {
+        offloaded.emplace_back(std::move(work), std::move(on_complete));
+    });
+    connection.set_coro_handler(mock_connection_handler);
+
+    append_frame(client, FrameType::settings, 0, 0U, {});
+    append_frame(client, FrameType::headers, FLAG_END_HEADERS, 1U, make_request_block("/upload"));
+    append_frame(client, FrameType::data, 0, 1U, std::vector<uint8_t>(3000UL, 'a'));
+    append_frame(client, FrameType::data, FLAG_END_STREAM, 1U, std::vector<uint8_t>(2000UL, 'b'));
+    append_frame(client, FrameType::headers, FLAG_END_HEADERS | FLAG_END_STREAM, 3U, make_request_block("/cancelled"));
+    connection.feed(client.data(), client.size());
+    take_reply(connection, 1U, header_streams);
+
+    if (plain_handler_ran || offloaded.size() != 2UL || !header_streams.empty() || connection.get_stream_count() != 2U) {
+        std::cerr << "Coroutine handlers did not take the requests and park on their offloaded work!" << std::endl;
+        return 1;
+    }
+
+    // Stream 3 is cancelled while its work is out: its handler goes now, and its completion must not resume it.
+    std::vector<uint8_t> cancel {};
+
+    append_frame(cancel, FrameType::rst_stream, 0, 3U, {0U, 0U, 0U, static_cast<uint8_t>(H2Error::cancel)});
+    connection.feed(cancel.data(), cancel.size());
+
+    for (auto& [work, on_complete] : offloaded) {
+        work();
+        on_complete();
+    }
+
+    std::string reply = take_reply(connection, 1U, header_streams);
+
+    if (header_streams != std::vector<uint32_t> {1U} || reply != "5000") {
+        std::cerr << "Coroutine handler answered wrongly after its offloaded work: " << reply << std::endl;
+        return 1;
+    }
+
+    if (connection.get_stream_count() != 0U) {
+        std::cerr << "Finished coroutine streams were left open!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+#endif
+
+static int test_arena() {
+    FrameArena arena {};
+    void* first = arena.allocate(200UL);
+    void* second = arena.allocate(200UL);
+
+    if (!first || !second || first == second || arena.get_live_count() != 2U) {
+        std::cerr << "FrameArena handed out bad blocks!" << std::endl;
+        return 1;
+    }
+
+    arena.deallocate(first, 200UL);
+
+    // A freed block of the same class must be recycled instead of carving new memory.
+    void* recycled = arena.allocate(250UL);
+
+    if (recycled != first || arena.get_chunk_count() != 1U) {
+        std::cerr << "FrameArena did not recycle a freed block!" << std::endl;
+        return 1;
+    }
+
+    void* huge = arena.allocate(FRAME_ARENA_MAX_BLOCK + 1UL);
+
+    if (!huge || arena.get_fallback_count() != 1U) {
+        std::cerr << "FrameArena mishandled an oversized block!" << std::endl;
+        return 1;
+    }
+
+    arena.deallocate(huge, FRAME_ARENA_MAX_BLOCK + 1UL);
+    arena.deallocate(recycled, 250UL);
+    arena.deallocate(second, 200UL);
+
+    if (arena.get_live_count() != 0U || arena.get_fallback_count() != 0U) {
+        std::cerr << "FrameArena counts did not return to zero!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int main() {
+    if (test_arena() != 0) {
+        return 1;
+    }
+
+#if defined(H2PLUS_COROUTINES)
+    if (test_coroutines() != 0) {
+        return 1;
+    }
+
+    return test_connection_handler();
+#else
+    std::cout << "Coroutine handler tests skipped: rebuild with CPP20_BUILD=1." << std::endl;
+    return 0;
+#endif
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test_h1parser.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for connection detection, the HTTP/1.1 parser and h2c Upgrade helpers.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <string>
+#include "http1/h1parser.hpp"
+
+static const uint8_t* as_octets(const std::string& text) {
+    return reinterpret_cast<const uint8_t*>(text.data());
+}
+
+int main() {
+    // Connection type detection works on whatever the first read returned.
+    const std::string preface {H2_CLIENT_PREFACE};
+    const std::string partial_preface = preface.substr(0, 10);
+    const std::string preface_and_frame = preface + std::string("\x00\x00\x00\x04\x00\x00\x00\x00\x00", 9);
+
+    if (detect_connection_kind(as_octets(preface_and_frame), preface_and_frame.length()) != ConnectionKind::h2_prior_knowledge
+        || detect_connection_kind(as_octets(partial_preface), partial_preface.length()) != ConnectionKind::need_more
+        || detect_connection_kind(as_octets(std::string {"GET / HTTP/1.1\r\n"}), 16UL) != ConnectionKind::http1
+        || detect_connection_kind(as_octets(std::string {"\x16\x03\x01"}), 3UL) != ConnectionKind::invalid) {
+        std::cerr << "Connection type detection failed!" << std::endl;
+        return 1;
+    }
+
+    // An h2c upgrade request with base64url SETTINGS: MAX_CONCURRENT_STREAMS=100, INITIAL_WINDOW_SIZE=65535.
+    const std::string upgrade_request {
+        "GET /index.html HTTP/1.1\r\n"
+        "Host: localhost:8080\r\n"
+        "Connection: Upgrade, HTTP2-Settings\r\n"
+        "Upgrade: h2c\r\n"
+        "HTTP2-Settings: AAMAAABkAAQAAP__\r\n"
+        "\r\n"
+    };
+
+    H1Request request {};
+
+    if (parse_h1_request(request, as_octets(upgrade_request), upgrade_request.length()) != H1ParseStatus::complete
+        || request.method != "GET" || request.target != "/index.html" || request.host != "localhost:8080"
+        || request.head_length != upgrade_request.length() || !request.keep_alive || !request.wants_h2c) {
+        std::cerr << "Upgrade request parsed incorrectly!" << std::endl;
+        return 1;
+    }
+
+    Http2Settings client_settings {};
+
+    if (decode_http2_settings(client_settings, request.http2_settings) != H2Error::no_error
+        || client_settings.max_concurrent_streams != 100U || client_settings.initial_window_size != 65535U) {
+        std::cerr << "HTTP2-Settings decoding failed!" << std::endl;
+        return 1;
+    }
+
+    // Pipelined keep-alive requests: the parser must stop exactly at the first blank line.
+    const std::string first_request {"POST /api HTTP/1.1\r\nhost: a\r\ncontent-length: 5\r\n\r\n"};
+    const std::string pipelined = first_request + "hello" + "GET /next HTTP/1.0\r\n\r\n";
+
+    if (parse_h1_request(request, as_octets(pipelined), pipelined.length()) != H1ParseStatus::complete
+        || request.head_length != first_request.length() || request.content_length != 5 || request.wants_h2c
+        || request.find_field("Content-Length") != "5") {
+        std::cerr << "Pipelined request head parsed incorrectly!" << std::endl;
+        return 1;
+    }
+
+    const size_t second_offset = first_request.length() + 5UL;
+
+    if (parse_h1_request(request, as_octets(pipelined) + second_offset, pipelined.length() - second_offset) != H1ParseStatus::complete
+        || request.version_minor != 0U || request.keep_alive) {
+        std::cerr << "HTTP/1.0 request should default to close!" << std::endl;
+        return 1;
+    }
+
+    // Truncated and malformed heads.
+    const std::string truncated {"GET / HTTP/1.1\r\nHost: a\r\n"};
+    const std::string smuggling {"POST / HTTP/1.1\r\ncontent-length: 3\r\ntransfer-encoding: chunked\r\n\r\n"};
+    const std::string folded {"GET / HTTP/1.1\r\nX-A: 1\r\n  2\r\n\r\n"};
+    const std::string split_smuggling {"POST / HTTP/1.1\r\ntransfer-encoding: chunked\r\ncontent-length: 3\r\ntransfer-encoding: identity\r\n\r\n"};
+    const std::string not_final {"POST / HTTP/1.1\r\ntransfer-encoding: chunked\r\ntransfer-encoding: gzip\r\n\r\n"};
+    const std::string twice_chunked {"POST / HTTP/1.1\r\ntransfer-encoding: chunked, chunked\r\n\r\n"};
+    const std::string gzip_chunked {"POST / HTTP/1.1\r\ntransfer-encoding: gzip\r\nTransfer-Encoding: Chunked\r\n\r\n"};
+
+    if (parse_h1_request(request, as_octets(truncated), truncated.length()) != H1ParseStatus::incomplete
+        || parse_h1_request(request, as_octets(smuggling), smuggling.length()) != H1ParseStatus::bad_request
+        || parse_h1_request(request, as_octets(folded), folded.length()) != H1ParseStatus::bad_request) {
+        std::cerr << "Malformed heads were not rejected!" << std::endl;
+        return 1;
+    }
+
+    // Transfer-Encoding is combined across fields: any TE with Content-Length, or a final coding other than chunked, is rejected.
+    if (parse_h1_request(request, as_octets(split_smuggling), split_smuggling.length()) != H1ParseStatus::bad_request
+        || parse_h1_request(request, as_octets(not_final), not_final.length()) != H1ParseStatus::bad_request
+        || parse_h1_request(request, as_octets(twice_chunked), twice_chunked.length()) != H1ParseStatus::bad_request) {
+        std::cerr << "Ambiguous Transfer-Encoding was not rejected!" << std::endl;
+        return 1;
+    }
+
+    if (parse_h1_request(request, as_octets(gzip_chunked), gzip_chunked.length()) != H1ParseStatus::complete
+        || !request.is_chunked || request.content_length != -1) {
+        std::cerr << "Combined Transfer-Encoding ending in chunked should parse!" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> response {};
+    H1Field response_fields[] = {{"content-type", "text/plain"}};
+
+    append_h1_response_head(response, 404U, response_fields, 1U, 9UL, true);
+
+    if (std::string(response.begin(), response.end()) != "HTTP/1.1 404 Not Found\r\ncontent-type: text/plain\r\ncontent-length: 9\r\n\r\n") {
+        std::cerr << "HTTP/1.1 response head is malformed!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
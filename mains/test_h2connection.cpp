@@ -0,0 +1,872 @@
+/**
+ * @file test_h2connection.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the sans-I/O HTTP/2 server connection.
+ * @date 2026-10-19
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "http1/h1parser.hpp"
+#include "server/h2connection.hpp"
+
+struct ParsedFrame {
+    FrameHeader header;
+    std::vector<uint8_t> payload;
+};
+
+static void append_frame(std::vector<uint8_t>& out, FrameType type, uint8_t flags, uint32_t stream_id, const std::vector<uint8_t>& payload) {
+    uint8_t raw_header[FRAME_HEADER_SIZE];
+
+    pack_frame_header(raw_header, FrameHeader {static_cast<uint32_t>(payload.size()), type, flags, stream_id});
+    out.insert(out.end(), raw_header, raw_header + FRAME_HEADER_SIZE);
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+static std::vector<uint8_t> make_request_block(const char* path) {
+    HpackEncoder encoder {};
+    std::vector<uint8_t> block {};
+
+    encoder.encode_field(block, ":method", "GET");
+    encoder.encode_field(block, ":scheme", "http");
+    encoder.encode_field(block, ":authority", "localhost");
+    encoder.encode_field(block, ":path", path);
+
+    return block;
+}
+
+static std::vector<uint8_t> make_client_start() {
+    std::vector<uint8_t> start {H2_CLIENT_PREFACE, H2_CLIENT_PREFACE + H2_PREFACE_LENGTH};
+
+    append_frame(start, FrameType::settings, 0, 0U, {});
+
+    return start;
+}
+
+static void take_frames(Http2Connection& connection, std::vector<ParsedFrame>& frames) {
+    const uint8_t* output = connection.get_output();
+    size_t output_size = connection.get_output_size();
+    size_t cursor = 0UL;
+
+    while (output_size - cursor >= FRAME_HEADER_SIZE) {
+        ParsedFrame frame {};
+
+        unpack_frame_header(frame.header, output + cursor, FRAME_HEADER_SIZE);
+        cursor += FRAME_HEADER_SIZE;
+        frame.payload.assign(output + cursor, output + cursor + frame.header.length);
+        cursor += frame.header.length;
+        frames.push_back(frame);
+    }
+
+    connection.consume_output(output_size);
+}
+
+/// @brief Takes the output the way the server loop does: once it is written, the connection may frame more pending DATA.
+static std::vector<ParsedFrame> drain_frames(Http2Connection& connection) {
+    std::vector<ParsedFrame> frames {};
+
+    do {
+        take_frames(connection, frames);
+    } while (connection.fill_output(H2_OUTPUT_LOW_WATER));
+
+    return frames;
+}
+
+static const ParsedFrame* find_frame(const std::vector<ParsedFrame>& frames, FrameType type, uint32_t stream_id) {
+    for (const auto& frame : frames) {
+        if (frame.header.type == type && frame.header.stream_id == stream_id) {
+            return &frame;
+        }
+    }
+
+    return nullptr;
+}
+
+static size_t count_data(const std::vector<ParsedFrame>& frames, uint32_t stream_id, bool& saw_end) {
+    size_t total = 0UL;
+
+    for (const auto& frame : frames) {
+        if (frame.header.type == FrameType::data && frame.header.stream_id == stream_id) {
+            total += frame.header.length;
+            saw_end = saw_end || (frame.header.flags & FLAG_END_STREAM) != 0;
+        }
+    }
+
+    return total;
+}
+
+static int test_simple_request() {
+    const std::string body = "hello world\n";
+    Http2Connection connection {[&body](Http2Connection& conn, uint32_t stream_id, const HeaderList& request) {
+        const HeaderField fields[] = {{"content-type", "text/plain"}};
+
+        if (request.get_path() == "/hello") {
+            conn.send_response(stream_id, 200U, fields, 1U, body);
+        } else {
+            conn.send_response(stream_id, 404U, nullptr, 0U, "");
+        }
+    }};
+    std::vector<uint8_t> client = make_client_start();
+    std::vector<uint8_t> block = make_request_block("/hello");
+
+    // Split the header block over HEADERS and CONTINUATION, and feed the octets in two uneven reads.
+    std::vector<uint8_t> first_part {block.begin(), block.begin() + 3};
+    std::vector<uint8_t> second_part {block.begin() + 3, block.end()};
+
+    append_frame(client, FrameType::headers, FLAG_END_STREAM, 1U, first_part);
+    append_frame(client, FrameType::continuation, FLAG_END_HEADERS, 1U, second_part);
+
+    if (!connection.feed(client.data(), 10UL) || !connection.feed(client.data() + 10, client.size() - 10UL)) {
+        std::cerr << "Connection rejected a valid request!" << std::endl;
+        return 1;
+    }
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    const ParsedFrame* response_head = find_frame(frames, FrameType::headers, 1U);
+    bool saw_end = false;
+
+    if (frames.size() < 4UL || frames[0].header.type != FrameType::settings || frames[1].header.flags != FLAG_ACK || !response_head) {
+        std::cerr << "Connection did not answer with SETTINGS, ACK and HEADERS!" << std::endl;
+        return 1;
+    }
+
+    HpackDecoder decoder {};
+    HeaderList response {};
+
+    if (decoder.decode_block(response_head->payload.data(), static_cast<uint32_t>(response_head->payload.size()), response) != HpackStatus::ok
+        || response.get_status() != "200" || !response.find_field("content-length") || response.find_field("content-length")->value != "12") {
+        std::cerr << "Response header block was wrong!" << std::endl;
+        return 1;
+    }
+
+    if (count_data(frames, 1U, saw_end) != body.size() || !saw_end || connection.get_stream_count() != 0U) {
+        std::cerr << "Response body or stream cleanup was wrong!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_response_continuation() {
+    // Two fields whose literals together pass two default-sized frames, so the block rolls over mid-field twice.
+    const std::string big_value(20000UL, '{');
+    const std::string other_value(15000UL, '#');
+    Http2Connection connection {[&](Http2Connection& conn, uint32_t stream_id, const HeaderList&) {
+        const HeaderField fields[] = {{"x-big", big_value}, {"x-other", other_value}};
+
+        conn.send_response(stream_id, 200U, fields, 2U, "ok");
+    }};
+    std::vector<uint8_t> client = make_client_start();
+
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 1U, make_request_block("/"));
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    std::vector<uint8_t> block {};
+    uint32_t continuation_count = 0U;
+    bool saw_end_headers = false;
+
+    for (const auto& frame : frames) {
+        if (frame.header.stream_id != 1U || (frame.header.type != FrameType::headers && frame.header.type != FrameType::continuation)) {
+            continue;
+        }
+
+        if (saw_end_headers || frame.header.length > FRAME_DEFAULT_MAX_SIZE) {
+            std::cerr << "Header block frames were out of order or oversized!" << std::endl;
+            return 1;
+        }
+
+        continuation_count += (frame.header.type == FrameType::continuation) ? 1U : 0U;
+        saw_end_headers = (frame.header.flags & FLAG_END_HEADERS) != 0;
+        block.insert(block.end(), frame.payload.begin(), frame.payload.end());
+    }
+
+    HpackDecoder decoder {65536UL};
+    HeaderList response {};
+    bool saw_end = false;
+
+    if (continuation_count != 2U || !saw_end_headers
+        || decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), response) != HpackStatus::ok
+        || !response.find_field("x-big") || response.find_field("x-big")->value != big_value
+        || !response.find_field("x-other") || response.find_field("x-other")->value != other_value
+        || count_data(frames, 1U, saw_end) != 2UL || !saw_end) {
+        std::cerr << "Split response header block was wrong!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_flow_control() {
+    const std::string body(70000UL, 'x');
+    Http2Connection connection {[&body](Http2Connection& conn, uint32_t stream_id, const HeaderList&) {
+        conn.send_response(stream_id, 200U, nullptr, 0U, body);
+    }};
+    std::vector<uint8_t> client = make_client_start();
+
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 1U, make_request_block("/big"));
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    bool saw_end = false;
+
+    // Both windows start at 65535 octets, so the body must stall there.
+    if (count_data(frames, 1U, saw_end) != DEFAULT_INITIAL_WINDOW_SIZE || saw_end) {
+        std::cerr << "Connection ignored the send window!" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> updates {};
+
+    append_frame(updates, FrameType::window_update, 0, 0U, {0x00, 0x01, 0x00, 0x00});
+    append_frame(updates, FrameType::window_update, 0, 1U, {0x00, 0x01, 0x00, 0x00});
+    connection.feed(updates.data(), updates.size());
+    frames = drain_frames(connection);
+
+    if (count_data(frames, 1U, saw_end) != body.size() - DEFAULT_INITIAL_WINDOW_SIZE || !saw_end) {
+        std::cerr << "Connection did not resume after WINDOW_UPDATE!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_cached_response() {
+    ResponseCache cache {1024UL * 1024UL};
+    const std::string small_body = "cached body\n";
+    const std::vector<uint8_t> big_body(70000UL, 0x2a);
+    const std::vector<HeaderTablePair> headers {{":status", "200"}, {"content-type", "text/plain"}};
+    uint32_t fallback_count = 0U;
+
+    cache.insert("/small", headers, reinterpret_cast<const uint8_t*>(small_body.data()), small_body.size());
+    cache.insert("/big", headers, big_body.data(), big_body.size());
+
+    Http2Connection connection {[&cache, &fallback_count](Http2Connection& conn, uint32_t stream_id, const HeaderList& request) {
+        const CachedResponse* hit = cache.find(request.get_path());
+
+        if (!hit || !conn.send_cached_response(stream_id, *hit)) {
+            fallback_count++;
+            conn.send_response(stream_id, 204U, nullptr, 0U, "");
+        }
+    }};
+    std::vector<uint8_t> client = make_client_start();
+
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 1U, make_request_block("/small"));
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 3U, make_request_block("/big"));
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 5U, make_request_block("/small"));
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    const ParsedFrame* small_headers = find_frame(frames, FrameType::headers, 5U);
+    bool saw_end = false;
+
+    if (!small_headers || (small_headers->header.flags & FLAG_END_HEADERS) == 0 || count_data(frames, 5U, saw_end) != small_body.size() || !saw_end
+        || !find_frame(frames, FrameType::headers, 1U)) {
+        std::cerr << "Cached response was not replayed on its stream!" << std::endl;
+        return 1;
+    }
+
+    // The big body can never fit the initial windows in one go, so it is sent the usual way.
+    if (fallback_count != 1U || !find_frame(frames, FrameType::headers, 3U) || count_data(frames, 3U, saw_end) != 0UL) {
+        std::cerr << "Cached response ignored the send windows!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_urgency_order() {
+    const std::string bulk(200000UL, 'b');
+    const std::string urgent(30000UL, 'u');
+    Http2Connection connection {[&bulk, &urgent](Http2Connection& conn, uint32_t stream_id, const HeaderList& request) {
+        conn.send_response(stream_id, 200U, nullptr, 0U, (request.get_path() == "/bulk") ? bulk : urgent);
+    }};
+    std::vector<uint8_t> client = make_client_start();
+    std::vector<uint8_t> bulk_block = make_request_block("/bulk");
+    std::vector<uint8_t> urgent_block = make_request_block("/urgent");
+    HpackEncoder encoder {};
+
+    encoder.encode_field(bulk_block, "priority", "u=7");
+    encoder.encode_field(urgent_block, "priority", "u=0, i");
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 1U, bulk_block);
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 3U, urgent_block);
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    size_t bulk_ahead = 0UL;
+    size_t urgent_sent = 0UL;
+
+    // Count the bulk DATA written before the urgent body was complete.
+    for (const auto& frame : frames) {
+        if (frame.header.type != FrameType::data || urgent_sent == urgent.size()) {
+            continue;
+        }
+
+        if (frame.header.stream_id == 1U) {
+            bulk_ahead += frame.header.length;
+        } else {
+            urgent_sent += frame.header.length;
+        }
+    }
+
+    if (urgent_sent != urgent.size() || bulk_ahead > H2_OUTPUT_LOW_WATER) {
+        std::cerr << "Urgent response waited behind " << bulk_ahead << " octets of bulk DATA!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static uint32_t get_u32(const ParsedFrame& frame, size_t offset = 0UL) {
+    return (static_cast<uint32_t>(frame.payload[offset]) << 24) | (static_cast<uint32_t>(frame.payload[offset + 1UL]) << 16)
+        | (static_cast<uint32_t>(frame.payload[offset + 2UL]) << 8) | static_cast<uint32_t>(frame.payload[offset + 3UL]);
+}
+
+static int test_streaming_body() {
+    std::string received {};
+    bool saw_last = false;
+    Http2Connection connection {[](Http2Connection& conn, uint32_t stream_id, const HeaderList&) {
+        conn.read_body(stream_id);
+    }, [&received, &saw_last](Http2Connection& conn, uint32_t stream_id, std::string_view data, bool is_last) {
+        if (stream_id == 3U) {
+            // Turn the upload away after its first chunk.
+            conn.send_response(stream_id, 413U, nullptr, 0U, "");
+            conn.discard_body(stream_id);
+            return;
+        }
+
+        received.append(data);
+        saw_last = saw_last || is_last;
+
+        if (is_last) {
+            conn.send_response(stream_id, 200U, nullptr, 0U, "ok");
+        }
+    }};
+    std::vector<uint8_t> client = make_client_start();
+    std::vector<uint8_t> padded {4U, 't', 'a', 'i', 'l', 0U, 0U, 0U, 0U};
+    std::string expected {};
+
+    append_frame(client, FrameType::headers, FLAG_END_HEADERS, 1U, make_request_block("/upload"));
+
+    for (char fill : {'a', 'b', 'c'}) {
+        append_frame(client, FrameType::data, 0, 1U, std::vector<uint8_t>(FRAME_DEFAULT_MAX_SIZE, static_cast<uint8_t>(fill)));
+        expected.append(FRAME_DEFAULT_MAX_SIZE, fill);
+    }
+
+    append_frame(client, FrameType::data, FLAG_PADDED, 1U, padded);
+    expected.append("tail");
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+
+    // Nothing was consumed yet, so no window may reopen.
+    if (received != expected || saw_last || find_frame(frames, FrameType::window_update, 0U) || find_frame(frames, FrameType::window_update, 1U)) {
+        std::cerr << "Body was not streamed as views ahead of WINDOW_UPDATE!" << std::endl;
+        return 1;
+    }
+
+    // Padding was credited on arrival; 40000 consumed octets cross the half-window mark on both windows.
+    connection.consume_body(1U, 40000U);
+    frames = drain_frames(connection);
+
+    const ParsedFrame* conn_update = find_frame(frames, FrameType::window_update, 0U);
+    const ParsedFrame* stream_update = find_frame(frames, FrameType::window_update, 1U);
+
+    if (!conn_update || !stream_update || get_u32(*conn_update) != 40005U || get_u32(*stream_update) != 40005U) {
+        std::cerr << "Consuming the body did not reopen the windows!" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> more {};
+
+    append_frame(more, FrameType::headers, FLAG_END_HEADERS, 3U, make_request_block("/upload"));
+    append_frame(more, FrameType::data, 0, 3U, std::vector<uint8_t>(1000UL, 'z'));
+    append_frame(more, FrameType::data, FLAG_END_STREAM, 1U, {});
+    connection.feed(more.data(), more.size());
+    frames = drain_frames(connection);
+
+    const ParsedFrame* reset = find_frame(frames, FrameType::rst_stream, 3U);
+    bool saw_end = false;
+
+    if (!reset || get_u32(*reset) != static_cast<uint32_t>(H2Error::no_error) || !saw_last || count_data(frames, 1U, saw_end) != 2UL || !saw_end) {
+        std::cerr << "Early answer did not discard the upload, or the finished upload got no answer!" << std::endl;
+        return 1;
+    }
+
+    if (connection.get_stream_count() != 0U) {
+        std::cerr << "Finished uploads left streams open!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/// @brief Sends one window's worth of upload on stream 1, then ACKs whatever PING the connection sent meanwhile.
+static std::vector<ParsedFrame> upload_and_ack(Http2Connection& connection, bool& saw_ping) {
+    std::vector<uint8_t> client = make_client_start();
+
+    append_frame(client, FrameType::headers, FLAG_END_HEADERS, 1U, make_request_block("/upload"));
+
+    for (uint32_t length : {16384U, 16384U, 16384U, 16383U}) {
+        append_frame(client, FrameType::data, 0, 1U, std::vector<uint8_t>(length, 'u'));
+    }
+
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    const ParsedFrame* ping = find_frame(frames, FrameType::ping, 0U);
+    std::vector<uint8_t> ack {};
+
+    saw_ping = ping != nullptr;
+
+    if (ping) {
+        append_frame(ack, FrameType::ping, FLAG_ACK, 0U, ping->payload);
+        connection.feed(ack.data(), ack.size());
+    }
+
+    return drain_frames(connection);
+}
+
+static int test_recv_window_autotune() {
+    Http2Connection drained {[](Http2Connection&, uint32_t, const HeaderList&) {}};
+    bool saw_ping = false;
+
+    // Dropped bodies are given back at once, so the round trip drains 49151 octets of a 65535 window: the window doubles.
+    std::vector<ParsedFrame> frames = upload_and_ack(drained, saw_ping);
+    const ParsedFrame* conn_update = find_frame(frames, FrameType::window_update, 0U);
+    const ParsedFrame* settings = find_frame(frames, FrameType::settings, 0U);
+
+    if (!saw_ping || !conn_update || get_u32(*conn_update) != DEFAULT_INITIAL_WINDOW_SIZE || !settings
+        || settings->payload.size() != SETTINGS_ENTRY_SIZE || settings->payload[1] != static_cast<uint8_t>(SettingsId::initial_window_size)
+        || get_u32(*settings, 2UL) != 2U * DEFAULT_INITIAL_WINDOW_SIZE) {
+        std::cerr << "Window-limited upload did not grow the receive windows!" << std::endl;
+        return 1;
+    }
+
+    Http2Connection held {[](Http2Connection& conn, uint32_t stream_id, const HeaderList&) {
+        conn.read_body(stream_id);
+    }, [](Http2Connection&, uint32_t, std::string_view, bool) {}};
+
+    frames = upload_and_ack(held, saw_ping);
+
+    if (!saw_ping || find_frame(frames, FrameType::window_update, 0U) || find_frame(frames, FrameType::settings, 0U)) {
+        std::cerr << "Windows grew for a handler that drained nothing!" << std::endl;
+        return 1;
+    }
+
+    Http2Connection capped {[](Http2Connection&, uint32_t, const HeaderList&) {}};
+
+    capped.set_recv_window_limit(DEFAULT_INITIAL_WINDOW_SIZE);
+    upload_and_ack(capped, saw_ping);
+
+    if (saw_ping) {
+        std::cerr << "Connection at its window limit still probed the round trip!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_protocol_errors() {
+    Http2Connection even_conn {[](Http2Connection&, uint32_t, const HeaderList&) {}};
+    std::vector<uint8_t> client = make_client_start();
+
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 2U, make_request_block("/"));
+
+    if (even_conn.feed(client.data(), client.size())) {
+        std::cerr << "Connection accepted a server-initiated stream ID!" << std::endl;
+        return 1;
+    }
+
+    std::vector<ParsedFrame> frames = drain_frames(even_conn);
+    const ParsedFrame* goaway = find_frame(frames, FrameType::goaway, 0U);
+
+    if (!goaway || goaway->payload[7] != static_cast<uint8_t>(H2Error::protocol_error) || !even_conn.should_close()) {
+        std::cerr << "Connection did not send GOAWAY(PROTOCOL_ERROR)!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_http1_requests() {
+    Http2Connection connection {[](Http2Connection& conn, uint32_t stream_id, const HeaderList& request) {
+        const HeaderField fields[] = {{"content-type", "text/plain"}};
+
+        if (request.get_path() != "/upload" || !conn.read_body(stream_id)) {
+            conn.send_response(stream_id, 200U, fields, 1U, (request.get_authority() == "x") ? "hi\n" : "??\n");
+        }
+    }, [](Http2Connection& conn, uint32_t stream_id, std::string_view data, bool is_last) {
+        conn.consume_body(stream_id, static_cast<uint32_t>(data.length()));
+
+        if (is_last) {
+            conn.send_response(stream_id, 200U, nullptr, 0U, "done");
+        }
+    }};
+    // Pipelined, with a HEAD, a body that must not be read as a request, and a last request asking to close.
+    const std::string requests = "GET /hello HTTP/1.1\r\nHost: x\r\n\r\nHEAD /hello HTTP/1.1\r\nHost: x\r\n\r\n"
+        "POST /upload HTTP/1.1\r\nHost: x\r\nContent-Length: 16\r\n\r\nGET / HTTP/1.1\r\n"
+        "GET /hello HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n";
+    const std::string expected = "HTTP/1.1 200 OK\r\ncontent-type: text/plain\r\ncontent-length: 3\r\n\r\nhi\n"
+        "HTTP/1.1 200 OK\r\ncontent-type: text/plain\r\ncontent-length: 3\r\n\r\n"
+        "HTTP/1.1 200 OK\r\ncontent-length: 4\r\n\r\ndone"
+        "HTTP/1.1 200 OK\r\ncontent-type: text/plain\r\ncontent-length: 3\r\nconnection: close\r\n\r\nhi\n";
+
+    // Split mid-head, mid-body and mid-request, as reads may arrive.
+    connection.feed(reinterpret_cast<const uint8_t*>(requests.data()), 20UL);
+    connection.feed(reinterpret_cast<const uint8_t*>(requests.data()) + 20UL, 100UL);
+    connection.feed(reinterpret_cast<const uint8_t*>(requests.data()) + 120UL, requests.size() - 120UL);
+
+    std::string reply {reinterpret_cast<const char*>(connection.get_output()), connection.get_output_size()};
+
+    connection.consume_output(connection.get_output_size());
+
+    if (reply != expected || !connection.should_close() || connection.get_stream_count() != 0U) {
+        std::cerr << "HTTP/1.1 requests were not served in order:\n" << reply << std::endl;
+        return 1;
+    }
+
+    Http2Connection chunked_conn {[](Http2Connection&, uint32_t, const HeaderList&) {}};
+    const std::string chunked_request = "POST / HTTP/1.1\r\nHost: x\r\nTransfer-Encoding: chunked\r\n\r\n";
+
+    chunked_conn.feed(reinterpret_cast<const uint8_t*>(chunked_request.data()), chunked_request.size());
+    reply.assign(reinterpret_cast<const char*>(chunked_conn.get_output()), chunked_conn.get_output_size());
+
+    if (reply.rfind("HTTP/1.1 501", 0) != 0) {
+        std::cerr << "Chunked HTTP/1.1 upload did not get a 501!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_h2c_upgrade() {
+    Http2Connection connection {[](Http2Connection& conn, uint32_t stream_id, const HeaderList& request) {
+        conn.send_response(stream_id, 200U, nullptr, 0U, request.get_path());
+    }};
+    // SETTINGS_MAX_CONCURRENT_STREAMS = 100 as base64url.
+    const std::string upgrade = "GET /upgraded HTTP/1.1\r\nHost: x\r\nConnection: Upgrade, HTTP2-Settings\r\nUpgrade: h2c\r\nHTTP2-Settings: AAMAAABk\r\n\r\n";
+    std::vector<uint8_t> client {upgrade.begin(), upgrade.end()};
+    const std::vector<uint8_t> client_start = make_client_start();
+
+    client.insert(client.end(), client_start.begin(), client_start.end());
+    connection.feed(client.data(), client.size());
+
+    const size_t switching_length = sizeof(H1_SWITCHING_PROTOCOLS) - 1UL;
+    std::string reply {reinterpret_cast<const char*>(connection.get_output()), connection.get_output_size()};
+
+    if (reply.compare(0UL, switching_length, H1_SWITCHING_PROTOCOLS) != 0 || connection.get_peer_settings().max_concurrent_streams != 100U) {
+        std::cerr << "h2c Upgrade was not accepted!" << std::endl;
+        return 1;
+    }
+
+    connection.consume_output(switching_length);
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    bool saw_end = false;
+
+    // Our SETTINGS come first, then the upgraded request's response on stream 1.
+    if (frames.empty() || frames[0].header.type != FrameType::settings || !find_frame(frames, FrameType::headers, 1U)
+        || count_data(frames, 1U, saw_end) != std::string_view {"/upgraded"}.length() || !saw_end) {
+        std::cerr << "Upgraded request was not answered on stream 1!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/// @brief A header block that never ends must not grow without bound (CVE-2024-27316).
+static int test_continuation_flood() {
+    uint32_t request_count = 0U;
+    Http2Connection connection {[&request_count](Http2Connection&, uint32_t, const HeaderList&) { request_count++; }};
+    std::vector<uint8_t> client = make_client_start();
+    const std::vector<uint8_t> filler(4096UL, 0x40);
+    bool is_open = true;
+
+    append_frame(client, FrameType::headers, 0, 1U, make_request_block("/"));
+    is_open = connection.feed(client.data(), client.size());
+
+    // 1 MiB of CONTINUATION, far past the advertised list size.
+    for (uint32_t frame_i = 0U; frame_i < 256U && is_open; frame_i++) {
+        std::vector<uint8_t> continuation {};
+
+        append_frame(continuation, FrameType::continuation, 0, 1U, filler);
+        is_open = connection.feed(continuation.data(), continuation.size());
+    }
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    const ParsedFrame* goaway = find_frame(frames, FrameType::goaway, 0U);
+
+    if (is_open || !goaway || goaway->payload[7] != static_cast<uint8_t>(H2Error::enhance_your_calm) || !connection.should_close()
+        || request_count != 0U) {
+        std::cerr << "CONTINUATION flood was not cut off with GOAWAY(ENHANCE_YOUR_CALM)!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/// @brief A client that keeps sending but never reads must stop being read, instead of growing the output without bound.
+static int test_unread_client() {
+    Http2Connection connection {[](Http2Connection&, uint32_t, const HeaderList&) {}};
+    std::vector<uint8_t> client = make_client_start();
+    const std::vector<uint8_t> ping_payload(8UL, 0x11);
+    const size_t ping_count = 20000UL;
+    const size_t ack_size = FRAME_HEADER_SIZE + ping_payload.size();
+
+    for (size_t ping_i = 0UL; ping_i < ping_count; ping_i++) {
+        append_frame(client, FrameType::ping, 0, 0U, ping_payload);
+    }
+
+    // Every PING is answered, but parsing stops once the unread ACKs pass the high mark.
+    if (!connection.feed(client.data(), client.size()) || connection.should_read()
+        || connection.get_output_size() > DEFAULT_CONN_OUT_HIGH + ack_size) {
+        std::cerr << "Unread output did not stop reading: " << connection.get_output_size() << " octets queued!" << std::endl;
+        return 1;
+    }
+
+    // Draining the output resumes parsing of what was left buffered, until every PING has its ACK.
+    std::vector<ParsedFrame> frames {};
+    size_t ack_count = 0UL;
+
+    for (uint32_t round_i = 0U; round_i < 16U && ack_count < ping_count; round_i++) {
+        frames.clear();
+        take_frames(connection, frames);
+
+        for (const auto& frame : frames) {
+            ack_count += (frame.header.type == FrameType::ping && frame.header.flags == FLAG_ACK) ? 1UL : 0UL;
+        }
+
+        if (!connection.should_read() || !connection.feed(nullptr, 0UL)) {
+            std::cerr << "Reading did not resume after the output drained!" << std::endl;
+            return 1;
+        }
+    }
+
+    if (ack_count != ping_count) {
+        std::cerr << "Only " << ack_count << " of " << ping_count << " PINGs were answered!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/// @brief Response bodies stuck behind flow control count against the outbound budget, so new requests are refused rather than piling up more.
+static int test_outbound_budget() {
+    const std::string body(100000UL, 'o');
+    uint32_t handled_count = 0U;
+    Http2Connection connection {[&body, &handled_count](Http2Connection& conn, uint32_t stream_id, const HeaderList&) {
+        handled_count++;
+        conn.send_response(stream_id, 200U, nullptr, 0U, body);
+    }};
+    std::vector<uint8_t> client = make_client_start();
+
+    for (uint32_t stream_id = 1U; stream_id <= 19U; stream_id += 2U) {
+        append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, stream_id, make_request_block("/big"));
+    }
+
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    uint32_t refused_count = 0U;
+
+    for (const auto& frame : frames) {
+        if (frame.header.type == FrameType::rst_stream && get_u32(frame) == static_cast<uint32_t>(H2Error::refused_stream)) {
+            refused_count++;
+        }
+    }
+
+    // Three 100 KB bodies fill the 256 KiB mark; the other seven requests never reach the handler.
+    if (handled_count != 3U || refused_count != 7U || connection.get_stream_count() != 3U) {
+        std::cerr << "Outbound budget let " << handled_count << " requests through and refused " << refused_count << "!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/// @brief A body stuck behind a zero send window stays charged, so it alone holds the connection over its mark until the peer opens the window.
+static int test_zero_window_refusal() {
+    const std::string body(300000UL, 'z');
+    uint32_t handled_count = 0U;
+    Http2Connection connection {[&body, &handled_count](Http2Connection& conn, uint32_t stream_id, const HeaderList&) {
+        handled_count++;
+        conn.send_response(stream_id, 200U, nullptr, 0U, body);
+    }};
+    std::vector<uint8_t> client {H2_CLIENT_PREFACE, H2_CLIENT_PREFACE + H2_PREFACE_LENGTH};
+
+    // SETTINGS_INITIAL_WINDOW_SIZE = 0
+    append_frame(client, FrameType::settings, 0, 0U, {0x00, 0x04, 0x00, 0x00, 0x00, 0x00});
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 1U, make_request_block("/big"));
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    bool saw_end = false;
+
+    if (handled_count != 1U || count_data(frames, 1U, saw_end) != 0UL) {
+        std::cerr << "Connection sent DATA into a zero window!" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> later {};
+
+    append_frame(later, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 3U, make_request_block("/big"));
+    append_frame(later, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 5U, make_request_block("/big"));
+    connection.feed(later.data(), later.size());
+    frames = drain_frames(connection);
+
+    const ParsedFrame* refused_3 = find_frame(frames, FrameType::rst_stream, 3U);
+    const ParsedFrame* refused_5 = find_frame(frames, FrameType::rst_stream, 5U);
+
+    if (handled_count != 1U || !refused_3 || !refused_5 || get_u32(*refused_3) != static_cast<uint32_t>(H2Error::refused_stream)
+        || get_u32(*refused_5) != static_cast<uint32_t>(H2Error::refused_stream)) {
+        std::cerr << "Requests behind a stalled large body were not refused!" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> updates {};
+
+    append_frame(updates, FrameType::window_update, 0, 0U, {0x00, 0x05, 0x00, 0x00});
+    append_frame(updates, FrameType::window_update, 0, 1U, {0x00, 0x05, 0x00, 0x00});
+    append_frame(updates, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 7U, make_request_block("/big"));
+    connection.feed(updates.data(), updates.size());
+    frames = drain_frames(connection);
+
+    if (count_data(frames, 1U, saw_end) != body.size() || !saw_end) {
+        std::cerr << "Stalled body did not finish after WINDOW_UPDATE!" << std::endl;
+        return 1;
+    }
+
+    // Stream 7 arrives in the same read as the updates, before the body drains, so it may still be refused; the next one must not be.
+    std::vector<uint8_t> next {};
+
+    append_frame(next, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 9U, make_request_block("/big"));
+    connection.feed(next.data(), next.size());
+    drain_frames(connection);
+
+    if (handled_count < 2U || connection.get_stream_count() == 0U) {
+        std::cerr << "Connection kept refusing streams after its output drained!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/// @brief Collects the DATA payload the connection sent on `stream_id` through a socket, as `write_file_output` does.
+static std::string read_socket_data(int socket_fd, uint32_t stream_id, bool& saw_end) {
+    std::vector<uint8_t> received {};
+    uint8_t chunk[16384];
+    ssize_t got = 0;
+
+    while ((got = recv(socket_fd, chunk, sizeof(chunk), MSG_DONTWAIT)) > 0) {
+        received.insert(received.end(), chunk, chunk + got);
+    }
+
+    std::string body {};
+    size_t cursor = 0UL;
+    FrameHeader header {};
+
+    while (received.size() - cursor >= FRAME_HEADER_SIZE) {
+        unpack_frame_header(header, received.data() + cursor, FRAME_HEADER_SIZE);
+        cursor += FRAME_HEADER_SIZE;
+
+        if (header.type == FrameType::data && header.stream_id == stream_id) {
+            body.append(reinterpret_cast<const char*>(received.data() + cursor), header.length);
+            saw_end = saw_end || (header.flags & FLAG_END_STREAM) != 0;
+        }
+
+        cursor += header.length;
+    }
+
+    return body;
+}
+
+/// @brief A file response goes out by `sendfile` within the send windows, after HEADERS from the output buffer.
+static int test_file_response() {
+    char file_path[] = "/tmp/h2plus_fileXXXXXX";
+    int temp_fd = mkstemp(file_path);
+    std::string expected(100000UL, '\0');
+    int sockets[2] {-1, -1};
+
+    for (size_t octet_i = 0UL; octet_i < expected.length(); octet_i++) {
+        expected[octet_i] = static_cast<char>('a' + octet_i % 26UL);
+    }
+
+    if (temp_fd == -1 || write(temp_fd, expected.data(), expected.length()) != static_cast<ssize_t>(expected.length())
+        || socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == -1) {
+        std::cerr << "Could not set up the file response test!" << std::endl;
+        return 1;
+    }
+
+    close(temp_fd);
+
+    Http2Connection connection {[&file_path](Http2Connection& conn, uint32_t stream_id, const HeaderList&) {
+        auto file = std::make_unique<StaticFileSender>();
+        const HeaderField fields[] = {{"content-type", "text/plain"}};
+
+        if (file->open_file(file_path)) {
+            conn.send_file_response(stream_id, 200U, fields, 1U, std::move(file));
+        }
+    }};
+    std::vector<uint8_t> client = make_client_start();
+
+    append_frame(client, FrameType::headers, FLAG_END_STREAM | FLAG_END_HEADERS, 1U, make_request_block("/file"));
+    connection.feed(client.data(), client.size());
+
+    std::vector<ParsedFrame> frames = drain_frames(connection);
+    const ParsedFrame* headers = find_frame(frames, FrameType::headers, 1U);
+    int status = 0;
+
+    if (!headers || (headers->header.flags & FLAG_END_STREAM) != 0 || find_frame(frames, FrameType::data, 1U)) {
+        std::cerr << "File response HEADERS were not queued alone!" << std::endl;
+        status = 1;
+    }
+
+    while (status == 0 && connection.write_file_output(sockets[0], SIZE_MAX) == SendStatus::done) {}
+
+    bool saw_end = false;
+    std::string body = read_socket_data(sockets[1], 1U, saw_end);
+
+    // The default windows let 65535 octets through.
+    if (status == 0 && (body.length() != 65535UL || saw_end)) {
+        std::cerr << "File response ignored the send window: " << body.length() << " octets!" << std::endl;
+        status = 1;
+    }
+
+    std::vector<uint8_t> updates {};
+
+    append_frame(updates, FrameType::window_update, 0, 0U, {0U, 1U, 0U, 0U});
+    append_frame(updates, FrameType::window_update, 0, 1U, {0U, 1U, 0U, 0U});
+    connection.feed(updates.data(), updates.size());
+    drain_frames(connection);
+
+    while (status == 0 && connection.write_file_output(sockets[0], SIZE_MAX) == SendStatus::done) {}
+
+    body.append(read_socket_data(sockets[1], 1U, saw_end));
+
+    if (status == 0 && (body != expected || !saw_end || connection.get_stream_count() != 0U)) {
+        std::cerr << "File response did not finish with the file's octets!" << std::endl;
+        status = 1;
+    }
+
+    close(sockets[0]);
+    close(sockets[1]);
+    unlink(file_path);
+
+    return status;
+}
+
+int main() {
+    if (test_simple_request() != 0 || test_response_continuation() != 0 || test_flow_control() != 0 || test_cached_response() != 0 || test_urgency_order() != 0 || test_streaming_body() != 0
+        || test_recv_window_autotune() != 0 || test_protocol_errors() != 0 || test_http1_requests() != 0 || test_h2c_upgrade() != 0
+        || test_continuation_flood() != 0 || test_unread_client() != 0
+        || test_outbound_budget() != 0 || test_zero_window_refusal() != 0 || test_file_response() != 0) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file test_h2server.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the event loop's per-connection timers, offloaded handler work, and HEAD and 405 responses over loopback sockets.
+ * @date 2026-10-19
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hpack/hpackdecoder.hpp"
+#include "server/h2server.hpp"
+#include "server/router.hpp"
+
+constexpr uint32_t TEST_IDLE_TIMEOUT_MS = 300U;
+constexpr uint32_t TEST_HANDSHAKE_TIMEOUT_MS = 150U;
+constexpr uint32_t TEST_HEADER_TIMEOUT_MS = 150U;
+constexpr int TEST_RECV_TIMEOUT_S = 3;
+constexpr uint32_t TEST_POOL_WORKERS = 2U;
+constexpr auto TEST_OFFLOAD_DELAY = std::chrono::milliseconds {50};
+constexpr std::string_view TEST_HELLO_BODY = "hello\n";
+
+enum TestRoute : int32_t {
+    test_route_offload,
+    test_route_hello
+};
+
+// GET /offload, END_STREAM: indexed :method GET and :scheme http, then :path as a literal with an indexed name.
+const std::vector<uint8_t> OFFLOAD_REQUEST_BLOCK {0x82, 0x86, 0x04, 0x08, '/', 'o', 'f', 'f', 'l', 'o', 'a', 'd'};
+
+// HEAD /hello and DELETE /hello, END_STREAM: :method as a literal with an indexed name, then as above.
+const std::vector<uint8_t> HEAD_REQUEST_BLOCK {0x02, 0x04, 'H', 'E', 'A', 'D', 0x86, 0x04, 0x06, '/', 'h', 'e', 'l', 'l', 'o'};
+const std::vector<uint8_t> DELETE_REQUEST_BLOCK {0x02, 0x06, 'D', 'E', 'L', 'E', 'T', 'E', 0x86, 0x04, 0x06, '/', 'h', 'e', 'l', 'l', 'o'};
+
+static int connect_client(uint16_t port) {
+    int client_fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address {};
+    timeval recv_timeout {TEST_RECV_TIMEOUT_S, 0};
+
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &recv_timeout, sizeof(recv_timeout));
+
+    if (connect(client_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(client_fd);
+        return -1;
+    }
+
+    return client_fd;
+}
+
+static void send_frame(int client_fd, FrameType type, uint8_t flags, uint32_t stream_id, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame(FRAME_HEADER_SIZE);
+
+    pack_frame_header(frame.data(), FrameHeader {static_cast<uint32_t>(payload.size()), type, flags, stream_id});
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    send(client_fd, frame.data(), frame.size(), MSG_NOSIGNAL);
+}
+
+/// @brief Reads until the server closes. Returns the GOAWAY error code, -1 for a close without GOAWAY, or -2 when the server never closed.
+static int64_t read_until_closed(int client_fd) {
+    std::vector<uint8_t> received {};
+    uint8_t chunk[4096];
+
+    while (true) {
+        ssize_t got = recv(client_fd, chunk, sizeof(chunk), 0);
+
+        if (got == 0) {
+            break;
+        }
+
+        if (got < 0) {
+            return -2;
+        }
+
+        received.insert(received.end(), chunk, chunk + got);
+    }
+
+    size_t cursor = 0UL;
+    FrameHeader header {};
+
+    while (received.size() - cursor >= FRAME_HEADER_SIZE) {
+        unpack_frame_header(header, received.data() + cursor, FRAME_HEADER_SIZE);
+        cursor += FRAME_HEADER_SIZE;
+
+        if (header.type == FrameType::goaway && header.length >= 8U && received.size() - cursor >= 8UL) {
+            const uint8_t* code = received.data() + cursor + 4UL;
+
+            return (static_cast<int64_t>(code[0]) << 24) | (code[1] << 16) | (code[2] << 8) | code[3];
+        }
+
+        cursor += header.length;
+    }
+
+    return -1;
+}
+
+/// @brief Reads frames until a HEADERS frame on `stream_id` arrives, keeping its header and payload. Returns false if the connection closed or went quiet first.
+static bool read_until_headers(int client_fd, uint32_t stream_id, FrameHeader& headers_frame, std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> received {};
+    uint8_t chunk[4096];
+    size_t cursor = 0UL;
+    FrameHeader header {};
+
+    while (true) {
+        while (received.size() - cursor >= FRAME_HEADER_SIZE) {
+            unpack_frame_header(header, received.data() + cursor, FRAME_HEADER_SIZE);
+
+            if (received.size() - cursor - FRAME_HEADER_SIZE < header.length) {
+                break;
+            }
+
+            if (header.type == FrameType::headers && header.stream_id == stream_id) {
+                const auto payload_start = received.begin() + static_cast<std::ptrdiff_t>(cursor + FRAME_HEADER_SIZE);
+
+                headers_frame = header;
+                payload.assign(payload_start, payload_start + header.length);
+                return true;
+            }
+
+            cursor += FRAME_HEADER_SIZE + header.length;
+        }
+
+        ssize_t got = recv(client_fd, chunk, sizeof(chunk), 0);
+
+        if (got <= 0) {
+            return false;
+        }
+
+        received.insert(received.end(), chunk, chunk + got);
+    }
+}
+
+/// @brief Sends the preface, an empty SETTINGS and the ACK for the server's SETTINGS, which ends the handshake.
+static void complete_handshake(int client_fd) {
+    send(client_fd, H2_CLIENT_PREFACE, H2_PREFACE_LENGTH, MSG_NOSIGNAL);
+    send_frame(client_fd, FrameType::settings, 0, 0U, {});
+    send_frame(client_fd, FrameType::settings, FLAG_ACK, 0U, {});
+}
+
+/// @brief Sends one request on stream 1 of a new connection and decodes the response head into `response`. Returns false if none came.
+static bool fetch_response_head(uint16_t port, const std::vector<uint8_t>& request_block, FrameHeader& headers_frame, HeaderList& response) {
+    int client_fd = connect_client(port);
+    std::vector<uint8_t> payload {};
+    HpackDecoder decoder {};
+
+    complete_handshake(client_fd);
+    send_frame(client_fd, FrameType::headers, FLAG_END_HEADERS | FLAG_END_STREAM, 1U, request_block);
+
+    const bool has_head = client_fd != -1 && read_until_headers(client_fd, 1U, headers_frame, payload)
+        && decoder.decode_block(payload.data(), static_cast<uint32_t>(payload.size()), response) == HpackStatus::ok;
+
+    close(client_fd);
+
+    return has_head;
+}
+
+int main() {
+    const uint16_t port = static_cast<uint16_t>(20000 + getpid() % 20000);
+    ServerConfig config {"127.0.0.1", port, 1U, H2_DEFAULT_RECV_WINDOW_LIMIT, TEST_IDLE_TIMEOUT_MS, TEST_HANDSHAKE_TIMEOUT_MS, TEST_HEADER_TIMEOUT_MS, TEST_POOL_WORKERS};
+    std::thread::id loop_thread {};
+    std::atomic<uint32_t> jobs_off_loop {0U};
+    Router router {};
+
+    router.add_route(HttpMethod::get, "/offload", test_route_offload);
+    router.add_route(HttpMethod::get, "/hello", test_route_hello);
+    router.add_route(HttpMethod::head, "/hello", test_route_hello);
+
+    Server server {[&router, &loop_thread, &jobs_off_loop](Http2Connection& connection, uint32_t stream_id, const HeaderList& request) {
+        RouteMatch match = router.match(parse_http_method(request.get_method()), request.get_path());
+
+        if (match.status == RouteStatus::method_not_allowed) {
+            const std::string allowed_methods = format_allowed_methods(match.allowed_mask);
+            const HeaderField fields[] = {{"allow", allowed_methods}};
+
+            connection.send_response(stream_id, 405U, fields, 1U, "");
+            return;
+        }
+
+        if (match.status != RouteStatus::found) {
+            connection.send_response(stream_id, 404U, nullptr, 0U, "");
+            return;
+        }
+
+        if (match.target == test_route_hello) {
+            connection.send_response(stream_id, 200U, nullptr, 0U, TEST_HELLO_BODY);
+            return;
+        }
+
+        loop_thread = std::this_thread::get_id();
+        connection.offload([&loop_thread, &jobs_off_loop]() {
+            std::this_thread::sleep_for(TEST_OFFLOAD_DELAY);
+
+            if (std::this_thread::get_id() != loop_thread) {
+                jobs_off_loop.fetch_add(1U);
+            }
+        }, [&connection, stream_id]() {
+            connection.send_response(stream_id, 200U, nullptr, 0U, "done\n");
+        });
+    }};
+
+    if (!server.start(config)) {
+        std::cerr << "Server could not listen on port " << port << "!" << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+
+    // A client that connects and says nothing is dropped without a GOAWAY: it never spoke HTTP/2.
+    int silent_fd = connect_client(port);
+
+    if (silent_fd == -1 || read_until_closed(silent_fd) != -1) {
+        std::cerr << "Silent client was not dropped by the handshake timer!" << std::endl;
+        failures++;
+    }
+
+    // The client's preface arrives, but our SETTINGS are never acknowledged.
+    int no_ack_fd = connect_client(port);
+
+    send(no_ack_fd, H2_CLIENT_PREFACE, H2_PREFACE_LENGTH, MSG_NOSIGNAL);
+    send_frame(no_ack_fd, FrameType::settings, 0, 0U, {});
+
+    if (read_until_closed(no_ack_fd) != static_cast<int64_t>(H2Error::settings_timeout)) {
+        std::cerr << "Missing SETTINGS ACK did not end in GOAWAY(SETTINGS_TIMEOUT)!" << std::endl;
+        failures++;
+    }
+
+    // Slowloris: a header block that is started and never finished.
+    int slow_fd = connect_client(port);
+
+    complete_handshake(slow_fd);
+    send_frame(slow_fd, FrameType::headers, 0, 1U, {0x82});
+
+    if (read_until_closed(slow_fd) != static_cast<int64_t>(H2Error::enhance_your_calm)) {
+        std::cerr << "Unfinished header block did not end in GOAWAY(ENHANCE_YOUR_CALM)!" << std::endl;
+        failures++;
+    }
+
+    // A finished handshake and nothing else is closed gracefully once idle.
+    int idle_fd = connect_client(port);
+
+    complete_handshake(idle_fd);
+
+    if (read_until_closed(idle_fd) != static_cast<int64_t>(H2Error::no_error)) {
+        std::cerr << "Idle connection did not end in GOAWAY(NO_ERROR)!" << std::endl;
+        failures++;
+    }
+
+    // A client gone before its job finishes: the completion must be dropped rather than touch the closed session.
+    int gone_fd = connect_client(port);
+
+    complete_handshake(gone_fd);
+    send_frame(gone_fd, FrameType::headers, FLAG_END_HEADERS | FLAG_END_STREAM, 1U, OFFLOAD_REQUEST_BLOCK);
+    std::this_thread::sleep_for(TEST_OFFLOAD_DELAY / 5);
+    close(gone_fd);
+
+    // The loop keeps serving while the job sleeps on a worker, and the reply comes once it is done.
+    int offload_fd = connect_client(port);
+
+    complete_handshake(offload_fd);
+    send_frame(offload_fd, FrameType::headers, FLAG_END_HEADERS | FLAG_END_STREAM, 1U, OFFLOAD_REQUEST_BLOCK);
+
+    FrameHeader headers_frame {};
+    std::vector<uint8_t> headers_payload {};
+
+    if (offload_fd == -1 || !read_until_headers(offload_fd, 1U, headers_frame, headers_payload)) {
+        std::cerr << "Offloaded handler never replied!" << std::endl;
+        failures++;
+    }
+
+    if (jobs_off_loop.load() != 2U) {
+        std::cerr << "Offloaded jobs did not run on the pool: " << jobs_off_loop.load() << " of 2!" << std::endl;
+        failures++;
+    }
+
+    // HEAD gets the GET response's head, length included, and END_STREAM on HEADERS instead of a body.
+    HeaderList head_response {};
+    const bool has_head_response = fetch_response_head(port, HEAD_REQUEST_BLOCK, headers_frame, head_response);
+    const HeaderField* head_length = head_response.find_field("content-length");
+
+    if (!has_head_response || head_response.get_status() != "200" || (headers_frame.flags & FLAG_END_STREAM) == 0 || !head_length
+        || head_length->value != std::to_string(TEST_HELLO_BODY.length())) {
+        std::cerr << "HEAD did not get a bodiless 200 with the GET length!" << std::endl;
+        failures++;
+    }
+
+    // A routed path refuses other methods with 405 and lists the ones it takes (RFC 9110 15.5.6).
+    HeaderList delete_response {};
+    const bool has_delete_response = fetch_response_head(port, DELETE_REQUEST_BLOCK, headers_frame, delete_response);
+    const HeaderField* allow = delete_response.find_field("allow");
+
+    if (!has_delete_response || delete_response.get_status() != "405" || !allow || allow->value != "GET, HEAD") {
+        std::cerr << "DELETE on a GET route did not get a 405 with Allow: GET, HEAD!" << std::endl;
+        failures++;
+    }
+
+    close(silent_fd);
+    close(no_ack_fd);
+    close(slow_fd);
+    close(idle_fd);
+    close(offload_fd);
+    server.stop();
+    server.wait();
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file test_hdrhistogram.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the HDR latency histogram.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include "utils/hdrhistogram.hpp"
+
+/// @brief True when `actual` is within `sig_figures` precision of `expected`.
+static bool is_close(uint64_t actual, uint64_t expected, double tolerance) {
+    double delta = static_cast<double>(actual) - static_cast<double>(expected);
+
+    return (delta < 0 ? -delta : delta) <= static_cast<double>(expected) * tolerance + 1.0;
+}
+
+int main() {
+    HdrHistogram histogram {1UL, 3600UL * 1000UL * 1000UL, 3U};
+
+    // 1..10000 uniformly: the percentiles are known exactly.
+    for (uint64_t value = 1UL; value <= 10000UL; value++) {
+        histogram.record(value);
+    }
+
+    if (histogram.get_count() != 10000UL || histogram.get_min() != 1UL || histogram.get_max() != 10000UL) {
+        std::cerr << "HdrHistogram lost counts or extremes!" << std::endl;
+        return 1;
+    }
+
+    if (!is_close(histogram.get_value_at_percentile(50.0), 5000UL, 0.001) || !is_close(histogram.get_value_at_percentile(99.0), 9900UL, 0.001)
+        || !is_close(histogram.get_value_at_percentile(99.9), 9990UL, 0.001) || histogram.get_value_at_percentile(100.0) != 10000UL) {
+        std::cerr << "HdrHistogram percentiles are off by more than 3 significant figures!" << std::endl;
+        return 1;
+    }
+
+    // A long tail recorded in a second histogram must show up after a merge.
+    HdrHistogram tail {1UL, 3600UL * 1000UL * 1000UL, 3U};
+
+    tail.record_n(2000000UL, 100UL);
+    histogram.merge(tail);
+
+    if (histogram.get_count() != 10100UL || !is_close(histogram.get_value_at_percentile(99.9), 2000000UL, 0.001)) {
+        std::cerr << "HdrHistogram merge dropped the tail!" << std::endl;
+        return 1;
+    }
+
+    histogram.record(UINT64_MAX);
+
+    if (histogram.get_clamped_count() != 1UL) {
+        std::cerr << "HdrHistogram did not clamp an out of range value!" << std::endl;
+        return 1;
+    }
+
+    histogram.reset();
+
+    if (histogram.get_count() != 0UL || histogram.get_value_at_percentile(50.0) != 0UL) {
+        std::cerr << "HdrHistogram reset left counts behind!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_headerlist.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the arena-backed header list.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <string>
+#include "bench/headercorpus.hpp"
+#include "hpack/headerlist.hpp"
+
+static int test_arena() {
+    ByteArena arena {};
+    std::string_view first = arena.copy("hello");
+    std::string big_text(BYTE_ARENA_CHUNK_SIZE + 10UL, 'x');
+    std::string_view big = arena.copy(big_text);
+
+    if (first != "hello" || big != big_text || arena.get_used() != 5UL + big_text.length()) {
+        std::cerr << "ByteArena copied text incorrectly!" << std::endl;
+        return 1;
+    }
+
+    // Reuse after reset must keep the old chunks instead of allocating more.
+    uint32_t chunk_count = arena.get_chunk_count();
+
+    arena.reset();
+    arena.copy("hello");
+    arena.copy(big_text);
+
+    if (arena.get_chunk_count() != chunk_count) {
+        std::cerr << "ByteArena did not reuse its chunks after reset!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_cookie_join() {
+    HeaderList headers {};
+
+    headers.add_field("cookie", "a=1");
+    headers.add_field("accept", "*/*");
+    headers.add_field("cookie", "b=2");
+    headers.add_static_field("cookie", "");
+    headers.add_field("cookie", "c=3");
+
+    const HeaderField* cookie = headers.find_field("cookie");
+
+    if (!cookie || cookie->value != "a=1; b=2; ; c=3" || headers.get_fields().size() != 2UL || headers.get_fields()[0].name != "cookie") {
+        std::cerr << "Cookie crumbs were not joined in place of the first cookie field!" << std::endl;
+        return 1;
+    }
+
+    // Back to back crumbs grow the joined value in place, so the arena holds just the final text.
+    headers.clear();
+    headers.add_field("cookie", "session=abc");
+    headers.add_field("cookie", "theme=dark");
+
+    if (headers.find_field("cookie")->value != "session=abc; theme=dark" || headers.get_fields().size() != 1UL) {
+        std::cerr << "Consecutive cookie crumbs were joined wrong!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_corpus_reserve() {
+    const CorpusHeaderSet* corpora[] = {REQUEST_CORPUS, RESPONSE_CORPUS};
+    const size_t corpus_counts[] = {REQUEST_CORPUS_COUNT, RESPONSE_CORPUS_COUNT};
+    HeaderList headers {};
+
+    // Every corpus set, with as many fields again to spare, fits the reserve, so a reused list never grows its vector.
+    for (size_t corpus_i = 0UL; corpus_i < 2UL; corpus_i++) {
+        for (size_t set_i = 0UL; set_i < corpus_counts[corpus_i]; set_i++) {
+            const CorpusHeaderSet& header_set = corpora[corpus_i][set_i];
+
+            headers.clear();
+
+            for (size_t field_i = 0UL; field_i < header_set.count; field_i++) {
+                headers.add_field(header_set.fields[field_i].name, header_set.fields[field_i].value);
+            }
+
+            if (headers.get_fields().size() * 2UL > HEADER_LIST_RESERVED_FIELDS || headers.get_fields().capacity() != HEADER_LIST_RESERVED_FIELDS) {
+                std::cerr << "Header corpus set " << header_set.label << " outgrew the reserved fields!" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main() {
+    if (test_arena() != 0 || test_cookie_join() != 0 || test_corpus_reserve() != 0) {
+        return 1;
+    }
+
+    HeaderList headers {};
+    std::string scratch {"/index.html"};
+
+    headers.add_static_field(":method", "GET");
+    headers.add_field(":path", scratch);
+    headers.add_field("user-agent", "test/1.0");
+
+    // Copied text must not alias the caller's buffer.
+    scratch.assign("/overwritten");
+
+    if (headers.get_method() != "GET" || headers.get_path() != "/index.html" || headers.get_count() != 3UL) {
+        std::cerr << "HeaderList lost pseudo-header slots!" << std::endl;
+        return 1;
+    }
+
+    const HeaderField* agent = headers.find_field("user-agent");
+
+    if (!agent || agent->value != "test/1.0" || headers.has_pseudo(PseudoHeader::authority) || !headers.is_well_formed()) {
+        std::cerr << "HeaderList lost a regular field!" << std::endl;
+        return 1;
+    }
+
+    // A pseudo-header after a regular field is malformed (RFC 7540 8.1.2.1).
+    headers.add_field(":authority", "example.com");
+
+    if (headers.is_well_formed() || headers.has_pseudo(PseudoHeader::authority)) {
+        std::cerr << "HeaderList accepted a late pseudo-header!" << std::endl;
+        return 1;
+    }
+
+    headers.clear();
+    headers.add_field(":method", "POST");
+    headers.add_field(":method", "PUT");
+
+    if (headers.get_method() != "POST" || headers.is_well_formed()) {
+        std::cerr << "HeaderList accepted a repeated pseudo-header!" << std::endl;
+        return 1;
+    }
+
+    headers.clear();
+
+    if (!headers.is_empty() || !headers.is_well_formed() || headers.get_path().length() != 0UL) {
+        std::cerr << "HeaderList clear left stale fields!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+/**
+ * @file test_hpackdecoder.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the HPACK decoder and its header list size limit, using RFC 7541 Appendix C blocks, plus encoder round trips under every indexing policy.
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "bench/headercorpus.hpp"
+#include "hpack/hpackdecoder.hpp"
+#include "hpack/hpackencoder.hpp"
+
+static bool has_field(const HeaderList& fields, const char* name, const char* value) {
+    const HeaderField* field = fields.find_field(name);
+
+    return field != nullptr && field->value == value;
+}
+
+static int test_rfc_examples() {
+    // RFC 7541 C.4.1 and C.4.2: requests with Huffman coding and a dynamic table reference.
+    const uint8_t request1[] = {
+        0x82, 0x86, 0x84, 0x41, 0x8c, 0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a, 0x6b, 0xa0, 0xab, 0x90, 0xf4, 0xff
+    };
+    const uint8_t request2[] = {0x82, 0x86, 0x84, 0xbe, 0x58, 0x86, 0xa8, 0xeb, 0x10, 0x64, 0x9c, 0xbf};
+    HpackDecoder decoder {};
+    HeaderList fields {};
+
+    if (decoder.decode_block(request1, sizeof(request1), fields) != HpackStatus::ok || fields.get_count() != 4UL
+        || fields.get_method() != "GET" || fields.get_authority() != "www.example.com" || !fields.is_well_formed()
+        || decoder.get_table().get_size() != 57UL) {
+        std::cerr << "Decoder failed on RFC 7541 C.4.1!" << std::endl;
+        return 1;
+    }
+
+    if (decoder.decode_block(request2, sizeof(request2), fields) != HpackStatus::ok || fields.get_count() != 5UL
+        || fields.get_authority() != "www.example.com" || !has_field(fields, "cache-control", "no-cache")
+        || decoder.get_table().get_size() != 110UL) {
+        std::cerr << "Decoder failed on RFC 7541 C.4.2!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_list_limit() {
+    // RFC 7541 C.3.1 without Huffman coding: 42 + 43 + 38 + 57 octets of header list.
+    const uint8_t request[] = {
+        0x82, 0x86, 0x84, 0x41, 0x0f, 'w', 'w', 'w', '.', 'e', 'x', 'a', 'm', 'p', 'l', 'e', '.', 'c', 'o', 'm'
+    };
+    HpackDecoder decoder {100UL};
+    HeaderList fields {};
+
+    if (decoder.decode_block(request, sizeof(request), fields) != HpackStatus::header_list_too_large || fields.get_count() != 2UL) {
+        std::cerr << "Decoder did not stop emitting at the header list limit!" << std::endl;
+        return 1;
+    }
+
+    // The indexed literal past the limit must still reach the dynamic table.
+    if (decoder.get_table().get_size() != 57UL) {
+        std::cerr << "Decoder lost dynamic table sync after the limit!" << std::endl;
+        return 1;
+    }
+
+    // One oversized plain literal: rejected as too large, not as malformed.
+    std::vector<uint8_t> big_value {0x00, 0x01, 'x', 0x7f, 0x49};
+    big_value.insert(big_value.end(), 200UL, 'a');
+
+    if (decoder.decode_block(big_value.data(), big_value.size(), fields) != HpackStatus::header_list_too_large || !fields.is_empty()) {
+        std::cerr << "Decoder accepted an oversized literal!" << std::endl;
+        return 1;
+    }
+
+    // The limit is per block, so the same decoder keeps working for the next request.
+    const uint8_t small_request[] = {0x82, 0xbe};
+
+    if (decoder.decode_block(small_request, sizeof(small_request), fields) != HpackStatus::ok
+        || fields.get_authority() != "www.example.com") {
+        std::cerr << "Decoder did not recover after an oversized block!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_malformed() {
+    const std::vector<std::vector<uint8_t>> bad_blocks {
+        {0x80},                                // index 0
+        {0xc6},                                // index 70 past an empty dynamic table
+        {0x41, 0x05, 'a'},                     // string shorter than its length
+        {0x00, 0x01, 'x', 0x7f, 0xff, 0xff, 0xff, 0xff, 0x0f}, // length overflows
+        {0x82, 0x3f, 0x01},                    // size update after a field
+        {0x3f, 0xe2, 0x1f},                    // size update past our table capacity
+        {0x00, 0x01, 'x', 0x81, 0x00},         // Huffman padding of zeros
+        {0x00, 0x01, 'x', 0x82, 0x1f, 0xff}    // Huffman padding longer than 7 bits
+    };
+
+    for (const auto& bad_block : bad_blocks) {
+        HpackDecoder decoder {};
+        HeaderList fields {};
+
+        if (decoder.decode_block(bad_block.data(), bad_block.size(), fields) != HpackStatus::compression_error) {
+            std::cerr << "Decoder accepted a malformed block of " << bad_block.size() << " octets!" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_cookie_crumbs() {
+    const char* cookies[] = {
+        "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; _ga=GA1.1.1843270671.1715612345; theme=dark",
+        "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90;  _ga=GA1.1.1843270671.1715612345; theme=light"
+    };
+    HpackEncoder plain_encoder {};
+    HpackEncoder crumb_encoder {};
+    HpackDecoder decoder {};
+    HeaderList fields {};
+    std::vector<uint8_t> plain_block {};
+    std::vector<uint8_t> crumb_block {};
+
+    crumb_encoder.set_split_cookies(true);
+
+    for (const char* cookie : cookies) {
+        plain_block.clear();
+        crumb_block.clear();
+        plain_encoder.encode_field(plain_block, "cookie", cookie);
+        crumb_encoder.encode_field(crumb_block, ":method", "GET");
+        crumb_encoder.encode_field(crumb_block, "cookie", cookie);
+
+        if (decoder.decode_block(crumb_block.data(), static_cast<uint32_t>(crumb_block.size()), fields) != HpackStatus::ok
+            || !fields.find_field("cookie") || fields.find_field("cookie")->value.find("session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; _ga=") != 0UL) {
+            std::cerr << "Split cookie did not decode back into one field!" << std::endl;
+            return 1;
+        }
+    }
+
+    // The second request repeats two crumbs, which shrink to one indexed octet each, and only `theme=light` is sent as a literal.
+    if (fields.find_field("cookie")->value != "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; _ga=GA1.1.1843270671.1715612345; theme=light"
+        || crumb_block.size() >= plain_block.size() / 4UL || decoder.get_table().get_total_length() != STATIC_TABLE_LENGTH + 4U) {
+        std::cerr << "Repeated cookie crumbs were not indexed!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_cookie_crumb_limits() {
+    const std::string long_crumb = "session=" + std::string(40UL, 'a');
+    const std::string cookie = "id=7; " + long_crumb;
+    const size_t capacities[] = {0UL, 64UL};
+
+    // No table, then one too small for the long crumb: whatever does not fit goes out without indexing, never as an insert that empties the table.
+    for (size_t capacity : capacities) {
+        HpackEncoder encoder {};
+        HpackDecoder decoder {};
+        HeaderList fields {};
+        std::vector<uint8_t> block {};
+
+        encoder.set_split_cookies(true);
+        encoder.set_table_capacity(capacity);
+        encoder.begin_block(block);
+        encoder.encode_field(block, "cookie", cookie);
+
+        const uint32_t expected_length = STATIC_TABLE_LENGTH + ((capacity == 0UL) ? 0U : 1U);
+
+        if (decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), fields) != HpackStatus::ok || !has_field(fields, "cookie", cookie.c_str())
+            || decoder.get_table().get_total_length() != expected_length) {
+            std::cerr << "Cookie crumbs overflowed a table of " << capacity << " octets!" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_size_update_minimum() {
+    HpackEncoder encoder {};
+    HpackDecoder decoder {};
+    HeaderList fields {};
+    std::vector<uint8_t> block {};
+
+    encoder.set_indexing_policy(IndexingPolicy::always);
+    encoder.encode_field(block, "x-trace", "ab12");
+
+    if (decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), fields) != HpackStatus::ok) {
+        std::cerr << "Indexed field did not decode!" << std::endl;
+        return 1;
+    }
+
+    // The peer shrinks its table to nothing and restores it before our next block: the entry is gone here, so the decoder must hear of the 0 as well.
+    encoder.set_table_capacity(0UL);
+    encoder.set_table_capacity(4096UL);
+    block.clear();
+    encoder.begin_block(block);
+    encoder.encode_field(block, "x-trace", "ab12");
+
+    const std::vector<uint8_t> expected_updates {0x20, 0x3f, 0xe1, 0x1f};
+
+    if (block.size() < expected_updates.size() || !std::equal(expected_updates.begin(), expected_updates.end(), block.begin())
+        || decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), fields) != HpackStatus::ok
+        || !has_field(fields, "x-trace", "ab12") || decoder.get_table().get_total_length() != STATIC_TABLE_LENGTH + 1U) {
+        std::cerr << "Size updates did not announce the minimum before the final size!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static bool is_same_list(const HeaderList& lhs, const HeaderList& rhs) {
+    const std::vector<HeaderField>& lhs_fields = lhs.get_fields();
+    const std::vector<HeaderField>& rhs_fields = rhs.get_fields();
+
+    if (lhs_fields.size() != rhs_fields.size() || lhs.get_method() != rhs.get_method() || lhs.get_path() != rhs.get_path()
+        || lhs.get_authority() != rhs.get_authority() || lhs.get_status() != rhs.get_status()) {
+        return false;
+    }
+
+    for (size_t field_i = 0UL; field_i < lhs_fields.size(); field_i++) {
+        if (lhs_fields[field_i].name != rhs_fields[field_i].name || lhs_fields[field_i].value != rhs_fields[field_i].value) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int test_indexing_policies() {
+    const IndexingPolicy policies[] = {IndexingPolicy::always, IndexingPolicy::size_threshold, IndexingPolicy::frequency};
+    size_t block_totals[3] = {0UL, 0UL, 0UL};
+
+    for (size_t policy_i = 0UL; policy_i < 3UL; policy_i++) {
+        HpackEncoder plain_encoder {};
+        HpackEncoder encoder {};
+        HpackDecoder plain_decoder {};
+        HpackDecoder decoder {};
+        HeaderList plain_fields {};
+        HeaderList fields {};
+        std::vector<uint8_t> plain_block {};
+        std::vector<uint8_t> block {};
+
+        encoder.set_indexing_policy(policies[policy_i]);
+
+        // Three page loads over one connection, each response tagged with a value that never repeats.
+        for (uint32_t pass_i = 0U; pass_i < 3U; pass_i++) {
+            for (size_t set_i = 0UL; set_i < RESPONSE_CORPUS_COUNT; set_i++) {
+                const CorpusHeaderSet& header_set = RESPONSE_CORPUS[set_i];
+                std::string sequence = std::to_string(pass_i * RESPONSE_CORPUS_COUNT + set_i);
+
+                plain_block.clear();
+                block.clear();
+                encoder.begin_block(block);
+
+                for (size_t field_i = 0UL; field_i < header_set.count; field_i++) {
+                    plain_encoder.encode_field(plain_block, header_set.fields[field_i].name, header_set.fields[field_i].value);
+                    encoder.encode_field(block, header_set.fields[field_i].name, header_set.fields[field_i].value);
+                }
+
+                plain_encoder.encode_field(plain_block, "x-sequence", sequence);
+                encoder.encode_field(block, "x-sequence", sequence);
+                block_totals[policy_i] += block.size();
+
+                if (plain_decoder.decode_block(plain_block.data(), static_cast<uint32_t>(plain_block.size()), plain_fields) != HpackStatus::ok
+                    || decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), fields) != HpackStatus::ok
+                    || !is_same_list(plain_fields, fields)) {
+                    std::cerr << "Indexing policy " << policy_i << " broke the round trip of " << header_set.label << "!" << std::endl;
+                    return 1;
+                }
+            }
+        }
+
+        // Unique values churn the table under `always`; frequency admission never lets them in.
+        bool has_unique = decoder.get_table().has_entry("x-sequence");
+
+        if (has_unique != (policies[policy_i] != IndexingPolicy::frequency)) {
+            std::cerr << "Indexing policy " << policy_i << " got unique values wrong!" << std::endl;
+            return 1;
+        }
+
+        // A smaller peer table is announced first in the next block and shrinks both tables alike.
+        encoder.set_table_capacity(256UL);
+        block.clear();
+        encoder.begin_block(block);
+        encoder.encode_field(block, "server", "h2plus");
+
+        if (decoder.decode_block(block.data(), static_cast<uint32_t>(block.size()), fields) != HpackStatus::ok
+            || decoder.get_table().get_capacity() != 256UL || !has_field(fields, "server", "h2plus")) {
+            std::cerr << "Table size update did not reach the decoder!" << std::endl;
+            return 1;
+        }
+    }
+
+    if (block_totals[2] >= block_totals[1] * 2UL) {
+        std::cerr << "Frequency admission compressed far worse than the size threshold!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int main() {
+    if (test_rfc_examples() != 0 || test_cookie_crumbs() != 0 || test_cookie_crumb_limits() != 0 || test_size_update_minimum() != 0 || test_indexing_policies() != 0) {
+        return 1;
+    }
+
+    if (test_list_limit() != 0) {
+        return 1;
+    }
+
+    return test_malformed();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file test_metrics.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the per-thread metric counters and HPACK instrumentation.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hpack/hpackdecoder.hpp"
+#include "hpack/hpackencoder.hpp"
+#include "utils/metrics.hpp"
+
+static int test_sharded_counts() {
+    constexpr uint32_t thread_count = 4U;
+    constexpr uint64_t bumps_per_thread = 10000UL;
+    std::vector<std::thread> threads {};
+
+    for (uint32_t thread_i = 0U; thread_i < thread_count; thread_i++) {
+        threads.emplace_back([]() {
+            for (uint64_t bump_i = 0UL; bump_i < bumps_per_thread; bump_i++) {
+                metrics_add(Metric::streams_opened);
+                metrics_add(Metric::streams_active);
+            }
+
+            // Gauges may go down on another thread than the one that raised them.
+            for (uint64_t bump_i = 0UL; bump_i < bumps_per_thread / 2UL; bump_i++) {
+                metrics_sub(Metric::streams_active);
+            }
+
+            metrics_count_frame(0x1, true);
+            metrics_count_frame(0xfa, false);
+        });
+    }
+
+    for (auto& worker : threads) {
+        worker.join();
+    }
+
+    if (metrics_total(Metric::streams_opened) != thread_count * bumps_per_thread
+        || metrics_total(Metric::streams_active) != thread_count * bumps_per_thread / 2UL) {
+        std::cerr << "Sharded counters lost updates!" << std::endl;
+        return 1;
+    }
+
+    if (metrics_frame_total(0x1, true) != thread_count || metrics_frame_total(0x42, false) != thread_count) {
+        std::cerr << "Frame counters were wrong!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_hpack_counts() {
+    // RFC 7541 C.3.1 and C.3.2: the second request reuses the entry the first one indexed.
+    const uint8_t first_block[] = {
+        0x82, 0x86, 0x84, 0x41, 0x0f, 0x77, 0x77, 0x77, 0x2e, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d
+    };
+    const uint8_t second_block[] = {
+        0x82, 0x86, 0x84, 0xbe, 0x58, 0x08, 0x6e, 0x6f, 0x2d, 0x63, 0x61, 0x63, 0x68, 0x65
+    };
+    const uint64_t encode_static_before = metrics_total(Metric::hpack_encode_static_hits);
+
+    {
+        HpackDecoder decoder {};
+        HeaderList fields {};
+
+        decoder.decode_block(first_block, sizeof(first_block), fields);
+        decoder.decode_block(second_block, sizeof(second_block), fields);
+
+        // C.3.1 and C.3.2 reference :method, :scheme and :path from the static table in each request.
+        if (metrics_total(Metric::hpack_decode_static_hits) != 6UL || metrics_total(Metric::hpack_decode_dynamic_hits) != 1UL
+            || metrics_total(Metric::hpack_encode_static_hits) != encode_static_before || metrics_total(Metric::hpack_table_inserts) != 2UL
+            || metrics_total(Metric::hpack_table_entries) != 2UL || metrics_total(Metric::hpack_decode_raw_strings) != 2UL
+            || metrics_total(Metric::hpack_decode_block_octets) != sizeof(first_block) + sizeof(second_block)) {
+            std::cerr << "Decoder counters were wrong!" << std::endl;
+            return 1;
+        }
+    }
+
+    if (metrics_total(Metric::hpack_table_entries) != 0UL || metrics_total(Metric::hpack_table_octets) != 0UL) {
+        std::cerr << "A destroyed table stayed in the occupancy gauges!" << std::endl;
+        return 1;
+    }
+
+    HpackEncoder encoder {};
+    std::vector<uint8_t> block {};
+
+    encoder.encode_field(block, ":method", "GET");
+    encoder.encode_field(block, "x-custom", "some value");
+
+    if (metrics_total(Metric::hpack_encode_static_hits) != encode_static_before + 1UL || metrics_total(Metric::hpack_decode_static_hits) != 6UL
+        || metrics_total(Metric::hpack_encode_literal_fields) != 1UL || metrics_total(Metric::hpack_encode_block_octets) != block.size()
+        || metrics_total(Metric::hpack_encode_huffman_strings) != 2UL) {
+        std::cerr << "Encoder counters were wrong!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_rendering() {
+    std::string text {};
+
+    render_metrics(text);
+
+    if (text.find("# TYPE h2plus_hpack_field_lookups_total counter\n") == std::string::npos
+        || text.find("h2plus_hpack_field_lookups_total{direction=\"decode\",table=\"dynamic\",result=\"hit\"} 1\n") == std::string::npos
+        || text.find("h2plus_frames_sent_total{type=\"headers\"} 4\n") == std::string::npos
+        || text.find("# TYPE h2plus_streams_active gauge\n") == std::string::npos) {
+        std::cerr << "Prometheus text was wrong:\n" << text << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int main() {
+    if (test_sharded_counts() != 0 || test_hpack_counts() != 0 || test_rendering() != 0) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_respcache.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the pre-framed response cache.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include "server/respcache.hpp"
+
+constexpr uint32_t TEST_BIG_BODY_SIZE = 20000U;
+
+int main() {
+    ResponseCache cache {64UL * 1024UL};
+    const uint8_t favicon[] = {0x00, 0x00, 0x01, 0x00, 0x01, 0x00};
+    std::vector<uint8_t> big_body(TEST_BIG_BODY_SIZE, 0x2a);
+
+    std::vector<HeaderTablePair> favicon_headers {
+        {":status", "200"},
+        {"content-type", "image/x-icon"}
+    };
+
+    if (!cache.insert("/favicon.ico", favicon_headers, favicon, sizeof(favicon))) {
+        std::cerr << "ResponseCache rejected a tiny entry!" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> out {};
+
+    if (cache.serve("/missing", 1U, out) != nullptr || cache.get_miss_count() != 1UL || !out.empty()) {
+        std::cerr << "ResponseCache served or miscounted a miss!" << std::endl;
+        return 1;
+    }
+
+    const CachedResponse* hit = cache.serve("/favicon.ico", 7U, out);
+
+    if (!hit || cache.get_hit_count() != 1UL || hit->frame_offsets.size() != 2UL || hit->body_length != sizeof(favicon)
+        || out.size() != hit->wire.size()) {
+        std::cerr << "ResponseCache hit had the wrong frame layout!" << std::endl;
+        return 1;
+    }
+
+    FrameHeader headers_frame {};
+    FrameHeader data_frame {};
+    const uint8_t* wire = out.data();
+
+    unpack_frame_header(headers_frame, wire, FRAME_HEADER_SIZE);
+    unpack_frame_header(data_frame, wire + hit->frame_offsets[1], FRAME_HEADER_SIZE);
+
+    if (headers_frame.type != FrameType::headers || headers_frame.stream_id != 7U || headers_frame.flags != FLAG_END_HEADERS
+        || data_frame.type != FrameType::data || data_frame.stream_id != 7U || data_frame.flags != FLAG_END_STREAM
+        || data_frame.length != sizeof(favicon)) {
+        std::cerr << "ResponseCache frame headers are wrong!" << std::endl;
+        return 1;
+    }
+
+    // Block should start with indexed :status 200 (static 8) then content-type (static 31) by name reference.
+    const uint8_t* block = wire + FRAME_HEADER_SIZE;
+
+    if (block[0] != 0x88 || block[1] != 0x0f || block[2] != 0x10) {
+        std::cerr << "Header block did not use static table references!" << std::endl;
+        return 1;
+    }
+
+    // A second hit on another stream gets its own copy: the first one may still be half written.
+    std::vector<uint8_t> second_out {};
+
+    hit = cache.serve("/favicon.ico", 9U, second_out);
+    unpack_frame_header(data_frame, second_out.data() + hit->frame_offsets[1], FRAME_HEADER_SIZE);
+    unpack_frame_header(headers_frame, out.data() + hit->frame_offsets[1], FRAME_HEADER_SIZE);
+
+    if (data_frame.stream_id != 9U || headers_frame.stream_id != 7U) {
+        std::cerr << "A repeat hit changed an earlier hit's stream IDs!" << std::endl;
+        return 1;
+    }
+
+    unpack_frame_header(data_frame, hit->wire.data() + hit->frame_offsets[1], FRAME_HEADER_SIZE);
+
+    if (data_frame.stream_id != 0U) {
+        std::cerr << "Serving patched the shared cached wire!" << std::endl;
+        return 1;
+    }
+
+    // A body over the default max frame size is split across DATA frames.
+    std::vector<HeaderTablePair> script_headers {{":status", "200"}, {"content-type", "text/javascript"}};
+
+    if (!cache.insert("/app.js", script_headers, big_body.data(), big_body.size())) {
+        std::cerr << "ResponseCache rejected a multi-frame entry!" << std::endl;
+        return 1;
+    }
+
+    hit = cache.find("/app.js");
+
+    if (!hit || hit->frame_offsets.size() != 3UL) {
+        std::cerr << "Large body was not split into two DATA frames!" << std::endl;
+        return 1;
+    }
+
+    // Shrinking the budget evicts least recently used entries first: /favicon.ico goes, /app.js stays.
+    cache.set_memory_limit(cache.get_memory_used() - 1UL);
+
+    if (cache.get_entry_count() != 1U || cache.get_eviction_count() != 1UL || cache.find("/app.js") == nullptr) {
+        std::cerr << "ResponseCache evicted the wrong entry!" << std::endl;
+        return 1;
+    }
+
+    // Entries larger than the whole budget are refused outright.
+    ResponseCache tiny_cache {256UL};
+
+    if (tiny_cache.insert("/app.js", script_headers, big_body.data(), big_body.size()) || tiny_cache.get_memory_used() != 0UL) {
+        std::cerr << "ResponseCache accepted an entry over its limit!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file test_router.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the trie router and the compile-time route table.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include "server/router.hpp"
+
+constexpr StaticRoute FIXED_ROUTES[] = {
+    {HttpMethod::get, "/", 0},
+    {HttpMethod::get, "/health", 1},
+    {HttpMethod::post, "/health", 2},
+    {HttpMethod::get, "/metrics", 3}
+};
+
+constexpr StaticRouteTable<4> FIXED_TABLE {FIXED_ROUTES};
+
+// The fixed table resolves entirely at compile time.
+static_assert(FIXED_TABLE.find(HttpMethod::post, "/health").target == 2);
+static_assert(FIXED_TABLE.find(HttpMethod::get, "/metrics?pretty=1").target == 3);
+static_assert(FIXED_TABLE.find(HttpMethod::put, "/health").status == RouteStatus::method_not_allowed);
+static_assert(FIXED_TABLE.find(HttpMethod::get, "/nope").status == RouteStatus::not_found);
+static_assert(parse_http_method("DELETE") == HttpMethod::del);
+
+static int test_trie() {
+    Router router {};
+
+    bool added = router.add_route(HttpMethod::get, "/users", 10)
+        && router.add_route(HttpMethod::get, "/users/me", 11)
+        && router.add_route(HttpMethod::get, "/users/:id", 12)
+        && router.add_route(HttpMethod::post, "/users/:id", 13)
+        && router.add_route(HttpMethod::get, "/users/:id/posts/:post", 14)
+        && router.add_route(HttpMethod::get, "/static/*file", 15)
+        && router.add_route(HttpMethod::get, "/use", 16);
+
+    if (!added || router.get_route_count() != 7U) {
+        std::cerr << "Router rejected valid routes!" << std::endl;
+        return 1;
+    }
+
+    // Bad patterns: duplicate route, conflicting parameter name, wildcard before the end, parameter mid-segment.
+    if (router.add_route(HttpMethod::get, "/users", 20) || router.add_route(HttpMethod::get, "/users/:name/x", 21)
+        || router.add_route(HttpMethod::get, "/a/*rest/b", 22) || router.add_route(HttpMethod::get, "/a:b", 23)) {
+        std::cerr << "Router accepted a bad route!" << std::endl;
+        return 1;
+    }
+
+    RouteMatch exact = router.match(HttpMethod::get, "/users/me");
+    RouteMatch param = router.match(HttpMethod::get, "/users/42?full=1");
+    RouteMatch nested = router.match(HttpMethod::get, "/users/42/posts/7");
+    RouteMatch wildcard = router.match(HttpMethod::get, "/static/js/app.js");
+    RouteMatch split = router.match(HttpMethod::get, "/use");
+
+    if (exact.target != 11 || param.target != 12 || param.params.get("id") != "42" || split.target != 16) {
+        std::cerr << "Router picked the wrong route!" << std::endl;
+        return 1;
+    }
+
+    if (nested.target != 14 || nested.params.count != 2U || nested.params.get("post") != "7"
+        || wildcard.target != 15 || wildcard.params.get("file") != "js/app.js") {
+        std::cerr << "Router captured the wrong parameters!" << std::endl;
+        return 1;
+    }
+
+    // POST /users/me has no static route, so matching must fall back to the parameter route.
+    RouteMatch fallback = router.match(HttpMethod::post, "/users/me");
+    RouteMatch wrong_method = router.match(HttpMethod::del, "/users/42");
+    RouteMatch missing = router.match(HttpMethod::get, "/users/42/comments");
+
+    if (fallback.target != 13 || fallback.params.get("id") != "me") {
+        std::cerr << "Router did not backtrack to a parameter route!" << std::endl;
+        return 1;
+    }
+
+    uint32_t expected_allow = (1U << static_cast<uint32_t>(HttpMethod::get)) | (1U << static_cast<uint32_t>(HttpMethod::post));
+
+    if (wrong_method.status != RouteStatus::method_not_allowed || wrong_method.allowed_mask != expected_allow
+        || missing.status != RouteStatus::not_found) {
+        std::cerr << "Router reported the wrong miss status!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int main() {
+    return test_trie();
+}
@@ -0,0 +1,66 @@
+/**
+ * @file test_stagetimes.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the per-thread stage latency histograms.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/stagetimes.hpp"
+
+static int test_clock() {
+    const uint64_t before = stage_clock_ticks();
+
+    if (get_stage_tick_ns() <= 0.0 || stage_clock_ticks() < before) {
+        std::cerr << "Stage clock was not monotonic or calibrated!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_merged_report() {
+    constexpr uint32_t thread_count = 3U;
+    constexpr uint64_t samples_per_thread = 1000UL;
+    std::vector<std::thread> threads {};
+
+    for (uint32_t thread_i = 0U; thread_i < thread_count; thread_i++) {
+        threads.emplace_back([]() {
+            for (uint64_t sample_i = 1UL; sample_i <= samples_per_thread; sample_i++) {
+                record_stage(Stage::hpack_decode, sample_i);
+            }
+
+            StageProbe probe {Stage::routing};
+        });
+    }
+
+    for (auto& worker : threads) {
+        worker.join();
+    }
+
+    std::string text {};
+
+    render_stage_times(text);
+
+    if (text.find("# TYPE h2plus_stage_latency_seconds summary\n") == std::string::npos
+        || text.find("h2plus_stage_latency_seconds_count{stage=\"hpack_decode\"} 3000\n") == std::string::npos
+        || text.find("h2plus_stage_latency_seconds_count{stage=\"routing\"} 3\n") == std::string::npos
+        || text.find("h2plus_stage_latency_seconds_count{stage=\"socket_flush\"} 0\n") == std::string::npos
+        || text.find("h2plus_stage_latency_seconds{stage=\"hpack_decode\",quantile=\"0.99\"} ") == std::string::npos) {
+        std::cerr << "Stage report was wrong:\n" << text << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int main() {
+    if (test_clock() != 0 || test_merged_report() != 0) {
+        return 1;
+    }
+
+    return 0;
+}
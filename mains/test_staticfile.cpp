@@ -0,0 +1,211 @@
+/**
+ * @file test_staticfile.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the zero-copy static file DATA frame sender and request path normalization.
+ * @date 2026-10-19
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "server/staticfile.hpp"
+
+constexpr uint32_t TEST_FILE_SIZE = 40000U;
+constexpr uint32_t TEST_STREAM_ID = 3U;
+
+static bool read_exact(int fd, uint8_t* out, uint32_t count) {
+    uint32_t got = 0U;
+
+    while (got < count) {
+        ssize_t chunk = read(fd, out + got, count - got);
+
+        if (chunk <= 0) {
+            return false;
+        }
+
+        got += static_cast<uint32_t>(chunk);
+    }
+
+    return true;
+}
+
+/// @brief Reads one DATA frame from the peer socket, appending its payload to `body`.
+static bool read_data_frame(int fd, FrameHeader& header, std::vector<uint8_t>& body) {
+    uint8_t raw_header[FRAME_HEADER_SIZE] {};
+
+    if (!read_exact(fd, raw_header, FRAME_HEADER_SIZE) || !unpack_frame_header(header, raw_header, FRAME_HEADER_SIZE)) {
+        return false;
+    }
+
+    size_t old_size = body.size();
+    body.resize(old_size + header.length);
+
+    return read_exact(fd, body.data() + old_size, header.length);
+}
+
+/// @brief Checks that a `.gz` sidecar next to `file_path` is only served to clients that accept gzip.
+static int test_sidecars(const char* file_path) {
+    const std::string sidecar_path = std::string {file_path} + ".gz";
+    const char sidecar_body[] = "pretend gzip octets";
+    FILE* sidecar = std::fopen(sidecar_path.c_str(), "wb");
+
+    if (!sidecar || std::fwrite(sidecar_body, 1, sizeof(sidecar_body), sidecar) != sizeof(sidecar_body)) {
+        std::cerr << "Could not create sidecar file!" << std::endl;
+        return 1;
+    }
+
+    std::fclose(sidecar);
+
+    StaticFileSender sender {};
+    int status = 0;
+    const uint32_t gzip_bit = 1U << static_cast<uint32_t>(ContentCoding::gzip);
+
+    if (!sender.open_negotiated(file_path, "br;q=1.0, gzip;q=0.5") || sender.get_coding() != ContentCoding::gzip
+        || sender.get_file_size() != sizeof(sidecar_body) || (sender.get_available_mask() & gzip_bit) == 0U) {
+        std::cerr << "StaticFileSender did not pick the gzip sidecar!" << std::endl;
+        status = 1;
+    }
+
+    if (status == 0 && (!sender.open_negotiated(file_path, "gzip;q=0, identity") || sender.get_coding() != ContentCoding::identity
+        || sender.get_file_size() != TEST_FILE_SIZE || (sender.get_available_mask() & gzip_bit) == 0U)) {
+        std::cerr << "StaticFileSender served a refused coding!" << std::endl;
+        status = 1;
+    }
+
+    unlink(sidecar_path.c_str());
+
+    return status;
+}
+
+static int test_normalize_path() {
+    struct PathCase {
+        const char* target;
+        const char* expected;   // nullptr: must be rejected
+    };
+
+    const PathCase cases[] = {
+        {"/", "/"},
+        {"/index.html?v=2", "/index.html"},
+        {"//css/./site.css", "/css/site.css"},
+        {"/a/b/../c", "/a/c"},
+        {"/docs/", "/docs/"},
+        {"/docs/..", "/"},
+        {"/caf%C3%A9.txt", "/caf\xC3\xA9.txt"},
+        {"/..", nullptr},
+        {"/a/../../etc/passwd", nullptr},
+        {"/%2e%2e/etc/passwd", nullptr},
+        {"/a%2f..%2f..%2fetc", nullptr},
+        {"/a\\..\\b", nullptr},
+        {"/nul%00.txt", nullptr},
+        {"/bad%2", nullptr},
+        {"/bad%zz", nullptr},
+        {"relative", nullptr}
+    };
+
+    std::string normalized {};
+
+    for (const auto& path_case : cases) {
+        const bool is_ok = normalize_request_path(path_case.target, normalized);
+
+        if (is_ok != (path_case.expected != nullptr) || (is_ok && normalized != path_case.expected)) {
+            std::cerr << "Bad normalization of " << path_case.target << ": " << ((is_ok) ? normalized : "rejected") << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int main() {
+    if (test_normalize_path() != 0) {
+        return 1;
+    }
+
+    char file_path[] = "/tmp/h2plus_staticXXXXXX";
+    int temp_fd = mkstemp(file_path);
+
+    if (temp_fd == -1) {
+        std::cerr << "Could not create temp file!" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> expected(TEST_FILE_SIZE);
+
+    for (uint32_t octet_i = 0U; octet_i < TEST_FILE_SIZE; octet_i++) {
+        expected[octet_i] = static_cast<uint8_t>((octet_i * 31U) & 0xff);
+    }
+
+    if (write(temp_fd, expected.data(), TEST_FILE_SIZE) != static_cast<ssize_t>(TEST_FILE_SIZE)) {
+        std::cerr << "Could not fill temp file!" << std::endl;
+        return 1;
+    }
+
+    close(temp_fd);
+
+    int sockets[2] {-1, -1};
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == -1) {
+        std::cerr << "Could not create socket pair!" << std::endl;
+        return 1;
+    }
+
+    StaticFileSender sender {};
+    int status = 0;
+
+    if (!sender.open_file(file_path) || sender.get_file_size() != TEST_FILE_SIZE) {
+        std::cerr << "StaticFileSender failed to open the file!" << std::endl;
+        return 1;
+    }
+
+    sender.bind_stream(TEST_STREAM_ID);
+
+    // First pass: the window runs out before the file does.
+    int64_t window = 30000;
+
+    if (sender.send_frames(sockets[0], window, FRAME_DEFAULT_MAX_SIZE) != SendStatus::window_empty || window != 0) {
+        std::cerr << "StaticFileSender ignored the flow-control window!" << std::endl;
+        status = 1;
+    }
+
+    // Second pass: a WINDOW_UPDATE lets the rest go out with END_STREAM.
+    window += 20000;
+
+    if (status == 0 && sender.send_frames(sockets[0], window, FRAME_DEFAULT_MAX_SIZE) != SendStatus::done) {
+        std::cerr << "StaticFileSender did not finish the file!" << std::endl;
+        status = 1;
+    }
+
+    const uint32_t expected_lengths[] = {16384U, 13616U, 10000U};
+    std::vector<uint8_t> body {};
+
+    for (uint32_t frame_i = 0U; status == 0 && frame_i < 3U; frame_i++) {
+        FrameHeader header {};
+        bool want_end = frame_i == 2U;
+
+        if (!read_data_frame(sockets[1], header, body) || header.type != FrameType::data
+            || header.stream_id != TEST_STREAM_ID || header.length != expected_lengths[frame_i]
+            || ((header.flags & FLAG_END_STREAM) != 0) != want_end) {
+            std::cerr << "Bad DATA frame #" << frame_i << std::endl;
+            status = 1;
+        }
+    }
+
+    if (status == 0 && body != expected) {
+        std::cerr << "DATA payloads do not match the file contents!" << std::endl;
+        status = 1;
+    }
+
+    if (status == 0) {
+        status = test_sidecars(file_path);
+    }
+
+    close(sockets[0]);
+    close(sockets[1]);
+    unlink(file_path);
+
+    return status;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file test_threadpool.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the work-stealing handler pool.
+ * @date 2026-10-19
+ */
+
+#include <poll.h>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include "server/threadpool.hpp"
+
+constexpr uint32_t TEST_WORKER_COUNT = 4U;
+constexpr uint32_t TEST_TASK_COUNT = 2000U;
+constexpr int TEST_POLL_TIMEOUT_MS = 2000;
+constexpr uint32_t TEST_BLOCKED_WORKER_COUNT = 2U;
+constexpr uint32_t TEST_QUEUED_TASK_COUNT = 64U;
+
+/// @brief Checks that tasks queued behind a worker stuck in a long handler still run on its peer.
+bool test_blocked_worker() {
+    ThreadPool pool {TEST_BLOCKED_WORKER_COUNT};
+    CompletionQueue replies {};
+    std::atomic<bool> is_released {false};
+    uint32_t short_done = 0U;
+    bool blocker_done = false;
+
+    pool.submit([&is_released]() {
+        while (!is_released.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }, [&blocker_done]() {
+        blocker_done = true;
+    }, replies);
+
+    // Round robin sends every other one of these to the blocked worker's inbox.
+    for (uint32_t task_i = 0U; task_i < TEST_QUEUED_TASK_COUNT; task_i++) {
+        pool.submit([]() {}, [&short_done]() {
+            short_done++;
+        }, replies);
+    }
+
+    pollfd wakeup {replies.get_wakeup_fd(), POLLIN, 0};
+
+    while (short_done < TEST_QUEUED_TASK_COUNT) {
+        if (poll(&wakeup, 1, TEST_POLL_TIMEOUT_MS) <= 0) {
+            std::cerr << "Tasks stuck behind a blocked worker: " << short_done << " of " << TEST_QUEUED_TASK_COUNT << std::endl;
+            is_released.store(true, std::memory_order_release);
+            return false;
+        }
+
+        replies.drain();
+    }
+
+    if (blocker_done) {
+        std::cerr << "Blocking task finished before it was released!" << std::endl;
+        return false;
+    }
+
+    is_released.store(true, std::memory_order_release);
+
+    while (!blocker_done) {
+        if (poll(&wakeup, 1, TEST_POLL_TIMEOUT_MS) <= 0) {
+            std::cerr << "Released blocking task never completed!" << std::endl;
+            return false;
+        }
+
+        replies.drain();
+    }
+
+    return true;
+}
+
+int main() {
+    ThreadPool pool {TEST_WORKER_COUNT};
+    CompletionQueue replies {};
+
+    if (!replies.is_ready()) {
+        std::cerr << "CompletionQueue failed to create its eventfd!" << std::endl;
+        return 1;
+    }
+
+    // Mock handlers with uneven costs: every 8th one is much heavier so its siblings get stolen.
+    uint64_t results[TEST_TASK_COUNT] {};
+    uint64_t completed_sum = 0U;
+    uint32_t completed_count = 0U;
+
+    for (uint32_t task_i = 0U; task_i < TEST_TASK_COUNT; task_i++) {
+        uint32_t spin_count = ((task_i & 7U) == 0U) ? 20000U : 200U;
+        uint64_t* slot = &results[task_i];
+
+        bool submitted = pool.submit([slot, task_i, spin_count]() {
+            volatile uint64_t acc = 0U;
+
+            for (uint32_t spin_i = 0U; spin_i < spin_count; spin_i++) {
+                acc = acc + spin_i;
+            }
+
+            *slot = task_i + 1U;
+        }, [slot, &completed_sum, &completed_count]() {
+            completed_sum += *slot;
+            completed_count++;
+        }, replies);
+
+        if (!submitted) {
+            std::cerr << "ThreadPool rejected task " << task_i << std::endl;
+            return 1;
+        }
+    }
+
+    // Act as the event loop: wait on the eventfd then run completions on this thread.
+    pollfd wakeup {replies.get_wakeup_fd(), POLLIN, 0};
+
+    while (completed_count < TEST_TASK_COUNT) {
+        int ready = poll(&wakeup, 1, TEST_POLL_TIMEOUT_MS);
+
+        if (ready <= 0) {
+            std::cerr << "Timed out waiting on completions: " << completed_count << " of " << TEST_TASK_COUNT << std::endl;
+            return 1;
+        }
+
+        replies.drain();
+    }
+
+    const uint64_t expected_sum = (static_cast<uint64_t>(TEST_TASK_COUNT) * (TEST_TASK_COUNT + 1U)) / 2U;
+
+    if (completed_sum != expected_sum) {
+        std::cerr << "Completion results were lost or duplicated: " << completed_sum << std::endl;
+        return 1;
+    }
+
+    std::cout << "steals: " << pool.get_steal_count() << std::endl;
+
+    // A second round runs on the task nodes the first one returned to the queue.
+    completed_count = 0U;
+
+    for (uint32_t task_i = 0U; task_i < TEST_TASK_COUNT; task_i++) {
+        pool.submit([]() {}, [&completed_count]() {
+            completed_count++;
+        }, replies);
+    }
+
+    while (completed_count < TEST_TASK_COUNT) {
+        if (poll(&wakeup, 1, TEST_POLL_TIMEOUT_MS) <= 0) {
+            std::cerr << "Timed out waiting on reused tasks: " << completed_count << " of " << TEST_TASK_COUNT << std::endl;
+            return 1;
+        }
+
+        replies.drain();
+    }
+
+    pool.shutdown();
+
+    // A stopped pool must refuse more work.
+    if (pool.submit([]() {}, []() {}, replies)) {
+        std::cerr << "ThreadPool accepted work after shutdown!" << std::endl;
+        return 1;
+    }
+
+    if (!test_blocked_worker()) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file test_timerwheel.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the hierarchical timer wheel.
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <vector>
+#include "server/timerwheel.hpp"
+
+constexpr uint32_t TEST_TICK_MS = 10U;
+
+int main() {
+    TimerWheel wheel {TEST_TICK_MS, 1000UL};
+    TimerNode settings_ack {};
+    TimerNode idle {};
+    TimerNode keepalive {};
+    TimerNode cancelled {};
+    std::vector<uint64_t> fired_at {};
+    uint64_t now_ms = 1000UL;
+
+    settings_ack.on_expire = [&fired_at, &now_ms]() { fired_at.push_back(now_ms); };
+    idle.on_expire = [&fired_at, &now_ms]() { fired_at.push_back(now_ms); };
+    cancelled.on_expire = [&fired_at]() { fired_at.push_back(0UL); };
+
+    // The keepalive re-arms itself every 2 s, like a PING timer would.
+    uint32_t keepalive_count = 0U;
+    keepalive.on_expire = [&wheel, &keepalive, &keepalive_count]() {
+        keepalive_count++;
+        wheel.schedule(keepalive, 2000UL);
+    };
+
+    if (wheel.next_timeout_ms(now_ms) != -1) {
+        std::cerr << "Empty wheel asked for a poll timeout!" << std::endl;
+        return 1;
+    }
+
+    wheel.schedule(settings_ack, 250UL);       // level 0
+    wheel.schedule(idle, 120000UL);            // level 2 after 12000 ticks
+    wheel.schedule(keepalive, 2000UL);         // level 1
+    wheel.schedule(cancelled, 300UL);
+    wheel.cancel(cancelled);
+
+    if (wheel.get_armed_count() != 3U || wheel.next_timeout_ms(now_ms) != 250) {
+        std::cerr << "Poll timeout does not match the nearest timer: " << wheel.next_timeout_ms(now_ms) << std::endl;
+        return 1;
+    }
+
+    // Drive the wheel like an event loop would, 10 ms at a time.
+    while (now_ms < 1000UL + 130000UL) {
+        now_ms += TEST_TICK_MS;
+        wheel.advance(now_ms);
+    }
+
+    if (fired_at.size() != 2UL || fired_at[0] != 1250UL || fired_at[1] != 121000UL) {
+        std::cerr << "Timers fired at the wrong times!" << std::endl;
+        return 1;
+    }
+
+    if (keepalive_count != 65U || wheel.get_armed_count() != 1U) {
+        std::cerr << "Self re-arming keepalive misbehaved: " << keepalive_count << std::endl;
+        return 1;
+    }
+
+    // A big jump (e.g. after a long poll) still fires what is due.
+    wheel.cancel(keepalive);
+    wheel.schedule(idle, 5000UL);
+    now_ms += 60000UL;
+    wheel.advance(now_ms);
+
+    if (fired_at.size() != 3UL || wheel.get_armed_count() != 0U || wheel.next_timeout_ms(now_ms) != -1) {
+        std::cerr << "Timer was lost across a large clock jump!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file test_tracer.cpp
+ * @author Derek Tan
+ * @brief Implements unit test for the trace rings, dump round trip and Chrome trace rendering.
+ * @date 2026-10-19
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "utils/tracer.hpp"
+
+static int test_ring_wraparound() {
+    auto ring = std::make_unique<TraceRing>(7U);
+    std::vector<TraceRecord> records {};
+
+    for (uint32_t event_i = 0U; event_i < TRACE_RING_CAPACITY + 10U; event_i++) {
+        ring->push(TraceEvent::frame_received, 1U, 0U, event_i);
+    }
+
+    ring->snapshot(records);
+
+    if (records.size() != TRACE_RING_CAPACITY - 1U || records.front().arg != 11U || records.back().arg != TRACE_RING_CAPACITY + 9U) {
+        std::cerr << "Ring did not keep the newest events in order!" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_dump_round_trip() {
+    const char* dump_path = "/tmp/h2plus_test_tracer.trace";
+
+    // Rings are registered per thread, so each worker shows up as its own track.
+    for (uint32_t thread_i = 0U; thread_i < 2U; thread_i++) {
+        std::thread worker {[thread_i]() {
+            TraceRing& ring = get_trace_ring();
+
+            ring.push(TraceEvent::conn_accepted, thread_i + 1U, 0U, 5U);
+            ring.push(TraceEvent::hpack_decode_begin, thread_i + 1U, 1U, 20U);
+            ring.push(TraceEvent::hpack_decode_end, thread_i + 1U, 1U, 4U);
+        }};
+
+        worker.join();
+    }
+
+    double tick_ns = 0.0;
+    std::vector<TraceThread> threads {};
+
+    if (!dump_traces(dump_path) || !load_trace_dump(dump_path, tick_ns, threads)) {
+        std::cerr << "Dump did not round trip!" << std::endl;
+        return 1;
+    }
+
+    std::remove(dump_path);
+
+    if (threads.size() != 2UL || threads[1].records.size() != 3UL || threads[1].records[1].stream_id != 1U || tick_ns <= 0.0) {
+        std::cerr << "Loaded dump was wrong!" << std::endl;
+        return 1;
+    }
+
+    std::string json {};
+
+    render_chrome_trace(json, tick_ns, threads);
+
+    if (json.find("\"traceEvents\":[") == std::string::npos
+        || json.find("{\"name\":\"hpack_decode\",\"ph\":\"B\",\"pid\":1,\"tid\":1,") == std::string::npos
+        || json.find("\"args\":{\"conn\":2,\"stream\":1,\"arg\":4}") == std::string::npos
+        || json.find("\"name\":\"conn_accepted\",\"ph\":\"i\"") == std::string::npos) {
+        std::cerr << "Chrome trace was wrong:\n" << json << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int main() {
+    if (test_ring_wraparound() != 0 || test_dump_round_trip() != 0) {
+        return 1;
+    }
+
+    return 0;
+}
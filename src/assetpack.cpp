@@ -0,0 +1,634 @@
+/**
+ * @file assetpack.cpp
+ * @author Derek Tan
+ * @brief Implements the packed static asset archive writer and memory-mapped reader.
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "server/assetpack.hpp"
+
+/* Constants */
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325UL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3UL;
+constexpr uint64_t SEED_MIX = 0x9e3779b97f4a7c15UL;
+constexpr uint32_t PERFECT_HASH_MAX_SEED = 1U << 20;
+constexpr uint32_t ASSET_PACK_ALIGN = 8U;
+constexpr size_t PACK_READ_CHUNK = 65536UL;
+
+/// @brief File extension to media type pairs for `guess_content_type`.
+struct ContentTypePair {
+    const char* extension;
+    const char* media_type;
+};
+
+const ContentTypePair CONTENT_TYPES[] = {
+    {".html", "text/html; charset=utf-8"},
+    {".htm", "text/html; charset=utf-8"},
+    {".css", "text/css; charset=utf-8"},
+    {".js", "text/javascript; charset=utf-8"},
+    {".mjs", "text/javascript; charset=utf-8"},
+    {".json", "application/json"},
+    {".webmanifest", "application/manifest+json"},
+    {".map", "application/json"},
+    {".txt", "text/plain; charset=utf-8"},
+    {".xml", "application/xml"},
+    {".svg", "image/svg+xml"},
+    {".png", "image/png"},
+    {".jpg", "image/jpeg"},
+    {".jpeg", "image/jpeg"},
+    {".gif", "image/gif"},
+    {".webp", "image/webp"},
+    {".avif", "image/avif"},
+    {".ico", "image/x-icon"},
+    {".woff", "font/woff"},
+    {".woff2", "font/woff2"},
+    {".wasm", "application/wasm"},
+    {".pdf", "application/pdf"},
+    {".mp4", "video/mp4"},
+    {".webm", "video/webm"}
+};
+
+/* Helper Impl. */
+
+uint64_t asset_path_hash(std::string_view text, uint32_t seed) {
+    uint64_t hash = FNV_OFFSET_BASIS ^ (SEED_MIX * seed);
+
+    for (char letter : text) {
+        hash ^= static_cast<uint8_t>(letter);
+        hash *= FNV_PRIME;
+    }
+
+    // Final avalanche so that nearby seeds give unrelated slots.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdUL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+const char* guess_content_type(std::string_view path) {
+    size_t dot_pos = path.rfind('.');
+
+    if (dot_pos != std::string_view::npos) {
+        std::string_view extension = path.substr(dot_pos);
+
+        for (const auto& pair : CONTENT_TYPES) {
+            if (extension == pair.extension) {
+                return pair.media_type;
+            }
+        }
+    }
+
+    return "application/octet-stream";
+}
+
+/* Packer Helpers Impl. */
+
+/// @brief A file to pack plus its sidecar variants. Empty paths mean the variant is absent.
+struct PackSource {
+    std::string url_path;
+    std::string fs_paths[ASSET_VARIANT_COUNT];
+};
+
+static bool collect_files(const std::string& fs_dir, const std::string& url_dir, std::map<std::string, std::string>& found) {
+    DIR* dir_handle = opendir(fs_dir.c_str());
+
+    if (!dir_handle) {
+        return false;
+    }
+
+    bool collect_ok = true;
+    dirent* item = nullptr;
+
+    while (collect_ok && (item = readdir(dir_handle)) != nullptr) {
+        std::string item_name {item->d_name};
+
+        if (item_name == "." || item_name == "..") {
+            continue;
+        }
+
+        std::string fs_path = fs_dir + "/" + item_name;
+        std::string url_path = url_dir + "/" + item_name;
+        struct stat item_info {};
+
+        // Use lstat so symlinks cannot pull files from outside the document root into the archive.
+        if (lstat(fs_path.c_str(), &item_info) == -1) {
+            collect_ok = false;
+        } else if (S_ISDIR(item_info.st_mode)) {
+            collect_ok = collect_files(fs_path, url_path, found);
+        } else if (S_ISREG(item_info.st_mode)) {
+            found.emplace(url_path, fs_path);
+        }
+    }
+
+    closedir(dir_handle);
+
+    return collect_ok;
+}
+
+static bool ends_with(const std::string& text, std::string_view suffix) {
+    size_t suffix_length = suffix.length();
+
+    return text.length() > suffix_length && text.compare(text.length() - suffix_length, suffix_length, suffix) == 0;
+}
+
+static std::vector<PackSource> group_variants(const std::map<std::string, std::string>& found) {
+    std::vector<PackSource> sources {};
+    std::map<std::string, size_t> source_index {};
+
+    // Base files first, so sidecars can find their owner below.
+    for (const auto& [url_path, fs_path] : found) {
+        bool is_sidecar = false;
+
+        for (uint32_t coding_i = 1U; coding_i < ASSET_VARIANT_COUNT; coding_i++) {
+            if (ends_with(url_path, get_coding_suffix(static_cast<ContentCoding>(coding_i)))) {
+                std::string base_path = url_path.substr(0, url_path.length() - get_coding_suffix(static_cast<ContentCoding>(coding_i)).length());
+                is_sidecar = found.count(base_path) > 0;
+            }
+        }
+
+        if (!is_sidecar) {
+            source_index.emplace(url_path, sources.size());
+            sources.push_back({url_path, {fs_path, "", "", ""}});
+        }
+    }
+
+    for (const auto& [url_path, fs_path] : found) {
+        for (uint32_t coding_i = 1U; coding_i < ASSET_VARIANT_COUNT; coding_i++) {
+            if (!ends_with(url_path, get_coding_suffix(static_cast<ContentCoding>(coding_i)))) {
+                continue;
+            }
+
+            auto owner = source_index.find(url_path.substr(0, url_path.length() - get_coding_suffix(static_cast<ContentCoding>(coding_i)).length()));
+
+            if (owner != source_index.end()) {
+                sources[owner->second].fs_paths[coding_i] = fs_path;
+            }
+        }
+    }
+
+    return sources;
+}
+
+static uint32_t put_pool_string(std::string& pool, std::string_view text) {
+    uint32_t offset = static_cast<uint32_t>(pool.length());
+    pool.append(text.data(), text.length());
+
+    return offset;
+}
+
+/// @brief Copies one file to the archive stream while hashing it for its ETag.
+static bool append_blob(FILE* archive, const std::string& fs_path, uint64_t& written, PackedAssetVariant& variant, std::string& pool) {
+    FILE* blob = std::fopen(fs_path.c_str(), "rb");
+
+    if (!blob) {
+        return false;
+    }
+
+    std::vector<uint8_t> chunk(PACK_READ_CHUNK);
+    uint64_t content_hash = FNV_OFFSET_BASIS;
+    uint64_t blob_length = 0UL;
+    size_t got = 0UL;
+    bool copy_ok = true;
+
+    variant.data_offset = written;
+
+    while ((got = std::fread(chunk.data(), 1UL, chunk.size(), blob)) > 0UL) {
+        for (size_t octet_i = 0UL; octet_i < got; octet_i++) {
+            content_hash ^= chunk[octet_i];
+            content_hash *= FNV_PRIME;
+        }
+
+        if (std::fwrite(chunk.data(), 1UL, got, archive) != got) {
+            copy_ok = false;
+            break;
+        }
+
+        blob_length += got;
+    }
+
+    copy_ok = copy_ok && !std::ferror(blob);
+    std::fclose(blob);
+
+    char etag_text[24] {};
+    std::snprintf(etag_text, sizeof(etag_text), "\"%016llx\"", static_cast<unsigned long long>(content_hash));
+
+    variant.data_length = blob_length;
+    variant.etag_offset = put_pool_string(pool, etag_text);
+    variant.etag_length = static_cast<uint32_t>(std::strlen(etag_text));
+    written += blob_length;
+
+    return copy_ok;
+}
+
+static bool pad_archive(FILE* archive, uint64_t& written) {
+    const uint8_t zeros[ASSET_PACK_ALIGN] {};
+    uint64_t padding = (ASSET_PACK_ALIGN - (written % ASSET_PACK_ALIGN)) % ASSET_PACK_ALIGN;
+
+    written += padding;
+
+    return std::fwrite(zeros, 1UL, padding, archive) == padding;
+}
+
+/**
+ * @brief Assigns every path a unique slot in [0, n) with one seed per bucket (hash and displace). Big buckets are placed first while slots are plentiful.
+ */
+static bool build_perfect_hash(const std::vector<PackSource>& sources, std::vector<uint32_t>& seeds, std::vector<uint32_t>& slot_of) {
+    const uint32_t entry_count = static_cast<uint32_t>(sources.size());
+    const uint32_t bucket_count = entry_count / 2U + 1U;
+    std::vector<std::vector<uint32_t>> buckets(bucket_count);
+    std::vector<bool> slot_taken(entry_count, false);
+    std::vector<uint32_t> bucket_order(bucket_count);
+    std::vector<uint32_t> trial_slots {};
+
+    seeds.assign(bucket_count, 0U);
+    slot_of.assign(entry_count, 0U);
+
+    for (uint32_t source_i = 0U; source_i < entry_count; source_i++) {
+        buckets[asset_path_hash(sources[source_i].url_path, 0U) % bucket_count].push_back(source_i);
+    }
+
+    for (uint32_t bucket_i = 0U; bucket_i < bucket_count; bucket_i++) {
+        bucket_order[bucket_i] = bucket_i;
+    }
+
+    std::stable_sort(bucket_order.begin(), bucket_order.end(), [&buckets](uint32_t lhs, uint32_t rhs) {
+        return buckets[lhs].size() > buckets[rhs].size();
+    });
+
+    for (auto bucket_i : bucket_order) {
+        const auto& members = buckets[bucket_i];
+
+        if (members.empty()) {
+            break;
+        }
+
+        bool placed = false;
+
+        for (uint32_t seed = 1U; !placed && seed < PERFECT_HASH_MAX_SEED; seed++) {
+            trial_slots.clear();
+            placed = true;
+
+            for (auto source_i : members) {
+                uint32_t slot = static_cast<uint32_t>(asset_path_hash(sources[source_i].url_path, seed) % entry_count);
+
+                if (slot_taken[slot] || std::find(trial_slots.begin(), trial_slots.end(), slot) != trial_slots.end()) {
+                    placed = false;
+                    break;
+                }
+
+                trial_slots.push_back(slot);
+            }
+
+            if (placed) {
+                seeds[bucket_i] = seed;
+
+                for (size_t member_i = 0UL; member_i < members.size(); member_i++) {
+                    slot_taken[trial_slots[member_i]] = true;
+                    slot_of[members[member_i]] = trial_slots[member_i];
+                }
+            }
+        }
+
+        if (!placed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Packer Impl. */
+
+int32_t pack_asset_directory(const char* doc_root, const char* archive_path) {
+    std::map<std::string, std::string> found {};
+    std::string root_dir {doc_root};
+
+    while (root_dir.length() > 1UL && root_dir.back() == '/') {
+        root_dir.pop_back();
+    }
+
+    if (!collect_files(root_dir, "", found)) {
+        return -1;
+    }
+
+    std::vector<PackSource> sources = group_variants(found);
+    std::vector<PackedAssetEntry> records(sources.size());
+    std::vector<uint32_t> seeds {};
+    std::vector<uint32_t> slot_of {};
+    std::string pool {};
+
+    if (!build_perfect_hash(sources, seeds, slot_of)) {
+        return -1;
+    }
+
+    FILE* archive = std::fopen(archive_path, "wb");
+
+    if (!archive) {
+        return -1;
+    }
+
+    PackedAssetHeader header {};
+    uint64_t written = sizeof(PackedAssetHeader);
+    bool pack_ok = std::fwrite(&header, sizeof(header), 1UL, archive) == 1UL;
+
+    // Payload blobs, with the index records filled in as their offsets become known.
+    for (size_t source_i = 0UL; pack_ok && source_i < sources.size(); source_i++) {
+        const PackSource& source = sources[source_i];
+        PackedAssetEntry& record = records[slot_of[source_i]];
+        const char* media_type = guess_content_type(source.url_path);
+
+        record.path_offset = put_pool_string(pool, source.url_path);
+        record.path_length = static_cast<uint32_t>(source.url_path.length());
+        record.type_offset = put_pool_string(pool, media_type);
+        record.type_length = static_cast<uint32_t>(std::strlen(media_type));
+
+        for (uint32_t coding_i = 0U; pack_ok && coding_i < ASSET_VARIANT_COUNT; coding_i++) {
+            if (source.fs_paths[coding_i].empty()) {
+                continue;
+            }
+
+            pack_ok = append_blob(archive, source.fs_paths[coding_i], written, record.variants[coding_i], pool);
+            record.variant_mask |= 1U << coding_i;
+        }
+    }
+
+    std::memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = ASSET_PACK_VERSION;
+    header.entry_count = static_cast<uint32_t>(records.size());
+    header.bucket_count = static_cast<uint32_t>(seeds.size());
+    header.strings_offset = written;
+    header.strings_length = pool.length();
+
+    pack_ok = pack_ok && std::fwrite(pool.data(), 1UL, pool.length(), archive) == pool.length();
+    written += pool.length();
+    pack_ok = pack_ok && pad_archive(archive, written);
+
+    header.seeds_offset = written;
+    pack_ok = pack_ok && std::fwrite(seeds.data(), sizeof(uint32_t), seeds.size(), archive) == seeds.size();
+    written += seeds.size() * sizeof(uint32_t);
+    pack_ok = pack_ok && pad_archive(archive, written);
+
+    header.entries_offset = written;
+    pack_ok = pack_ok && std::fwrite(records.data(), sizeof(PackedAssetEntry), records.size(), archive) == records.size();
+    written += records.size() * sizeof(PackedAssetEntry);
+    header.archive_length = written;
+
+    // Patch the real header in now that every offset is known.
+    pack_ok = pack_ok && std::fseek(archive, 0L, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1UL, archive) == 1UL;
+    pack_ok = (std::fclose(archive) == 0) && pack_ok;
+
+    if (!pack_ok) {
+        std::remove(archive_path);
+        return -1;
+    }
+
+    return static_cast<int32_t>(records.size());
+}
+
+/* AssetPack Private Impl. */
+
+bool AssetPack::validate() const {
+    if (this->mapping_length < sizeof(PackedAssetHeader)) {
+        return false;
+    }
+
+    const PackedAssetHeader* temp_header = reinterpret_cast<const PackedAssetHeader*>(this->mapping);
+    const uint64_t total = this->mapping_length;
+
+    if (std::memcmp(temp_header->magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC)) != 0
+        || temp_header->version != ASSET_PACK_VERSION || temp_header->archive_length != total
+        || temp_header->strings_offset > total || temp_header->strings_length > total - temp_header->strings_offset
+        || temp_header->seeds_offset % ASSET_PACK_ALIGN != 0UL || temp_header->entries_offset % ASSET_PACK_ALIGN != 0UL
+        || temp_header->seeds_offset > total || temp_header->bucket_count > (total - temp_header->seeds_offset) / sizeof(uint32_t)
+        || temp_header->entries_offset > total || temp_header->entry_count > (total - temp_header->entries_offset) / sizeof(PackedAssetEntry)
+        || (temp_header->entry_count > 0U && temp_header->bucket_count == 0U)) {
+        return false;
+    }
+
+    // Check every record once here, so lookups can trust offsets without bounds checks.
+    const PackedAssetEntry* temp_entries = reinterpret_cast<const PackedAssetEntry*>(this->mapping + temp_header->entries_offset);
+
+    for (uint32_t entry_i = 0U; entry_i < temp_header->entry_count; entry_i++) {
+        const PackedAssetEntry& entry = temp_entries[entry_i];
+
+        if (static_cast<uint64_t>(entry.path_offset) + entry.path_length > temp_header->strings_length
+            || static_cast<uint64_t>(entry.type_offset) + entry.type_length > temp_header->strings_length
+            || (entry.variant_mask & 1U) == 0U) {
+            return false;
+        }
+
+        for (uint32_t coding_i = 0U; coding_i < ASSET_VARIANT_COUNT; coding_i++) {
+            const PackedAssetVariant& variant = entry.variants[coding_i];
+
+            if ((entry.variant_mask & (1U << coding_i)) == 0U) {
+                continue;
+            }
+
+            if (variant.data_offset > total || variant.data_length > total - variant.data_offset
+                || static_cast<uint64_t>(variant.etag_offset) + variant.etag_length > temp_header->strings_length) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::string_view AssetPack::get_string(uint32_t offset, uint32_t length) const {
+    return std::string_view {this->strings + offset, length};
+}
+
+/* AssetPack Public Impl. */
+
+AssetPack::AssetPack() {
+    this->mapping = nullptr;
+    this->mapping_length = 0UL;
+    this->header = nullptr;
+    this->bucket_seeds = nullptr;
+    this->entries = nullptr;
+    this->strings = nullptr;
+    this->archive_fd = -1;
+}
+
+AssetPack::~AssetPack() {
+    close_archive();
+}
+
+bool AssetPack::open_archive(const char* archive_path) {
+    close_archive();
+
+    int temp_fd = open(archive_path, O_RDONLY | O_CLOEXEC);
+    struct stat archive_info {};
+
+    if (temp_fd == -1) {
+        return false;
+    }
+
+    if (fstat(temp_fd, &archive_info) == -1 || archive_info.st_size < static_cast<off_t>(sizeof(PackedAssetHeader))) {
+        close(temp_fd);
+        return false;
+    }
+
+    void* temp_mapping = mmap(nullptr, static_cast<size_t>(archive_info.st_size), PROT_READ, MAP_PRIVATE, temp_fd, 0);
+
+    if (temp_mapping == MAP_FAILED) {
+        close(temp_fd);
+        return false;
+    }
+
+    this->mapping = static_cast<const uint8_t*>(temp_mapping);
+    this->mapping_length = static_cast<size_t>(archive_info.st_size);
+    this->archive_fd = temp_fd;
+
+    if (!validate()) {
+        close_archive();
+        return false;
+    }
+
+    this->header = reinterpret_cast<const PackedAssetHeader*>(this->mapping);
+    this->strings = reinterpret_cast<const char*>(this->mapping + this->header->strings_offset);
+    this->bucket_seeds = reinterpret_cast<const uint32_t*>(this->mapping + this->header->seeds_offset);
+    this->entries = reinterpret_cast<const PackedAssetEntry*>(this->mapping + this->header->entries_offset);
+
+    return true;
+}
+
+void AssetPack::close_archive() {
+    if (this->mapping != nullptr) {
+        munmap(const_cast<uint8_t*>(this->mapping), this->mapping_length);
+        this->mapping = nullptr;
+        this->mapping_length = 0UL;
+    }
+
+    if (this->archive_fd != -1) {
+        close(this->archive_fd);
+        this->archive_fd = -1;
+    }
+
+    this->header = nullptr;
+    this->bucket_seeds = nullptr;
+    this->entries = nullptr;
+    this->strings = nullptr;
+}
+
+bool AssetPack::is_open() const {
+    return this->header != nullptr;
+}
+
+int AssetPack::get_fd() const {
+    return this->archive_fd;
+}
+
+uint32_t AssetPack::get_entry_count() const {
+    return (this->header != nullptr) ? this->header->entry_count : 0U;
+}
+
+const PackedAssetEntry* AssetPack::find(std::string_view path) const {
+    if (get_entry_count() == 0U) {
+        return nullptr;
+    }
+
+    uint32_t bucket = static_cast<uint32_t>(asset_path_hash(path, 0U) % this->header->bucket_count);
+    uint32_t slot = static_cast<uint32_t>(asset_path_hash(path, this->bucket_seeds[bucket]) % this->header->entry_count);
+    const PackedAssetEntry* candidate = &this->entries[slot];
+
+    /// @note A perfect hash maps unknown paths to some slot too, so the stored path is always compared.
+    if (get_path(*candidate) != path) {
+        return nullptr;
+    }
+
+    return candidate;
+}
+
+bool AssetPack::has_variant(const PackedAssetEntry& entry, ContentCoding coding) const {
+    return (entry.variant_mask & (1U << static_cast<uint32_t>(coding))) != 0U;
+}
+
+std::string_view AssetPack::get_path(const PackedAssetEntry& entry) const {
+    return get_string(entry.path_offset, entry.path_length);
+}
+
+std::string_view AssetPack::get_content_type(const PackedAssetEntry& entry) const {
+    return get_string(entry.type_offset, entry.type_length);
+}
+
+ContentCoding AssetPack::negotiate(const PackedAssetEntry& entry, std::string_view accept_encoding) const {
+    return negotiate_coding(accept_encoding, entry.variant_mask);
+}
+
+std::string_view AssetPack::get_etag(const PackedAssetEntry& entry, ContentCoding coding) const {
+    if (!has_variant(entry, coding)) {
+        return {};
+    }
+
+    const PackedAssetVariant& variant = entry.variants[static_cast<uint32_t>(coding)];
+
+    return get_string(variant.etag_offset, variant.etag_length);
+}
+
+std::string_view AssetPack::get_body(const PackedAssetEntry& entry, ContentCoding coding) const {
+    if (!has_variant(entry, coding)) {
+        return {};
+    }
+
+    const PackedAssetVariant& variant = entry.variants[static_cast<uint32_t>(coding)];
+
+    return std::string_view {reinterpret_cast<const char*>(this->mapping + variant.data_offset), static_cast<size_t>(variant.data_length)};
+}
+
+bool AssetPack::is_not_modified(const PackedAssetEntry& entry, ContentCoding coding, std::string_view if_none_match) const {
+    std::string_view etag = get_etag(entry, coding);
+
+    if (etag.empty()) {
+        return false;
+    }
+
+    // If-None-Match uses the weak comparison, so a W/ prefix on a candidate is ignored (RFC 7232 3.2).
+    while (!if_none_match.empty()) {
+        size_t comma_pos = if_none_match.find(',');
+        std::string_view candidate = if_none_match.substr(0, comma_pos);
+
+        if_none_match = (comma_pos == std::string_view::npos) ? std::string_view {} : if_none_match.substr(comma_pos + 1UL);
+
+        while (!candidate.empty() && (candidate.front() == ' ' || candidate.front() == '\t')) {
+            candidate.remove_prefix(1UL);
+        }
+
+        while (!candidate.empty() && (candidate.back() == ' ' || candidate.back() == '\t')) {
+            candidate.remove_suffix(1UL);
+        }
+
+        if (candidate == "*") {
+            return true;
+        }
+
+        if (candidate.substr(0, 2UL) == "W/") {
+            candidate.remove_prefix(2UL);
+        }
+
+        if (candidate == etag) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AssetPack::encode_not_modified(std::vector<uint8_t>& block, HpackEncoder& encoder, const PackedAssetEntry& entry, ContentCoding coding) const {
+    encoder.encode_field(block, ":status", "304");
+    encoder.encode_field(block, "etag", get_etag(entry, coding));
+
+    // A 304 repeats the Vary the 200 would carry (RFC 9110 15.4.5), so caches keep keying variants apart.
+    encode_coding_fields(block, encoder, ContentCoding::identity, entry.variant_mask);
+}
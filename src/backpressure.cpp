@@ -0,0 +1,215 @@
+/**
+ * @file backpressure.cpp
+ * @author Derek Tan
+ * @brief Implements per-connection and per-stream buffer accounting.
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include "server/backpressure.hpp"
+
+/* BufferLimits Impl. */
+
+BufferLimits::BufferLimits() {
+    this->conn_out_high = DEFAULT_CONN_OUT_HIGH;
+    this->conn_out_low = DEFAULT_CONN_OUT_LOW;
+    this->stream_out_high = DEFAULT_STREAM_OUT_HIGH;
+    this->stream_out_low = DEFAULT_STREAM_OUT_LOW;
+    this->conn_in_high = DEFAULT_CONN_IN_HIGH;
+    this->conn_in_low = DEFAULT_CONN_IN_LOW;
+}
+
+/* ConnectionBudget Private Impl. */
+
+ConnectionBudget::StreamBudget& ConnectionBudget::get_stream(uint32_t stream_id) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it != this->streams.end()) {
+        return stream_it->second;
+    }
+
+    if (this->spare_streams.empty()) {
+        return this->streams[stream_id];
+    }
+
+    StreamMap::node_type stream_node = std::move(this->spare_streams.back());
+
+    this->spare_streams.pop_back();
+    stream_node.key() = stream_id;
+    stream_node.mapped() = StreamBudget {};
+
+    return this->streams.insert(std::move(stream_node)).position->second;
+}
+
+void ConnectionBudget::check_resumes() {
+    if (this->is_queue_full && get_outbound(0U) <= this->limits.conn_out_low) {
+        this->is_queue_full = false;
+    }
+
+    if (this->paused_count == 0U) {
+        return;
+    }
+
+    for (auto& [stream_id, budget] : this->streams) {
+        if (!budget.paused_by_stream && !budget.paused_by_conn) {
+            continue;
+        }
+
+        // Each pause reason clears only at its own low mark, which keeps producers from flapping at the high mark.
+        if (budget.paused_by_stream && budget.outbound <= this->limits.stream_out_low) {
+            budget.paused_by_stream = false;
+        }
+
+        if (budget.paused_by_conn && this->outbound_total <= this->limits.conn_out_low) {
+            budget.paused_by_conn = false;
+        }
+
+        if (!budget.paused_by_stream && !budget.paused_by_conn) {
+            this->resumed_streams.push_back(stream_id);
+            this->paused_count--;
+        }
+    }
+}
+
+/* ConnectionBudget Public Impl. */
+
+ConnectionBudget::ConnectionBudget(const BufferLimits& buffer_limits) : streams {}, spare_streams {}, resumed_streams {}, limits {buffer_limits} {
+    this->outbound_total = 0UL;
+    this->inbound_total = 0UL;
+    this->outbound_peak = 0UL;
+    this->paused_count = 0U;
+    this->is_inbound_full = false;
+    this->is_queue_full = false;
+}
+
+size_t ConnectionBudget::get_outbound() const {
+    return this->outbound_total;
+}
+
+size_t ConnectionBudget::get_outbound(uint32_t stream_id) const {
+    auto stream_it = this->streams.find(stream_id);
+
+    return (stream_it != this->streams.end()) ? stream_it->second.outbound : 0UL;
+}
+
+size_t ConnectionBudget::get_inbound() const {
+    return this->inbound_total;
+}
+
+size_t ConnectionBudget::get_outbound_peak() const {
+    return this->outbound_peak;
+}
+
+bool ConnectionBudget::should_read() const {
+    return !this->is_inbound_full && !this->is_queue_full;
+}
+
+/**
+ * @brief Checks whether everything buffered outbound is at `conn_out_high`, so no new producer should be started.
+ */
+bool ConnectionBudget::is_outbound_full() const {
+    return this->outbound_total >= this->limits.conn_out_high;
+}
+
+size_t ConnectionBudget::reserve(uint32_t stream_id, size_t wanted) {
+    StreamBudget& budget = get_stream(stream_id);
+
+    if (budget.paused_by_stream || budget.paused_by_conn) {
+        return 0UL;
+    }
+
+    size_t stream_room = (budget.outbound < this->limits.stream_out_high) ? this->limits.stream_out_high - budget.outbound : 0UL;
+    size_t conn_room = (this->outbound_total < this->limits.conn_out_high) ? this->limits.conn_out_high - this->outbound_total : 0UL;
+    size_t granted = std::min({wanted, stream_room, conn_room});
+
+    budget.outbound += granted;
+    this->outbound_total += granted;
+    this->outbound_peak = std::max(this->outbound_peak, this->outbound_total);
+
+    // A short grant means a mark was hit: park the producer until the buffers drain.
+    if (granted < wanted) {
+        budget.paused_by_stream = granted == stream_room;
+        budget.paused_by_conn = granted == conn_room;
+        this->paused_count++;
+    }
+
+    return granted;
+}
+
+/**
+ * @brief Counts octets that are already buffered and cannot be refused. Producers on other streams see less room, and stream 0 over `conn_out_high` stops reading.
+ */
+void ConnectionBudget::charge(uint32_t stream_id, size_t octets) {
+    StreamBudget& budget = get_stream(stream_id);
+
+    budget.outbound += octets;
+    this->outbound_total += octets;
+    this->outbound_peak = std::max(this->outbound_peak, this->outbound_total);
+
+    if (stream_id == 0U && budget.outbound >= this->limits.conn_out_high) {
+        this->is_queue_full = true;
+    }
+}
+
+void ConnectionBudget::on_flushed(uint32_t stream_id, size_t octets) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end()) {
+        return;
+    }
+
+    size_t released = std::min(octets, stream_it->second.outbound);
+
+    stream_it->second.outbound -= released;
+    this->outbound_total -= released;
+    check_resumes();
+}
+
+void ConnectionBudget::on_inbound(size_t octets) {
+    this->inbound_total += octets;
+
+    if (this->inbound_total >= this->limits.conn_in_high) {
+        this->is_inbound_full = true;
+    }
+}
+
+void ConnectionBudget::on_consumed(size_t octets) {
+    this->inbound_total -= std::min(octets, this->inbound_total);
+
+    if (this->is_inbound_full && this->inbound_total <= this->limits.conn_in_low) {
+        this->is_inbound_full = false;
+    }
+}
+
+void ConnectionBudget::close_stream(uint32_t stream_id) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end()) {
+        return;
+    }
+
+    // Whatever the stream still had queued is dropped with it, freeing room for the others.
+    if (stream_it->second.paused_by_stream || stream_it->second.paused_by_conn) {
+        this->paused_count--;
+    }
+
+    this->outbound_total -= stream_it->second.outbound;
+
+    // Streams come and go with requests, so keep up to a connection's worth of nodes around.
+    if (this->spare_streams.size() < this->streams.size()) {
+        this->spare_streams.push_back(this->streams.extract(stream_it));
+    } else {
+        this->streams.erase(stream_it);
+    }
+
+    check_resumes();
+}
+
+uint32_t ConnectionBudget::collect_resumed(std::vector<uint32_t>& out) {
+    uint32_t resumed_count = static_cast<uint32_t>(this->resumed_streams.size());
+
+    out.insert(out.end(), this->resumed_streams.begin(), this->resumed_streams.end());
+    this->resumed_streams.clear();
+
+    return resumed_count;
+}
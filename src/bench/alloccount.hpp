@@ -0,0 +1,64 @@
+#ifndef ALLOCCOUNT_HPP
+#define ALLOCCOUNT_HPP
+
+/**
+ * @file alloccount.hpp
+ * @author Derek Tan
+ * @brief Replaces global `operator new` with a counting version for the benchmark counters in `benchkit.hpp`.
+ * @note Include from exactly one translation unit of a program, i.e. the `mains/bench_*.cpp` file itself. Never include from `src/`, since those objects are linked into every executable.
+ * @date 2026-10-19
+ */
+
+#include <cstdlib>
+#include <new>
+#include "bench/benchkit.hpp"
+
+void* operator new(size_t size) {
+    bench_alloc_count.fetch_add(1UL, std::memory_order_relaxed);
+    bench_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (void* block = std::malloc(size == 0UL ? 1UL : size)) {
+        return block;
+    }
+
+    throw std::bad_alloc {};
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    bench_alloc_count.fetch_add(1UL, std::memory_order_relaxed);
+    bench_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    return std::malloc(size == 0UL ? 1UL : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+// GCC sees through the replaced new to the malloc inside and flags the matching free below; the pairing is intentional here.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block, size_t) noexcept {
+    std::free(block);
+}
+
+#pragma GCC diagnostic pop
+
+#endif
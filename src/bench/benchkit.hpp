@@ -0,0 +1,111 @@
+#ifndef BENCHKIT_HPP
+#define BENCHKIT_HPP
+
+/**
+ * @file benchkit.hpp
+ * @author Derek Tan
+ * @brief Declares the small harness shared by the `mains/bench_*` microbenchmarks: timing, thread scaling, allocation counts and JSON output.
+ * @date 2026-10-19
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+constexpr uint64_t BENCH_DEFAULT_MIN_MS = 200UL;
+constexpr uint64_t BENCH_CALIBRATE_NS = 10000000UL; // calibration stops once a run takes 10 ms
+
+/// @brief Allocation counters. They stay zero unless the program includes `bench/alloccount.hpp`, which replaces global `operator new`.
+extern std::atomic<uint64_t> bench_alloc_count;
+extern std::atomic<uint64_t> bench_alloc_bytes;
+
+/**
+ * @brief Counts the allocations made while it is alive, by any thread.
+ * @note Useful in tests that assert a warmed-up path allocates nothing.
+ */
+class AllocScope {
+private:
+    uint64_t count_before;
+    uint64_t bytes_before;
+
+public:
+    AllocScope() : count_before {bench_alloc_count.load(std::memory_order_relaxed)}, bytes_before {bench_alloc_bytes.load(std::memory_order_relaxed)} {}
+
+    uint64_t get_count() const {
+        return bench_alloc_count.load(std::memory_order_relaxed) - this->count_before;
+    }
+
+    uint64_t get_bytes() const {
+        return bench_alloc_bytes.load(std::memory_order_relaxed) - this->bytes_before;
+    }
+};
+
+/// @brief Keeps the optimizer from discarding a benchmark result.
+template <typename T>
+inline void bench_keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Runs `iterations` operations and returns the payload octets processed, for bytes/sec.
+ */
+using BenchBody = std::function<uint64_t(uint64_t iterations)>;
+
+/**
+ * @brief Builds one `BenchBody` per thread, so each thread owns its codec state just like one event loop would.
+ */
+using BenchFactory = std::function<BenchBody()>;
+
+struct BenchOptions {
+    std::vector<uint32_t> thread_counts;   // one run per entry, e.g. 1,2,4 for a scaling curve
+    uint64_t min_time_ms;
+
+    BenchOptions();
+    bool parse(int argc, char** argv);
+};
+
+struct BenchResult {
+    std::string name;
+    uint32_t threads;
+    uint64_t ops;             // total over all threads
+    uint64_t bytes;
+    double ns_per_op;         // wall time per operation of one thread
+    double ops_per_sec;       // aggregate over all threads
+    double bytes_per_sec;
+    double allocs_per_op;
+    double alloc_bytes_per_op;
+};
+
+/// @brief An untimed size measurement, e.g. encoded octets over plain octets for one coding option.
+struct BenchRatio {
+    std::string name;
+    uint64_t input_bytes;
+    uint64_t output_bytes;
+};
+
+/**
+ * @brief Collects the cases of one benchmark program and prints them as one JSON document.
+ */
+class BenchSuite {
+private:
+    std::string suite_name;
+    BenchOptions options;
+    std::vector<BenchResult> results;
+    std::vector<BenchRatio> ratios;
+
+    uint64_t calibrate(const BenchFactory& factory) const;
+
+public:
+    BenchSuite(const char* name, const BenchOptions& bench_options);
+
+    void run(const char* case_name, const BenchFactory& factory);
+    void add_ratio(const char* ratio_name, uint64_t input_bytes, uint64_t output_bytes);
+    const std::vector<BenchResult>& get_results() const;
+    const std::vector<BenchRatio>& get_ratios() const;
+    void print_json(std::ostream& out) const;
+};
+
+#endif
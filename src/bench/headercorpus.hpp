@@ -0,0 +1,36 @@
+#ifndef HEADERCORPUS_HPP
+#define HEADERCORPUS_HPP
+
+/**
+ * @file headercorpus.hpp
+ * @author Derek Tan
+ * @brief Declares the bundled corpus of realistic browser request and server response header sets used by the benchmarks.
+ * @date 2026-10-19
+ */
+
+#include <cstddef>
+#include <string_view>
+
+struct CorpusField {
+    std::string_view name;
+    std::string_view value;
+};
+
+struct CorpusHeaderSet {
+    const char* label;
+    const CorpusField* fields;
+    size_t count;
+};
+
+/// @brief Requests in page-load order, as one browser connection would send them.
+extern const CorpusHeaderSet REQUEST_CORPUS[];
+extern const size_t REQUEST_CORPUS_COUNT;
+
+/// @brief Responses matching the requests, plus a few error and revalidation replies.
+extern const CorpusHeaderSet RESPONSE_CORPUS[];
+extern const size_t RESPONSE_CORPUS_COUNT;
+
+/// @brief Octets of names plus values, the payload counted for bytes/sec.
+size_t get_corpus_octets(const CorpusHeaderSet& header_set);
+
+#endif
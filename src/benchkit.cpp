@@ -0,0 +1,207 @@
+/**
+ * @file benchkit.cpp
+ * @author Derek Tan
+ * @brief Implements the microbenchmark harness.
+ * @date 2026-10-19
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "bench/benchkit.hpp"
+
+std::atomic<uint64_t> bench_alloc_count {0UL};
+std::atomic<uint64_t> bench_alloc_bytes {0UL};
+
+/* Helper Impl. */
+
+static uint64_t bench_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/* BenchOptions Impl. */
+
+BenchOptions::BenchOptions() : thread_counts {1U}, min_time_ms {BENCH_DEFAULT_MIN_MS} {}
+
+bool BenchOptions::parse(int argc, char** argv) {
+    for (int arg_i = 1; arg_i < argc; arg_i++) {
+        const char* arg = argv[arg_i];
+
+        if (std::strncmp(arg, "--threads=", 10) == 0) {
+            const char* cursor = arg + 10;
+
+            this->thread_counts.clear();
+
+            while (*cursor != '\0') {
+                char* number_end = nullptr;
+                unsigned long count = std::strtoul(cursor, &number_end, 10);
+
+                if (number_end == cursor || count == 0UL || count > 256UL) {
+                    return false;
+                }
+
+                this->thread_counts.push_back(static_cast<uint32_t>(count));
+                cursor = (*number_end == ',') ? number_end + 1 : number_end;
+
+                if (*number_end != ',' && *number_end != '\0') {
+                    return false;
+                }
+            }
+        } else if (std::strncmp(arg, "--min-ms=", 9) == 0) {
+            this->min_time_ms = std::strtoull(arg + 9, nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+
+    return !this->thread_counts.empty() && this->min_time_ms > 0UL;
+}
+
+/* BenchSuite Private Impl. */
+
+uint64_t BenchSuite::calibrate(const BenchFactory& factory) const {
+    BenchBody body = factory();
+    uint64_t iterations = 1UL;
+
+    // Double the count until one run is long enough to time reliably, then scale to the wanted run time.
+    while (true) {
+        uint64_t start_ns = bench_now_ns();
+        bench_keep(body(iterations));
+        uint64_t elapsed_ns = bench_now_ns() - start_ns;
+
+        if (elapsed_ns >= BENCH_CALIBRATE_NS || iterations >= (1UL << 40)) {
+            double per_op_ns = static_cast<double>(elapsed_ns) / static_cast<double>(iterations);
+            double wanted = static_cast<double>(this->options.min_time_ms) * 1e6 / ((per_op_ns > 0.0) ? per_op_ns : 1.0);
+
+            return (wanted < 1.0) ? 1UL : static_cast<uint64_t>(wanted);
+        }
+
+        iterations *= 2UL;
+    }
+}
+
+/* BenchSuite Public Impl. */
+
+BenchSuite::BenchSuite(const char* name, const BenchOptions& bench_options)
+: suite_name {name}, options {bench_options}, results {}, ratios {} {}
+
+void BenchSuite::run(const char* case_name, const BenchFactory& factory) {
+    const uint64_t iterations = calibrate(factory);
+
+    for (uint32_t thread_count : this->options.thread_counts) {
+        std::vector<BenchBody> bodies {};
+        std::vector<uint64_t> thread_bytes(thread_count, 0UL);
+        std::vector<std::thread> threads {};
+        std::atomic<uint32_t> ready_count {0U};
+        std::atomic<bool> start_flag {false};
+
+        for (uint32_t thread_i = 0U; thread_i < thread_count; thread_i++) {
+            bodies.push_back(factory());
+            // Warm caches and any lazily grown buffers before the timed run.
+            bench_keep(bodies.back()(iterations / 16UL + 1UL));
+        }
+
+        for (uint32_t thread_i = 0U; thread_i < thread_count; thread_i++) {
+            threads.emplace_back([&, thread_i]() {
+                ready_count.fetch_add(1U, std::memory_order_acq_rel);
+
+                while (!start_flag.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+
+                thread_bytes[thread_i] = bodies[thread_i](iterations);
+            });
+        }
+
+        while (ready_count.load(std::memory_order_acquire) < thread_count) {
+            std::this_thread::yield();
+        }
+
+        uint64_t alloc_count_before = bench_alloc_count.load(std::memory_order_relaxed);
+        uint64_t alloc_bytes_before = bench_alloc_bytes.load(std::memory_order_relaxed);
+        uint64_t start_ns = bench_now_ns();
+
+        start_flag.store(true, std::memory_order_release);
+
+        for (auto& worker : threads) {
+            worker.join();
+        }
+
+        uint64_t elapsed_ns = bench_now_ns() - start_ns;
+        uint64_t alloc_count = bench_alloc_count.load(std::memory_order_relaxed) - alloc_count_before;
+        uint64_t alloc_bytes = bench_alloc_bytes.load(std::memory_order_relaxed) - alloc_bytes_before;
+        uint64_t total_ops = iterations * thread_count;
+        uint64_t total_bytes = 0UL;
+
+        for (uint64_t bytes : thread_bytes) {
+            total_bytes += bytes;
+        }
+
+        double elapsed_sec = static_cast<double>(elapsed_ns) / 1e9;
+
+        this->results.push_back(BenchResult {
+            case_name,
+            thread_count,
+            total_ops,
+            total_bytes,
+            static_cast<double>(elapsed_ns) / static_cast<double>(iterations),
+            static_cast<double>(total_ops) / elapsed_sec,
+            static_cast<double>(total_bytes) / elapsed_sec,
+            static_cast<double>(alloc_count) / static_cast<double>(total_ops),
+            static_cast<double>(alloc_bytes) / static_cast<double>(total_ops)
+        });
+    }
+}
+
+void BenchSuite::add_ratio(const char* ratio_name, uint64_t input_bytes, uint64_t output_bytes) {
+    this->ratios.push_back(BenchRatio {ratio_name, input_bytes, output_bytes});
+}
+
+const std::vector<BenchResult>& BenchSuite::get_results() const {
+    return this->results;
+}
+
+const std::vector<BenchRatio>& BenchSuite::get_ratios() const {
+    return this->ratios;
+}
+
+void BenchSuite::print_json(std::ostream& out) const {
+    out << "{\"suite\":\"" << this->suite_name << "\",\"min_ms\":" << this->options.min_time_ms << ",\"results\":[";
+
+    for (size_t result_i = 0UL; result_i < this->results.size(); result_i++) {
+        const BenchResult& result = this->results[result_i];
+
+        out << ((result_i > 0UL) ? "," : "") << "\n  {\"name\":\"" << result.name
+            << "\",\"threads\":" << result.threads
+            << ",\"ops\":" << result.ops
+            << ",\"bytes\":" << result.bytes
+            << ",\"ns_per_op\":" << result.ns_per_op
+            << ",\"ops_per_sec\":" << result.ops_per_sec
+            << ",\"bytes_per_sec\":" << result.bytes_per_sec
+            << ",\"allocs_per_op\":" << result.allocs_per_op
+            << ",\"alloc_bytes_per_op\":" << result.alloc_bytes_per_op << "}";
+    }
+
+    out << "\n]";
+
+    // Suites without size measurements keep their original shape.
+    if (!this->ratios.empty()) {
+        out << ",\"ratios\":[";
+
+        for (size_t ratio_i = 0UL; ratio_i < this->ratios.size(); ratio_i++) {
+            const BenchRatio& ratio = this->ratios[ratio_i];
+            double value = (ratio.input_bytes > 0UL) ? static_cast<double>(ratio.output_bytes) / static_cast<double>(ratio.input_bytes) : 0.0;
+
+            out << ((ratio_i > 0UL) ? "," : "") << "\n  {\"name\":\"" << ratio.name
+                << "\",\"input_bytes\":" << ratio.input_bytes
+                << ",\"output_bytes\":" << ratio.output_bytes
+                << ",\"ratio\":" << value << "}";
+        }
+
+        out << "\n]";
+    }
+
+    out << "}" << std::endl;
+}
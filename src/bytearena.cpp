@@ -0,0 +1,118 @@
+/**
+ * @file bytearena.cpp
+ * @author Derek Tan
+ * @brief Implements the bump allocator for variable-length bytes.
+ * @date 2026-10-19
+ */
+
+#include <cstring>
+#include <new>
+#include "utils/bytearena.hpp"
+
+/* ByteArena Impl. */
+
+ByteArena::ByteArena() : chunks {} {
+    this->chunk_index = 0UL;
+    this->chunk_used = 0UL;
+    this->used_total = 0UL;
+}
+
+ByteArena::~ByteArena() {
+    for (auto& chunk : this->chunks) {
+        delete[] chunk.data;
+    }
+
+    this->chunks.clear();
+}
+
+uint8_t* ByteArena::allocate(size_t size) {
+    if (this->chunk_index < this->chunks.size() && this->chunks[this->chunk_index].capacity - this->chunk_used >= size) {
+        uint8_t* block = this->chunks[this->chunk_index].data + this->chunk_used;
+
+        this->chunk_used += size;
+        this->used_total += size;
+
+        return block;
+    }
+
+    // Move on to the next kept chunk when it is big enough, else splice in a new one after the current chunk.
+    size_t next_index = (this->chunks.empty()) ? 0UL : this->chunk_index + 1UL;
+
+    if (next_index >= this->chunks.size() || this->chunks[next_index].capacity < size) {
+        size_t capacity = (size > BYTE_ARENA_CHUNK_SIZE) ? size : BYTE_ARENA_CHUNK_SIZE;
+        uint8_t* data = new (std::nothrow) uint8_t[capacity];
+
+        if (!data) {
+            return nullptr;
+        }
+
+        this->chunks.insert(this->chunks.begin() + next_index, Chunk {data, capacity});
+    }
+
+    this->chunk_index = next_index;
+    this->chunk_used = size;
+    this->used_total += size;
+
+    return this->chunks[next_index].data;
+}
+
+std::string_view ByteArena::copy(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+
+    uint8_t* block = allocate(text.length());
+
+    if (!block) {
+        return {};
+    }
+
+    std::memcpy(block, text.data(), text.length());
+
+    return {reinterpret_cast<const char*>(block), text.length()};
+}
+
+std::string_view ByteArena::join(std::string_view head, std::string_view separator, std::string_view tail) {
+    const size_t extra = separator.length() + tail.length();
+    uint8_t* block = nullptr;
+
+    if (!head.empty() && this->chunk_index < this->chunks.size()) {
+        Chunk& chunk = this->chunks[this->chunk_index];
+        uint8_t* bump = chunk.data + this->chunk_used;
+
+        if (reinterpret_cast<const uint8_t*>(head.data()) + head.length() == bump && chunk.capacity - this->chunk_used >= extra) {
+            this->chunk_used += extra;
+            this->used_total += extra;
+            block = bump - head.length();
+        }
+    }
+
+    if (!block) {
+        block = allocate(head.length() + extra);
+
+        if (!block) {
+            return {};
+        }
+
+        std::memcpy(block, head.data(), head.length());
+    }
+
+    std::memcpy(block + head.length(), separator.data(), separator.length());
+    std::memcpy(block + head.length() + separator.length(), tail.data(), tail.length());
+
+    return {reinterpret_cast<const char*>(block), head.length() + extra};
+}
+
+void ByteArena::reset() {
+    this->chunk_index = 0UL;
+    this->chunk_used = 0UL;
+    this->used_total = 0UL;
+}
+
+size_t ByteArena::get_used() const {
+    return this->used_total;
+}
+
+uint32_t ByteArena::get_chunk_count() const {
+    return static_cast<uint32_t>(this->chunks.size());
+}
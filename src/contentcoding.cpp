@@ -0,0 +1,220 @@
+/**
+ * @file contentcoding.cpp
+ * @author Derek Tan
+ * @brief Implements `accept-encoding` parsing and content coding negotiation.
+ * @date 2026-10-19
+ */
+
+#include "server/contentcoding.hpp"
+
+constexpr std::string_view CODING_TOKENS[CONTENT_CODING_COUNT] = {"identity", "br", "gzip", "zstd"};
+constexpr std::string_view CODING_SUFFIXES[CONTENT_CODING_COUNT] = {"", ".br", ".gz", ".zst"};
+
+constexpr uint16_t QVALUE_IMPLICIT_IDENTITY = 1U;
+
+/// @brief Server preference among equal q-values: best compression first.
+constexpr ContentCoding CODING_PREFERENCE[CONTENT_CODING_COUNT] = {
+    ContentCoding::br, ContentCoding::zstd, ContentCoding::gzip, ContentCoding::identity
+};
+
+/* Helper Impl. */
+
+static std::string_view trim_spaces(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1UL);
+    }
+
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1UL);
+    }
+
+    return text;
+}
+
+static bool equals_ignore_case(std::string_view lhs, std::string_view rhs) {
+    if (lhs.length() != rhs.length()) {
+        return false;
+    }
+
+    for (size_t char_i = 0UL; char_i < lhs.length(); char_i++) {
+        char lhs_char = lhs[char_i];
+
+        if (lhs_char >= 'A' && lhs_char <= 'Z') {
+            lhs_char = static_cast<char>(lhs_char - 'A' + 'a');
+        }
+
+        if (lhs_char != rhs[char_i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Parses a qvalue: "0", "1", or up to three decimals. Returns -1 if malformed.
+static int32_t parse_qvalue(std::string_view text) {
+    if (text.empty() || (text[0] != '0' && text[0] != '1')) {
+        return -1;
+    }
+
+    int32_t whole = text[0] - '0';
+    int32_t thousandths = 0;
+    int32_t scale = 100;
+
+    if (text.length() > 1UL) {
+        if (text[1] != '.' || text.length() > 5UL) {
+            return -1;
+        }
+
+        for (size_t digit_i = 2UL; digit_i < text.length(); digit_i++) {
+            char digit = text[digit_i];
+
+            // "1.000" is the only legal spelling of one with decimals.
+            if (digit < '0' || digit > '9' || (whole == 1 && digit != '0')) {
+                return -1;
+            }
+
+            thousandths += (digit - '0') * scale;
+            scale /= 10;
+        }
+    }
+
+    return whole * QVALUE_MAX + thousandths;
+}
+
+std::string_view get_coding_token(ContentCoding coding) {
+    return CODING_TOKENS[static_cast<uint32_t>(coding)];
+}
+
+std::string_view get_coding_suffix(ContentCoding coding) {
+    return CODING_SUFFIXES[static_cast<uint32_t>(coding)];
+}
+
+/* AcceptEncoding Impl. */
+
+AcceptEncoding::AcceptEncoding() {
+    // Without the header only identity is assumed: sending compressed octets to a client that never asked is a bug we cannot take back.
+    for (auto& qvalue : this->qvalues) {
+        qvalue = 0U;
+    }
+
+    this->qvalues[static_cast<uint32_t>(ContentCoding::identity)] = QVALUE_MAX;
+}
+
+void AcceptEncoding::parse(std::string_view header_value) {
+    bool is_listed[CONTENT_CODING_COUNT] = {false, false, false, false};
+    int32_t wildcard_q = -1;
+
+    while (!header_value.empty()) {
+        size_t comma_pos = header_value.find(',');
+        std::string_view item = header_value.substr(0, comma_pos);
+
+        header_value = (comma_pos == std::string_view::npos) ? std::string_view {} : header_value.substr(comma_pos + 1UL);
+
+        size_t semicolon_pos = item.find(';');
+        std::string_view token = trim_spaces(item.substr(0, semicolon_pos));
+        int32_t qvalue = QVALUE_MAX;
+
+        if (token.empty()) {
+            continue;
+        }
+
+        if (semicolon_pos != std::string_view::npos) {
+            std::string_view param = trim_spaces(item.substr(semicolon_pos + 1UL));
+
+            if (param.length() < 2UL || (param[0] != 'q' && param[0] != 'Q') || param[1] != '=') {
+                continue;
+            }
+
+            qvalue = parse_qvalue(trim_spaces(param.substr(2UL)));
+
+            // A malformed weight drops just that item, not the whole header.
+            if (qvalue < 0) {
+                continue;
+            }
+        }
+
+        if (token == "*") {
+            wildcard_q = qvalue;
+            continue;
+        }
+
+        for (uint32_t coding_i = 0U; coding_i < CONTENT_CODING_COUNT; coding_i++) {
+            if (equals_ignore_case(token, CODING_TOKENS[coding_i]) || (coding_i == static_cast<uint32_t>(ContentCoding::gzip) && equals_ignore_case(token, "x-gzip"))) {
+                this->qvalues[coding_i] = static_cast<uint16_t>(qvalue);
+                is_listed[coding_i] = true;
+                break;
+            }
+        }
+    }
+
+    // "*" covers every coding not named explicitly, identity included (RFC 9110 12.5.3).
+    if (wildcard_q >= 0) {
+        for (uint32_t coding_i = 0U; coding_i < CONTENT_CODING_COUNT; coding_i++) {
+            if (!is_listed[coding_i]) {
+                this->qvalues[coding_i] = static_cast<uint16_t>(wildcard_q);
+            }
+        }
+    } else if (!is_listed[static_cast<uint32_t>(ContentCoding::identity)]) {
+        // Unnamed identity stays acceptable but must not outrank any coding the client did name.
+        this->qvalues[static_cast<uint32_t>(ContentCoding::identity)] = QVALUE_IMPLICIT_IDENTITY;
+    }
+}
+
+bool AcceptEncoding::is_acceptable(ContentCoding coding) const {
+    return this->qvalues[static_cast<uint32_t>(coding)] > 0U;
+}
+
+/* Negotiation Impl. */
+
+ContentCoding negotiate_coding(std::string_view accept_encoding, uint32_t available_mask) {
+    AcceptEncoding preferences {};
+    ContentCoding best = ContentCoding::identity;
+    uint16_t best_q = 0U;
+
+    // Fast path for resources with no precompressed variant.
+    if ((available_mask & ~1U) == 0U) {
+        return ContentCoding::identity;
+    }
+
+    preferences.parse(accept_encoding);
+
+    for (ContentCoding coding : CODING_PREFERENCE) {
+        uint16_t qvalue = preferences.qvalues[static_cast<uint32_t>(coding)];
+
+        if ((available_mask & (1U << static_cast<uint32_t>(coding))) == 0U) {
+            continue;
+        }
+
+        if (qvalue > best_q) {
+            best = coding;
+            best_q = qvalue;
+        }
+    }
+
+    return best;
+}
+
+void encode_coding_fields(std::vector<uint8_t>& block, HpackEncoder& encoder, ContentCoding coding, uint32_t available_mask) {
+    if (coding != ContentCoding::identity) {
+        encoder.encode_field(block, "content-encoding", get_coding_token(coding));
+    }
+
+    if ((available_mask & ~1U) != 0U) {
+        encoder.encode_field(block, "vary", "accept-encoding");
+    }
+}
+
+uint32_t put_coding_fields(HeaderField* out, ContentCoding coding, uint32_t available_mask) {
+    uint32_t field_count = 0U;
+
+    if (coding != ContentCoding::identity) {
+        out[field_count++] = {"content-encoding", get_coding_token(coding)};
+    }
+
+    if ((available_mask & ~1U) != 0U) {
+        out[field_count++] = {"vary", "accept-encoding"};
+    }
+
+    return field_count;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file corohandler.cpp
+ * @author Derek Tan
+ * @brief Implements awaitables for the C++20 coroutine handler API. Compiles to nothing in C++17 builds.
+ * @date 2026-10-19
+ */
+
+#include "server/corohandler.hpp"
+
+#if defined(H2PLUS_COROUTINES)
+
+/* HandlerTask Impl. */
+
+HandlerTask::HandlerTask(std::coroutine_handle<promise_type> coro_handle) : handle {coro_handle} {}
+
+HandlerTask::HandlerTask(std::nullptr_t) : handle {nullptr} {}
+
+HandlerTask::~HandlerTask() {
+    if (this->handle) {
+        this->handle.destroy();
+        this->handle = nullptr;
+    }
+}
+
+HandlerTask::HandlerTask(HandlerTask&& other) noexcept : handle {other.handle} {
+    other.handle = nullptr;
+}
+
+HandlerTask& HandlerTask::operator=(HandlerTask&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    if (this->handle) {
+        this->handle.destroy();
+    }
+
+    this->handle = other.handle;
+    other.handle = nullptr;
+
+    return *this;
+}
+
+bool HandlerTask::is_valid() const {
+    return static_cast<bool>(this->handle);
+}
+
+bool HandlerTask::done() const {
+    return !this->handle || this->handle.done();
+}
+
+/* BodyChannel Impl. */
+
+BodyChannel::BodyChannel() : waiter {nullptr} {
+    this->head = 0U;
+    this->count = 0U;
+    this->is_finished = false;
+}
+
+void BodyChannel::wake() {
+    std::coroutine_handle<> temp_waiter = this->waiter;
+
+    if (temp_waiter) {
+        this->waiter = nullptr;
+        temp_waiter.resume();
+    }
+}
+
+bool BodyChannel::is_full() const {
+    // The slot just before `head` still backs the chunk the handler is reading.
+    return this->count >= BODY_CHANNEL_SLOTS - 1U;
+}
+
+bool BodyChannel::push_chunk(const uint8_t* data, uint32_t length) {
+    if (this->is_finished) {
+        return false;
+    }
+
+    if (is_full()) {
+        std::vector<uint8_t>& newest = this->slots[(this->head + this->count - 1U) % BODY_CHANNEL_SLOTS];
+
+        newest.insert(newest.end(), data, data + length);
+    } else {
+        this->slots[(this->head + this->count) % BODY_CHANNEL_SLOTS].assign(data, data + length);
+        this->count++;
+    }
+
+    wake();
+
+    return true;
+}
+
+void BodyChannel::finish() {
+    this->is_finished = true;
+    wake();
+}
+
+BodyChannel::NextChunk BodyChannel::next_chunk() {
+    return NextChunk {*this};
+}
+
+BodyChannel::NextChunk::NextChunk(BodyChannel& source) : channel {source} {}
+
+bool BodyChannel::NextChunk::await_ready() const noexcept {
+    return this->channel.count > 0U || this->channel.is_finished;
+}
+
+void BodyChannel::NextChunk::await_suspend(std::coroutine_handle<> caller) noexcept {
+    this->channel.waiter = caller;
+}
+
+BodyChunk BodyChannel::NextChunk::await_resume() noexcept {
+    BodyChannel& source = this->channel;
+
+    if (source.count == 0U) {
+        return {nullptr, 0U, true};
+    }
+
+    const std::vector<uint8_t>& slot = source.slots[source.head];
+
+    source.head = (source.head + 1U) % BODY_CHANNEL_SLOTS;
+    source.count--;
+
+    return {slot.data(), static_cast<uint32_t>(slot.size()), source.is_finished && source.count == 0U};
+}
+
+/* FlowWindow Impl. */
+
+FlowWindow::FlowWindow(int64_t initial) : available {initial}, waiter {nullptr} {}
+
+int64_t FlowWindow::get_available() const {
+    return this->available;
+}
+
+void FlowWindow::grant(int64_t increment) {
+    this->available += increment;
+
+    if (this->available > 0 && this->waiter) {
+        std::coroutine_handle<> temp_waiter = this->waiter;
+        this->waiter = nullptr;
+        temp_waiter.resume();
+    }
+}
+
+FlowWindow::Reserve FlowWindow::reserve(uint32_t want) {
+    return Reserve {*this, want};
+}
+
+FlowWindow::Reserve::Reserve(FlowWindow& target, uint32_t want) : window {target}, wanted {want} {}
+
+bool FlowWindow::Reserve::await_ready() const noexcept {
+    return this->window.available > 0;
+}
+
+void FlowWindow::Reserve::await_suspend(std::coroutine_handle<> caller) noexcept {
+    this->window.waiter = caller;
+}
+
+uint32_t FlowWindow::Reserve::await_resume() noexcept {
+    int64_t taken = (this->window.available < static_cast<int64_t>(this->wanted))
+        ? this->window.available
+        : static_cast<int64_t>(this->wanted);
+
+    this->window.available -= taken;
+
+    return static_cast<uint32_t>(taken);
+}
+
+/* OffloadAwaiter Impl. */
+
+OffloadAwaiter::OffloadAwaiter(ThreadPool& target_pool, CompletionQueue& reply_queue, std::function<void()> job)
+: pool {&target_pool}, replies {&reply_queue}, offloader {nullptr}, work {std::move(job)}, submitted {false} {}
+
+OffloadAwaiter::OffloadAwaiter(const Offloader& target_offloader, std::function<void()> job)
+: pool {nullptr}, replies {nullptr}, offloader {&target_offloader}, work {std::move(job)}, submitted {false} {}
+
+bool OffloadAwaiter::await_ready() const noexcept {
+    return false;
+}
+
+bool OffloadAwaiter::await_suspend(std::coroutine_handle<> caller) {
+    if (this->offloader) {
+        const Offloader& target = *this->offloader;
+
+        /// @note An offloader may run everything inline and resume the caller before returning, which ends this awaiter, so it is not touched after the call.
+        this->submitted = true;
+        target(std::move(this->work), [caller]() {
+            caller.resume();
+        });
+
+        return true;
+    }
+
+    this->submitted = this->pool->submit(std::move(this->work), [caller]() {
+        caller.resume();
+    }, *this->replies);
+
+    /// @note A rejected submit must not suspend, or nothing would ever resume the handler.
+    return this->submitted;
+}
+
+bool OffloadAwaiter::await_resume() const noexcept {
+    return this->submitted;
+}
+
+/* CoroStream Impl. */
+
+CoroStream::CoroStream(int64_t initial_window, ThreadPool* offload_pool, CompletionQueue* reply_queue)
+: body {}, send_window {initial_window}, offloader {}, pool {offload_pool}, replies {reply_queue} {}
+
+CoroStream::CoroStream(int64_t initial_window, Offloader stream_offloader)
+: body {}, send_window {initial_window}, offloader {std::move(stream_offloader)}, pool {nullptr}, replies {nullptr} {}
+
+OffloadAwaiter CoroStream::offload(std::function<void()> job) {
+    if (this->offloader) {
+        return OffloadAwaiter {this->offloader, std::move(job)};
+    }
+
+    return OffloadAwaiter {*this->pool, *this->replies, std::move(job)};
+}
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file framearena.cpp
+ * @author Derek Tan
+ * @brief Implements the per-connection slab allocator for coroutine frames.
+ * @date 2026-10-19
+ */
+
+#include <new>
+#include "utils/framearena.hpp"
+
+/* FrameArena Private Impl. */
+
+uint32_t FrameArena::get_size_class(size_t size) {
+    uint32_t size_class = 0U;
+    size_t block_size = FRAME_ARENA_MIN_BLOCK;
+
+    while (block_size < size) {
+        block_size <<= 1;
+        size_class++;
+    }
+
+    return size_class;
+}
+
+/* FrameArena Public Impl. */
+
+FrameArena::FrameArena() {
+    for (uint32_t class_i = 0U; class_i < FRAME_ARENA_CLASS_COUNT; class_i++) {
+        this->free_lists[class_i] = nullptr;
+    }
+
+    this->newest_chunk = nullptr;
+    this->bump_cursor = nullptr;
+    this->bump_left = 0UL;
+    this->live_count = 0U;
+    this->fallback_count = 0U;
+    this->chunk_count = 0U;
+}
+
+FrameArena::~FrameArena() {
+    while (this->newest_chunk) {
+        uint8_t* older_chunk = *reinterpret_cast<uint8_t**>(this->newest_chunk);
+
+        delete[] this->newest_chunk;
+        this->newest_chunk = older_chunk;
+    }
+}
+
+void* FrameArena::allocate(size_t size) {
+    if (size > FRAME_ARENA_MAX_BLOCK) {
+        void* block = ::operator new(size, std::nothrow);
+
+        this->fallback_count += (block) ? 1U : 0U;
+
+        return block;
+    }
+
+    uint32_t size_class = get_size_class(size);
+    size_t block_size = FRAME_ARENA_MIN_BLOCK << size_class;
+    FreeBlock* recycled = this->free_lists[size_class];
+
+    if (recycled != nullptr) {
+        this->free_lists[size_class] = recycled->next;
+        this->live_count++;
+        return recycled;
+    }
+
+    if (this->bump_left < block_size) {
+        /// @note The leftover tail of the old chunk is abandoned; it is under one max block and only lost until the arena dies.
+        uint8_t* chunk = new (std::nothrow) uint8_t[FRAME_ARENA_CHUNK_SIZE];
+
+        if (!chunk) {
+            return nullptr;
+        }
+
+        // The first block links to the previous chunk, so tracking chunks never allocates (or throws) on its own.
+        *reinterpret_cast<uint8_t**>(chunk) = this->newest_chunk;
+        this->newest_chunk = chunk;
+        this->chunk_count++;
+        this->bump_cursor = chunk + FRAME_ARENA_MIN_BLOCK;
+        this->bump_left = FRAME_ARENA_CHUNK_SIZE - FRAME_ARENA_MIN_BLOCK;
+    }
+
+    void* block = this->bump_cursor;
+    this->bump_cursor += block_size;
+    this->bump_left -= block_size;
+    this->live_count++;
+
+    return block;
+}
+
+void FrameArena::deallocate(void* block, size_t size) {
+    if (!block) {
+        return;
+    }
+
+    if (size > FRAME_ARENA_MAX_BLOCK) {
+        this->fallback_count--;
+        ::operator delete(block, std::nothrow);
+        return;
+    }
+
+    uint32_t size_class = get_size_class(size);
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+
+    freed->next = this->free_lists[size_class];
+    this->free_lists[size_class] = freed;
+    this->live_count--;
+}
+
+uint32_t FrameArena::get_live_count() const {
+    return this->live_count;
+}
+
+uint32_t FrameArena::get_fallback_count() const {
+    return this->fallback_count;
+}
+
+uint32_t FrameArena::get_chunk_count() const {
+    return this->chunk_count;
+}
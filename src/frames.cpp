@@ -0,0 +1,46 @@
+/**
+ * @file frames.cpp
+ * @author Derek Tan
+ * @brief Implements HTTP/2 frame header packing helpers.
+ * @date 2026-10-19
+ */
+
+#include "http2/frames.hpp"
+
+/* Frame Header Helpers Impl. */
+
+void pack_frame_header(uint8_t* out, const FrameHeader& header) {
+    patch_frame_length(out, header.length);
+    out[3] = static_cast<uint8_t>(header.type);
+    out[4] = header.flags;
+    patch_frame_stream_id(out, header.stream_id);
+}
+
+bool unpack_frame_header(FrameHeader& header, const uint8_t* data, uint32_t data_length) {
+    if (data_length < FRAME_HEADER_SIZE) {
+        return false;
+    }
+
+    header.length = (static_cast<uint32_t>(data[0]) << 16) | (static_cast<uint32_t>(data[1]) << 8) | data[2];
+    header.type = static_cast<FrameType>(data[3]);
+    header.flags = data[4];
+    header.stream_id = ((static_cast<uint32_t>(data[5]) << 24) | (static_cast<uint32_t>(data[6]) << 16)
+        | (static_cast<uint32_t>(data[7]) << 8) | data[8]) & STREAM_ID_MASK;
+
+    return true;
+}
+
+void patch_frame_length(uint8_t* frame, uint32_t length) {
+    frame[0] = static_cast<uint8_t>((length >> 16) & 0xff);
+    frame[1] = static_cast<uint8_t>((length >> 8) & 0xff);
+    frame[2] = static_cast<uint8_t>(length & 0xff);
+}
+
+void patch_frame_stream_id(uint8_t* frame, uint32_t stream_id) {
+    uint32_t checked_id = stream_id & STREAM_ID_MASK;
+
+    frame[5] = static_cast<uint8_t>((checked_id >> 24) & 0xff);
+    frame[6] = static_cast<uint8_t>((checked_id >> 16) & 0xff);
+    frame[7] = static_cast<uint8_t>((checked_id >> 8) & 0xff);
+    frame[8] = static_cast<uint8_t>(checked_id & 0xff);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file freqsketch.cpp
+ * @author Derek Tan
+ * @brief Implements the count-min frequency sketch for HPACK indexing admission.
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include "hpack/freqsketch.hpp"
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325UL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3UL;
+
+/* Helper Impl. */
+
+uint64_t hash_header_field(std::string_view name, std::string_view value) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+
+    // Field names never hold NUL, so it separates name from value unambiguously.
+    hash *= FNV_PRIME;
+
+    for (char c : value) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+
+    // FNV-1a mixes its low bits poorly; the splitmix64 finalizer spreads them over all four row slices.
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9UL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebUL;
+
+    return hash ^ (hash >> 31);
+}
+
+/* FrequencySketch Private Impl. */
+
+uint32_t FrequencySketch::get_slot(uint64_t key, uint32_t row) const {
+    // Each row takes its own 16 bits of the key, which covers widths up to 65536.
+    return row * (this->width_mask + 1U) + (static_cast<uint32_t>(key >> (row * 16U)) & this->width_mask);
+}
+
+void FrequencySketch::age() {
+    for (uint8_t& counter : this->counters) {
+        counter >>= 1;
+    }
+
+    this->sample_count /= 2U;
+}
+
+/* FrequencySketch Public Impl. */
+
+FrequencySketch::FrequencySketch() : counters {} {
+    this->width_mask = 0U;
+    this->sample_count = 0U;
+    this->sample_limit = 0U;
+}
+
+void FrequencySketch::resize(uint32_t width) {
+    this->counters.assign(static_cast<size_t>(width) * SKETCH_ROWS, 0);
+    this->width_mask = (width > 0U) ? width - 1U : 0U;
+    this->sample_count = 0U;
+    this->sample_limit = width * SKETCH_SAMPLE_FACTOR;
+}
+
+void FrequencySketch::clear() {
+    std::fill(this->counters.begin(), this->counters.end(), 0);
+    this->sample_count = 0U;
+}
+
+uint32_t FrequencySketch::record(uint64_t key) {
+    if (this->counters.empty()) {
+        return 0U;
+    }
+
+    const uint32_t old_estimate = estimate(key);
+
+    // Conservative update: only the counters at the minimum grow, which keeps collisions from inflating the others.
+    if (old_estimate < SKETCH_COUNTER_MAX) {
+        for (uint32_t row = 0U; row < SKETCH_ROWS; row++) {
+            uint8_t& counter = this->counters[get_slot(key, row)];
+
+            if (counter == old_estimate) {
+                counter++;
+            }
+        }
+    }
+
+    if (++this->sample_count >= this->sample_limit) {
+        age();
+        return estimate(key);
+    }
+
+    return std::min(old_estimate + 1U, static_cast<uint32_t>(SKETCH_COUNTER_MAX));
+}
+
+uint32_t FrequencySketch::estimate(uint64_t key) const {
+    if (this->counters.empty()) {
+        return 0U;
+    }
+
+    uint32_t least = SKETCH_COUNTER_MAX;
+
+    for (uint32_t row = 0U; row < SKETCH_ROWS; row++) {
+        least = std::min(least, static_cast<uint32_t>(this->counters[get_slot(key, row)]));
+    }
+
+    return least;
+}
@@ -0,0 +1,452 @@
+/**
+ * @file h1parser.cpp
+ * @author Derek Tan
+ * @brief Implements connection type detection and the HTTP/1.1 request head parser.
+ * @date 2026-10-19
+ */
+
+#include <cstring>
+#include <string>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "http1/h1parser.hpp"
+
+/* Constants */
+
+constexpr size_t SIMD_BLOCK_SIZE = 16UL;
+constexpr uint32_t HTTP2_SETTINGS_MAX_OCTETS = 256U;
+
+/// @brief Status code to reason phrase pairs for HTTP/1.1 responses.
+struct ReasonPair {
+    uint32_t status_code;
+    const char* reason;
+};
+
+const ReasonPair REASON_PHRASES[] = {
+    {200U, "OK"},
+    {204U, "No Content"},
+    {206U, "Partial Content"},
+    {301U, "Moved Permanently"},
+    {302U, "Found"},
+    {304U, "Not Modified"},
+    {400U, "Bad Request"},
+    {403U, "Forbidden"},
+    {404U, "Not Found"},
+    {405U, "Method Not Allowed"},
+    {408U, "Request Timeout"},
+    {413U, "Content Too Large"},
+    {431U, "Request Header Fields Too Large"},
+    {500U, "Internal Server Error"},
+    {503U, "Service Unavailable"},
+    {505U, "HTTP Version Not Supported"}
+};
+
+/* Helper Impl. */
+
+/**
+ * @brief Finds the next LF. SSE2 compares 16 octets per step, since header sections are mostly long lines.
+ */
+static const uint8_t* find_line_feed(const uint8_t* cursor, const uint8_t* end) {
+#if defined(__SSE2__)
+    const __m128i line_feeds = _mm_set1_epi8('\n');
+
+    while (static_cast<size_t>(end - cursor) >= SIMD_BLOCK_SIZE) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+        int hit_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, line_feeds));
+
+        if (hit_mask != 0) {
+            return cursor + __builtin_ctz(static_cast<unsigned int>(hit_mask));
+        }
+
+        cursor += SIMD_BLOCK_SIZE;
+    }
+#endif
+
+    const void* hit = std::memchr(cursor, '\n', static_cast<size_t>(end - cursor));
+
+    return static_cast<const uint8_t*>(hit);
+}
+
+static bool is_token_char(uint8_t letter) {
+    // tchar from RFC 9110 5.6.2
+    if ((letter >= 'a' && letter <= 'z') || (letter >= 'A' && letter <= 'Z') || (letter >= '0' && letter <= '9')) {
+        return true;
+    }
+
+    return std::strchr("!#$%&'*+-.^_`|~", letter) != nullptr && letter != '\0';
+}
+
+static bool is_token(std::string_view text) {
+    if (text.empty()) {
+        return false;
+    }
+
+    for (char letter : text) {
+        if (!is_token_char(static_cast<uint8_t>(letter))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static char to_lower_ascii(char letter) {
+    return (letter >= 'A' && letter <= 'Z') ? static_cast<char>(letter + ('a' - 'A')) : letter;
+}
+
+static bool iequals(std::string_view lhs, std::string_view rhs) {
+    if (lhs.length() != rhs.length()) {
+        return false;
+    }
+
+    for (size_t letter_i = 0UL; letter_i < lhs.length(); letter_i++) {
+        if (to_lower_ascii(lhs[letter_i]) != to_lower_ascii(rhs[letter_i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static std::string_view trim_whitespace(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1UL);
+    }
+
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1UL);
+    }
+
+    return text;
+}
+
+/// @brief Checks a comma separated list header such as `Connection` for a token, ignoring case.
+static bool has_list_token(std::string_view list, std::string_view token) {
+    while (!list.empty()) {
+        size_t comma_pos = list.find(',');
+        std::string_view item = trim_whitespace(list.substr(0, comma_pos));
+
+        if (iequals(item, token)) {
+            return true;
+        }
+
+        list = (comma_pos == std::string_view::npos) ? std::string_view {} : list.substr(comma_pos + 1UL);
+    }
+
+    return false;
+}
+
+/// @brief Counts case-insensitive occurrences of a token in a comma separated list and reports its last non-empty item.
+static uint32_t count_list_tokens(std::string_view list, std::string_view token, std::string_view& last_item) {
+    uint32_t count = 0U;
+
+    while (!list.empty()) {
+        size_t comma_pos = list.find(',');
+        std::string_view item = trim_whitespace(list.substr(0, comma_pos));
+
+        if (!item.empty()) {
+            last_item = item;
+            count += (iequals(item, token)) ? 1U : 0U;
+        }
+
+        list = (comma_pos == std::string_view::npos) ? std::string_view {} : list.substr(comma_pos + 1UL);
+    }
+
+    return count;
+}
+
+static bool parse_content_length(std::string_view text, int64_t& result) {
+    if (text.empty() || text.length() > 18UL) {
+        return false;
+    }
+
+    int64_t value = 0;
+
+    for (char letter : text) {
+        if (letter < '0' || letter > '9') {
+            return false;
+        }
+
+        value = value * 10 + (letter - '0');
+    }
+
+    result = value;
+
+    return true;
+}
+
+static int8_t base64url_value(char letter) {
+    if (letter >= 'A' && letter <= 'Z') {
+        return static_cast<int8_t>(letter - 'A');
+    } else if (letter >= 'a' && letter <= 'z') {
+        return static_cast<int8_t>(letter - 'a' + 26);
+    } else if (letter >= '0' && letter <= '9') {
+        return static_cast<int8_t>(letter - '0' + 52);
+    } else if (letter == '-') {
+        return 62;
+    } else if (letter == '_') {
+        return 63;
+    }
+
+    return -1;
+}
+
+/* Detection Impl. */
+
+ConnectionKind detect_connection_kind(const uint8_t* data, size_t length) {
+    if (length == 0UL) {
+        return ConnectionKind::need_more;
+    }
+
+    size_t compare_length = (length < H2_PREFACE_LENGTH) ? length : H2_PREFACE_LENGTH;
+
+    if (std::memcmp(data, H2_CLIENT_PREFACE, compare_length) == 0) {
+        return (compare_length == H2_PREFACE_LENGTH) ? ConnectionKind::h2_prior_knowledge : ConnectionKind::need_more;
+    }
+
+    // Any request line starts with a method token.
+    return is_token_char(data[0]) ? ConnectionKind::http1 : ConnectionKind::invalid;
+}
+
+/* H1Request Impl. */
+
+std::string_view H1Request::find_field(std::string_view name) const {
+    for (uint32_t field_i = 0U; field_i < this->field_count; field_i++) {
+        if (iequals(this->fields[field_i].name, name)) {
+            return this->fields[field_i].value;
+        }
+    }
+
+    return {};
+}
+
+/* Parser Impl. */
+
+H1ParseStatus parse_h1_request(H1Request& request, const uint8_t* data, size_t length) {
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + ((length > H1_MAX_HEAD_SIZE) ? H1_MAX_HEAD_SIZE : length);
+    const uint8_t* line_end = find_line_feed(cursor, end);
+
+    request.field_count = 0U;
+    request.head_length = 0UL;
+    request.content_length = -1;
+    request.is_chunked = false;
+    request.keep_alive = false;
+    request.wants_h2c = false;
+    request.host = {};
+    request.http2_settings = {};
+
+    if (!line_end) {
+        return (length >= H1_MAX_HEAD_SIZE) ? H1ParseStatus::too_large : H1ParseStatus::incomplete;
+    }
+
+    // Request line: method SP request-target SP HTTP-version
+    std::string_view request_line {reinterpret_cast<const char*>(cursor), static_cast<size_t>(line_end - cursor)};
+
+    if (!request_line.empty() && request_line.back() == '\r') {
+        request_line.remove_suffix(1UL);
+    }
+
+    size_t first_space = request_line.find(' ');
+    size_t second_space = (first_space == std::string_view::npos) ? first_space : request_line.find(' ', first_space + 1UL);
+
+    if (second_space == std::string_view::npos) {
+        return H1ParseStatus::bad_request;
+    }
+
+    std::string_view version = request_line.substr(second_space + 1UL);
+
+    request.method = request_line.substr(0, first_space);
+    request.target = request_line.substr(first_space + 1UL, second_space - first_space - 1UL);
+
+    if (!is_token(request.method) || request.target.empty() || version.length() != 8UL
+        || version.substr(0, 7UL) != "HTTP/1." || (version[7] != '0' && version[7] != '1')) {
+        return H1ParseStatus::bad_request;
+    }
+
+    request.version_minor = static_cast<uint8_t>(version[7] - '0');
+    cursor = line_end + 1;
+
+    bool saw_close = false;
+    bool saw_keep_alive = false;
+    bool saw_upgrade_token = false;
+    bool saw_settings_token = false;
+    bool upgrade_to_h2c = false;
+    bool saw_transfer_coding = false;
+    uint32_t settings_field_count = 0U;
+    uint32_t chunked_count = 0U;
+    std::string_view final_coding {};
+
+    while (true) {
+        line_end = find_line_feed(cursor, end);
+
+        if (!line_end) {
+            return (length >= H1_MAX_HEAD_SIZE) ? H1ParseStatus::too_large : H1ParseStatus::incomplete;
+        }
+
+        std::string_view line {reinterpret_cast<const char*>(cursor), static_cast<size_t>(line_end - cursor)};
+        cursor = line_end + 1;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1UL);
+        }
+
+        if (line.empty()) {
+            break;
+        }
+
+        // Obsolete line folding is rejected, as RFC 9112 5.2 allows.
+        if (line.front() == ' ' || line.front() == '\t') {
+            return H1ParseStatus::bad_request;
+        }
+
+        size_t colon_pos = line.find(':');
+
+        if (colon_pos == std::string_view::npos || !is_token(line.substr(0, colon_pos))) {
+            return H1ParseStatus::bad_request;
+        }
+
+        if (request.field_count >= H1_MAX_FIELDS) {
+            return H1ParseStatus::too_large;
+        }
+
+        H1Field& field = request.fields[request.field_count++];
+        field.name = line.substr(0, colon_pos);
+        field.value = trim_whitespace(line.substr(colon_pos + 1UL));
+
+        if (iequals(field.name, "host")) {
+            request.host = field.value;
+        } else if (iequals(field.name, "content-length")) {
+            int64_t parsed_length = 0;
+
+            if (!parse_content_length(field.value, parsed_length)
+                || (request.content_length != -1 && request.content_length != parsed_length)) {
+                return H1ParseStatus::bad_request;
+            }
+
+            request.content_length = parsed_length;
+        } else if (iequals(field.name, "transfer-encoding")) {
+            // Repeated fields form one list in order (RFC 9110 5.3), so only the last coding across all of them counts.
+            chunked_count += count_list_tokens(field.value, "chunked", final_coding);
+            saw_transfer_coding = true;
+        } else if (iequals(field.name, "connection")) {
+            saw_close = saw_close || has_list_token(field.value, "close");
+            saw_keep_alive = saw_keep_alive || has_list_token(field.value, "keep-alive");
+            saw_upgrade_token = saw_upgrade_token || has_list_token(field.value, "upgrade");
+            saw_settings_token = saw_settings_token || has_list_token(field.value, "http2-settings");
+        } else if (iequals(field.name, "upgrade")) {
+            upgrade_to_h2c = has_list_token(field.value, "h2c");
+        } else if (iequals(field.name, "http2-settings")) {
+            request.http2_settings = field.value;
+            settings_field_count++;
+        }
+    }
+
+    // Any coding list without a single, final chunked leaves the body length unknown, and both framing headers at once
+    // is a request smuggling vector: RFC 9112 6.1 and 6.3 say to reject either.
+    if (saw_transfer_coding) {
+        if (request.content_length != -1 || chunked_count != 1U || !iequals(final_coding, "chunked")) {
+            return H1ParseStatus::bad_request;
+        }
+
+        request.is_chunked = true;
+    }
+
+    request.head_length = static_cast<size_t>(cursor - data);
+    request.keep_alive = (request.version_minor == 1U) ? !saw_close : saw_keep_alive;
+
+    /// @note Only body-less upgrades are honored, so the switch never has to carry an HTTP/1.1 body into stream 1.
+    request.wants_h2c = upgrade_to_h2c && saw_upgrade_token && saw_settings_token && settings_field_count == 1U
+        && request.version_minor == 1U && !request.is_chunked && request.content_length <= 0;
+
+    return H1ParseStatus::complete;
+}
+
+/* Upgrade Helpers Impl. */
+
+bool decode_base64url(std::string_view text, uint8_t* out, size_t out_capacity, size_t& out_length) {
+    uint32_t bit_buffer = 0U;
+    uint32_t bit_count = 0U;
+
+    out_length = 0UL;
+
+    // Some clients pad anyway, so trailing '=' are tolerated.
+    while (!text.empty() && text.back() == '=') {
+        text.remove_suffix(1UL);
+    }
+
+    for (char letter : text) {
+        int8_t sextet = base64url_value(letter);
+
+        if (sextet < 0) {
+            return false;
+        }
+
+        bit_buffer = (bit_buffer << 6) | static_cast<uint32_t>(sextet);
+        bit_count += 6U;
+
+        if (bit_count >= 8U) {
+            if (out_length >= out_capacity) {
+                return false;
+            }
+
+            bit_count -= 8U;
+            out[out_length++] = static_cast<uint8_t>((bit_buffer >> bit_count) & 0xff);
+        }
+    }
+
+    // A single leftover sextet cannot come from whole octets.
+    return bit_count < 6U;
+}
+
+H2Error decode_http2_settings(Http2Settings& settings, std::string_view header_value) {
+    uint8_t payload[HTTP2_SETTINGS_MAX_OCTETS] {};
+    size_t payload_length = 0UL;
+
+    if (!decode_base64url(trim_whitespace(header_value), payload, sizeof(payload), payload_length)) {
+        return H2Error::protocol_error;
+    }
+
+    return parse_settings_payload(settings, payload, static_cast<uint32_t>(payload_length));
+}
+
+void append_h1_response_head(std::vector<uint8_t>& out, uint32_t status_code, const H1Field* fields, uint32_t field_count, uint64_t content_length, bool keep_alive) {
+    const char* reason = "Unknown";
+
+    for (const auto& pair : REASON_PHRASES) {
+        if (pair.status_code == status_code) {
+            reason = pair.reason;
+            break;
+        }
+    }
+
+    auto put_text = [&out](std::string_view text) {
+        out.insert(out.end(), text.begin(), text.end());
+    };
+
+    std::string status_digits = std::to_string(status_code);
+    std::string length_digits = std::to_string(content_length);
+
+    put_text("HTTP/1.1 ");
+    put_text(status_digits);
+    put_text(" ");
+    put_text(reason);
+    put_text("\r\n");
+
+    for (uint32_t field_i = 0U; field_i < field_count; field_i++) {
+        put_text(fields[field_i].name);
+        put_text(": ");
+        put_text(fields[field_i].value);
+        put_text("\r\n");
+    }
+
+    // 1xx, 204 and 304 responses never have a body, so they carry no length (RFC 9110 8.6).
+    if (status_code >= 200U && status_code != 204U && status_code != 304U) {
+        put_text("content-length: ");
+        put_text(length_digits);
+        put_text("\r\n");
+    }
+
+    put_text((keep_alive) ? "\r\n" : "connection: close\r\n\r\n");
+}
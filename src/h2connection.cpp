@@ -0,0 +1,1737 @@
+/**
+ * @file h2connection.cpp
+ * @author Derek Tan
+ * @brief Implements the sans-I/O HTTP/2 server connection.
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "server/h2connection.hpp"
+#include "utils/metrics.hpp"
+#include "utils/stagetimes.hpp"
+#include "utils/tracer.hpp"
+
+constexpr uint32_t PRIORITY_PAYLOAD_SIZE = 5U;
+constexpr uint32_t PING_PAYLOAD_SIZE = 8U;
+constexpr uint32_t U32_PAYLOAD_SIZE = 4U;
+constexpr uint32_t GOAWAY_PAYLOAD_SIZE = 8U;
+
+static constexpr uint8_t BDP_PING_PAYLOAD[PING_PAYLOAD_SIZE] = {'h', '2', 'p', 'l', 'u', 's', 'b', 'w'};
+
+static std::atomic<uint32_t> next_trace_id {1U};
+
+/// @brief HTTP/1.1 fields about the connection rather than the request, which a `HeaderList` never holds (RFC 7540 8.1.2.2). `host` becomes `:authority`.
+constexpr std::string_view H1_CONNECTION_FIELDS[] = {"connection", "keep-alive", "proxy-connection", "transfer-encoding", "upgrade", "http2-settings", "host"};
+constexpr std::string_view H1_CONTINUE = "HTTP/1.1 100 Continue\r\n\r\n";
+
+static uint32_t read_u32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+        | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+static void append_u32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/// @brief Reads the urgency of an RFC 9218 `priority` field, e.g. `u=1, i`. Anything unreadable keeps the default.
+static uint8_t parse_urgency(const HeaderField* priority) {
+    if (!priority) {
+        return H2_DEFAULT_URGENCY;
+    }
+
+    std::string_view text = priority->value;
+    size_t item_start = 0UL;
+
+    while (item_start < text.length()) {
+        item_start = text.find_first_not_of(' ', item_start);
+
+        if (item_start == std::string_view::npos) {
+            break;
+        }
+
+        if (text.length() - item_start >= 3UL && text[item_start] == 'u' && text[item_start + 1UL] == '='
+            && text[item_start + 2UL] >= '0' && text[item_start + 2UL] <= '7') {
+            return static_cast<uint8_t>(text[item_start + 2UL] - '0');
+        }
+
+        item_start = text.find(',', item_start);
+        item_start = (item_start == std::string_view::npos) ? text.length() : item_start + 1UL;
+    }
+
+    return H2_DEFAULT_URGENCY;
+}
+
+#if defined(H2PLUS_COROUTINES)
+/* Http2Connection::CoroSlot Impl. */
+
+Http2Connection::CoroSlot::CoroSlot(int64_t initial_window, Offloader stream_offloader)
+: stream {initial_window, std::move(stream_offloader)}, task {nullptr} {}
+#endif
+
+/* Http2Connection Output Impl. */
+
+void Http2Connection::put_frame_header(uint32_t length, FrameType type, uint8_t flags, uint32_t stream_id) {
+    uint8_t raw_header[FRAME_HEADER_SIZE];
+
+    pack_frame_header(raw_header, FrameHeader {length, type, flags, stream_id});
+    this->out.insert(this->out.end(), raw_header, raw_header + FRAME_HEADER_SIZE);
+    metrics_count_frame(static_cast<uint8_t>(type), true);
+}
+
+void Http2Connection::put_frame(FrameType type, uint8_t flags, uint32_t stream_id, const uint8_t* payload, uint32_t length) {
+    put_frame_header(length, type, flags, stream_id);
+
+    if (length > 0U) {
+        this->out.insert(this->out.end(), payload, payload + length);
+    }
+}
+
+void Http2Connection::put_u32_frame(FrameType type, uint32_t stream_id, uint32_t value) {
+    put_frame_header(U32_PAYLOAD_SIZE, type, 0, stream_id);
+    append_u32(this->out, value);
+}
+
+/// @brief Counts newly queued output against the write queue's budget. Called wherever parsing or a public call may have queued frames.
+void Http2Connection::charge_output() {
+    const size_t unsent = get_output_size();
+
+    if (unsent > this->out_charged) {
+        this->budget.charge(0U, unsent - this->out_charged);
+        this->out_charged = unsent;
+    }
+}
+
+void Http2Connection::begin_header_block(bool end_stream) {
+    // Reserve the HEADERS frame header; the encoder writes the block right behind it and the length is patched in later.
+    this->block_frame_start = this->out.size();
+    this->block_frame_type = FrameType::headers;
+    this->block_frame_flags = (end_stream) ? FLAG_END_STREAM : 0;
+    this->out.resize(this->out.size() + FRAME_HEADER_SIZE);
+}
+
+void Http2Connection::seal_header_frame(uint32_t stream_id, uint32_t length, bool is_last) {
+    const uint8_t flags = static_cast<uint8_t>(this->block_frame_flags | ((is_last) ? FLAG_END_HEADERS : 0));
+
+    pack_frame_header(this->out.data() + this->block_frame_start, FrameHeader {length, this->block_frame_type, flags, stream_id});
+    metrics_count_frame(static_cast<uint8_t>(this->block_frame_type), true);
+}
+
+void Http2Connection::roll_header_block(uint32_t stream_id) {
+    const size_t max_frame = this->peer_settings.max_frame_size;
+
+    // HEADERS carries the first fragment and END_STREAM, CONTINUATION frames carry the rest (RFC 7540 6.10).
+    while (this->out.size() - this->block_frame_start - FRAME_HEADER_SIZE > max_frame) {
+        const size_t split_at = this->block_frame_start + FRAME_HEADER_SIZE + max_frame;
+
+        seal_header_frame(stream_id, static_cast<uint32_t>(max_frame), false);
+
+        /// @note Called after every field, so the octets shifted here are only the tail of the field that crossed the boundary.
+        this->out.insert(this->out.begin() + static_cast<std::ptrdiff_t>(split_at), FRAME_HEADER_SIZE, 0);
+        this->block_frame_start = split_at;
+        this->block_frame_type = FrameType::continuation;
+        this->block_frame_flags = 0;
+    }
+}
+
+void Http2Connection::end_header_block(uint32_t stream_id) {
+    roll_header_block(stream_id);
+    seal_header_frame(stream_id, static_cast<uint32_t>(this->out.size() - this->block_frame_start - FRAME_HEADER_SIZE), true);
+}
+
+void Http2Connection::put_local_settings() {
+    std::vector<uint8_t> payload {};
+    const std::pair<SettingsId, uint32_t> entries[] = {
+        {SettingsId::enable_push, 0U},
+        {SettingsId::max_concurrent_streams, this->local_settings.max_concurrent_streams},
+        {SettingsId::max_header_list_size, this->local_settings.max_header_list_size}
+    };
+
+    for (const auto& [id, value] : entries) {
+        payload.push_back(static_cast<uint8_t>(static_cast<uint16_t>(id) >> 8));
+        payload.push_back(static_cast<uint8_t>(id));
+        append_u32(payload, value);
+    }
+
+    put_frame(FrameType::settings, 0, 0U, payload.data(), static_cast<uint32_t>(payload.size()));
+    this->unacked_settings++;
+}
+
+void Http2Connection::credit_connection(uint32_t octets) {
+    // HTTP/1.1 has no windows to give octets back to.
+    if (this->is_http1) {
+        return;
+    }
+
+    this->conn_recv_consumed += octets;
+
+    if (this->bdp_ping_ticks != 0UL) {
+        this->bdp_sample += octets;
+    }
+
+    if (this->conn_recv_consumed >= this->conn_recv_target / 2U) {
+        put_u32_frame(FrameType::window_update, 0U, this->conn_recv_consumed);
+        this->conn_recv_window += this->conn_recv_consumed;
+        this->conn_recv_consumed = 0U;
+    }
+}
+
+void Http2Connection::credit_stream(uint32_t stream_id, Http2Stream& stream, uint32_t octets) {
+    credit_connection(octets);
+
+    // The client sends nothing more on a stream it ended, so its window can stay shut.
+    if (stream.is_remote_closed || this->is_http1) {
+        return;
+    }
+
+    stream.recv_consumed += octets;
+
+    if (stream.recv_consumed >= this->local_settings.initial_window_size / 2U) {
+        put_u32_frame(FrameType::window_update, stream_id, stream.recv_consumed);
+        stream.recv_window += stream.recv_consumed;
+        stream.recv_consumed = 0U;
+    }
+}
+
+void Http2Connection::end_bdp_sample() {
+    const uint64_t rtt_ticks = std::max(stage_clock_ticks() - this->bdp_ping_ticks, 1UL);
+
+    this->bdp_ping_ticks = 0UL;
+
+    if (this->min_rtt_ticks == 0UL || rtt_ticks < this->min_rtt_ticks) {
+        this->min_rtt_ticks = rtt_ticks;
+    }
+
+    const double drain_rate = static_cast<double>(this->bdp_sample) / static_cast<double>(rtt_ticks);
+    const double window_rate = static_cast<double>(this->conn_recv_target) / static_cast<double>(this->min_rtt_ticks);
+
+    // Updates go out per half window, so a window-limited peer drains at least half the window per round trip; 3/8 leaves room for jitter. A slow handler drains less, and a window beyond what the path carries only queues, which stretches the round trip instead.
+    if (drain_rate * 8.0 >= window_rate * 3.0) {
+        grow_recv_windows(static_cast<uint32_t>(std::min(static_cast<uint64_t>(this->conn_recv_target) * 2UL, static_cast<uint64_t>(this->recv_window_limit))));
+    }
+}
+
+void Http2Connection::grow_recv_windows(uint32_t window_size) {
+    if (window_size <= this->conn_recv_target) {
+        return;
+    }
+
+    const uint32_t delta = window_size - this->conn_recv_target;
+
+    put_u32_frame(FrameType::window_update, 0U, delta);
+    this->conn_recv_window += delta;
+    this->conn_recv_target = window_size;
+
+    // The peer applies a new initial window to its open streams as well (RFC 7540 6.9.2). Counting it here already only makes us more lenient.
+    put_frame_header(SETTINGS_ENTRY_SIZE, FrameType::settings, 0, 0U);
+    this->out.push_back(static_cast<uint8_t>(static_cast<uint16_t>(SettingsId::initial_window_size) >> 8));
+    this->out.push_back(static_cast<uint8_t>(SettingsId::initial_window_size));
+    append_u32(this->out, window_size);
+    this->unacked_settings++;
+
+    for (auto& [stream_id, stream] : this->streams) {
+        (void)stream_id;
+        stream.recv_window += window_size - this->local_settings.initial_window_size;
+    }
+
+    this->local_settings.initial_window_size = window_size;
+    metrics_add(Metric::recv_window_grows);
+}
+
+void Http2Connection::send_goaway(H2Error error) {
+    if (this->phase == Phase::closing) {
+        return;
+    }
+
+    put_frame_header(GOAWAY_PAYLOAD_SIZE, FrameType::goaway, 0, 0U);
+    append_u32(this->out, this->last_stream_id);
+    append_u32(this->out, static_cast<uint32_t>(error));
+
+    this->phase = Phase::closing;
+}
+
+Http2Stream& Http2Connection::open_stream(uint32_t stream_id) {
+    if (this->spare_streams.empty()) {
+        return this->streams[stream_id];
+    }
+
+    StreamMap::node_type stream_node = std::move(this->spare_streams.back());
+
+    this->spare_streams.pop_back();
+    stream_node.key() = stream_id;
+
+    return this->streams.insert(std::move(stream_node)).position->second;
+}
+
+/// @brief Opens a stream for the request now in `request_fields`.
+Http2Stream& Http2Connection::start_stream(uint32_t stream_id, bool end_stream) {
+    Http2Stream& stream = open_stream(stream_id);
+
+    stream.pending_offset = 0UL;
+    stream.send_window = this->peer_settings.initial_window_size;
+    stream.recv_window = this->local_settings.initial_window_size;
+    stream.recv_consumed = 0U;
+    stream.recv_unconsumed = 0U;
+    stream.is_reading_body = false;
+    stream.is_coroutine = false;
+    stream.is_remote_closed = end_stream;
+    stream.is_local_closed = false;
+    stream.has_pending_end = false;
+    stream.is_head = this->request_fields.get_method() == "HEAD";
+    stream.urgency = parse_urgency(this->request_fields.find_field("priority"));
+
+    metrics_add(Metric::streams_opened);
+    metrics_add(Metric::streams_active);
+    trace_event(TraceEvent::stream_opened, this->trace_id, stream_id);
+
+    return stream;
+}
+
+void Http2Connection::dispatch_request(uint32_t stream_id, Http2Stream& stream) {
+    StageProbe handler_probe {Stage::handler};
+
+#if defined(H2PLUS_COROUTINES)
+    if (this->coro_handler) {
+        start_coroutine(stream_id, stream);
+        return;
+    }
+#else
+    (void)stream;
+#endif
+
+    this->handler(*this, stream_id, this->request_fields);
+}
+
+void Http2Connection::close_stream(uint32_t stream_id) {
+    StreamMap::node_type stream_node = this->streams.extract(stream_id);
+
+    if (stream_node.empty()) {
+        return;
+    }
+
+    metrics_sub(Metric::streams_active);
+    this->budget.close_stream(stream_id);
+
+#if defined(H2PLUS_COROUTINES)
+    if (stream_node.mapped().is_coroutine) {
+        auto slot_it = this->coro_slots.find(stream_id);
+
+        if (slot_it != this->coro_slots.end()) {
+            this->retired_coros.push_back(std::move(slot_it->second));
+            this->coro_slots.erase(slot_it);
+            reap_coroutines();
+        }
+    }
+#endif
+
+    // A file whose frame is half written keeps going until that frame is complete.
+    if (stream_node.mapped().file_body && stream_id == this->file_frame_stream_id) {
+        this->orphan_file = std::move(stream_node.mapped().file_body);
+    }
+
+    stream_node.mapped().file_body.reset();
+
+    // Body the handler never gave back still holds the connection window.
+    credit_connection(stream_node.mapped().recv_unconsumed);
+    this->budget.on_consumed(stream_node.mapped().recv_unconsumed);
+    stream_node.mapped().recv_unconsumed = 0U;
+
+    if (this->spare_streams.size() >= this->local_settings.max_concurrent_streams) {
+        return;
+    }
+
+    std::string& pending_body = stream_node.mapped().pending_body;
+
+    if (pending_body.capacity() > H2_SPARE_BODY_LIMIT) {
+        std::string {}.swap(pending_body);
+    }
+
+    this->spare_streams.push_back(std::move(stream_node));
+}
+
+void Http2Connection::end_local_side(uint32_t stream_id) {
+    if (this->is_http1) {
+        finish_h1_response(stream_id);
+        return;
+    }
+
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end()) {
+        return;
+    }
+
+    /// @note The response is complete while the client may still be uploading. Unless the handler reads the body, stop the upload with NO_ERROR (RFC 7540 8.1).
+    if (!stream_it->second.is_remote_closed) {
+        if (has_body_reader(stream_it->second)) {
+            return;
+        }
+
+        put_u32_frame(FrameType::rst_stream, stream_id, static_cast<uint32_t>(H2Error::no_error));
+    }
+
+    close_stream(stream_id);
+}
+
+bool Http2Connection::has_body_reader(const Http2Stream& stream) const {
+    return stream.is_reading_body && (stream.is_coroutine || this->body_handler);
+}
+
+void Http2Connection::deliver_body(uint32_t stream_id, std::string_view data, bool is_last) {
+#if defined(H2PLUS_COROUTINES)
+    auto slot_it = this->coro_slots.find(stream_id);
+
+    if (slot_it != this->coro_slots.end()) {
+        BodyChannel& body = slot_it->second->stream.body;
+
+        // A handler waiting on the channel runs from here until it next suspends.
+        this->coro_depth++;
+
+        if (!data.empty()) {
+            body.push_chunk(reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.length()));
+        }
+
+        if (is_last) {
+            body.finish();
+        }
+
+        this->coro_depth--;
+        reap_coroutines();
+        return;
+    }
+#endif
+
+    this->body_handler(*this, stream_id, data, is_last);
+}
+
+#if defined(H2PLUS_COROUTINES)
+void Http2Connection::start_coroutine(uint32_t stream_id, Http2Stream& stream) {
+    auto slot = std::make_unique<CoroSlot>(stream.send_window, [this, stream_id](std::function<void()> work, std::function<void()> resume) {
+        offload(std::move(work), [this, stream_id, resume = std::move(resume)]() {
+            resume_coroutine(stream_id, resume);
+        });
+    });
+    CoroSlot& started = *slot;
+
+    stream.is_coroutine = true;
+    stream.is_reading_body = !stream.is_remote_closed;
+
+    if (stream.is_remote_closed) {
+        started.stream.body.finish();
+    }
+
+    // In the map before the handler runs, so a stream it closes at once retires the slot like any other.
+    this->coro_slots.emplace(stream_id, std::move(slot));
+    this->coro_depth++;
+    started.task = this->coro_handler(this->coro_arena, started.stream, *this, stream_id, this->request_fields);
+    this->coro_depth--;
+
+    // The arena could not fit the frame, so the handler never ran.
+    if (!started.task.is_valid()) {
+        reset_stream(stream_id, H2Error::internal_error);
+    }
+
+    reap_coroutines();
+}
+
+void Http2Connection::resume_coroutine(uint32_t stream_id, const std::function<void()>& resume) {
+    // Stream IDs are never reused, so a missing slot means the stream closed while the work ran.
+    if (this->coro_slots.count(stream_id) == 0UL) {
+        return;
+    }
+
+    this->coro_depth++;
+    resume();
+    this->coro_depth--;
+    reap_coroutines();
+}
+
+void Http2Connection::reap_coroutines() {
+    // Destroying a handler that is on the stack would pull its frame out from under it.
+    if (this->coro_depth == 0U) {
+        this->retired_coros.clear();
+    }
+}
+#endif
+
+size_t Http2Connection::put_data_frames(uint32_t stream_id, Http2Stream& stream, std::string_view data, bool is_final, size_t max_octets) {
+    const uint32_t max_frame = this->peer_settings.max_frame_size;
+    size_t sent = 0UL;
+
+    // END_STREAM only rides on a frame that really reaches the end of the data.
+    is_final = is_final && data.length() <= max_octets;
+    data = data.substr(0UL, max_octets);
+
+    while (sent < data.length()) {
+        int64_t window = std::min(stream.send_window, this->conn_send_window);
+
+        if (window <= 0) {
+            break;
+        }
+
+        size_t data_left = data.length() - sent;
+        uint32_t chunk = static_cast<uint32_t>(std::min({data_left, static_cast<size_t>(window), static_cast<size_t>(max_frame)}));
+        bool is_last = chunk == data_left;
+
+        put_frame(FrameType::data, (is_last && is_final) ? FLAG_END_STREAM : 0, stream_id, reinterpret_cast<const uint8_t*>(data.data()) + sent, chunk);
+
+        sent += chunk;
+        stream.send_window -= chunk;
+        this->conn_send_window -= chunk;
+    }
+
+    return sent;
+}
+
+void Http2Connection::flush_stream(uint32_t stream_id, Http2Stream& stream, size_t max_octets) {
+    std::string_view pending {stream.pending_body};
+    const size_t framed = put_data_frames(stream_id, stream, pending.substr(stream.pending_offset), stream.has_pending_end, max_octets);
+
+    // Framed octets move from the stream's pending body to the write queue, where `charge_output` counts them.
+    stream.pending_offset += framed;
+    this->budget.on_flushed(stream_id, framed);
+
+    if (stream.pending_offset < stream.pending_body.size()) {
+        return;
+    }
+
+    stream.pending_body.clear();
+    stream.pending_offset = 0UL;
+
+    if (stream.has_pending_end) {
+        stream.has_pending_end = false;
+        end_local_side(stream_id);
+    }
+}
+
+/* Http2Connection Input Impl. */
+
+bool Http2Connection::on_preface() {
+    ConnectionKind kind = detect_connection_kind(this->in.data(), this->in.size());
+
+    if (kind == ConnectionKind::need_more) {
+        return true;
+    }
+
+    // After an accepted Upgrade only the preface may come (RFC 7540 3.5).
+    if (kind == ConnectionKind::http1 && !this->is_upgraded) {
+        this->phase = Phase::http1;
+        this->is_http1 = true;
+
+        return on_h1_input();
+    }
+
+    if (kind != ConnectionKind::h2_prior_knowledge) {
+        this->in.clear();
+        this->phase = Phase::closing;
+        return false;
+    }
+
+    this->in.erase(this->in.begin(), this->in.begin() + H2_PREFACE_LENGTH);
+    this->phase = Phase::settings;
+
+    if (!this->is_upgraded) {
+        put_local_settings();
+        return true;
+    }
+
+    // The upgraded request is answered only now, so that no more than our SETTINGS trails the 101 in the client's first read.
+    auto stream_it = this->streams.find(1U);
+
+    if (stream_it != this->streams.end()) {
+        dispatch_request(1U, stream_it->second);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads HTTP/1.1 requests one at a time. A pipelined request waits in `in` until the response before it is finished, so responses leave in request order.
+ * @returns False once the connection is closing.
+ */
+bool Http2Connection::on_h1_input() {
+    this->is_parsing_h1 = true;
+
+    while (this->phase == Phase::http1 && !this->in.empty() && should_read()) {
+        if (this->h1_body_left > 0UL) {
+            on_h1_body();
+            continue;
+        }
+
+        if (this->h1_stream_id != 0U) {
+            break;
+        }
+
+        H1Request request {};
+        const H1ParseStatus status = parse_h1_request(request, this->in.data(), this->in.size());
+
+        if (status == H1ParseStatus::incomplete) {
+            break;
+        }
+
+        if (status != H1ParseStatus::complete) {
+            refuse_h1((status == H1ParseStatus::too_large) ? 431U : 400U);
+            break;
+        }
+
+        if (!on_h1_request(request)) {
+            break;
+        }
+    }
+
+    this->is_parsing_h1 = false;
+
+    // An accepted Upgrade leaves the client preface, and maybe frames after it, in `in`.
+    if (this->phase == Phase::preface) {
+        return on_preface();
+    }
+
+    return this->phase != Phase::closing;
+}
+
+/// @brief Passes body octets at the front of `in` to the latest request's reader, or drops them. Either way they are taken off, so the next request head lines up.
+void Http2Connection::on_h1_body() {
+    const size_t taken = static_cast<size_t>(std::min<uint64_t>(this->in.size(), this->h1_body_left));
+    const uint32_t stream_id = this->last_stream_id;
+    auto stream_it = this->streams.find(stream_id);
+
+    this->h1_body_left -= taken;
+
+    if (stream_it != this->streams.end()) {
+        Http2Stream& stream = stream_it->second;
+
+        stream.is_remote_closed = this->h1_body_left == 0UL;
+
+        if (has_body_reader(stream)) {
+            stream.recv_unconsumed += static_cast<uint32_t>(taken);
+            this->budget.on_inbound(taken);
+            deliver_body(stream_id, std::string_view {reinterpret_cast<const char*>(this->in.data()), taken}, this->h1_body_left == 0UL);
+            stream_it = this->streams.find(stream_id);
+        }
+
+        // A response that only waited for the upload to end.
+        if (stream_it != this->streams.end() && stream_it->second.is_remote_closed && stream_it->second.is_local_closed && !stream_it->second.has_pending_end) {
+            close_stream(stream_id);
+        }
+    }
+
+    this->in.erase(this->in.begin(), this->in.begin() + static_cast<std::ptrdiff_t>(taken));
+}
+
+/**
+ * @brief Turns one HTTP/1.1 request head into a stream for the same handlers, or accepts its `Upgrade: h2c` (RFC 7540 3.2).
+ * @note Only the first request, and only without a body, is upgraded: it becomes stream 1 and nothing after it is read as HTTP/1.1. Any other Upgrade is ignored, as HTTP/1.1 allows.
+ */
+bool Http2Connection::on_h1_request(const H1Request& request) {
+    // Bodies are only read framed by `content-length`.
+    if (request.is_chunked) {
+        refuse_h1(501U);
+        return false;
+    }
+
+    const uint32_t stream_id = (this->last_stream_id == 0U) ? 1U : this->last_stream_id + 2U;
+    const bool has_body = request.content_length > 0;
+    const bool is_upgrade = request.wants_h2c && stream_id == 1U && !has_body;
+    Http2Settings upgrade_settings = this->peer_settings;
+
+    if (is_upgrade && decode_http2_settings(upgrade_settings, request.http2_settings) != H2Error::no_error) {
+        refuse_h1(400U);
+        return false;
+    }
+
+    std::string field_name {};
+
+    this->request_fields.clear();
+
+    // `add_field` copies, since the head is taken off `in` before the handler runs.
+    bool is_stored = this->request_fields.add_field(":method", request.method) && this->request_fields.add_field(":scheme", "http")
+        && (request.host.empty() || this->request_fields.add_field(":authority", request.host)) && this->request_fields.add_field(":path", request.target);
+
+    // Names are lowercased as in HTTP/2, so handlers look fields up the same way for both.
+    for (uint32_t field_i = 0U; field_i < request.field_count && is_stored; field_i++) {
+        field_name.assign(request.fields[field_i].name);
+        std::transform(field_name.begin(), field_name.end(), field_name.begin(), [](char letter) {
+            return static_cast<char>((letter >= 'A' && letter <= 'Z') ? letter + ('a' - 'A') : letter);
+        });
+
+        if (std::find(std::begin(H1_CONNECTION_FIELDS), std::end(H1_CONNECTION_FIELDS), field_name) == std::end(H1_CONNECTION_FIELDS)) {
+            is_stored = this->request_fields.add_field(field_name, request.fields[field_i].value);
+        }
+    }
+
+    if (!is_stored) {
+        refuse_h1(431U);
+        return false;
+    }
+
+    const bool wants_continue = has_body && request.find_field("expect") == "100-continue";
+
+    this->last_stream_id = stream_id;
+    this->h1_body_left = (has_body) ? static_cast<uint64_t>(request.content_length) : 0UL;
+    this->h1_keep_alive = request.keep_alive;
+    this->in.erase(this->in.begin(), this->in.begin() + static_cast<std::ptrdiff_t>(request.head_length));
+
+    if (is_upgrade) {
+        // Our SETTINGS must be the first HTTP/2 frame, ahead of the response on stream 1.
+        this->out.insert(this->out.end(), H1_SWITCHING_PROTOCOLS, H1_SWITCHING_PROTOCOLS + sizeof(H1_SWITCHING_PROTOCOLS) - 1UL);
+        this->peer_settings = upgrade_settings;
+        this->encoder.set_table_capacity(this->peer_settings.header_table_size);
+        this->is_http1 = false;
+        this->is_upgraded = true;
+        this->phase = Phase::preface;
+        put_local_settings();
+    } else {
+        this->h1_stream_id = stream_id;
+
+        if (wants_continue) {
+            this->out.insert(this->out.end(), H1_CONTINUE.begin(), H1_CONTINUE.end());
+        }
+    }
+
+    Http2Stream& stream = start_stream(stream_id, !has_body);
+
+    if (!is_upgrade) {
+        dispatch_request(stream_id, stream);
+    }
+
+    return true;
+}
+
+bool Http2Connection::on_data(const FrameHeader& header, const uint8_t* payload) {
+    const bool is_padded = (header.flags & FLAG_PADDED) != 0;
+
+    if (header.stream_id == 0U || header.stream_id > this->last_stream_id) {
+        send_goaway(H2Error::protocol_error);
+        return false;
+    }
+
+    if (is_padded && (header.length == 0U || payload[0] >= header.length)) {
+        send_goaway(H2Error::protocol_error);
+        return false;
+    }
+
+    // The whole frame, padding included, counts against both receive windows (RFC 7540 6.9.1).
+    this->conn_recv_window -= header.length;
+
+    if (this->conn_recv_window < 0) {
+        send_goaway(H2Error::flow_control_error);
+        return false;
+    }
+
+    // Over half the window in flight means it may be what holds the peer back, so time one round trip of draining.
+    if (this->bdp_ping_ticks == 0UL && this->conn_recv_target < this->recv_window_limit
+        && this->conn_recv_window <= static_cast<int64_t>(this->conn_recv_target / 2U)) {
+        put_frame(FrameType::ping, 0, 0U, BDP_PING_PAYLOAD, PING_PAYLOAD_SIZE);
+        this->bdp_ping_ticks = stage_clock_ticks();
+        this->bdp_sample = 0U;
+    }
+
+    auto stream_it = this->streams.find(header.stream_id);
+
+    if (stream_it == this->streams.end()) {
+        // A stream we already closed; late DATA after our RST_STREAM is expected and dropped.
+        credit_connection(header.length);
+        return true;
+    }
+
+    Http2Stream& stream = stream_it->second;
+
+    if (stream.is_remote_closed) {
+        credit_connection(header.length);
+        reset_stream(header.stream_id, H2Error::stream_closed);
+        return true;
+    }
+
+    stream.recv_window -= header.length;
+
+    if (stream.recv_window < 0) {
+        credit_connection(header.length);
+        reset_stream(header.stream_id, H2Error::flow_control_error);
+        return true;
+    }
+
+    const bool is_last = (header.flags & FLAG_END_STREAM) != 0;
+
+    stream.is_remote_closed = is_last;
+
+    if (!has_body_reader(stream)) {
+        credit_stream(header.stream_id, stream, header.length);
+    } else {
+        const uint32_t pad_octets = (is_padded) ? payload[0] + 1U : 0U;
+        const uint32_t data_length = header.length - pad_octets;
+
+        // Padding never reaches the handler, so only the data waits for `consume_body`.
+        credit_stream(header.stream_id, stream, pad_octets);
+        stream.recv_unconsumed += data_length;
+        this->budget.on_inbound(data_length);
+        deliver_body(header.stream_id, std::string_view {reinterpret_cast<const char*>(payload) + ((is_padded) ? 1 : 0), data_length}, is_last);
+
+        // The handler may have answered, reset or discarded the stream.
+        stream_it = this->streams.find(header.stream_id);
+
+        if (stream_it == this->streams.end()) {
+            return true;
+        }
+    }
+
+    // Only close once the response is fully out, or its pending DATA would be lost.
+    if (is_last && stream_it->second.is_local_closed && !stream_it->second.has_pending_end) {
+        close_stream(header.stream_id);
+    }
+
+    return true;
+}
+
+bool Http2Connection::on_headers(const FrameHeader& header, const uint8_t* payload) {
+    uint32_t skip_front = 0U;
+    uint32_t pad_length = 0U;
+
+    // Client streams are odd (RFC 7540 5.1.1).
+    if ((header.stream_id & 1U) == 0U) {
+        send_goaway(H2Error::protocol_error);
+        return false;
+    }
+
+    if ((header.flags & FLAG_PADDED) != 0) {
+        if (header.length == 0U) {
+            send_goaway(H2Error::protocol_error);
+            return false;
+        }
+
+        pad_length = payload[0];
+        skip_front = 1U;
+    }
+
+    if ((header.flags & FLAG_PRIORITY) != 0) {
+        skip_front += PRIORITY_PAYLOAD_SIZE;
+    }
+
+    if (skip_front + pad_length > header.length) {
+        send_goaway(H2Error::protocol_error);
+        return false;
+    }
+
+    this->header_block.clear();
+
+    if (!append_header_fragment(payload + skip_front, header.length - skip_front - pad_length)) {
+        return false;
+    }
+
+    this->header_stream_id = header.stream_id;
+    this->header_flags = header.flags;
+
+    if ((header.flags & FLAG_END_HEADERS) == 0) {
+        return true;
+    }
+
+    return on_header_block(header.stream_id, (header.flags & FLAG_END_STREAM) != 0);
+}
+
+/**
+ * @brief Buffers one HEADERS or CONTINUATION fragment. The block must be complete before HPACK can decode it, so without a
+ * cap an endless CONTINUATION run would grow `header_block` until the process dies (the CVE-2024-27316 flood).
+ * @note A decoded list costs 32 octets per field beyond its text (RFC 7540 6.5.2), which outweighs HPACK's length
+ * prefixes, so an honest block stays under SETTINGS_MAX_HEADER_LIST_SIZE. The slack covers table size updates and
+ * Huffman codes longer than 8 bits. The block cannot be skipped without desynchronizing the HPACK decoder, so going
+ * over ends the connection rather than just the stream.
+ */
+bool Http2Connection::append_header_fragment(const uint8_t* fragment, uint32_t length) {
+    const size_t block_limit = static_cast<size_t>(this->local_settings.max_header_list_size) + H2_HEADER_BLOCK_SLACK;
+
+    if (this->header_block.size() + length > block_limit) {
+        this->header_block.clear();
+        this->header_stream_id = 0U;
+        send_goaway(H2Error::enhance_your_calm);
+        return false;
+    }
+
+    this->header_block.insert(this->header_block.end(), fragment, fragment + length);
+
+    return true;
+}
+
+bool Http2Connection::on_header_block(uint32_t stream_id, bool end_stream) {
+    const uint64_t decode_ticks = stage_clock_ticks();
+
+    record_stage(Stage::frame_parse, decode_ticks - this->read_ticks);
+
+    trace_event(TraceEvent::hpack_decode_begin, this->trace_id, stream_id, static_cast<uint32_t>(this->header_block.size()));
+
+    HpackStatus status = this->decoder.decode_block(this->header_block.data(), static_cast<uint32_t>(this->header_block.size()), this->request_fields);
+
+    record_stage(Stage::hpack_decode, stage_clock_ticks() - decode_ticks);
+    trace_event(TraceEvent::hpack_decode_end, this->trace_id, stream_id, static_cast<uint32_t>(this->request_fields.get_count()));
+
+    this->header_block.clear();
+    this->header_stream_id = 0U;
+
+    if (status == HpackStatus::compression_error) {
+        send_goaway(H2Error::compression_error);
+        return false;
+    }
+
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it != this->streams.end()) {
+        // Trailers: they must end the stream, and there is nothing to hand over yet.
+        Http2Stream& stream = stream_it->second;
+
+        if (stream.is_remote_closed || !end_stream) {
+            reset_stream(stream_id, (stream.is_remote_closed) ? H2Error::stream_closed : H2Error::protocol_error);
+            return true;
+        }
+
+        stream.is_remote_closed = true;
+
+        if (has_body_reader(stream)) {
+            deliver_body(stream_id, std::string_view {}, true);
+            stream_it = this->streams.find(stream_id);
+
+            if (stream_it == this->streams.end()) {
+                return true;
+            }
+        }
+
+        if (stream_it->second.is_local_closed && !stream_it->second.has_pending_end) {
+            close_stream(stream_id);
+        }
+
+        return true;
+    }
+
+    if (stream_id <= this->last_stream_id) {
+        send_goaway(H2Error::stream_closed);
+        return false;
+    }
+
+    this->last_stream_id = stream_id;
+
+    if (this->is_peer_going_away) {
+        return true;
+    }
+
+    charge_output();
+
+    // Every accepted request may queue a whole response body, so none are taken while the buffered output is at its high mark. REFUSED_STREAM tells the client the request was never processed and may be retried (RFC 7540 8.1.4).
+    if (this->streams.size() >= this->local_settings.max_concurrent_streams || this->budget.is_outbound_full()) {
+        put_u32_frame(FrameType::rst_stream, stream_id, static_cast<uint32_t>(H2Error::refused_stream));
+        metrics_add(Metric::streams_reset);
+        return true;
+    }
+
+    Http2Stream& stream = start_stream(stream_id, end_stream);
+
+    if (status == HpackStatus::header_list_too_large) {
+        send_response(stream_id, 431U, nullptr, 0U, "");
+        return true;
+    }
+
+    if (!this->request_fields.is_well_formed() || this->request_fields.get_method().empty() || this->request_fields.get_path().empty()) {
+        reset_stream(stream_id, H2Error::protocol_error);
+        return true;
+    }
+
+    dispatch_request(stream_id, stream);
+
+    return true;
+}
+
+bool Http2Connection::on_settings(const FrameHeader& header, const uint8_t* payload) {
+    if (header.stream_id != 0U) {
+        send_goaway(H2Error::protocol_error);
+        return false;
+    }
+
+    if ((header.flags & FLAG_ACK) != 0) {
+        if (header.length != 0U) {
+            send_goaway(H2Error::frame_size_error);
+            return false;
+        }
+
+        this->unacked_settings -= (this->unacked_settings > 0U) ? 1U : 0U;
+
+        return true;
+    }
+
+    const uint32_t old_window = this->peer_settings.initial_window_size;
+    H2Error error = parse_settings_payload(this->peer_settings, payload, header.length);
+
+    if (error != H2Error::no_error) {
+        send_goaway(error);
+        return false;
+    }
+
+    // Responses may only use as much table as the client's decoder keeps.
+    this->encoder.set_table_capacity(this->peer_settings.header_table_size);
+
+    // A new initial window shifts every open stream's send window by the difference (RFC 7540 6.9.2).
+    const int64_t window_delta = static_cast<int64_t>(this->peer_settings.initial_window_size) - static_cast<int64_t>(old_window);
+
+    for (auto& [stream_id, stream] : this->streams) {
+        (void)stream_id;
+        stream.send_window += window_delta;
+
+        if (stream.send_window > static_cast<int64_t>(MAX_WINDOW_SIZE)) {
+            send_goaway(H2Error::flow_control_error);
+            return false;
+        }
+    }
+
+#if defined(H2PLUS_COROUTINES)
+    // A granted handler may close streams and so erase slots, hence the copy of the IDs.
+    std::vector<uint32_t> coro_ids {};
+
+    for (const auto& [stream_id, slot] : this->coro_slots) {
+        (void)slot;
+        coro_ids.push_back(stream_id);
+    }
+
+    this->coro_depth++;
+
+    for (uint32_t stream_id : coro_ids) {
+        auto slot_it = this->coro_slots.find(stream_id);
+
+        if (slot_it != this->coro_slots.end()) {
+            slot_it->second->stream.send_window.grant(window_delta);
+        }
+    }
+
+    this->coro_depth--;
+    reap_coroutines();
+#endif
+
+    put_frame(FrameType::settings, FLAG_ACK, 0U, nullptr, 0U);
+
+    return true;
+}
+
+bool Http2Connection::on_window_update(const FrameHeader& header, const uint8_t* payload) {
+    if (header.length != U32_PAYLOAD_SIZE) {
+        send_goaway(H2Error::frame_size_error);
+        return false;
+    }
+
+    const uint32_t increment = read_u32(payload) & STREAM_ID_MASK;
+
+    if (header.stream_id == 0U) {
+        this->conn_send_window += increment;
+
+        if (increment == 0U || this->conn_send_window > static_cast<int64_t>(MAX_WINDOW_SIZE)) {
+            send_goaway((increment == 0U) ? H2Error::protocol_error : H2Error::flow_control_error);
+            return false;
+        }
+
+        return true;
+    }
+
+    auto stream_it = this->streams.find(header.stream_id);
+
+    if (stream_it == this->streams.end()) {
+        // Updates may trail a stream we closed, but never precede one the client has not opened.
+        if (header.stream_id > this->last_stream_id) {
+            send_goaway(H2Error::protocol_error);
+            return false;
+        }
+
+        return true;
+    }
+
+    Http2Stream& stream = stream_it->second;
+
+    stream.send_window += increment;
+
+    if (increment == 0U || stream.send_window > static_cast<int64_t>(MAX_WINDOW_SIZE)) {
+        reset_stream(header.stream_id, (increment == 0U) ? H2Error::protocol_error : H2Error::flow_control_error);
+        return true;
+    }
+
+#if defined(H2PLUS_COROUTINES)
+    auto slot_it = this->coro_slots.find(header.stream_id);
+
+    if (slot_it != this->coro_slots.end()) {
+        this->coro_depth++;
+        slot_it->second->stream.send_window.grant(increment);
+        this->coro_depth--;
+        reap_coroutines();
+    }
+#endif
+
+    return true;
+}
+
+bool Http2Connection::on_frame(const FrameHeader& header, const uint8_t* payload) {
+    metrics_count_frame(static_cast<uint8_t>(header.type), false);
+    trace_event(TraceEvent::frame_received, this->trace_id, header.stream_id, (static_cast<uint32_t>(header.type) << 24) | header.length);
+
+    if (this->phase == Phase::settings) {
+        if (header.type != FrameType::settings || (header.flags & FLAG_ACK) != 0) {
+            send_goaway(H2Error::protocol_error);
+            return false;
+        }
+
+        this->phase = Phase::frames;
+    }
+
+    // Nothing may interleave with an unfinished header block (RFC 7540 6.10).
+    if (this->header_stream_id != 0U && (header.type != FrameType::continuation || header.stream_id != this->header_stream_id)) {
+        send_goaway(H2Error::protocol_error);
+        return false;
+    }
+
+    switch (header.type) {
+    case FrameType::data:
+        return on_data(header, payload);
+    case FrameType::headers:
+        return on_headers(header, payload);
+    case FrameType::continuation:
+        if (this->header_stream_id == 0U) {
+            send_goaway(H2Error::protocol_error);
+            return false;
+        }
+
+        if (!append_header_fragment(payload, header.length)) {
+            return false;
+        }
+
+        return ((header.flags & FLAG_END_HEADERS) == 0) || on_header_block(header.stream_id, (this->header_flags & FLAG_END_STREAM) != 0);
+    case FrameType::priority:
+        if (header.stream_id == 0U || header.length != PRIORITY_PAYLOAD_SIZE) {
+            send_goaway((header.stream_id == 0U) ? H2Error::protocol_error : H2Error::frame_size_error);
+            return false;
+        }
+
+        return true;
+    case FrameType::rst_stream:
+        if (header.stream_id == 0U || header.stream_id > this->last_stream_id || header.length != U32_PAYLOAD_SIZE) {
+            send_goaway((header.length != U32_PAYLOAD_SIZE) ? H2Error::frame_size_error : H2Error::protocol_error);
+            return false;
+        }
+
+        if (this->streams.count(header.stream_id) > 0UL) {
+            metrics_add(Metric::streams_reset);
+            close_stream(header.stream_id);
+        }
+
+        return true;
+    case FrameType::settings:
+        return on_settings(header, payload);
+    case FrameType::push_promise:
+        send_goaway(H2Error::protocol_error);
+        return false;
+    case FrameType::ping:
+        if (header.stream_id != 0U || header.length != PING_PAYLOAD_SIZE) {
+            send_goaway((header.stream_id != 0U) ? H2Error::protocol_error : H2Error::frame_size_error);
+            return false;
+        }
+
+        if ((header.flags & FLAG_ACK) == 0) {
+            put_frame(FrameType::ping, FLAG_ACK, 0U, payload, PING_PAYLOAD_SIZE);
+        } else if (this->bdp_ping_ticks != 0UL && std::memcmp(payload, BDP_PING_PAYLOAD, PING_PAYLOAD_SIZE) == 0) {
+            end_bdp_sample();
+        }
+
+        return true;
+    case FrameType::goaway:
+        // Finish what is in flight, then close once the last stream is done.
+        this->is_peer_going_away = true;
+        return true;
+    case FrameType::window_update:
+        return on_window_update(header, payload);
+    default:
+        // Unknown frame types are ignored (RFC 7540 4.1).
+        return true;
+    }
+}
+
+/* Http2Connection Public Impl. */
+
+Http2Connection::Http2Connection(RequestHandler request_handler, BodyHandler request_body_handler)
+: streams {}, spare_streams {}, handler {std::move(request_handler)}, body_handler {std::move(request_body_handler)}, offloader {}, decoder {}, encoder {}, request_fields {}, budget {BufferLimits {}}, local_settings {}, peer_settings {},
+  in {}, out {}, header_block {}, output_marks {}, send_order {}, h1_fields {} {
+    this->local_settings.enable_push = 0U;
+    this->local_settings.max_concurrent_streams = H2_LOCAL_MAX_STREAMS;
+    this->local_settings.max_header_list_size = static_cast<uint32_t>(this->decoder.get_max_header_list_size());
+    this->out_consumed = 0UL;
+    this->out_charged = 0UL;
+    this->file_frame_stream_id = 0U;
+    this->block_frame_start = 0UL;
+    this->marks_consumed = 0UL;
+    this->out_written_total = 0UL;
+    this->read_ticks = 0UL;
+    this->h1_body_left = 0UL;
+    this->conn_send_window = DEFAULT_INITIAL_WINDOW_SIZE;
+    this->conn_recv_window = DEFAULT_INITIAL_WINDOW_SIZE;
+    this->bdp_ping_ticks = 0UL;
+    this->min_rtt_ticks = 0UL;
+    this->bdp_sample = 0U;
+    this->conn_recv_target = DEFAULT_INITIAL_WINDOW_SIZE;
+    this->recv_window_limit = H2_DEFAULT_RECV_WINDOW_LIMIT;
+    this->conn_recv_consumed = 0U;
+    this->unacked_settings = 0U;
+    this->header_stream_id = 0U;
+    this->last_stream_id = 0U;
+    this->h1_stream_id = 0U;
+    this->header_flags = 0;
+    this->block_frame_flags = 0;
+    this->block_frame_type = FrameType::headers;
+    this->phase = Phase::preface;
+    this->encoder.set_indexing_policy(IndexingPolicy::frequency);
+    this->is_peer_going_away = false;
+    this->is_http1 = false;
+    this->is_upgraded = false;
+    this->is_parsing_h1 = false;
+    this->h1_keep_alive = false;
+    this->trace_id = next_trace_id.fetch_add(1U, std::memory_order_relaxed);
+#if defined(H2PLUS_COROUTINES)
+    this->coro_depth = 0U;
+#endif
+}
+
+void Http2Connection::set_indexing_policy(IndexingPolicy policy) {
+    this->encoder.set_indexing_policy(policy);
+}
+
+void Http2Connection::set_recv_window_limit(uint32_t limit) {
+    this->recv_window_limit = std::min(limit, MAX_WINDOW_SIZE);
+}
+
+void Http2Connection::set_buffer_limits(const BufferLimits& limits) {
+    this->budget = ConnectionBudget {limits};
+    this->out_charged = 0UL;
+    charge_output();
+}
+
+void Http2Connection::set_offloader(Offloader blocking_offloader) {
+    this->offloader = std::move(blocking_offloader);
+}
+
+#if defined(H2PLUS_COROUTINES)
+void Http2Connection::set_coro_handler(CoroHandler handler) {
+    this->coro_handler = std::move(handler);
+}
+#endif
+
+void Http2Connection::offload(std::function<void()> work, std::function<void()> on_complete) {
+    if (!this->offloader) {
+        work();
+        on_complete();
+        return;
+    }
+
+    this->offloader(std::move(work), std::move(on_complete));
+}
+
+bool Http2Connection::feed(const uint8_t* data, size_t length) {
+    if (this->phase == Phase::closing) {
+        return false;
+    }
+
+    if (length > 0UL) {
+        this->in.insert(this->in.end(), data, data + length);
+    }
+
+    this->read_ticks = stage_clock_ticks();
+
+    if (this->phase == Phase::preface || this->phase == Phase::http1) {
+        const bool keep_going = (this->phase == Phase::preface) ? on_preface() : on_h1_input();
+
+        // Only a preface just taken goes on to the frames behind it.
+        if (!keep_going || this->phase != Phase::settings) {
+            charge_output();
+            return this->phase != Phase::closing;
+        }
+    }
+
+    size_t cursor = 0UL;
+    FrameHeader header {};
+    bool keep_going = true;
+
+    while (keep_going && this->in.size() - cursor >= FRAME_HEADER_SIZE && should_read()) {
+        unpack_frame_header(header, this->in.data() + cursor, FRAME_HEADER_SIZE);
+
+        if (header.length > this->local_settings.max_frame_size) {
+            send_goaway(H2Error::frame_size_error);
+            keep_going = false;
+            break;
+        }
+
+        if (this->in.size() - cursor - FRAME_HEADER_SIZE < header.length) {
+            break;
+        }
+
+        keep_going = on_frame(header, this->in.data() + cursor + FRAME_HEADER_SIZE);
+        cursor += FRAME_HEADER_SIZE + header.length;
+    }
+
+    this->in.erase(this->in.begin(), this->in.begin() + static_cast<std::ptrdiff_t>(cursor));
+
+    if (keep_going) {
+        fill_output(H2_OUTPUT_LOW_WATER);
+    }
+
+    charge_output();
+
+    return keep_going;
+}
+
+bool Http2Connection::should_read() {
+    charge_output();
+
+    return this->budget.should_read();
+}
+
+void Http2Connection::on_peer_closed() {
+    this->phase = Phase::closing;
+}
+
+const uint8_t* Http2Connection::get_output() const {
+    return this->out.data() + this->out_consumed;
+}
+
+size_t Http2Connection::get_output_size() const {
+    return this->out.size() - this->out_consumed;
+}
+
+void Http2Connection::consume_output(size_t octets) {
+    const size_t released = std::min(octets, this->out_charged);
+
+    this->budget.on_flushed(0U, released);
+    this->out_charged -= released;
+    this->out_consumed += octets;
+    this->out_written_total += octets;
+
+    if (this->marks_consumed < this->output_marks.size() && this->output_marks[this->marks_consumed].end_offset <= this->out_written_total) {
+        const uint64_t now_ticks = stage_clock_ticks();
+
+        do {
+            record_stage(Stage::write_queue, now_ticks - this->output_marks[this->marks_consumed].queued_ticks);
+            this->marks_consumed++;
+        } while (this->marks_consumed < this->output_marks.size() && this->output_marks[this->marks_consumed].end_offset <= this->out_written_total);
+
+        if (this->marks_consumed == this->output_marks.size()) {
+            this->output_marks.clear();
+            this->marks_consumed = 0UL;
+        }
+    }
+
+    if (this->out_consumed >= this->out.size()) {
+        this->out.clear();
+        this->out_consumed = 0UL;
+    }
+}
+
+uint32_t Http2Connection::pick_file_stream() const {
+    uint64_t best_key = UINT64_MAX;
+
+    // Same order as `fill_output`. A file with nothing left still owes its END_STREAM frame, which needs no window.
+    for (const auto& [stream_id, stream] : this->streams) {
+        if (!stream.file_body || (!this->is_http1 && stream.file_body->get_remaining() > 0UL && (stream.send_window <= 0 || this->conn_send_window <= 0))) {
+            continue;
+        }
+
+        best_key = std::min(best_key, (static_cast<uint64_t>(stream.urgency) << 32) | stream_id);
+    }
+
+    return (best_key == UINT64_MAX) ? 0U : static_cast<uint32_t>(best_key);
+}
+
+bool Http2Connection::fill_output(size_t target_octets) {
+    const size_t size_before = get_output_size();
+
+    this->send_order.clear();
+
+    // Urgency above the stream ID in one key: most urgent first, then streams finish in request order.
+    for (const auto& [stream_id, stream] : this->streams) {
+        if (!stream.file_body && (stream.has_pending_end || stream.pending_offset < stream.pending_body.size())) {
+            this->send_order.push_back((static_cast<uint64_t>(stream.urgency) << 32) | stream_id);
+        }
+    }
+
+    std::sort(this->send_order.begin(), this->send_order.end());
+
+    for (uint64_t order_key : this->send_order) {
+        const uint32_t stream_id = static_cast<uint32_t>(order_key);
+        const size_t unsent = get_output_size();
+
+        if (unsent >= target_octets || this->conn_send_window <= 0) {
+            break;
+        }
+
+        auto stream_it = this->streams.find(stream_id);
+
+        if (stream_it != this->streams.end()) {
+            flush_stream(stream_id, stream_it->second, target_octets - unsent);
+        }
+    }
+
+    return get_output_size() > size_before;
+}
+
+bool Http2Connection::should_close() const {
+    if (get_output_size() > 0UL) {
+        return false;
+    }
+
+    return this->phase == Phase::closing || (this->is_peer_going_away && this->streams.empty());
+}
+
+uint32_t Http2Connection::get_stream_count() const {
+    return static_cast<uint32_t>(this->streams.size());
+}
+
+bool Http2Connection::is_handshaking() const {
+    return this->phase == Phase::preface || this->phase == Phase::settings || this->unacked_settings > 0U;
+}
+
+bool Http2Connection::has_partial_header_block() const {
+    // An HTTP/1.1 request head counts too, once it has begun arriving.
+    if (this->phase == Phase::http1) {
+        return this->h1_stream_id == 0U && this->h1_body_left == 0UL && !this->in.empty();
+    }
+
+    return this->header_stream_id != 0U;
+}
+
+void Http2Connection::expire(H2Error error) {
+    if (this->phase == Phase::preface || this->is_http1) {
+        this->phase = Phase::closing;
+        return;
+    }
+
+    send_goaway(error);
+}
+
+uint32_t Http2Connection::get_trace_id() const {
+    return this->trace_id;
+}
+
+const Http2Settings& Http2Connection::get_peer_settings() const {
+    return this->peer_settings;
+}
+
+void Http2Connection::put_response_head(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, uint64_t content_length, bool end_stream) {
+    if (this->is_http1) {
+        this->h1_fields.clear();
+
+        for (uint32_t field_i = 0U; field_i < field_count; field_i++) {
+            this->h1_fields.push_back(H1Field {fields[field_i].name, fields[field_i].value});
+        }
+
+        append_h1_response_head(this->out, status, this->h1_fields.data(), field_count, content_length, this->h1_keep_alive);
+        return;
+    }
+
+    StageProbe encode_probe {Stage::hpack_encode};
+
+    begin_header_block(end_stream);
+    this->encoder.begin_block(this->out);
+    this->encoder.encode_field(this->out, ":status", std::to_string(status));
+
+    for (uint32_t field_i = 0U; field_i < field_count; field_i++) {
+        this->encoder.encode_field(this->out, fields[field_i].name, fields[field_i].value);
+        roll_header_block(stream_id);
+    }
+
+    // A 204 must not carry a length, and a 304's would have to be that of the 200 it stands for (RFC 9110 8.6).
+    if (status != 204U && status != 304U) {
+        this->encoder.encode_field(this->out, "content-length", std::to_string(content_length));
+    }
+
+    end_header_block(stream_id);
+}
+
+/// @brief Ends an HTTP/1.1 exchange once its response is queued. The stream closes unless a reader still takes the upload, and a pipelined request behind it may start.
+void Http2Connection::finish_h1_response(uint32_t stream_id) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end()) {
+        return;
+    }
+
+    if (stream_id == this->h1_stream_id) {
+        this->h1_stream_id = 0U;
+    }
+
+    // The head said `connection: close`.
+    if (!this->h1_keep_alive) {
+        this->phase = Phase::closing;
+    }
+
+    if (stream_it->second.is_remote_closed || !has_body_reader(stream_it->second) || this->phase == Phase::closing) {
+        close_stream(stream_id);
+    }
+
+    if (this->phase == Phase::http1 && !this->is_parsing_h1) {
+        on_h1_input();
+    }
+}
+
+/// @brief Answers an HTTP/1.1 request that cannot be served and closes, since whatever follows it cannot be told apart.
+void Http2Connection::refuse_h1(uint32_t status) {
+    append_h1_response_head(this->out, status, nullptr, 0U, 0UL, false);
+    this->in.clear();
+    this->phase = Phase::closing;
+}
+
+void Http2Connection::mark_response_queued() {
+    // Reclaim recorded marks before the vector would grow, for a connection whose output never fully drains.
+    if (this->marks_consumed > 0UL && this->output_marks.size() == this->output_marks.capacity()) {
+        this->output_marks.erase(this->output_marks.begin(), this->output_marks.begin() + static_cast<std::ptrdiff_t>(this->marks_consumed));
+        this->marks_consumed = 0UL;
+    }
+
+    this->output_marks.push_back(OutputMark {this->out_written_total + get_output_size(), stage_clock_ticks()});
+}
+
+void Http2Connection::queue_response(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, std::string_view body, std::string* owned_body) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end() || stream_it->second.is_local_closed) {
+        return;
+    }
+
+    Http2Stream& stream = stream_it->second;
+
+    // A HEAD response keeps the length of the body it leaves out.
+    put_response_head(stream_id, status, fields, field_count, body.length(), body.empty() || stream.is_head);
+    stream.is_local_closed = true;
+
+    if (stream.is_head) {
+        body = std::string_view {};
+    }
+
+    // An HTTP/1.1 body has no flow control to wait for.
+    if (this->is_http1) {
+        this->out.insert(this->out.end(), body.begin(), body.end());
+
+        mark_response_queued();
+        finish_h1_response(stream_id);
+        return;
+    }
+
+    // Frame the start of the body straight from the caller's buffer. `fill_output` frames the rest once the socket drains, so a big body cannot hold later urgent responses back.
+    const size_t unsent = get_output_size();
+    size_t sent = (!body.empty() && unsent < H2_OUTPUT_LOW_WATER) ? put_data_frames(stream_id, stream, body, true, H2_OUTPUT_LOW_WATER - unsent) : 0UL;
+
+    if (sent < body.length()) {
+        this->budget.charge(stream_id, body.length() - sent);
+    }
+
+    if (sent == body.length()) {
+        end_local_side(stream_id);
+    } else if (owned_body) {
+        // An owned body is kept as it is rather than copied.
+        stream.pending_body = std::move(*owned_body);
+        stream.pending_offset = sent;
+        stream.has_pending_end = true;
+    } else {
+        stream.pending_body.assign(body.data() + sent, body.length() - sent);
+        stream.pending_offset = 0UL;
+        stream.has_pending_end = true;
+    }
+
+    /// @note Only the start of the body is queued now, so a stalled body shows up in flow control rather than in this stage.
+    mark_response_queued();
+}
+
+void Http2Connection::send_response(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, std::string_view body) {
+    queue_response(stream_id, status, fields, field_count, body, nullptr);
+}
+
+void Http2Connection::send_owned_response(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, std::string&& body) {
+    queue_response(stream_id, status, fields, field_count, body, &body);
+}
+
+void Http2Connection::send_file_response(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, std::unique_ptr<StaticFileSender> file) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end() || stream_it->second.is_local_closed || !file) {
+        return;
+    }
+
+    Http2Stream& stream = stream_it->second;
+
+    // Even an empty file ends with its own zero length DATA frame, so HEADERS only carries END_STREAM for HEAD.
+    put_response_head(stream_id, status, fields, field_count, file->get_file_size(), stream.is_head);
+
+    if (stream.is_head) {
+        stream.is_local_closed = true;
+        mark_response_queued();
+        end_local_side(stream_id);
+        return;
+    }
+
+    file->set_unframed(this->is_http1);
+    file->bind_stream(stream_id);
+    stream.file_body = std::move(file);
+    stream.is_local_closed = true;
+    stream.has_pending_end = true;
+    mark_response_queued();
+}
+
+bool Http2Connection::send_cached_response(uint32_t stream_id, const CachedResponse& response) {
+    auto stream_it = this->streams.find(stream_id);
+
+    // A HEAD response has no DATA frames to replay, so it takes the uncached path.
+    if (this->is_http1 || stream_it == this->streams.end() || stream_it->second.is_local_closed || stream_it->second.is_head || this->encoder.has_pending_size_update()) {
+        return false;
+    }
+
+    Http2Stream& stream = stream_it->second;
+    const int64_t body_length = static_cast<int64_t>(response.body_length);
+
+    // The cached DATA frames go out whole, so both windows must already cover them.
+    if (stream.send_window < body_length || this->conn_send_window < body_length) {
+        return false;
+    }
+
+    const size_t wire_start = this->out.size();
+
+    response.append_wire(this->out, stream_id);
+
+    for (auto frame_offset : response.frame_offsets) {
+        metrics_count_frame(this->out[wire_start + frame_offset + 3UL], true);
+    }
+
+    stream.send_window -= body_length;
+    this->conn_send_window -= body_length;
+    stream.is_local_closed = true;
+    end_local_side(stream_id);
+    mark_response_queued();
+
+    return true;
+}
+
+SendStatus Http2Connection::write_file_output(int socket_fd, size_t max_octets) {
+    // An HTTP/1.1 body is bounded by the write quantum alone.
+    const uint32_t max_frame = (this->is_http1) ? MAX_WINDOW_SIZE : this->peer_settings.max_frame_size;
+
+    // A frame cut short is on the wire already and must be finished, even for a stream closed since; its window was taken when it began.
+    if (this->orphan_file) {
+        int64_t no_window = 0;
+        SendStatus status = this->orphan_file->send_frames(socket_fd, no_window, max_frame);
+
+        if (status == SendStatus::blocked || status == SendStatus::error) {
+            return status;
+        }
+
+        this->orphan_file.reset();
+        this->file_frame_stream_id = 0U;
+
+        return SendStatus::done;
+    }
+
+    const uint32_t stream_id = (this->file_frame_stream_id != 0U) ? this->file_frame_stream_id : pick_file_stream();
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end()) {
+        return SendStatus::window_empty;
+    }
+
+    Http2Stream& stream = stream_it->second;
+    const int64_t octet_limit = static_cast<int64_t>(std::min<size_t>(max_octets, MAX_WINDOW_SIZE));
+    const int64_t window_before = (this->is_http1) ? octet_limit : std::max<int64_t>(0, std::min({stream.send_window, this->conn_send_window, octet_limit}));
+    int64_t window = window_before;
+    SendStatus status = stream.file_body->send_frames(socket_fd, window, max_frame);
+    const int64_t sent = window_before - window;
+
+    if (!this->is_http1) {
+        stream.send_window -= sent;
+        this->conn_send_window -= sent;
+    }
+    this->file_frame_stream_id = (status == SendStatus::blocked) ? stream_id : 0U;
+
+    if (status == SendStatus::done) {
+        stream.file_body.reset();
+        stream.has_pending_end = false;
+        end_local_side(stream_id);
+    }
+
+    // Octets went out, so another pass may find more to send.
+    if (status == SendStatus::window_empty && sent > 0) {
+        return SendStatus::done;
+    }
+
+    return status;
+}
+
+bool Http2Connection::has_file_frame_pending() const {
+    return this->file_frame_stream_id != 0U;
+}
+
+void Http2Connection::reset_stream(uint32_t stream_id, H2Error error) {
+    // One HTTP/1.1 exchange cannot be cut off alone, so the connection goes with it.
+    if (this->is_http1) {
+        close_stream(stream_id);
+        this->phase = Phase::closing;
+        return;
+    }
+
+    put_u32_frame(FrameType::rst_stream, stream_id, static_cast<uint32_t>(error));
+
+    if (this->streams.count(stream_id) > 0UL) {
+        metrics_add(Metric::streams_reset);
+        close_stream(stream_id);
+    }
+}
+
+bool Http2Connection::read_body(uint32_t stream_id) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end() || stream_it->second.is_remote_closed || !this->body_handler) {
+        return false;
+    }
+
+    stream_it->second.is_reading_body = true;
+
+    return true;
+}
+
+void Http2Connection::consume_body(uint32_t stream_id, uint32_t octets) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end()) {
+        return;
+    }
+
+    Http2Stream& stream = stream_it->second;
+    const uint32_t given_back = std::min(octets, stream.recv_unconsumed);
+
+    stream.recv_unconsumed -= given_back;
+    this->budget.on_consumed(given_back);
+    credit_stream(stream_id, stream, given_back);
+}
+
+void Http2Connection::discard_body(uint32_t stream_id) {
+    auto stream_it = this->streams.find(stream_id);
+
+    if (stream_it == this->streams.end()) {
+        return;
+    }
+
+    Http2Stream& stream = stream_it->second;
+
+    stream.is_reading_body = false;
+    consume_body(stream_id, stream.recv_unconsumed);
+
+    // A complete response was only waiting for the upload to end, which is no longer needed.
+    if (stream.is_local_closed && !stream.has_pending_end) {
+        end_local_side(stream_id);
+    }
+
+#if defined(H2PLUS_COROUTINES)
+    // A coroutine handler still awaiting the body sees it end here.
+    auto slot_it = this->coro_slots.find(stream_id);
+
+    if (slot_it != this->coro_slots.end()) {
+        this->coro_depth++;
+        slot_it->second->stream.body.finish();
+        this->coro_depth--;
+        reap_coroutines();
+    }
+#endif
+}
@@ -0,0 +1,512 @@
+/**
+ * @file h2server.cpp
+ * @author Derek Tan
+ * @brief Implements the epoll event loops for h2c connections.
+ * @date 2026-10-19
+ */
+
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "server/h2server.hpp"
+#include "utils/metrics.hpp"
+#include "utils/stagetimes.hpp"
+#include "utils/tracer.hpp"
+
+constexpr uint32_t SERVER_READS_PER_EVENT = 4U;   // bounded so one busy client cannot starve the rest of its loop
+
+/* ServerLoop::Session Impl. */
+
+ServerLoop::Session::Session(const RequestHandler& handler, const BodyHandler& body_handler, uint64_t session_serial, int fd)
+: connection {handler, body_handler}, serial {session_serial}, socket_fd {fd}, wants_read {true}, wants_write {false} {}
+
+/* ServerLoop Private Impl. */
+
+void ServerLoop::accept_clients() {
+    while (true) {
+        int client_fd = accept4(this->listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (client_fd == -1) {
+            // EAGAIN ends the batch; anything else (EMFILE, ECONNABORTED) drops just this client.
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return;
+        }
+
+        int enable = 1;
+        int notsent_lowat = static_cast<int>(SERVER_NOTSENT_LOWAT);
+
+        // Frames go out as soon as they are written, and the kernel holds few unsent octets, so what is queued next is still ours to reorder.
+        setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        setsockopt(client_fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &notsent_lowat, sizeof(notsent_lowat));
+
+        epoll_event event {};
+
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = client_fd;
+
+        if (epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, client_fd, &event) == -1) {
+            close(client_fd);
+            continue;
+        }
+
+        auto& session = this->sessions[client_fd];
+        const uint64_t serial = this->next_serial++;
+
+        session = std::make_unique<Session>(this->handler, this->body_handler, serial, client_fd);
+        session->connection.set_recv_window_limit(this->recv_window_limit);
+
+        if (this->pool && this->completions.is_ready()) {
+            session->connection.set_offloader([this, client_fd, serial](std::function<void()> work, std::function<void()> on_complete) {
+                // Only a task the pool refuses while shutting down is lost, and then the loop is exiting too.
+                this->pool->submit(std::move(work), [this, client_fd, serial, on_complete = std::move(on_complete)]() {
+                    complete_offload(client_fd, serial, on_complete);
+                }, this->completions);
+            });
+        }
+
+#if defined(H2PLUS_COROUTINES)
+        if (this->coro_handler && *this->coro_handler) {
+            session->connection.set_coro_handler(*this->coro_handler);
+        }
+#endif
+
+        session->idle_timer.on_expire = [this, client_fd]() { this->expired_timers.push_back({client_fd, SessionTimeout::idle}); };
+        session->handshake_timer.on_expire = [this, client_fd]() { this->expired_timers.push_back({client_fd, SessionTimeout::handshake}); };
+        session->header_timer.on_expire = [this, client_fd]() { this->expired_timers.push_back({client_fd, SessionTimeout::header}); };
+        refresh_timers(*session);
+        trace_event(TraceEvent::conn_accepted, session->connection.get_trace_id(), 0U, static_cast<uint32_t>(client_fd));
+        metrics_add(Metric::connections_accepted);
+        metrics_add(Metric::connections_active);
+    }
+}
+
+void ServerLoop::on_readable(Session& session) {
+    uint8_t chunk[SERVER_READ_CHUNK];
+
+    // A session over its buffer marks is not read at all; the peer's TCP window does the waiting.
+    for (uint32_t read_i = 0U; read_i < SERVER_READS_PER_EVENT && session.connection.should_read(); read_i++) {
+        ssize_t got = recv(session.socket_fd, chunk, sizeof(chunk), 0);
+
+        if (got > 0) {
+            if (!session.connection.feed(chunk, static_cast<size_t>(got))) {
+                return;
+            }
+
+            continue;
+        }
+
+        if (got == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+
+        if (got == -1 && errno == EINTR) {
+            continue;
+        }
+
+        session.connection.on_peer_closed();
+        return;
+    }
+}
+
+bool ServerLoop::flush(Session& session) {
+    Http2Connection& connection = session.connection;
+    const uint64_t flush_ticks = stage_clock_ticks();
+    size_t output_flushed = 0UL;
+    bool wants_read = session.wants_read;
+
+    do {
+        while (true) {
+            // Pending DATA is only framed once everything queued before it was taken, i.e. while the socket is writable. A file frame cut short goes before all of it.
+            if (!connection.has_file_frame_pending() && (connection.get_output_size() > 0UL || connection.fill_output(SERVER_WRITE_QUANTUM))) {
+                ssize_t sent = send(session.socket_fd, connection.get_output(), connection.get_output_size(), MSG_NOSIGNAL);
+
+                if (sent >= 0) {
+                    connection.consume_output(static_cast<size_t>(sent));
+                    output_flushed += static_cast<size_t>(sent);
+                    continue;
+                }
+
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    return false;
+                }
+
+                break;
+            }
+
+            // With the buffered output gone, file responses get one write quantum, then buffered frames again.
+            SendStatus file_status = connection.write_file_output(session.socket_fd, SERVER_WRITE_QUANTUM);
+
+            if (file_status == SendStatus::error) {
+                return false;
+            }
+
+            if (file_status != SendStatus::done) {
+                break;
+            }
+        }
+
+        const bool was_reading = wants_read;
+
+        wants_read = connection.should_read();
+
+        // Frames left unparsed when reading paused come first once it resumes; what they queue goes out on the next pass.
+        if (wants_read && !was_reading) {
+            connection.feed(nullptr, 0UL);
+            continue;
+        }
+
+        break;
+    } while (true);
+
+    if (output_flushed > 0UL) {
+        record_stage(Stage::socket_flush, stage_clock_ticks() - flush_ticks);
+        trace_event(TraceEvent::flush, connection.get_trace_id(), 0U, static_cast<uint32_t>(output_flushed));
+    }
+
+    update_interest(session, wants_read, connection.get_output_size() > 0UL || connection.has_file_frame_pending());
+
+    return true;
+}
+
+void ServerLoop::update_interest(Session& session, bool wants_read, bool wants_write) {
+    if (wants_read == session.wants_read && wants_write == session.wants_write) {
+        return;
+    }
+
+    epoll_event event {};
+
+    // EPOLLRDHUP goes with EPOLLIN: level triggered, it would wake the loop for a paused session over and over.
+    event.events = ((wants_read) ? EPOLLIN | EPOLLRDHUP : 0U) | ((wants_write) ? EPOLLOUT : 0U);
+    event.data.fd = session.socket_fd;
+    epoll_ctl(this->epoll_fd, EPOLL_CTL_MOD, session.socket_fd, &event);
+    session.wants_read = wants_read;
+    session.wants_write = wants_write;
+}
+
+/**
+ * @brief Arms or cancels a session's timers to match what its connection waits for. Called after every event on it.
+ */
+void ServerLoop::refresh_timers(Session& session) {
+    const Http2Connection& connection = session.connection;
+
+    // The handshake and header timers run from when the wait began, so only arm them once.
+    if (!connection.is_handshaking()) {
+        this->timers.cancel(session.handshake_timer);
+    } else if (!session.handshake_timer.is_armed) {
+        this->timers.schedule(session.handshake_timer, this->handshake_timeout_ms);
+    }
+
+    if (!connection.has_partial_header_block()) {
+        this->timers.cancel(session.header_timer);
+    } else if (!session.header_timer.is_armed) {
+        this->timers.schedule(session.header_timer, this->header_timeout_ms);
+    }
+
+    // Open streams may wait on a handler for as long as it takes; only a connection with nothing in flight can be idle.
+    if (connection.get_stream_count() == 0U) {
+        this->timers.schedule(session.idle_timer, this->idle_timeout_ms);
+    } else {
+        this->timers.cancel(session.idle_timer);
+    }
+}
+
+void ServerLoop::expire_session(const ExpiredTimer& expired) {
+    auto session_it = this->sessions.find(expired.socket_fd);
+
+    if (session_it == this->sessions.end()) {
+        return;
+    }
+
+    Http2Connection& connection = session_it->second->connection;
+
+    switch (expired.kind) {
+    case SessionTimeout::idle:
+        connection.expire(H2Error::no_error);
+        break;
+    case SessionTimeout::handshake:
+        connection.expire(H2Error::settings_timeout);
+        break;
+    default:
+        // A header block left open stalls the whole connection, which is how slowloris holds servers.
+        connection.expire(H2Error::enhance_your_calm);
+        break;
+    }
+
+    // One attempt to write the GOAWAY: a client that let a timer run out is not waited on any further.
+    flush(*session_it->second);
+    close_session(expired.socket_fd);
+}
+
+/**
+ * @brief Runs an offloaded job's completion on its session, if that session is still open, then writes whatever it queued.
+ */
+void ServerLoop::complete_offload(int socket_fd, uint64_t serial, const std::function<void()>& on_complete) {
+    auto session_it = this->sessions.find(socket_fd);
+
+    if (session_it == this->sessions.end() || session_it->second->serial != serial) {
+        return;
+    }
+
+    Session& session = *session_it->second;
+
+    on_complete();
+
+    if (!flush(session) || session.connection.should_close()) {
+        close_session(socket_fd);
+        return;
+    }
+
+    refresh_timers(session);
+}
+
+void ServerLoop::close_session(int socket_fd) {
+    auto session_it = this->sessions.find(socket_fd);
+
+    epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, socket_fd, nullptr);
+    close(socket_fd);
+
+    if (session_it == this->sessions.end()) {
+        return;
+    }
+
+    // Nodes have no back pointer to the wheel, so they must be unlinked before the session goes.
+    this->timers.cancel(session_it->second->idle_timer);
+    this->timers.cancel(session_it->second->handshake_timer);
+    this->timers.cancel(session_it->second->header_timer);
+    this->sessions.erase(session_it);
+    metrics_sub(Metric::connections_active);
+}
+
+/* ServerLoop Public Impl. */
+
+ServerLoop::ServerLoop(const RequestHandler& request_handler, const BodyHandler& request_body_handler, const std::atomic<bool>& running_flag, ThreadPool* offload_pool)
+: sessions {}, timers {TIMER_WHEEL_DEFAULT_TICK_MS, timer_clock_ms()}, expired_timers {}, completions {}, handler {request_handler}, body_handler {request_body_handler}, is_running {running_flag} {
+    this->pool = offload_pool;
+#if defined(H2PLUS_COROUTINES)
+    this->coro_handler = nullptr;
+#endif
+    this->next_serial = 0UL;
+    this->listen_fd = -1;
+    this->epoll_fd = -1;
+    this->recv_window_limit = H2_DEFAULT_RECV_WINDOW_LIMIT;
+    this->idle_timeout_ms = SERVER_IDLE_TIMEOUT_MS;
+    this->handshake_timeout_ms = SERVER_HANDSHAKE_TIMEOUT_MS;
+    this->header_timeout_ms = SERVER_HEADER_TIMEOUT_MS;
+}
+
+ServerLoop::~ServerLoop() {
+    std::vector<int> open_fds {};
+
+    for (const auto& [socket_fd, session] : this->sessions) {
+        (void)session;
+        open_fds.push_back(socket_fd);
+    }
+
+    for (int socket_fd : open_fds) {
+        close_session(socket_fd);
+    }
+
+    if (this->listen_fd != -1) {
+        close(this->listen_fd);
+    }
+
+    if (this->epoll_fd != -1) {
+        close(this->epoll_fd);
+    }
+}
+
+#if defined(H2PLUS_COROUTINES)
+void ServerLoop::set_coro_handler(const CoroHandler* handler) {
+    this->coro_handler = handler;
+}
+#endif
+
+bool ServerLoop::listen_on(const ServerConfig& config) {
+    addrinfo hints {};
+    addrinfo* address = nullptr;
+    std::string port_text = std::to_string(config.port);
+    int enable = 1;
+
+    this->recv_window_limit = config.recv_window_limit;
+    this->idle_timeout_ms = config.idle_timeout_ms;
+    this->handshake_timeout_ms = config.handshake_timeout_ms;
+    this->header_timeout_ms = config.header_timeout_ms;
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+
+    if (getaddrinfo((config.host.empty()) ? nullptr : config.host.c_str(), port_text.c_str(), &hints, &address) != 0 || !address) {
+        return false;
+    }
+
+    this->listen_fd = socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, address->ai_protocol);
+
+    bool is_ok = this->listen_fd != -1
+        && setsockopt(this->listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) == 0
+        && setsockopt(this->listen_fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) == 0
+        && bind(this->listen_fd, address->ai_addr, address->ai_addrlen) == 0
+        && listen(this->listen_fd, SERVER_LISTEN_BACKLOG) == 0;
+
+    freeaddrinfo(address);
+
+    if (!is_ok) {
+        return false;
+    }
+
+    this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+    epoll_event event {};
+
+    event.events = EPOLLIN;
+    event.data.fd = this->listen_fd;
+
+    if (this->epoll_fd == -1 || epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->listen_fd, &event) != 0) {
+        return false;
+    }
+
+    if (!this->pool || !this->completions.is_ready()) {
+        return true;
+    }
+
+    event.events = EPOLLIN;
+    event.data.fd = this->completions.get_wakeup_fd();
+
+    return epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->completions.get_wakeup_fd(), &event) == 0;
+}
+
+void ServerLoop::run() {
+    epoll_event events[SERVER_MAX_EVENTS];
+
+    while (this->is_running.load(std::memory_order_relaxed)) {
+        const int timer_wait_ms = this->timers.next_timeout_ms(timer_clock_ms());
+        const int poll_timeout_ms = (timer_wait_ms < 0 || timer_wait_ms > SERVER_POLL_TIMEOUT_MS) ? SERVER_POLL_TIMEOUT_MS : timer_wait_ms;
+        int ready_count = epoll_wait(this->epoll_fd, events, SERVER_MAX_EVENTS, poll_timeout_ms);
+
+        if (ready_count == -1 && errno != EINTR) {
+            return;
+        }
+
+        for (int event_i = 0; event_i < ready_count; event_i++) {
+            const int event_fd = events[event_i].data.fd;
+            const uint32_t flags = events[event_i].events;
+
+            if (event_fd == this->listen_fd) {
+                accept_clients();
+                continue;
+            }
+
+            // Each completion services its own session; see `complete_offload`.
+            if (event_fd == this->completions.get_wakeup_fd()) {
+                this->completions.drain();
+                continue;
+            }
+
+            auto session_it = this->sessions.find(event_fd);
+
+            if (session_it == this->sessions.end()) {
+                continue;
+            }
+
+            Session& session = *session_it->second;
+
+            if ((flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0U) {
+                on_readable(session);
+            }
+
+            // HUP and ERR are reported even while EPOLLIN is off, and a paused session would never read the EOF.
+            if ((flags & (EPOLLHUP | EPOLLERR)) != 0U && !session.wants_read) {
+                session.connection.on_peer_closed();
+            }
+
+            if (!flush(session) || session.connection.should_close()) {
+                close_session(event_fd);
+                continue;
+            }
+
+            refresh_timers(session);
+        }
+
+        this->timers.advance(timer_clock_ms());
+
+        for (const auto& expired : this->expired_timers) {
+            expire_session(expired);
+        }
+
+        this->expired_timers.clear();
+    }
+}
+
+/* Server Impl. */
+
+Server::Server(RequestHandler request_handler, BodyHandler request_body_handler)
+: loops {}, threads {}, pool {}, handler {std::move(request_handler)}, body_handler {std::move(request_body_handler)}, is_running {false} {}
+
+Server::~Server() {
+    stop();
+    wait();
+}
+
+#if defined(H2PLUS_COROUTINES)
+void Server::set_coro_handler(CoroHandler handler) {
+    this->coro_handler = std::move(handler);
+}
+#endif
+
+bool Server::start(const ServerConfig& config) {
+    this->is_running.store(true);
+
+    if (config.pool_workers > 0U) {
+        this->pool = std::make_unique<ThreadPool>(config.pool_workers);
+    }
+
+    for (uint32_t loop_i = 0U; loop_i < config.loop_count; loop_i++) {
+        auto loop = std::make_unique<ServerLoop>(this->handler, this->body_handler, this->is_running, this->pool.get());
+
+#if defined(H2PLUS_COROUTINES)
+        loop->set_coro_handler(&this->coro_handler);
+#endif
+
+        if (!loop->listen_on(config)) {
+            this->loops.clear();
+            this->pool.reset();
+            return false;
+        }
+
+        this->loops.push_back(std::move(loop));
+    }
+
+    for (auto& loop : this->loops) {
+        this->threads.emplace_back(&ServerLoop::run, loop.get());
+    }
+
+    return true;
+}
+
+void Server::stop() {
+    this->is_running.store(false);
+}
+
+void Server::wait() {
+    for (auto& loop_thread : this->threads) {
+        if (loop_thread.joinable()) {
+            loop_thread.join();
+        }
+    }
+
+    this->threads.clear();
+
+    // Jobs still running finish first, and post into completion queues that are still there; their completions are then dropped with the loops.
+    this->pool.reset();
+    this->loops.clear();
+}
@@ -0,0 +1,204 @@
+/**
+ * @file hdrhistogram.cpp
+ * @author Derek Tan
+ * @brief Implements the high dynamic range latency histogram.
+ * @date 2026-10-19
+ */
+
+#include <cmath>
+#include "utils/hdrhistogram.hpp"
+
+/* HdrHistogram Private Impl. */
+
+int32_t HdrHistogram::get_bucket_index(uint64_t value) const {
+    // Position of the highest set bit, with the sub-bucket range folded into bucket 0.
+    int32_t pow2_ceiling = 64 - __builtin_clzll(value | this->sub_bucket_mask);
+
+    return pow2_ceiling - this->unit_magnitude - (this->sub_bucket_half_count_magnitude + 1);
+}
+
+int32_t HdrHistogram::get_sub_bucket_index(uint64_t value, int32_t bucket_index) const {
+    return static_cast<int32_t>(value >> (bucket_index + this->unit_magnitude));
+}
+
+size_t HdrHistogram::get_counts_index(int32_t bucket_index, int32_t sub_bucket_index) const {
+    int32_t bucket_base = (bucket_index + 1) << this->sub_bucket_half_count_magnitude;
+
+    return static_cast<size_t>(bucket_base + (sub_bucket_index - this->sub_bucket_half_count));
+}
+
+uint64_t HdrHistogram::get_value_at_index(size_t index) const {
+    int32_t bucket_index = static_cast<int32_t>(index >> this->sub_bucket_half_count_magnitude) - 1;
+    int32_t sub_bucket_index = static_cast<int32_t>(index & static_cast<size_t>(this->sub_bucket_half_count - 1)) + this->sub_bucket_half_count;
+
+    if (bucket_index < 0) {
+        sub_bucket_index -= this->sub_bucket_half_count;
+        bucket_index = 0;
+    }
+
+    return static_cast<uint64_t>(sub_bucket_index) << (bucket_index + this->unit_magnitude);
+}
+
+uint64_t HdrHistogram::get_highest_equivalent(uint64_t value) const {
+    int32_t bucket_index = get_bucket_index(value);
+    int32_t sub_bucket_index = get_sub_bucket_index(value, bucket_index);
+    uint64_t lowest_equivalent = static_cast<uint64_t>(sub_bucket_index) << (bucket_index + this->unit_magnitude);
+    int32_t adjusted_bucket = (sub_bucket_index >= this->sub_bucket_count) ? bucket_index + 1 : bucket_index;
+    uint64_t range_size = 1ULL << (this->unit_magnitude + adjusted_bucket);
+
+    return lowest_equivalent + range_size - 1ULL;
+}
+
+/* HdrHistogram Public Impl. */
+
+HdrHistogram::HdrHistogram(uint64_t lowest, uint64_t highest, uint32_t sig_figures) : counts {} {
+    this->lowest_trackable = (lowest < 1UL) ? 1UL : lowest;
+    this->highest_trackable = (highest < 2UL * this->lowest_trackable) ? 2UL * this->lowest_trackable : highest;
+    this->significant_figures = (sig_figures < 1U) ? 1U : ((sig_figures > 5U) ? 5U : sig_figures);
+
+    // Enough linear sub-buckets per power of two to keep the requested decimal precision.
+    uint64_t largest_single_unit = 2UL * static_cast<uint64_t>(std::pow(10.0, this->significant_figures));
+    int32_t sub_bucket_count_magnitude = static_cast<int32_t>(std::ceil(std::log2(static_cast<double>(largest_single_unit))));
+
+    this->unit_magnitude = 63 - __builtin_clzll(this->lowest_trackable);
+    this->sub_bucket_half_count_magnitude = ((sub_bucket_count_magnitude > 1) ? sub_bucket_count_magnitude : 1) - 1;
+    this->sub_bucket_count = 1 << (this->sub_bucket_half_count_magnitude + 1);
+    this->sub_bucket_half_count = this->sub_bucket_count / 2;
+    this->sub_bucket_mask = static_cast<uint64_t>(this->sub_bucket_count - 1) << this->unit_magnitude;
+
+    uint64_t smallest_untrackable = static_cast<uint64_t>(this->sub_bucket_count) << this->unit_magnitude;
+    int32_t bucket_count = 1;
+
+    while (smallest_untrackable <= this->highest_trackable) {
+        if (smallest_untrackable > (UINT64_MAX >> 1)) {
+            bucket_count++;
+            break;
+        }
+
+        smallest_untrackable <<= 1;
+        bucket_count++;
+    }
+
+    this->counts.assign(static_cast<size_t>((bucket_count + 1) * this->sub_bucket_half_count), 0UL);
+    reset();
+}
+
+void HdrHistogram::record(uint64_t value) {
+    record_n(value, 1UL);
+}
+
+void HdrHistogram::record_n(uint64_t value, uint64_t count) {
+    if (value > this->highest_trackable) {
+        value = this->highest_trackable;
+        this->clamped_count += count;
+    }
+
+    int32_t bucket_index = get_bucket_index(value);
+    size_t counts_index = get_counts_index(bucket_index, get_sub_bucket_index(value, bucket_index));
+
+    if (counts_index >= this->counts.size()) {
+        counts_index = this->counts.size() - 1UL;
+    }
+
+    this->counts[counts_index] += count;
+    this->total_count += count;
+    this->value_sum += static_cast<double>(value) * static_cast<double>(count);
+
+    if (value < this->min_value) {
+        this->min_value = value;
+    }
+
+    if (value > this->max_value) {
+        this->max_value = value;
+    }
+}
+
+void HdrHistogram::merge(const HdrHistogram& other) {
+    // Histograms with the same layout add bucket by bucket; anything else is re-recorded value by value.
+    if (other.counts.size() == this->counts.size() && other.unit_magnitude == this->unit_magnitude
+        && other.sub_bucket_count == this->sub_bucket_count) {
+        for (size_t index = 0UL; index < this->counts.size(); index++) {
+            this->counts[index] += other.counts[index];
+        }
+
+        this->total_count += other.total_count;
+        this->clamped_count += other.clamped_count;
+        this->value_sum += other.value_sum;
+
+        if (other.total_count > 0UL) {
+            this->min_value = (other.min_value < this->min_value) ? other.min_value : this->min_value;
+            this->max_value = (other.max_value > this->max_value) ? other.max_value : this->max_value;
+        }
+
+        return;
+    }
+
+    for (size_t index = 0UL; index < other.counts.size(); index++) {
+        if (other.counts[index] > 0UL) {
+            record_n(other.get_value_at_index(index), other.counts[index]);
+        }
+    }
+}
+
+void HdrHistogram::reset() {
+    for (auto& count : this->counts) {
+        count = 0UL;
+    }
+
+    this->total_count = 0UL;
+    this->clamped_count = 0UL;
+    this->min_value = UINT64_MAX;
+    this->max_value = 0UL;
+    this->value_sum = 0.0;
+}
+
+uint64_t HdrHistogram::get_count() const {
+    return this->total_count;
+}
+
+uint64_t HdrHistogram::get_clamped_count() const {
+    return this->clamped_count;
+}
+
+uint64_t HdrHistogram::get_min() const {
+    return (this->total_count > 0UL) ? this->min_value : 0UL;
+}
+
+uint64_t HdrHistogram::get_max() const {
+    return this->max_value;
+}
+
+double HdrHistogram::get_mean() const {
+    return (this->total_count > 0UL) ? this->value_sum / static_cast<double>(this->total_count) : 0.0;
+}
+
+uint64_t HdrHistogram::get_value_at_percentile(double percentile) const {
+    if (this->total_count == 0UL) {
+        return 0UL;
+    }
+
+    double clamped_percentile = (percentile > 100.0) ? 100.0 : ((percentile < 0.0) ? 0.0 : percentile);
+    uint64_t count_at_percentile = static_cast<uint64_t>(clamped_percentile / 100.0 * static_cast<double>(this->total_count) + 0.5);
+    uint64_t running_count = 0UL;
+
+    if (count_at_percentile < 1UL) {
+        count_at_percentile = 1UL;
+    }
+
+    for (size_t index = 0UL; index < this->counts.size(); index++) {
+        running_count += this->counts[index];
+
+        if (running_count >= count_at_percentile) {
+            uint64_t bucket_value = get_highest_equivalent(get_value_at_index(index));
+
+            // Never report past the largest value actually seen.
+            return (bucket_value > this->max_value) ? this->max_value : bucket_value;
+        }
+    }
+
+    return this->max_value;
+}
+
+size_t HdrHistogram::get_footprint() const {
+    return this->counts.size() * sizeof(uint64_t);
+}
@@ -0,0 +1,247 @@
+/**
+ * @file headercorpus.cpp
+ * @author Derek Tan
+ * @brief Implements the benchmark header corpus. Values are modelled on current desktop Chrome and Firefox traffic and on common CDN responses.
+ * @date 2026-10-19
+ */
+
+#include "bench/headercorpus.hpp"
+
+/* Requests */
+
+static const CorpusField CHROME_NAVIGATE[] = {
+    {":method", "GET"},
+    {":scheme", "https"},
+    {":authority", "www.example.com"},
+    {":path", "/"},
+    {"sec-ch-ua", "\"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\""},
+    {"sec-ch-ua-mobile", "?0"},
+    {"sec-ch-ua-platform", "\"Linux\""},
+    {"upgrade-insecure-requests", "1"},
+    {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36"},
+    {"accept", "text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,image/apng,*/*;q=0.8,application/signed-exchange;v=b3;q=0.7"},
+    {"sec-fetch-site", "none"},
+    {"sec-fetch-mode", "navigate"},
+    {"sec-fetch-user", "?1"},
+    {"sec-fetch-dest", "document"},
+    {"accept-encoding", "gzip, deflate, br, zstd"},
+    {"accept-language", "en-US,en;q=0.9"},
+    {"cookie", "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; _ga=GA1.1.1843270671.1715612345; _ga_X1Y2Z3=GS1.1.1715612345.3.1.1715612399.0.0.0"}
+};
+
+static const CorpusField CHROME_STYLESHEET[] = {
+    {":method", "GET"},
+    {":scheme", "https"},
+    {":authority", "www.example.com"},
+    {":path", "/static/css/site.3f9a2c.css"},
+    {"sec-ch-ua", "\"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\""},
+    {"sec-ch-ua-mobile", "?0"},
+    {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36"},
+    {"sec-ch-ua-platform", "\"Linux\""},
+    {"accept", "text/css,*/*;q=0.1"},
+    {"sec-fetch-site", "same-origin"},
+    {"sec-fetch-mode", "no-cors"},
+    {"sec-fetch-dest", "style"},
+    {"referer", "https://www.example.com/"},
+    {"accept-encoding", "gzip, deflate, br, zstd"},
+    {"accept-language", "en-US,en;q=0.9"},
+    {"cookie", "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; _ga=GA1.1.1843270671.1715612345; _ga_X1Y2Z3=GS1.1.1715612345.3.1.1715612399.0.0.0"}
+};
+
+static const CorpusField CHROME_SCRIPT[] = {
+    {":method", "GET"},
+    {":scheme", "https"},
+    {":authority", "www.example.com"},
+    {":path", "/static/js/app.8c1d77e0.js"},
+    {"sec-ch-ua", "\"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\""},
+    {"sec-ch-ua-mobile", "?0"},
+    {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36"},
+    {"sec-ch-ua-platform", "\"Linux\""},
+    {"accept", "*/*"},
+    {"sec-fetch-site", "same-origin"},
+    {"sec-fetch-mode", "no-cors"},
+    {"sec-fetch-dest", "script"},
+    {"referer", "https://www.example.com/"},
+    {"accept-encoding", "gzip, deflate, br, zstd"},
+    {"accept-language", "en-US,en;q=0.9"},
+    {"cookie", "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; _ga=GA1.1.1843270671.1715612345; _ga_X1Y2Z3=GS1.1.1715612345.3.1.1715612399.0.0.0"}
+};
+
+static const CorpusField CHROME_IMAGE[] = {
+    {":method", "GET"},
+    {":scheme", "https"},
+    {":authority", "www.example.com"},
+    {":path", "/static/img/hero-1440w.avif"},
+    {"sec-ch-ua", "\"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\""},
+    {"sec-ch-ua-mobile", "?0"},
+    {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36"},
+    {"sec-ch-ua-platform", "\"Linux\""},
+    {"accept", "image/avif,image/webp,image/apng,image/svg+xml,image/*,*/*;q=0.8"},
+    {"sec-fetch-site", "same-origin"},
+    {"sec-fetch-mode", "no-cors"},
+    {"sec-fetch-dest", "image"},
+    {"referer", "https://www.example.com/"},
+    {"accept-encoding", "gzip, deflate, br, zstd"},
+    {"accept-language", "en-US,en;q=0.9"},
+    {"cookie", "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; _ga=GA1.1.1843270671.1715612345; _ga_X1Y2Z3=GS1.1.1715612345.3.1.1715612399.0.0.0"}
+};
+
+static const CorpusField CHROME_API_POST[] = {
+    {":method", "POST"},
+    {":scheme", "https"},
+    {":authority", "www.example.com"},
+    {":path", "/api/v1/events?batch=1"},
+    {"content-length", "348"},
+    {"sec-ch-ua", "\"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\""},
+    {"content-type", "application/json"},
+    {"sec-ch-ua-mobile", "?0"},
+    {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36"},
+    {"sec-ch-ua-platform", "\"Linux\""},
+    {"accept", "*/*"},
+    {"origin", "https://www.example.com"},
+    {"sec-fetch-site", "same-origin"},
+    {"sec-fetch-mode", "cors"},
+    {"sec-fetch-dest", "empty"},
+    {"referer", "https://www.example.com/"},
+    {"accept-encoding", "gzip, deflate, br, zstd"},
+    {"accept-language", "en-US,en;q=0.9"},
+    {"cookie", "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; _ga=GA1.1.1843270671.1715612345; _ga_X1Y2Z3=GS1.1.1715612345.3.1.1715612399.0.0.0"}
+};
+
+static const CorpusField FIREFOX_NAVIGATE[] = {
+    {":method", "GET"},
+    {":path", "/docs/getting-started?ref=nav"},
+    {":authority", "www.example.com"},
+    {":scheme", "https"},
+    {"user-agent", "Mozilla/5.0 (X11; Linux x86_64; rv:125.0) Gecko/20100101 Firefox/125.0"},
+    {"accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8"},
+    {"accept-language", "en-US,en;q=0.5"},
+    {"accept-encoding", "gzip, deflate, br, zstd"},
+    {"referer", "https://www.example.com/"},
+    {"upgrade-insecure-requests", "1"},
+    {"sec-fetch-dest", "document"},
+    {"sec-fetch-mode", "navigate"},
+    {"sec-fetch-site", "same-origin"},
+    {"sec-fetch-user", "?1"},
+    {"if-none-match", "\"5d8c72a5edda8d6a\""},
+    {"priority", "u=0, i"},
+    {"te", "trailers"}
+};
+
+static const CorpusField CURL_SIMPLE[] = {
+    {":method", "GET"},
+    {":scheme", "http"},
+    {":authority", "localhost:8080"},
+    {":path", "/health"},
+    {"user-agent", "curl/8.5.0"},
+    {"accept", "*/*"}
+};
+
+const CorpusHeaderSet REQUEST_CORPUS[] = {
+    {"chrome_navigate", CHROME_NAVIGATE, sizeof(CHROME_NAVIGATE) / sizeof(CorpusField)},
+    {"chrome_stylesheet", CHROME_STYLESHEET, sizeof(CHROME_STYLESHEET) / sizeof(CorpusField)},
+    {"chrome_script", CHROME_SCRIPT, sizeof(CHROME_SCRIPT) / sizeof(CorpusField)},
+    {"chrome_image", CHROME_IMAGE, sizeof(CHROME_IMAGE) / sizeof(CorpusField)},
+    {"chrome_api_post", CHROME_API_POST, sizeof(CHROME_API_POST) / sizeof(CorpusField)},
+    {"firefox_navigate", FIREFOX_NAVIGATE, sizeof(FIREFOX_NAVIGATE) / sizeof(CorpusField)},
+    {"curl_simple", CURL_SIMPLE, sizeof(CURL_SIMPLE) / sizeof(CorpusField)}
+};
+
+const size_t REQUEST_CORPUS_COUNT = sizeof(REQUEST_CORPUS) / sizeof(CorpusHeaderSet);
+
+/* Responses */
+
+static const CorpusField HTML_OK[] = {
+    {":status", "200"},
+    {"date", "Mon, 13 May 2024 15:12:25 GMT"},
+    {"content-type", "text/html; charset=utf-8"},
+    {"content-length", "18342"},
+    {"content-encoding", "br"},
+    {"vary", "accept-encoding"},
+    {"cache-control", "no-cache"},
+    {"etag", "\"5d8c72a5edda8d6a\""},
+    {"server", "h2plus/0.2"},
+    {"strict-transport-security", "max-age=63072000; includeSubDomains; preload"},
+    {"x-content-type-options", "nosniff"},
+    {"content-security-policy", "default-src 'self'; script-src 'self' 'sha256-47DEQpj8HBSa+/TImW+5JCeuQeRkm5NMpJWZG3hSuFU='; img-src 'self' data:; style-src 'self'; frame-ancestors 'none'"},
+    {"referrer-policy", "strict-origin-when-cross-origin"}
+};
+
+static const CorpusField STATIC_OK[] = {
+    {":status", "200"},
+    {"date", "Mon, 13 May 2024 15:12:25 GMT"},
+    {"content-type", "text/css"},
+    {"content-length", "4821"},
+    {"content-encoding", "br"},
+    {"vary", "accept-encoding"},
+    {"cache-control", "public, max-age=31536000, immutable"},
+    {"etag", "\"3f9a2c-12d5-65f1a9e0\""},
+    {"last-modified", "Wed, 13 Mar 2024 09:41:20 GMT"},
+    {"accept-ranges", "bytes"},
+    {"age", "5120"},
+    {"server", "h2plus/0.2"}
+};
+
+static const CorpusField SCRIPT_OK[] = {
+    {":status", "200"},
+    {"date", "Mon, 13 May 2024 15:12:25 GMT"},
+    {"content-type", "text/javascript; charset=utf-8"},
+    {"content-length", "91234"},
+    {"content-encoding", "br"},
+    {"vary", "accept-encoding"},
+    {"cache-control", "public, max-age=31536000, immutable"},
+    {"etag", "\"8c1d77e0-16462-65f1a9e0\""},
+    {"last-modified", "Wed, 13 Mar 2024 09:41:20 GMT"},
+    {"accept-ranges", "bytes"},
+    {"server", "h2plus/0.2"}
+};
+
+static const CorpusField NOT_MODIFIED[] = {
+    {":status", "304"},
+    {"date", "Mon, 13 May 2024 15:12:26 GMT"},
+    {"etag", "\"5d8c72a5edda8d6a\""},
+    {"cache-control", "no-cache"},
+    {"vary", "accept-encoding"},
+    {"server", "h2plus/0.2"}
+};
+
+static const CorpusField API_CREATED[] = {
+    {":status", "201"},
+    {"date", "Mon, 13 May 2024 15:12:27 GMT"},
+    {"content-type", "application/json"},
+    {"content-length", "57"},
+    {"cache-control", "no-store"},
+    {"access-control-allow-origin", "https://www.example.com"},
+    {"set-cookie", "session=4f2c9a1be07d4c1e9b3f6a8d2e5c7b90; Path=/; Max-Age=86400; Secure; HttpOnly; SameSite=Lax"},
+    {"x-request-id", "01HXRZK6Q9M4N2P7V3T8B5C1DE"},
+    {"server", "h2plus/0.2"}
+};
+
+static const CorpusField NOT_FOUND[] = {
+    {":status", "404"},
+    {"date", "Mon, 13 May 2024 15:12:28 GMT"},
+    {"content-type", "text/plain; charset=utf-8"},
+    {"content-length", "9"},
+    {"server", "h2plus/0.2"}
+};
+
+const CorpusHeaderSet RESPONSE_CORPUS[] = {
+    {"html_ok", HTML_OK, sizeof(HTML_OK) / sizeof(CorpusField)},
+    {"static_ok", STATIC_OK, sizeof(STATIC_OK) / sizeof(CorpusField)},
+    {"script_ok", SCRIPT_OK, sizeof(SCRIPT_OK) / sizeof(CorpusField)},
+    {"not_modified", NOT_MODIFIED, sizeof(NOT_MODIFIED) / sizeof(CorpusField)},
+    {"api_created", API_CREATED, sizeof(API_CREATED) / sizeof(CorpusField)},
+    {"not_found", NOT_FOUND, sizeof(NOT_FOUND) / sizeof(CorpusField)}
+};
+
+const size_t RESPONSE_CORPUS_COUNT = sizeof(RESPONSE_CORPUS) / sizeof(CorpusHeaderSet);
+
+size_t get_corpus_octets(const CorpusHeaderSet& header_set) {
+    size_t octets = 0UL;
+
+    for (size_t field_i = 0UL; field_i < header_set.count; field_i++) {
+        octets += header_set.fields[field_i].name.length() + header_set.fields[field_i].value.length();
+    }
+
+    return octets;
+}
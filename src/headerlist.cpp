@@ -0,0 +1,162 @@
+/**
+ * @file headerlist.cpp
+ * @author Derek Tan
+ * @brief Implements the decoded header list of one stream.
+ * @date 2026-10-19
+ */
+
+#include "hpack/headerlist.hpp"
+
+constexpr std::string_view PSEUDO_HEADER_NAMES[] = {":method", ":scheme", ":authority", ":path", ":status"};
+constexpr std::string_view COOKIE_NAME = "cookie";
+constexpr std::string_view COOKIE_SEPARATOR = "; ";
+
+/* Helper Impl. */
+
+PseudoHeader find_pseudo_header(std::string_view name) {
+    for (size_t slot_i = 0UL; slot_i < static_cast<size_t>(PseudoHeader::count); slot_i++) {
+        if (PSEUDO_HEADER_NAMES[slot_i] == name) {
+            return static_cast<PseudoHeader>(slot_i);
+        }
+    }
+
+    return PseudoHeader::count;
+}
+
+/* HeaderList Private Impl. */
+
+HeaderField* HeaderList::find_cookie() {
+    for (auto& field : this->fields) {
+        if (field.name == COOKIE_NAME) {
+            return &field;
+        }
+    }
+
+    return nullptr;
+}
+
+void HeaderList::put_field(std::string_view name, std::string_view value) {
+    if (name.empty() || name[0] != ':') {
+        this->fields.push_back(HeaderField {name, value});
+        return;
+    }
+
+    PseudoHeader slot = find_pseudo_header(name);
+    uint32_t slot_bit = 1U << static_cast<uint32_t>(slot);
+
+    // Unknown, repeated, or late pseudo-headers make the request malformed; they are dropped rather than stored.
+    if (slot == PseudoHeader::count || (this->pseudo_mask & slot_bit) != 0U || !this->fields.empty()) {
+        this->is_malformed = true;
+        return;
+    }
+
+    this->pseudo_slots[static_cast<size_t>(slot)] = value;
+    this->pseudo_mask |= slot_bit;
+}
+
+/* HeaderList Public Impl. */
+
+HeaderList::HeaderList() : pseudo_slots {}, fields {}, arena {} {
+    this->fields.reserve(HEADER_LIST_RESERVED_FIELDS);
+    this->pseudo_mask = 0U;
+    this->is_malformed = false;
+}
+
+bool HeaderList::add_field(std::string_view name, std::string_view value) {
+    // Joining straight from the decoder's text lets consecutive crumbs grow the first one in place.
+    if (HeaderField* cookie = (name == COOKIE_NAME) ? find_cookie() : nullptr; cookie) {
+        std::string_view joined = this->arena.join(cookie->value, COOKIE_SEPARATOR, value);
+
+        if (!joined.data()) {
+            return false;
+        }
+
+        cookie->value = joined;
+        return true;
+    }
+
+    std::string_view name_copy = this->arena.copy(name);
+    std::string_view value_copy = this->arena.copy(value);
+
+    if ((!name.empty() && !name_copy.data()) || (!value.empty() && !value_copy.data())) {
+        return false;
+    }
+
+    put_field(name_copy, value_copy);
+
+    return true;
+}
+
+void HeaderList::add_static_field(std::string_view name, std::string_view value) {
+    if (name == COOKIE_NAME && find_cookie()) {
+        add_field(name, value);
+        return;
+    }
+
+    put_field(name, value);
+}
+
+void HeaderList::clear() {
+    for (auto& slot : this->pseudo_slots) {
+        slot = {};
+    }
+
+    this->fields.clear();
+    this->arena.reset();
+    this->pseudo_mask = 0U;
+    this->is_malformed = false;
+}
+
+std::string_view HeaderList::get_pseudo(PseudoHeader slot) const {
+    return (slot < PseudoHeader::count) ? this->pseudo_slots[static_cast<size_t>(slot)] : std::string_view {};
+}
+
+bool HeaderList::has_pseudo(PseudoHeader slot) const {
+    return slot < PseudoHeader::count && (this->pseudo_mask & (1U << static_cast<uint32_t>(slot))) != 0U;
+}
+
+std::string_view HeaderList::get_method() const {
+    return this->pseudo_slots[static_cast<size_t>(PseudoHeader::method)];
+}
+
+std::string_view HeaderList::get_scheme() const {
+    return this->pseudo_slots[static_cast<size_t>(PseudoHeader::scheme)];
+}
+
+std::string_view HeaderList::get_authority() const {
+    return this->pseudo_slots[static_cast<size_t>(PseudoHeader::authority)];
+}
+
+std::string_view HeaderList::get_path() const {
+    return this->pseudo_slots[static_cast<size_t>(PseudoHeader::path)];
+}
+
+std::string_view HeaderList::get_status() const {
+    return this->pseudo_slots[static_cast<size_t>(PseudoHeader::status)];
+}
+
+const std::vector<HeaderField>& HeaderList::get_fields() const {
+    return this->fields;
+}
+
+const HeaderField* HeaderList::find_field(std::string_view name) const {
+    for (const auto& field : this->fields) {
+        if (field.name == name) {
+            return &field;
+        }
+    }
+
+    return nullptr;
+}
+
+size_t HeaderList::get_count() const {
+    return this->fields.size() + static_cast<size_t>(__builtin_popcount(this->pseudo_mask));
+}
+
+bool HeaderList::is_empty() const {
+    return this->fields.empty() && this->pseudo_mask == 0U;
+}
+
+bool HeaderList::is_well_formed() const {
+    return !this->is_malformed;
+}
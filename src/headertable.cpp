@@ -5,22 +5,74 @@
  * @date 2023-11-25
  */
 
+#include <utility>
 #include "hpack/headertable.hpp"
+#include "utils/metrics.hpp"
+
+constexpr uint32_t TABLE_MIN_SLOTS = 16U;
+
+/* Private HeaderIndexingTable Impl. */
+
+const HeaderTablePair& HeaderIndexingTable::get_dynamic(uint32_t dynamic_index) const {
+    return this->dynamic_slots[(this->newest_slot + dynamic_index) % this->dynamic_slots.size()];
+}
+
+void HeaderIndexingTable::grow_slots() {
+    std::vector<HeaderTablePair> grown {};
+    const size_t old_count = this->dynamic_slots.size();
+
+    grown.reserve((old_count == 0UL) ? TABLE_MIN_SLOTS : old_count * 2UL);
+
+    // Unroll the ring newest first, then pad with empty slots.
+    for (size_t slot_i = 0UL; slot_i < old_count; slot_i++) {
+        grown.push_back(std::move(this->dynamic_slots[(this->newest_slot + slot_i) % old_count]));
+    }
+
+    while (grown.size() < grown.capacity()) {
+        grown.emplace_back("", "");
+    }
+
+    this->dynamic_slots = std::move(grown);
+    this->newest_slot = 0U;
+}
+
+void HeaderIndexingTable::evict_back() {
+    // The oldest slot keeps its strings for a later insert to reuse.
+    size_t entry_overhead = compute_entry_overhead(get_dynamic(this->dynamic_length - 1U));
+
+    this->table_size -= entry_overhead;
+    this->dynamic_length--;
+
+    metrics_add(Metric::hpack_table_evictions);
+    metrics_sub(Metric::hpack_table_octets, entry_overhead);
+    metrics_sub(Metric::hpack_table_entries);
+}
 
 /* Public HeaderIndexingTable Impl. */
 
-HeaderIndexingTable::HeaderIndexingTable() : dynamic_table {} {
+HeaderIndexingTable::HeaderIndexingTable() : dynamic_slots {} {
     this->static_table = STATIC_HEADER_TABLE;
     this->table_capacity = TABLE_DEFAULT_SIZE;
     this->table_size = 0UL;
     this->static_length = STATIC_TABLE_LENGTH;
     this->dynamic_length = 0U;
+    this->newest_slot = 0U;
+}
+
+HeaderIndexingTable::~HeaderIndexingTable() {
+    // Take this table's share back out of the occupancy gauges.
+    metrics_sub(Metric::hpack_table_octets, this->table_size);
+    metrics_sub(Metric::hpack_table_entries, this->dynamic_length);
 }
 
 size_t HeaderIndexingTable::get_size() const {
     return this->table_size;
 }
 
+size_t HeaderIndexingTable::get_capacity() const {
+    return this->table_capacity;
+}
+
 uint32_t HeaderIndexingTable::get_total_length() const {
     return this->dynamic_length + this->static_length;
 }
@@ -31,41 +83,28 @@ bool HeaderIndexingTable::is_full() const {
 
 void HeaderIndexingTable::update_capacity(size_t new_capacity) {
     /// @todo 1: The risk is that the new_capacity may be too large from the client's wishes. I should put an implementation defined hard limit on this value.
- 
-    uint32_t temp_dyntable_length = this->dynamic_length; // temp copy of dynamic entry count
-    size_t temp_dyntable_size = this->table_size; // copy of total table size
-    size_t temp_entry_size = 0UL; // temp size of evicting entry
 
     // Update table size
     this->table_capacity = new_capacity;
 
-    // Handle special case of clear dynamic table
-    if (this->table_capacity == 0UL) {
-        this->dynamic_table.clear();
-        this->table_size = 0UL;
-        this->dynamic_length = 0U;
-        return;
+    // Evict entries only if current memory size exceeds the new limit, which also covers clearing the table for a zero capacity.
+    while (this->table_size > this->table_capacity) {
+        evict_back();
     }
+}
 
-    // Evict entries only if current memory size exceeds the new limit
-    if (this->is_full()) {
-        while (temp_dyntable_size > this->table_capacity) {
-            const HeaderTablePair& old_entry = this->dynamic_table.back();
-            temp_entry_size = compute_entry_overhead(old_entry);
-            this->dynamic_table.pop_back();
-    
-            temp_dyntable_size -= temp_entry_size;
-            temp_dyntable_length--;
-        }
+void HeaderIndexingTable::clear_dynamic() {
+    metrics_add(Metric::hpack_table_evictions, this->dynamic_length);
+    metrics_sub(Metric::hpack_table_octets, this->table_size);
+    metrics_sub(Metric::hpack_table_entries, this->dynamic_length);
 
-        this->table_size = temp_dyntable_size;
-        this->dynamic_length = temp_dyntable_length;
-    }
+    this->table_size = 0UL;
+    this->dynamic_length = 0U;
 }
 
 bool HeaderIndexingTable::has_entry(const std::string& name) const {
-    for (auto& item : this->dynamic_table) {
-        if (item.get_name() == name) {
+    for (uint32_t dynamic_i = 0U; dynamic_i < this->dynamic_length; dynamic_i++) {
+        if (get_dynamic(dynamic_i).get_name() == name) {
             return true;
         }
     }
@@ -80,26 +119,47 @@ const HeaderTablePair& HeaderIndexingTable::get_entry(uint32_t index) const {
     if (real_index < curr_static_length) {
         return this->static_table[real_index];
     } else if (real_index < curr_static_length + this->dynamic_length) {
-        return this->dynamic_table.at(real_index - curr_static_length);
+        return get_dynamic(real_index - curr_static_length);
     }
 
     return this->static_table[0];
 }
 
-void HeaderIndexingTable::put_entry(const HeaderTablePair& entry) {
-    size_t entry_overhead = compute_entry_overhead(entry);
+uint32_t HeaderIndexingTable::find_entry(std::string_view name, std::string_view value) const {
+    // Only the dynamic part: static lookups go through `find_static_index`.
+    for (uint32_t dynamic_i = 0U; dynamic_i < this->dynamic_length; dynamic_i++) {
+        const HeaderTablePair& entry = get_dynamic(dynamic_i);
+
+        if (entry.get_value() == value && entry.get_name() == name) {
+            return this->static_length + dynamic_i + 1U;
+        }
+    }
+
+    return 0U;
+}
 
-    this->dynamic_table.push_front(entry);
+void HeaderIndexingTable::put_entry(std::string_view name, std::string_view value) {
+    size_t entry_overhead = ENTRY_OVERHEAD + name.length() + value.length();
+
+    if (this->dynamic_length == this->dynamic_slots.size()) {
+        grow_slots();
+    }
+
+    this->newest_slot = static_cast<uint32_t>((this->newest_slot + this->dynamic_slots.size() - 1UL) % this->dynamic_slots.size());
+    this->dynamic_slots[this->newest_slot].assign(name, value);
     this->table_size += entry_overhead;
     this->dynamic_length++;
 
-    // If the table passes its memory capacity again, evict entries until size is OK
-    while (this->is_full()) {
-        const HeaderTablePair& temp_back_entry = this->dynamic_table.back();
-        entry_overhead = compute_entry_overhead(temp_back_entry);
-        this->dynamic_table.pop_back();
+    metrics_add(Metric::hpack_table_inserts);
+    metrics_add(Metric::hpack_table_octets, entry_overhead);
+    metrics_add(Metric::hpack_table_entries);
 
-        this->table_size -= entry_overhead;
-        this->dynamic_length--;
+    // If the table passes its memory capacity again, evict entries until size is OK. An entry that exactly fills the table stays (RFC 7541 4.4).
+    while (this->table_size > this->table_capacity) {
+        evict_back();
     }
 }
+
+void HeaderIndexingTable::put_entry(const HeaderTablePair& entry) {
+    put_entry(entry.get_name(), entry.get_value());
+}
@@ -0,0 +1,56 @@
+#ifndef FREQSKETCH_HPP
+#define FREQSKETCH_HPP
+
+/**
+ * @file freqsketch.hpp
+ * @author Derek Tan
+ * @brief Declares the count-min frequency sketch behind the encoder's TinyLFU indexing admission.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+constexpr uint32_t SKETCH_ROWS = 4U;
+constexpr uint32_t SKETCH_DEFAULT_WIDTH = 256U;   // counters per row, a power of two
+constexpr uint8_t SKETCH_COUNTER_MAX = 15U;       // counters saturate like 4-bit ones
+constexpr uint32_t SKETCH_SAMPLE_FACTOR = 10U;    // halve every counter after width * factor records
+
+/**
+ * @brief Hashes a header field for the sketch. The name and value are kept apart so `a: bc` and `ab: c` differ.
+ */
+uint64_t hash_header_field(std::string_view name, std::string_view value);
+
+/**
+ * @brief Count-min sketch of recent key frequencies (TinyLFU). Every key has one small counter per row and its estimate is the least of them, so collisions only ever overestimate.
+ * @note Counters are halved once enough records went in, so the sketch follows what is popular now instead of over the connection's whole life.
+ */
+class FrequencySketch {
+private:
+    std::vector<uint8_t> counters;   // `SKETCH_ROWS` rows of `width_mask + 1` counters
+    uint32_t width_mask;
+    uint32_t sample_count;
+    uint32_t sample_limit;
+
+    uint32_t get_slot(uint64_t key, uint32_t row) const;
+    void age();
+
+public:
+    FrequencySketch();
+
+    /**
+     * @brief Allocates `width` counters per row and clears them. An unsized sketch estimates 0 for every key.
+     */
+    void resize(uint32_t width);
+    void clear();
+
+    /**
+     * @brief Counts one sighting of `key`.
+     * @returns The key's estimate including this sighting.
+     */
+    uint32_t record(uint64_t key);
+    uint32_t estimate(uint64_t key) const;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef HEADERLIST_HPP
+#define HEADERLIST_HPP
+
+/**
+ * @file headerlist.hpp
+ * @author Derek Tan
+ * @brief Declares the decoded header list of one stream.
+ * @date 2026-10-19
+ */
+
+#include <string_view>
+#include <vector>
+#include "utils/bytearena.hpp"
+
+constexpr size_t HEADER_LIST_RESERVED_FIELDS = 32UL;   // twice the most regular fields of a header corpus set (15, chrome_api_post), for client hints and app headers
+
+enum class PseudoHeader : uint8_t {
+    method,
+    scheme,
+    authority,
+    path,
+    status,
+    count
+};
+
+struct HeaderField {
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * @brief Finds the slot of a pseudo-header name such as `:path`.
+ * @returns `PseudoHeader::count` for unknown names.
+ */
+PseudoHeader find_pseudo_header(std::string_view name);
+
+/**
+ * @brief Decoded headers of one stream. Pseudo-headers sit in fixed slots and the rest in a flat vector; all text is views into the list's own arena or into the static table.
+ * @note Views stay valid until `clear`, which keeps the arena and vector memory so a reused list decodes without allocating.
+ * Cookie crumbs sent as separate fields are joined back into the first `cookie` field with "; " (RFC 7540 8.1.2.5).
+ */
+class HeaderList {
+private:
+    std::string_view pseudo_slots[static_cast<size_t>(PseudoHeader::count)];
+    std::vector<HeaderField> fields;   // regular fields in arrival order
+    ByteArena arena;
+    uint32_t pseudo_mask;              // bit per filled pseudo slot
+    bool is_malformed;                 // pseudo-header rules broken (RFC 7540 8.1.2.1)
+
+    HeaderField* find_cookie();
+    void put_field(std::string_view name, std::string_view value);
+
+public:
+    HeaderList();
+
+    HeaderList(const HeaderList& other) = delete;
+    HeaderList& operator=(const HeaderList& other) = delete;
+
+    bool add_field(std::string_view name, std::string_view value);
+    void add_static_field(std::string_view name, std::string_view value);
+    void clear();
+
+    std::string_view get_pseudo(PseudoHeader slot) const;
+    bool has_pseudo(PseudoHeader slot) const;
+    std::string_view get_method() const;
+    std::string_view get_scheme() const;
+    std::string_view get_authority() const;
+    std::string_view get_path() const;
+    std::string_view get_status() const;
+
+    const std::vector<HeaderField>& get_fields() const;
+    const HeaderField* find_field(std::string_view name) const;
+    size_t get_count() const;
+    bool is_empty() const;
+    bool is_well_formed() const;
+};
+
+#endif
@@ -1,14 +1,23 @@
 #ifndef HEADERTABLE_HPP
 #define HEADERTABLE_HPP
 
-#include <deque>
+#include <string_view>
+#include <vector>
 #include "hpack/tables.hpp"
 
 constexpr size_t ENTRY_OVERHEAD = 32UL;
 constexpr uint32_t STATIC_TABLE_LENGTH = 61UL;
 constexpr size_t TABLE_DEFAULT_SIZE = 4096UL;
 
-constexpr size_t compute_entry_overhead(const HeaderTablePair& entry) {
+// First-octet patterns of header field representations (RFC 7541 6).
+constexpr uint8_t HPACK_INDEXED_FLAG = 0x80;       // 1xxxxxxx: indexed header field
+constexpr uint8_t HPACK_LITERAL_INDEXING = 0x40;   // 01xxxxxx: literal with incremental indexing
+constexpr uint8_t HPACK_LITERAL_PLAIN = 0x00;      // 0000xxxx: literal without indexing
+constexpr uint8_t HPACK_LITERAL_NEVER = 0x10;      // 0001xxxx: literal never indexed
+constexpr uint8_t HPACK_HUFFMAN_FLAG = 0x80;       // H bit of a string length
+constexpr uint8_t HPACK_SIZE_UPDATE_FLAG = 0x20;   // 001xxxxx: dynamic table size update
+
+inline size_t compute_entry_overhead(const HeaderTablePair& entry) {
     return ENTRY_OVERHEAD + entry.get_name().length() + entry.get_value().length();
 }
 
@@ -46,7 +55,7 @@ const HeaderTablePair STATIC_HEADER_TABLE[] = {
     {"content-range", ""},
     {"content-type", ""},
     {"cookie", ""},
-    {"data", ""},
+    {"date", ""},
     {"etag", ""},
     {"expect", ""},
     {"expires", ""},
@@ -77,23 +86,41 @@ const HeaderTablePair STATIC_HEADER_TABLE[] = {
     {"www-authenticate", ""},
 };
 
+/**
+ * @brief The static table plus one context's dynamic table (RFC 7541 2.3).
+ * @note Dynamic entries live in a ring of recycled slots, so once the ring and its strings have grown to the working set, inserts and evictions allocate nothing.
+ */
 class HeaderIndexingTable {
 private:
-    std::deque<HeaderTablePair> dynamic_table; // dynamic header field table
+    std::vector<HeaderTablePair> dynamic_slots; // ring of dynamic entries, newest at `newest_slot`
     const HeaderTablePair* static_table; // ptr to static array of header field classes
     size_t table_capacity; // maximum dynamic entry memory in octets permitted
     size_t table_size; // current dynamic entry memory in octets
     uint32_t static_length; // item count of static table
     uint32_t dynamic_length; // item count of dynamic table
+    uint32_t newest_slot; // slot of dynamic index 0
+
+    const HeaderTablePair& get_dynamic(uint32_t dynamic_index) const;
+    void grow_slots();
+    void evict_back();
 
 public:
     HeaderIndexingTable();
+    ~HeaderIndexingTable();
+
+    HeaderIndexingTable(const HeaderIndexingTable& other) = delete;
+    HeaderIndexingTable& operator=(const HeaderIndexingTable& other) = delete;
+
     size_t get_size() const;
+    size_t get_capacity() const;
     uint32_t get_total_length() const;
     bool is_full() const;
     void update_capacity(size_t new_capacity);
+    void clear_dynamic();
     bool has_entry(const std::string& name) const;
     const HeaderTablePair& get_entry(uint32_t index) const;
+    uint32_t find_entry(std::string_view name, std::string_view value) const;
+    void put_entry(std::string_view name, std::string_view value);
     void put_entry(const HeaderTablePair& entry);
 };
 
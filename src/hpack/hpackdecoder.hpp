@@ -0,0 +1,55 @@
+#ifndef HPACKDECODER_HPP
+#define HPACKDECODER_HPP
+
+/**
+ * @file hpackdecoder.hpp
+ * @author Derek Tan
+ * @brief Declares the HPACK header block decoder.
+ * @date 2026-10-19
+ */
+
+#include <string>
+#include "hpack/headerlist.hpp"
+#include "hpack/headertable.hpp"
+#include "hpack/huffxcoders.hpp"
+#include "hpack/intxcoder.hpp"
+
+constexpr size_t HPACK_DEFAULT_MAX_HEADER_LIST = 16384UL; // advertised SETTINGS_MAX_HEADER_LIST_SIZE
+
+/**
+ * @brief Outcome of decoding one header block.
+ */
+enum class HpackStatus {
+    ok,
+    header_list_too_large, // block was valid but passed the list limit: reset the stream or reply 431, the connection stays usable
+    compression_error      // malformed block: the dynamic table is out of sync, so this is a connection error (RFC 7540 4.3)
+};
+
+/**
+ * @brief Decodes HPACK header blocks (RFC 7541 6) against one connection's dynamic table.
+ * @note Static table fields are stored in `HeaderList` as views of the table; all other text is copied once into the list's arena.
+ * The decoded list size (name + value + 32 per field, RFC 7540 6.5.2) is checked before each field is copied, so an oversized block costs no more memory than the limit. Past the limit the rest of the block is still parsed to keep the dynamic table in sync, but fields are no longer emitted.
+ */
+class HpackDecoder {
+private:
+    HeaderIndexingTable table;
+    HuffmanDecoder huffman_decoder;
+    IntegerDecoder int_decoder;
+    size_t max_header_list_size;
+    size_t max_table_capacity;   // our SETTINGS_HEADER_TABLE_SIZE: the peer may not resize past this
+    std::string name_scratch;
+    std::string value_scratch;
+
+    bool read_integer(const uint8_t* block, uint32_t block_length, uint32_t& offset, uint8_t prefix_n, uint32_t& value);
+    HuffmanStatus read_string(const uint8_t* block, uint32_t block_length, uint32_t& offset, std::string& result, size_t max_length);
+
+public:
+    HpackDecoder(size_t max_list_size = HPACK_DEFAULT_MAX_HEADER_LIST, size_t max_capacity = TABLE_DEFAULT_SIZE);
+
+    const HeaderIndexingTable& get_table() const;
+    size_t get_max_header_list_size() const;
+    void set_max_header_list_size(size_t max_list_size);
+    HpackStatus decode_block(const uint8_t* block, uint32_t block_length, HeaderList& fields);
+};
+
+#endif
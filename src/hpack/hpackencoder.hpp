@@ -0,0 +1,96 @@
+#ifndef HPACKENCODER_HPP
+#define HPACKENCODER_HPP
+
+/**
+ * @file hpackencoder.hpp
+ * @author Derek Tan
+ * @brief Declares the HPACK header block encoder.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "hpack/freqsketch.hpp"
+#include "hpack/headertable.hpp"
+#include "hpack/huffxcoders.hpp"
+#include "hpack/intxcoder.hpp"
+
+constexpr size_t HPACK_DEFAULT_INDEX_SIZE_LIMIT = 128UL;   // entry size (RFC 7541 4.1) admitted by `size_threshold`
+constexpr uint32_t HPACK_FREQUENCY_ADMIT_MIN = 2U;          // sightings before `frequency` indexes a field
+
+/**
+ * @brief Decides which fields missing both tables go out as literals with incremental indexing rather than without indexing.
+ */
+enum class IndexingPolicy : uint8_t {
+    never,            // stateless output, the default
+    always,
+    size_threshold,   // only entries no larger than the size limit, so one big value cannot flush the table
+    frequency         // TinyLFU: only fields seen repeatedly, and only when hotter than the entry they would evict
+};
+
+/**
+ * @brief Finds the 1-based static table index of a header. Sets `full_match` when the value matches too.
+ * @returns 0 when no static entry has this name.
+ */
+uint32_t find_static_index(std::string_view name, std::string_view value, bool& full_match);
+
+/**
+ * @brief Encodes header fields into an HPACK header block (RFC 7541 6). Fields use static table references where possible and literals without indexing otherwise, so by default the output depends on no connection state and can be cached.
+ * @note An indexing policy other than `never`, or cookie splitting, keeps a dynamic table, so only an encoder that owns its connection's whole header stream may turn them on.
+ */
+class HpackEncoder {
+private:
+    HeaderIndexingTable table;   // mirrors the peer's decoder
+    FrequencySketch sketch;      // sized only under the `frequency` policy
+    HuffmanEncoder huffman_encoder;
+    IntegerEncoder int_encoder;
+    BitArray huffman_bits;   // scratch for Huffman output
+    OctetArray int_octets;   // scratch for integer output
+    size_t index_size_limit;
+    size_t min_update_capacity;   // smallest capacity set since the last block
+    IndexingPolicy policy;
+    bool is_splitting_cookies;
+    bool has_size_update;    // the table shrank and the next block must say so first
+
+    void put_integer(std::vector<uint8_t>& out, uint8_t flags, uint32_t prefix_n, uint32_t value);
+    void put_string(std::vector<uint8_t>& out, std::string_view text);
+    void put_cookie_crumb(std::vector<uint8_t>& out, std::string_view crumb);
+    bool should_index(std::string_view name, std::string_view value, uint32_t frequency, IndexingPolicy indexing_policy) const;
+
+public:
+    HpackEncoder();
+
+    /**
+     * @brief Picks how fields that miss both tables are sent. `size_limit` only applies to `size_threshold`.
+     * @note Switching policy keeps the table, which the peer's decoder holds either way.
+     */
+    void set_indexing_policy(IndexingPolicy indexing_policy, size_t size_limit = HPACK_DEFAULT_INDEX_SIZE_LIMIT);
+    IndexingPolicy get_indexing_policy() const;
+
+    /**
+     * @brief Bounds the table by the peer's SETTINGS_HEADER_TABLE_SIZE. Capacities above the 4096 octet default are not used.
+     * @note A change is announced by `begin_block`, which must then run before the next block's first field (RFC 7541 4.2). Several changes between blocks are announced as the smallest capacity reached, then the final one, so the peer evicts what this table did.
+     */
+    void set_table_capacity(size_t capacity);
+
+    /**
+     * @brief Starts a header block: writes pending dynamic table size updates, or nothing.
+     */
+    void begin_block(std::vector<uint8_t>& out);
+
+    /**
+     * @brief Tells whether the next block must open with a size update, which a block encoded elsewhere would lack.
+     */
+    bool has_pending_size_update() const;
+
+    /**
+     * @brief Sends each crumb of a `cookie` value as its own field (RFC 7540 8.1.2.5), indexed so a crumb repeated on later requests costs one or two octets.
+     * @note Crumbs pass the same admission as other fields, except that `never` judges them as `always`: a cookie header is resent on every request of the connection. A crumb turned down, such as one larger than the table, goes out without indexing.
+     */
+    void set_split_cookies(bool is_enabled);
+    void encode_field(std::vector<uint8_t>& out, std::string_view name, std::string_view value);
+};
+
+#endif
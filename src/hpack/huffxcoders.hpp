@@ -1,10 +1,20 @@
 #ifndef HUFFXCODERS_HPP
 #define HUFFXCODERS_HPP
 
+#include <string_view>
 #include "hpack/tables.hpp"
 #include "utils/octarr.hpp"
 #include "utils/symtree.hpp"
 
+/**
+ * @brief Outcome of a bounded Huffman decode.
+ */
+enum class HuffmanStatus {
+    ok,
+    invalid,  // bad code path, EOS inside the string, or bad padding (RFC 7541 5.2)
+    too_long  // output would pass the caller's limit: nothing past the limit was appended
+};
+
 /**
  * @brief Encodes an ASCII string into a 1-padded bit sequence according to static Huffman codes. The bits are stored in a BitArray object.
  * @note For HTTP/2 header Huffman compression.
@@ -14,7 +24,7 @@ private:
     const HuffmanCodePair* huffcodes_ptr; // pointer to statically created huffman code structs
 public:
     HuffmanEncoder(const HuffmanCodePair* huffcodes);
-    uint32_t encode(BitArray& result, const std::string& text);
+    uint32_t encode(BitArray& result, std::string_view text);
 };
 
 /**
@@ -25,15 +35,14 @@ public:
 class HuffmanDecoder {
 private:
     SymbolTree huffcode_tree;
-    const SymbolNode* tree_cursor;
     bool is_ready;
 
-    void reset_cursor();
     bool load_huffcode(const HuffmanCodePair* huffcode, uint8_t symbol);
 public:
     HuffmanDecoder(const HuffmanCodePair* huffcodes);
     bool setup_valid() const;
     bool decode(std::string& result, const OctetArray& raw_octets);
+    HuffmanStatus decode(std::string& result, const uint8_t* data, uint32_t data_length, size_t max_result_length);
 };
 
 #endif
\ No newline at end of file
@@ -34,12 +34,15 @@ class IntegerDecoder {
 private:
     uint32_t decoding_offset;  // offset from 1st octet in decoding
     uint8_t prefix;          // N-bit prefix of integer to decode
+    bool last_ok;            // false if the last decode ran out of octets or overflowed
 public:
     IntegerDecoder();
     uint32_t get_relative_offset() const;
+    bool is_ok() const;
     void set_offset(uint32_t offset);
     void set_prefix(uint8_t prefix_n);
     uint32_t decode_int(const OctetArray& buffer);
+    uint32_t decode_int(const uint8_t* data, uint32_t data_length);
     void reset();
 };
 
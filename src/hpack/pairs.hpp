@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 /**
  * @brief Simple class for the static header table of an HPACK context.
@@ -13,6 +14,8 @@ private:
     std::string value;
 public:
     HeaderTablePair(const char* name_cstr, const char* value_cstr);
+    HeaderTablePair(std::string name_str, std::string value_str);
+    void assign(std::string_view name_text, std::string_view value_text);
     const std::string& get_name() const;
     const std::string& get_value() const;
 };
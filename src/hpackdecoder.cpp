@@ -0,0 +1,218 @@
+/**
+ * @file hpackdecoder.cpp
+ * @author Derek Tan
+ * @brief Implements the HPACK header block decoder.
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include "hpack/hpackdecoder.hpp"
+#include "utils/metrics.hpp"
+
+constexpr uint8_t HPACK_INDEXED_PREFIX = 7U;
+constexpr uint8_t HPACK_INDEXING_PREFIX = 6U;
+constexpr uint8_t HPACK_LITERAL_PREFIX = 4U;
+constexpr uint8_t HPACK_SIZE_UPDATE_PREFIX = 5U;
+constexpr uint8_t HPACK_STRING_PREFIX = 7U;
+constexpr uint8_t HPACK_SIZE_UPDATE_MASK = 0xe0;
+constexpr uint8_t HPACK_INDEXING_MASK = 0xc0;
+
+/* HpackDecoder Private Impl. */
+
+bool HpackDecoder::read_integer(const uint8_t* block, uint32_t block_length, uint32_t& offset, uint8_t prefix_n, uint32_t& value) {
+    this->int_decoder.set_prefix(prefix_n);
+    this->int_decoder.set_offset(offset);
+
+    value = this->int_decoder.decode_int(block, block_length);
+    offset = this->int_decoder.get_relative_offset();
+
+    return this->int_decoder.is_ok();
+}
+
+HuffmanStatus HpackDecoder::read_string(const uint8_t* block, uint32_t block_length, uint32_t& offset, std::string& result, size_t max_length) {
+    uint32_t string_length = 0U;
+
+    result.clear();
+
+    if (offset >= block_length) {
+        return HuffmanStatus::invalid;
+    }
+
+    bool is_huffman = (block[offset] & HPACK_HUFFMAN_FLAG) != 0;
+
+    if (!read_integer(block, block_length, offset, HPACK_STRING_PREFIX, string_length) || string_length > block_length - offset) {
+        return HuffmanStatus::invalid;
+    }
+
+    const uint8_t* string_data = block + offset;
+    HuffmanStatus status = HuffmanStatus::ok;
+
+    /// @note The offset always moves past the whole string, so a too-long string can be skipped without decoding the rest of it.
+    offset += string_length;
+
+    metrics_add((is_huffman) ? Metric::hpack_decode_huffman_strings : Metric::hpack_decode_raw_strings);
+
+    if (is_huffman) {
+        status = this->huffman_decoder.decode(result, string_data, string_length, max_length);
+    } else if (string_length > max_length) {
+        status = HuffmanStatus::too_long;
+    } else {
+        result.assign(reinterpret_cast<const char*>(string_data), string_length);
+    }
+
+    return status;
+}
+
+/* HpackDecoder Public Impl. */
+
+HpackDecoder::HpackDecoder(size_t max_list_size, size_t max_capacity)
+: table {}, huffman_decoder {STATIC_HUFFMAN_CODES}, int_decoder {}, max_header_list_size {max_list_size}, max_table_capacity {max_capacity}, name_scratch {}, value_scratch {} {
+    this->table.update_capacity(max_capacity);
+}
+
+const HeaderIndexingTable& HpackDecoder::get_table() const {
+    return this->table;
+}
+
+size_t HpackDecoder::get_max_header_list_size() const {
+    return this->max_header_list_size;
+}
+
+void HpackDecoder::set_max_header_list_size(size_t max_list_size) {
+    this->max_header_list_size = max_list_size;
+}
+
+HpackStatus HpackDecoder::decode_block(const uint8_t* block, uint32_t block_length, HeaderList& fields) {
+    const size_t list_limit = this->max_header_list_size;
+    size_t list_size = 0UL;
+    uint32_t offset = 0U;
+    bool over_limit = false;
+    bool size_update_allowed = true; // table size updates may only lead the block (RFC 7541 4.2)
+
+    fields.clear();
+    metrics_add(Metric::hpack_decode_block_octets, block_length);
+
+    while (offset < block_length) {
+        const uint8_t lead_octet = block[offset];
+        uint32_t index = 0U;
+
+        if ((lead_octet & HPACK_INDEXED_FLAG) != 0) {
+            if (!read_integer(block, block_length, offset, HPACK_INDEXED_PREFIX, index) || index == 0U || index > this->table.get_total_length()) {
+                return HpackStatus::compression_error;
+            }
+
+            size_update_allowed = false;
+            metrics_add((index <= STATIC_TABLE_LENGTH) ? Metric::hpack_decode_static_hits : Metric::hpack_decode_dynamic_hits);
+
+            if (over_limit) {
+                continue;
+            }
+
+            const HeaderTablePair& entry = this->table.get_entry(index);
+            size_t field_size = compute_entry_overhead(entry);
+
+            if (list_size + field_size > list_limit) {
+                over_limit = true;
+                continue;
+            }
+
+            if (index <= STATIC_TABLE_LENGTH) {
+                fields.add_static_field(entry.get_name(), entry.get_value());
+            } else if (!fields.add_field(entry.get_name(), entry.get_value())) {
+                over_limit = true;
+                continue;
+            }
+
+            list_size += field_size;
+            metrics_add(Metric::hpack_decode_plain_octets, field_size - ENTRY_OVERHEAD);
+            continue;
+        }
+
+        if ((lead_octet & HPACK_SIZE_UPDATE_MASK) == HPACK_SIZE_UPDATE_FLAG) {
+            uint32_t new_capacity = 0U;
+
+            if (!size_update_allowed || !read_integer(block, block_length, offset, HPACK_SIZE_UPDATE_PREFIX, new_capacity) || new_capacity > this->max_table_capacity) {
+                return HpackStatus::compression_error;
+            }
+
+            this->table.update_capacity(new_capacity);
+            continue;
+        }
+
+        size_update_allowed = false;
+        metrics_add(Metric::hpack_decode_literal_fields);
+
+        bool is_indexing = (lead_octet & HPACK_INDEXING_MASK) == HPACK_LITERAL_INDEXING;
+        uint8_t prefix_n = (is_indexing) ? HPACK_INDEXING_PREFIX : HPACK_LITERAL_PREFIX;
+
+        if (!read_integer(block, block_length, offset, prefix_n, index) || index > this->table.get_total_length()) {
+            return HpackStatus::compression_error;
+        }
+
+        // Strings of this field may only use what is left of the list budget. A field that will be indexed must still be decoded up to the table capacity, or the table would drift from the encoder's.
+        size_t field_budget = 0UL;
+
+        if (!over_limit && list_size + ENTRY_OVERHEAD <= list_limit) {
+            field_budget = list_limit - list_size - ENTRY_OVERHEAD;
+        } else {
+            over_limit = true;
+        }
+
+        size_t string_limit = (is_indexing) ? std::max(field_budget, this->table.get_capacity()) : field_budget;
+        bool is_too_long = false;
+        HuffmanStatus status = HuffmanStatus::ok;
+
+        if (index != 0U) {
+            const std::string& indexed_name = this->table.get_entry(index).get_name();
+
+            is_too_long = indexed_name.length() > string_limit;
+
+            if (!is_too_long) {
+                this->name_scratch.assign(indexed_name);
+            }
+        } else {
+            status = read_string(block, block_length, offset, this->name_scratch, string_limit);
+            is_too_long = status == HuffmanStatus::too_long;
+
+            if (status == HuffmanStatus::invalid) {
+                return HpackStatus::compression_error;
+            }
+        }
+
+        size_t value_limit = (is_too_long) ? 0UL : string_limit - this->name_scratch.length();
+
+        status = read_string(block, block_length, offset, this->value_scratch, value_limit);
+
+        if (status == HuffmanStatus::invalid) {
+            return HpackStatus::compression_error;
+        }
+
+        is_too_long = is_too_long || status == HuffmanStatus::too_long;
+
+        if (is_too_long) {
+            over_limit = true;
+
+            /// @note Passing the string limit of an indexed field means the entry is bigger than the table, and adding it would have emptied the table (RFC 7541 4.4).
+            if (is_indexing) {
+                this->table.clear_dynamic();
+            }
+
+            continue;
+        }
+
+        size_t field_size = ENTRY_OVERHEAD + this->name_scratch.length() + this->value_scratch.length();
+
+        if (!over_limit && list_size + field_size <= list_limit && fields.add_field(this->name_scratch, this->value_scratch)) {
+            list_size += field_size;
+            metrics_add(Metric::hpack_decode_plain_octets, field_size - ENTRY_OVERHEAD);
+        } else {
+            over_limit = true;
+        }
+
+        if (is_indexing) {
+            this->table.put_entry(this->name_scratch, this->value_scratch);
+        }
+    }
+
+    return (over_limit) ? HpackStatus::header_list_too_large : HpackStatus::ok;
+}
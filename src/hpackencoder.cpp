@@ -0,0 +1,280 @@
+/**
+ * @file hpackencoder.cpp
+ * @author Derek Tan
+ * @brief Implements the HPACK header block encoder.
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include "hpack/hpackencoder.hpp"
+#include "utils/metrics.hpp"
+
+constexpr uint32_t HPACK_INDEXED_PREFIX = 7U;
+constexpr uint32_t HPACK_LITERAL_PREFIX = 4U;
+constexpr uint32_t HPACK_STRING_PREFIX = 7U;
+constexpr uint32_t HPACK_INDEXING_PREFIX = 6U;
+constexpr uint32_t HPACK_SIZE_UPDATE_PREFIX = 5U;
+constexpr uint32_t HPACK_COOKIE_INDEX = 32U;   // static entry for the `cookie` name
+
+/* Helper Impl. */
+
+uint32_t find_static_index(std::string_view name, std::string_view value, bool& full_match) {
+    uint32_t name_index = 0U;
+
+    full_match = false;
+
+    for (uint32_t entry_i = 0U; entry_i < STATIC_TABLE_LENGTH; entry_i++) {
+        const HeaderTablePair& entry = STATIC_HEADER_TABLE[entry_i];
+
+        if (entry.get_name() != name) {
+            continue;
+        }
+
+        if (entry.get_value() == value) {
+            full_match = true;
+            return entry_i + 1U;
+        }
+
+        /// @note Keep scanning: same-name entries are adjacent and a later one may match the value too.
+        if (name_index == 0U) {
+            name_index = entry_i + 1U;
+        }
+    }
+
+    return name_index;
+}
+
+/* HpackEncoder Private Impl. */
+
+void HpackEncoder::put_integer(std::vector<uint8_t>& out, uint8_t flags, uint32_t prefix_n, uint32_t value) {
+    this->int_encoder.reset();
+    this->int_encoder.set_prefix(prefix_n);
+
+    uint32_t octet_count = this->int_encoder.encode_int(this->int_octets, value);
+
+    // The integer encoder leaves the bits above the prefix clear, so the representation flags are OR'ed in here.
+    out.push_back(flags | this->int_octets.get_octet(0));
+
+    for (uint32_t octet_i = 1U; octet_i < octet_count; octet_i++) {
+        out.push_back(this->int_octets.get_octet(octet_i));
+    }
+}
+
+void HpackEncoder::put_string(std::vector<uint8_t>& out, std::string_view text) {
+    this->huffman_bits.clear();
+
+    uint32_t bit_count = this->huffman_encoder.encode(this->huffman_bits, text);
+    uint32_t huffman_length = bit_count / 8U;
+
+    /// @note Huffman coding can expand rare octets, so only use it when it actually saves space.
+    if (bit_count > 0U && huffman_length < text.length()) {
+        const uint8_t* huffman_octets = this->huffman_bits.get_octets();
+
+        put_integer(out, HPACK_HUFFMAN_FLAG, HPACK_STRING_PREFIX, huffman_length);
+        out.insert(out.end(), huffman_octets, huffman_octets + huffman_length);
+        metrics_add(Metric::hpack_encode_huffman_strings);
+        return;
+    }
+
+    metrics_add(Metric::hpack_encode_raw_strings);
+
+    put_integer(out, 0, HPACK_STRING_PREFIX, static_cast<uint32_t>(text.length()));
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+void HpackEncoder::put_cookie_crumb(std::vector<uint8_t>& out, std::string_view crumb) {
+    uint32_t dynamic_index = this->table.find_entry("cookie", crumb);
+    const uint32_t frequency = (this->policy != IndexingPolicy::never) ? this->sketch.record(hash_header_field("cookie", crumb)) : 0U;
+    const IndexingPolicy crumb_policy = (this->policy == IndexingPolicy::never) ? IndexingPolicy::always : this->policy;
+
+    if (dynamic_index != 0U) {
+        put_integer(out, HPACK_INDEXED_FLAG, HPACK_INDEXED_PREFIX, dynamic_index);
+        metrics_add(Metric::hpack_encode_dynamic_hits);
+        return;
+    }
+
+    if (!should_index("cookie", crumb, frequency, crumb_policy)) {
+        put_integer(out, HPACK_LITERAL_PLAIN, HPACK_LITERAL_PREFIX, HPACK_COOKIE_INDEX);
+        put_string(out, crumb);
+        metrics_add(Metric::hpack_encode_literal_fields);
+        return;
+    }
+
+    // Literal with incremental indexing on the static `cookie` name; the table update matches what the peer's decoder does.
+    put_integer(out, HPACK_LITERAL_INDEXING, HPACK_INDEXING_PREFIX, HPACK_COOKIE_INDEX);
+    put_string(out, crumb);
+    this->table.put_entry("cookie", crumb);
+    metrics_add(Metric::hpack_encode_literal_fields);
+}
+
+bool HpackEncoder::should_index(std::string_view name, std::string_view value, uint32_t frequency, IndexingPolicy indexing_policy) const {
+    const size_t entry_size = ENTRY_OVERHEAD + name.length() + value.length();
+
+    // An entry larger than the table would only empty it (RFC 7541 4.4).
+    if (entry_size > this->table.get_capacity()) {
+        return false;
+    }
+
+    switch (indexing_policy) {
+        case IndexingPolicy::always:
+            return true;
+        case IndexingPolicy::size_threshold:
+            return entry_size <= this->index_size_limit;
+        case IndexingPolicy::frequency:
+            break;
+        default:
+            return false;
+    }
+
+    if (frequency < HPACK_FREQUENCY_ADMIT_MIN) {
+        return false;
+    }
+
+    const uint32_t total_length = this->table.get_total_length();
+
+    // TinyLFU admission: when the insert evicts, the newcomer must be hotter than the oldest entry, which goes first.
+    if (this->table.get_size() + entry_size > this->table.get_capacity() && total_length > STATIC_TABLE_LENGTH) {
+        const HeaderTablePair& victim = this->table.get_entry(total_length);
+
+        return frequency > this->sketch.estimate(hash_header_field(victim.get_name(), victim.get_value()));
+    }
+
+    return true;
+}
+
+/* HpackEncoder Public Impl. */
+
+HpackEncoder::HpackEncoder() : table {}, sketch {}, huffman_encoder {STATIC_HUFFMAN_CODES}, int_encoder {}, huffman_bits {}, int_octets {} {
+    this->index_size_limit = HPACK_DEFAULT_INDEX_SIZE_LIMIT;
+    this->min_update_capacity = TABLE_DEFAULT_SIZE;
+    this->policy = IndexingPolicy::never;
+    this->is_splitting_cookies = false;
+    this->has_size_update = false;
+}
+
+void HpackEncoder::set_indexing_policy(IndexingPolicy indexing_policy, size_t size_limit) {
+    this->policy = indexing_policy;
+    this->index_size_limit = size_limit;
+
+    if (indexing_policy == IndexingPolicy::frequency) {
+        this->sketch.resize(SKETCH_DEFAULT_WIDTH);
+    } else {
+        this->sketch.resize(0U);
+    }
+}
+
+IndexingPolicy HpackEncoder::get_indexing_policy() const {
+    return this->policy;
+}
+
+void HpackEncoder::set_table_capacity(size_t capacity) {
+    const size_t new_capacity = std::min(capacity, TABLE_DEFAULT_SIZE);
+
+    if (new_capacity == this->table.get_capacity()) {
+        return;
+    }
+
+    if (!this->has_size_update || new_capacity < this->min_update_capacity) {
+        this->min_update_capacity = new_capacity;
+    }
+
+    this->table.update_capacity(new_capacity);
+    this->has_size_update = true;
+}
+
+void HpackEncoder::begin_block(std::vector<uint8_t>& out) {
+    if (!this->has_size_update) {
+        return;
+    }
+
+    const size_t final_capacity = this->table.get_capacity();
+
+    // A shrink followed by a regrowth still evicted entries, which the peer only learns from the smaller size (RFC 7541 4.2).
+    if (this->min_update_capacity < final_capacity) {
+        put_integer(out, HPACK_SIZE_UPDATE_FLAG, HPACK_SIZE_UPDATE_PREFIX, static_cast<uint32_t>(this->min_update_capacity));
+    }
+
+    put_integer(out, HPACK_SIZE_UPDATE_FLAG, HPACK_SIZE_UPDATE_PREFIX, static_cast<uint32_t>(final_capacity));
+    this->has_size_update = false;
+}
+
+bool HpackEncoder::has_pending_size_update() const {
+    return this->has_size_update;
+}
+
+void HpackEncoder::set_split_cookies(bool is_enabled) {
+    this->is_splitting_cookies = is_enabled;
+}
+
+void HpackEncoder::encode_field(std::vector<uint8_t>& out, std::string_view name, std::string_view value) {
+    bool full_match = false;
+    uint32_t static_index = find_static_index(name, value, full_match);
+    const size_t block_start = out.size();
+
+    metrics_add(Metric::hpack_encode_plain_octets, name.length() + value.length());
+
+    if (this->is_splitting_cookies && name == "cookie" && !value.empty()) {
+        size_t crumb_start = 0UL;
+
+        // Crumbs are split at ';' with the following spaces dropped, so the receiver's "; " join restores the value.
+        while (crumb_start < value.length()) {
+            size_t crumb_end = std::min(value.find(';', crumb_start), value.length());
+
+            if (crumb_end > crumb_start) {
+                put_cookie_crumb(out, value.substr(crumb_start, crumb_end - crumb_start));
+            }
+
+            crumb_start = value.find_first_not_of(' ', crumb_end + 1UL);
+            crumb_start = (crumb_start == std::string_view::npos) ? value.length() : crumb_start;
+        }
+
+        metrics_add(Metric::hpack_encode_block_octets, out.size() - block_start);
+        return;
+    }
+
+    if (full_match) {
+        put_integer(out, HPACK_INDEXED_FLAG, HPACK_INDEXED_PREFIX, static_index);
+        metrics_add(Metric::hpack_encode_static_hits);
+        metrics_add(Metric::hpack_encode_block_octets, out.size() - block_start);
+        return;
+    }
+
+    if (this->policy != IndexingPolicy::never) {
+        const uint32_t dynamic_index = this->table.find_entry(name, value);
+        // Hits count too, so an entry in use stays hotter than newcomers that would push it out.
+        const uint32_t frequency = this->sketch.record(hash_header_field(name, value));
+
+        if (dynamic_index != 0U) {
+            put_integer(out, HPACK_INDEXED_FLAG, HPACK_INDEXED_PREFIX, dynamic_index);
+            metrics_add(Metric::hpack_encode_dynamic_hits);
+            metrics_add(Metric::hpack_encode_block_octets, out.size() - block_start);
+            return;
+        }
+
+        if (should_index(name, value, frequency, this->policy)) {
+            // Literal with incremental indexing; the table update matches what the peer's decoder does.
+            put_integer(out, HPACK_LITERAL_INDEXING, HPACK_INDEXING_PREFIX, static_index);
+
+            if (static_index == 0U) {
+                put_string(out, name);
+            }
+
+            put_string(out, value);
+            this->table.put_entry(name, value);
+            metrics_add(Metric::hpack_encode_literal_fields);
+            metrics_add(Metric::hpack_encode_block_octets, out.size() - block_start);
+            return;
+        }
+    }
+
+    // Literal without indexing: the name is either a static reference or a literal string after a zero index.
+    put_integer(out, HPACK_LITERAL_PLAIN, HPACK_LITERAL_PREFIX, static_index);
+
+    if (static_index == 0U) {
+        put_string(out, name);
+    }
+
+    put_string(out, value);
+    metrics_add(Metric::hpack_encode_literal_fields);
+    metrics_add(Metric::hpack_encode_block_octets, out.size() - block_start);
+}
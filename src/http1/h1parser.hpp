@@ -0,0 +1,89 @@
+#ifndef H1PARSER_HPP
+#define H1PARSER_HPP
+
+/**
+ * @file h1parser.hpp
+ * @author Derek Tan
+ * @brief Declares connection type detection, the HTTP/1.1 request head parser, and h2c Upgrade helpers.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "http2/settings.hpp"
+
+constexpr uint32_t H1_MAX_FIELDS = 64U;
+constexpr size_t H1_MAX_HEAD_SIZE = 16384UL;
+
+/// @brief Fixed reply accepting an `Upgrade: h2c` request (RFC 7540 3.2).
+constexpr char H1_SWITCHING_PROTOCOLS[] = "HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n";
+
+/**
+ * @brief What a new cleartext connection speaks, judged from its first octets.
+ */
+enum class ConnectionKind {
+    need_more,          // a prefix of the h2 preface: read again
+    h2_prior_knowledge, // full h2 client preface present
+    http1,              // anything else that starts like a request line
+    invalid
+};
+
+enum class H1ParseStatus {
+    incomplete,
+    complete,
+    bad_request,
+    too_large
+};
+
+/**
+ * @brief One header field as views into the receive buffer.
+ */
+struct H1Field {
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * @brief A parsed request head. Every view points into the caller's receive buffer and is only valid while that buffer is.
+ */
+struct H1Request {
+    std::string_view method;
+    std::string_view target;
+    std::string_view host;
+    std::string_view http2_settings;  // raw HTTP2-Settings value when `wants_h2c` is set
+    H1Field fields[H1_MAX_FIELDS];
+    uint32_t field_count;
+    size_t head_length;               // octets up to and including the blank line
+    int64_t content_length;           // -1 when absent
+    uint8_t version_minor;
+    bool is_chunked;
+    bool keep_alive;
+    bool wants_h2c;
+
+    std::string_view find_field(std::string_view name) const;
+};
+
+ConnectionKind detect_connection_kind(const uint8_t* data, size_t length);
+
+/**
+ * @brief Parses one request head in place, leaving any body or pipelined request after `head_length` untouched.
+ */
+H1ParseStatus parse_h1_request(H1Request& request, const uint8_t* data, size_t length);
+
+/**
+ * @brief Decodes unpadded base64url (RFC 4648 5) as used by `HTTP2-Settings`.
+ */
+bool decode_base64url(std::string_view text, uint8_t* out, size_t out_capacity, size_t& out_length);
+
+/**
+ * @brief Decodes an `HTTP2-Settings` header value into the client's initial SETTINGS.
+ */
+H2Error decode_http2_settings(Http2Settings& settings, std::string_view header_value);
+
+/**
+ * @brief Appends an HTTP/1.1 status line and header section ending in the blank line.
+ */
+void append_h1_response_head(std::vector<uint8_t>& out, uint32_t status_code, const H1Field* fields, uint32_t field_count, uint64_t content_length, bool keep_alive);
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef FRAMES_HPP
+#define FRAMES_HPP
+
+/**
+ * @file frames.hpp
+ * @author Derek Tan
+ * @brief Declares HTTP/2 frame header constants and packing helpers (RFC 7540 4.1).
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+
+constexpr uint32_t FRAME_HEADER_SIZE = 9U;
+constexpr uint32_t FRAME_DEFAULT_MAX_SIZE = 16384U;     // initial SETTINGS_MAX_FRAME_SIZE
+constexpr uint32_t FRAME_MAX_SIZE_LIMIT = 16777215U;    // largest legal SETTINGS_MAX_FRAME_SIZE
+constexpr uint32_t STREAM_ID_MASK = 0x7fffffffU;
+constexpr uint32_t H2_PREFACE_LENGTH = 24U;
+
+/// @brief Client connection preface for prior-knowledge h2c (RFC 7540 3.5).
+constexpr char H2_CLIENT_PREFACE[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+constexpr uint8_t FLAG_END_STREAM = 0x01;
+constexpr uint8_t FLAG_ACK = 0x01;
+constexpr uint8_t FLAG_END_HEADERS = 0x04;
+constexpr uint8_t FLAG_PADDED = 0x08;
+constexpr uint8_t FLAG_PRIORITY = 0x20;
+
+enum class FrameType : uint8_t {
+    data = 0x0,
+    headers = 0x1,
+    priority = 0x2,
+    rst_stream = 0x3,
+    settings = 0x4,
+    push_promise = 0x5,
+    ping = 0x6,
+    goaway = 0x7,
+    window_update = 0x8,
+    continuation = 0x9
+};
+
+/**
+ * @brief Error codes for RST_STREAM and GOAWAY (RFC 7540 7).
+ */
+enum class H2Error : uint32_t {
+    no_error = 0x0,
+    protocol_error = 0x1,
+    internal_error = 0x2,
+    flow_control_error = 0x3,
+    settings_timeout = 0x4,
+    stream_closed = 0x5,
+    frame_size_error = 0x6,
+    refused_stream = 0x7,
+    cancel = 0x8,
+    compression_error = 0x9,
+    connect_error = 0xa,
+    enhance_your_calm = 0xb,
+    inadequate_security = 0xc,
+    http_1_1_required = 0xd
+};
+
+/**
+ * @brief Decoded form of the fixed 9 octet frame header.
+ */
+struct FrameHeader {
+    uint32_t length;    // 24-bit payload length
+    FrameType type;
+    uint8_t flags;
+    uint32_t stream_id; // 31-bit stream identifier, reserved bit cleared
+};
+
+void pack_frame_header(uint8_t* out, const FrameHeader& header);
+
+bool unpack_frame_header(FrameHeader& header, const uint8_t* data, uint32_t data_length);
+
+void patch_frame_length(uint8_t* frame, uint32_t length);
+
+void patch_frame_stream_id(uint8_t* frame, uint32_t stream_id);
+
+#endif
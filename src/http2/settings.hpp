@@ -0,0 +1,47 @@
+#ifndef SETTINGS_HPP
+#define SETTINGS_HPP
+
+/**
+ * @file settings.hpp
+ * @author Derek Tan
+ * @brief Declares HTTP/2 SETTINGS parameters and payload parsing (RFC 7540 6.5).
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include "http2/frames.hpp"
+
+constexpr uint32_t SETTINGS_ENTRY_SIZE = 6U;
+constexpr uint32_t DEFAULT_INITIAL_WINDOW_SIZE = 65535U;
+constexpr uint32_t MAX_WINDOW_SIZE = 2147483647U;
+
+enum class SettingsId : uint16_t {
+    header_table_size = 0x1,
+    enable_push = 0x2,
+    max_concurrent_streams = 0x3,
+    initial_window_size = 0x4,
+    max_frame_size = 0x5,
+    max_header_list_size = 0x6
+};
+
+/**
+ * @brief One side's SETTINGS values, starting from the RFC defaults.
+ */
+struct Http2Settings {
+    uint32_t header_table_size;
+    uint32_t enable_push;
+    uint32_t max_concurrent_streams;
+    uint32_t initial_window_size;
+    uint32_t max_frame_size;
+    uint32_t max_header_list_size;
+
+    Http2Settings();
+    H2Error apply(uint16_t id, uint32_t value);
+};
+
+/**
+ * @brief Applies every parameter in a SETTINGS payload. Unknown identifiers are ignored as the RFC requires.
+ */
+H2Error parse_settings_payload(Http2Settings& settings, const uint8_t* payload, uint32_t payload_length);
+
+#endif
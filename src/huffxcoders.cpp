@@ -17,7 +17,7 @@ HuffmanEncoder::HuffmanEncoder(const HuffmanCodePair* huffcodes) {
     this->huffcodes_ptr = huffcodes;
 }
 
-uint32_t HuffmanEncoder::encode(BitArray& result, const std::string& text) {
+uint32_t HuffmanEncoder::encode(BitArray& result, std::string_view text) {
     uint32_t encode_count = 0U; // bits encoded
     size_t text_length = text.length();
 
@@ -75,12 +75,6 @@ HuffmanDecoder::HuffmanDecoder(const HuffmanCodePair* huffcodes) : huffcode_tree
             break;
         }
     }
-
-    if (this->is_ready) {
-        this->tree_cursor = huffcode_tree.get_root_symbol_node();
-    } else {
-        this->tree_cursor = nullptr;
-    }
 }
 
 bool HuffmanDecoder::setup_valid() const {
@@ -88,67 +82,67 @@ bool HuffmanDecoder::setup_valid() const {
 }
 
 bool HuffmanDecoder::decode(std::string& result, const OctetArray& raw_octets) {
-    int32_t data_length = raw_octets.get_length();
+    return decode(result, raw_octets.get_octets(), raw_octets.get_length(), HPACK_TEXT_MAX_LEN) == HuffmanStatus::ok;
+}
 
-    // Do not attempt to decode into invalid OctetArray data e.g length = -1
-    if (data_length < 1) {
-        return false;
+HuffmanStatus HuffmanDecoder::decode(std::string& result, const uint8_t* data, uint32_t data_length, size_t max_result_length) {
+    const SymbolNode* root = huffcode_tree.get_root_symbol_node();
+    const SymbolNode* cursor = root;
+    size_t emitted_count = 0UL;
+    uint32_t pending_bits = 0U; // bits walked since the last complete symbol
+    bool pending_all_ones = true;
+
+    if (!this->is_ready || !root) {
+        return HuffmanStatus::invalid;
     }
 
-    BitArray result_bitstr {HUFFCODE_OCTET_BITS * data_length};
-    bool curr_bit = false;
-    bool decode_ok = true;
+    // Walk the code tree straight from the octets, so no intermediate bit copy is made.
+    for (uint32_t octet_i = 0U; octet_i < data_length; octet_i++) {
+        const uint8_t temp_octet = data[octet_i];
 
-    // Copy all bits of `raw_octets` into `result_bitstr`
-    for (int32_t copy_i = 0; copy_i < data_length; copy_i++) {
-        const uint8_t temp_octet = raw_octets.get_octet(copy_i);
+        for (int32_t bit_i = HUFFCODE_OCTET_BITS - 1U; bit_i >= 0; bit_i--) {
+            bool curr_bit = ((temp_octet >> bit_i) & 1U) == 1U;
 
-        // Append each octet as 8 bit chunk
-        if (!result_bitstr.append(temp_octet)) {
-            decode_ok = false;
-            return decode_ok;
-        }
-    }
-    
-    // Decode raw octets by bitstring to plaintext
-    int32_t result_bit_span = result_bitstr.length();
-    uint8_t node_symbol = 0;
+            cursor = (curr_bit) ? cursor->right : cursor->left;
 
-    for (int32_t peek_i = 0; peek_i < result_bit_span; peek_i++) {
-        if (!this->tree_cursor) {
-            break;
-        }
+            if (!cursor) {
+                return HuffmanStatus::invalid;
+            }
 
-        curr_bit = result_bitstr.at(peek_i);
+            pending_bits++;
+            pending_all_ones = pending_all_ones && curr_bit;
 
-        if (is_leaf(this->tree_cursor)) {
-            node_symbol = tree_cursor->symbol;
+            if (!is_leaf(cursor)) {
+                continue;
+            }
 
-            if (!tree_cursor->is_eos) {
-                result += node_symbol;
-                reset_cursor();
-            } else {
-                reset_cursor();
-                break;
+            if (is_eos(cursor)) {
+                return HuffmanStatus::invalid;
+            }
+
+            /// @note Check the caller's limit before growing `result`, so hostile input cannot force a large allocation.
+            if (emitted_count >= max_result_length) {
+                return HuffmanStatus::too_long;
             }
-        }
 
-        if (curr_bit) {
-            tree_cursor = tree_cursor->right;
-        } else {
-            tree_cursor = tree_cursor->left;
+            result += static_cast<char>(cursor->symbol);
+            emitted_count++;
+            cursor = root;
+            pending_bits = 0U;
+            pending_all_ones = true;
         }
     }
 
-    return decode_ok;
+    // Trailing bits must be a prefix of EOS: at most 7 bits, all ones.
+    if (pending_bits >= HUFFCODE_OCTET_BITS || !pending_all_ones) {
+        return HuffmanStatus::invalid;
+    }
+
+    return HuffmanStatus::ok;
 }
 
 /* HuffmanDecoder Private Impl. */
 
-void HuffmanDecoder::reset_cursor() {
-    this->tree_cursor = huffcode_tree.get_root_symbol_node();
-}
-
 bool HuffmanDecoder::load_huffcode(const HuffmanCodePair* huffcode, uint8_t symbol) {
     uint32_t temp_huffcode = huffcode->code_number;
     uint32_t code_span = huffcode->code_length;
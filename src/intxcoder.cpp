@@ -53,7 +53,7 @@ uint32_t IntegerEncoder::encode_int(OctetArray& buffer, uint32_t target) {
 
     if (target < prefix_mask) {
         temp_octet = target;
-        buffer.set_octet(0, temp_octet);        
+        buffer.set_octet(encoding_count, temp_octet);
         encoding_count++;
 
         return encoding_count;
@@ -95,6 +95,7 @@ uint32_t IntegerEncoder::encode_int(OctetArray& buffer, uint32_t target) {
 IntegerDecoder::IntegerDecoder() {
     decoding_offset = 0U;
     prefix = 0U;
+    last_ok = true;
 }
 
 uint32_t IntegerDecoder::get_relative_offset() const
@@ -102,6 +103,10 @@ uint32_t IntegerDecoder::get_relative_offset() const
     return decoding_offset;
 }
 
+bool IntegerDecoder::is_ok() const {
+    return last_ok;
+}
+
 void IntegerDecoder::set_offset(uint32_t offset) {
     this->decoding_offset = offset;
 }
@@ -111,47 +116,56 @@ void IntegerDecoder::set_prefix(uint8_t prefix_n) {
 }
 
 uint32_t IntegerDecoder::decode_int(const OctetArray& buffer) {
-    uint32_t result = 0U;
+    return decode_int(buffer.get_octets(), buffer.get_length());
+}
+
+uint32_t IntegerDecoder::decode_int(const uint8_t* data, uint32_t data_length) {
     uint8_t prefix_mask = get_prefix_mask(prefix);
-    uint8_t temp_chunk = buffer.get_octet(decoding_offset) & prefix_mask;
+
+    last_ok = false;
+
+    if (decoding_offset >= data_length) {
+        return 0U;
+    }
+
+    uint8_t temp_chunk = data[decoding_offset] & prefix_mask;
+    decoding_offset++;
 
     if (temp_chunk != prefix_mask) {
         /// @note Handles 1 octet integers where no additional chunks need to be decoded!
-        result = temp_chunk;
-        decoding_offset++;
-        return result;
+        last_ok = true;
+        return temp_chunk;
     }
 
-    uint8_t temp_octet = 0; // raw octet from buffer
-    uint32_t chunk_count = 0U;
-    uint32_t multiplier = 1U; // power of 2 to multiply with result accumulator term
-    result = temp_chunk;
-    decoding_offset++;
+    uint64_t result = temp_chunk;
+    uint32_t shift = 0U; // bit position of the next 7-bit chunk
 
-    while (decoding_offset < buffer.get_length() && chunk_count <= HPACK_MAX_INT_OCTETS) {
-        temp_octet = buffer.get_octet(decoding_offset);
-        temp_chunk = temp_octet & HPACK_INT_CHUNK_VALUE;
+    for (uint32_t chunk_count = 0U; chunk_count < HPACK_MAX_INT_OCTETS; chunk_count++) {
+        if (decoding_offset >= data_length) {
+            // Truncated integer: the encoding promised more chunks than the buffer holds.
+            return 0U;
+        }
 
-        result += temp_chunk * multiplier;
+        uint8_t temp_octet = data[decoding_offset];
+        decoding_offset++;
 
-        if ((temp_octet & HPACK_TERMINAL_TINY_INT) == 0) {
-            /// @note Handle flag 0 of encoding chunk as END so that H(un)PACK is correct.
-            decoding_offset++;
-            chunk_count++;
-            break;
+        result += static_cast<uint64_t>(temp_octet & HPACK_INT_CHUNK_VALUE) << shift;
+
+        if (result > UINT32_MAX) {
+            // Handle overflowing values with decoding error.
+            return 0U;
         }
 
-        if ((multiplier << 7) < multiplier) {
-            // Handle overflowing multiplier with decoding error.
-            result = 0U;
-            break;
+        if ((temp_octet & HPACK_TERMINAL_TINY_INT) == 0) {
+            /// @note Handle flag 0 of encoding chunk as END so that H(un)PACK is correct.
+            last_ok = true;
+            return static_cast<uint32_t>(result);
         }
 
-        multiplier <<= 7;
-        decoding_offset++;
+        shift += 7U;
     }
 
-    return result;
+    return 0U;
 }
 
 void IntegerDecoder::reset() {
@@ -0,0 +1,148 @@
+/**
+ * @file metrics.cpp
+ * @author Derek Tan
+ * @brief Implements the metric shard registry and Prometheus text rendering.
+ * @date 2026-10-19
+ */
+
+#include <cstring>
+#include "utils/metrics.hpp"
+
+/**
+ * @brief How one metric is exposed. Consecutive entries of the same family share their HELP and TYPE lines.
+ */
+struct MetricInfo {
+    const char* family;
+    const char* labels;   // label set without braces, empty for none
+    const char* help;
+    bool is_gauge;
+};
+
+static constexpr MetricInfo METRIC_INFOS[METRIC_COUNT] = {
+    {"h2plus_hpack_field_lookups_total", "direction=\"encode\",table=\"static\",result=\"hit\"", "Header fields coded by HPACK, by direction, table and outcome.", false},
+    {"h2plus_hpack_field_lookups_total", "direction=\"encode\",table=\"dynamic\",result=\"hit\"", "", false},
+    {"h2plus_hpack_field_lookups_total", "direction=\"encode\",table=\"any\",result=\"literal\"", "", false},
+    {"h2plus_hpack_field_lookups_total", "direction=\"decode\",table=\"static\",result=\"hit\"", "", false},
+    {"h2plus_hpack_field_lookups_total", "direction=\"decode\",table=\"dynamic\",result=\"hit\"", "", false},
+    {"h2plus_hpack_field_lookups_total", "direction=\"decode\",table=\"any\",result=\"literal\"", "", false},
+    {"h2plus_hpack_table_inserts_total", "", "Entries added to HPACK dynamic tables.", false},
+    {"h2plus_hpack_table_evictions_total", "", "Entries evicted from HPACK dynamic tables.", false},
+    {"h2plus_hpack_table_octets", "", "RFC 7541 size of all live HPACK dynamic tables.", true},
+    {"h2plus_hpack_table_entries", "", "Entries held by all live HPACK dynamic tables.", true},
+    {"h2plus_hpack_octets_total", "direction=\"encode\",form=\"plain\"", "Header octets before and after HPACK coding.", false},
+    {"h2plus_hpack_octets_total", "direction=\"encode\",form=\"block\"", "", false},
+    {"h2plus_hpack_octets_total", "direction=\"decode\",form=\"block\"", "", false},
+    {"h2plus_hpack_octets_total", "direction=\"decode\",form=\"plain\"", "", false},
+    {"h2plus_hpack_strings_total", "direction=\"encode\",coding=\"huffman\"", "HPACK string literals by Huffman use.", false},
+    {"h2plus_hpack_strings_total", "direction=\"encode\",coding=\"raw\"", "", false},
+    {"h2plus_hpack_strings_total", "direction=\"decode\",coding=\"huffman\"", "", false},
+    {"h2plus_hpack_strings_total", "direction=\"decode\",coding=\"raw\"", "", false},
+    {"h2plus_connections_accepted_total", "", "Accepted client connections.", false},
+    {"h2plus_connections_active", "", "Open client connections.", true},
+    {"h2plus_streams_opened_total", "", "Client streams opened.", false},
+    {"h2plus_streams_reset_total", "", "Streams reset by either side.", false},
+    {"h2plus_streams_active", "", "Open streams.", true},
+    {"h2plus_recv_window_grows_total", "", "Receive window increases from bandwidth-delay autotuning.", false}
+};
+
+static constexpr const char* FRAME_TYPE_NAMES[METRICS_FRAME_SLOTS] = {
+    "data", "headers", "priority", "rst_stream", "settings", "push_promise", "ping", "goaway", "window_update", "continuation", "unknown"
+};
+
+static MetricsShard shards[METRICS_MAX_SHARDS];
+static std::atomic<uint32_t> claimed_shards {0U};
+
+/* Registry Impl. */
+
+MetricsShard& claim_metrics_shard() {
+    uint32_t shard_i = claimed_shards.fetch_add(1U, std::memory_order_relaxed);
+
+    if (shard_i >= METRICS_MAX_SHARDS - 1U) {
+        MetricsShard& overflow = shards[METRICS_MAX_SHARDS - 1U];
+
+        overflow.is_shared.store(true, std::memory_order_relaxed);
+        return overflow;
+    }
+
+    return shards[shard_i];
+}
+
+static uint32_t get_shard_count() {
+    uint32_t claimed = claimed_shards.load(std::memory_order_relaxed);
+
+    return (claimed < METRICS_MAX_SHARDS) ? claimed : METRICS_MAX_SHARDS;
+}
+
+uint64_t metrics_total(Metric metric) {
+    const uint32_t shard_count = get_shard_count();
+    uint64_t total = 0UL;
+
+    for (uint32_t shard_i = 0U; shard_i < shard_count; shard_i++) {
+        total += shards[shard_i].values[static_cast<uint32_t>(metric)].load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+uint64_t metrics_frame_total(uint8_t frame_type, bool is_outbound) {
+    const uint32_t shard_count = get_shard_count();
+    uint32_t slot = (frame_type < METRICS_FRAME_SLOTS - 1U) ? frame_type : METRICS_FRAME_SLOTS - 1U;
+    uint64_t total = 0UL;
+
+    for (uint32_t shard_i = 0U; shard_i < shard_count; shard_i++) {
+        const MetricsShard& shard = shards[shard_i];
+
+        total += ((is_outbound) ? shard.frames_out[slot] : shard.frames_in[slot]).load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+/* Rendering Impl. */
+
+static void append_sample(std::string& out, const char* family, const char* labels, uint64_t value, bool is_gauge) {
+    out.append(family);
+
+    if (labels[0] != '\0') {
+        out.push_back('{');
+        out.append(labels);
+        out.push_back('}');
+    }
+
+    out.push_back(' ');
+    out.append((is_gauge) ? std::to_string(static_cast<int64_t>(value)) : std::to_string(value));
+    out.push_back('\n');
+}
+
+static void append_family_head(std::string& out, const char* family, const char* help, bool is_gauge) {
+    out.append("# HELP ").append(family).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(family).append((is_gauge) ? " gauge\n" : " counter\n");
+}
+
+void render_metrics(std::string& out) {
+    const char* last_family = "";
+
+    for (uint32_t metric_i = 0U; metric_i < METRIC_COUNT; metric_i++) {
+        const MetricInfo& info = METRIC_INFOS[metric_i];
+
+        if (std::strcmp(info.family, last_family) != 0) {
+            append_family_head(out, info.family, info.help, info.is_gauge);
+            last_family = info.family;
+        }
+
+        append_sample(out, info.family, info.labels, metrics_total(static_cast<Metric>(metric_i)), info.is_gauge);
+    }
+
+    for (uint32_t direction_i = 0U; direction_i < 2U; direction_i++) {
+        const bool is_outbound = direction_i == 1U;
+        const char* family = (is_outbound) ? "h2plus_frames_sent_total" : "h2plus_frames_received_total";
+        std::string labels {};
+
+        append_family_head(out, family, (is_outbound) ? "HTTP/2 frames written, by type." : "HTTP/2 frames read, by type.", false);
+
+        for (uint8_t type_i = 0U; type_i < METRICS_FRAME_SLOTS; type_i++) {
+            labels.assign("type=\"").append(FRAME_TYPE_NAMES[type_i]).append("\"");
+            append_sample(out, family, labels.c_str(), metrics_frame_total(type_i, is_outbound), false);
+        }
+    }
+}
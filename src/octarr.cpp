@@ -137,7 +137,7 @@ uint8_t OctetArray::get_octet(uint32_t index) const {
 }
 
 void OctetArray::set_octet(uint32_t index, uint8_t value) {
-    if (index >= 0 && index < this->get_length()) {
+    if (index < this->get_length()) {
         this->octets[index] = value;
     }
 }
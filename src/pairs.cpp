@@ -5,12 +5,21 @@
  * @date 2023-11-22
  */
 
+#include <utility>
 #include "hpack/pairs.hpp"
 
 /* HeaderTablePair Impl. */
 
 HeaderTablePair::HeaderTablePair(const char* name_cstr, const char* value_cstr): name {name_cstr}, value {value_cstr} {}
 
+HeaderTablePair::HeaderTablePair(std::string name_str, std::string value_str): name {std::move(name_str)}, value {std::move(value_str)} {}
+
+void HeaderTablePair::assign(std::string_view name_text, std::string_view value_text) {
+    // Assigning over the old text reuses its buffers, so a recycled table slot only allocates for a longer field than it ever held.
+    this->name.assign(name_text);
+    this->value.assign(value_text);
+}
+
 const std::string& HeaderTablePair::get_name() const {
     return this->name;
 }
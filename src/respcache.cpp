@@ -0,0 +1,210 @@
+/**
+ * @file respcache.cpp
+ * @author Derek Tan
+ * @brief Implements the in-memory cache of pre-framed responses.
+ * @date 2026-10-19
+ */
+
+#include "server/respcache.hpp"
+
+/* CachedResponse Impl. */
+
+size_t CachedResponse::get_footprint() const {
+    return this->wire.capacity() + this->frame_offsets.capacity() * sizeof(uint32_t) + RESPONSE_CACHE_ENTRY_OVERHEAD;
+}
+
+void CachedResponse::append_wire(std::vector<uint8_t>& out, uint32_t stream_id) const {
+    const size_t copy_start = out.size();
+
+    out.insert(out.end(), this->wire.begin(), this->wire.end());
+
+    uint8_t* raw_copy = out.data() + copy_start;
+
+    for (auto frame_offset : this->frame_offsets) {
+        patch_frame_stream_id(raw_copy + frame_offset, stream_id);
+    }
+}
+
+/* ResponseCache Private Impl. */
+
+void ResponseCache::build_frames(CachedResponse& response, const uint8_t* body, size_t body_length) {
+    const uint32_t max_payload = FRAME_DEFAULT_MAX_SIZE;
+    const size_t block_length = this->block_scratch.size();
+    const size_t header_frames = (block_length == 0UL) ? 1UL : (block_length + max_payload - 1UL) / max_payload;
+    const size_t data_frames = (body_length + max_payload - 1UL) / max_payload;
+
+    response.body_length = body_length;
+    response.wire.reserve((header_frames + data_frames) * FRAME_HEADER_SIZE + block_length + body_length);
+    response.frame_offsets.reserve(header_frames + data_frames);
+
+    // Header block: one HEADERS frame, then CONTINUATION frames for any overflow.
+    size_t block_offset = 0UL;
+
+    for (size_t frame_i = 0UL; frame_i < header_frames; frame_i++) {
+        size_t slice = block_length - block_offset;
+        slice = (slice > max_payload) ? max_payload : slice;
+
+        uint8_t flags = (frame_i + 1UL == header_frames) ? FLAG_END_HEADERS : 0;
+
+        if (frame_i == 0UL && body_length == 0UL) {
+            flags |= FLAG_END_STREAM;
+        }
+
+        FrameHeader header {static_cast<uint32_t>(slice), (frame_i == 0UL) ? FrameType::headers : FrameType::continuation, flags, 0U};
+        size_t frame_offset = response.wire.size();
+
+        response.frame_offsets.push_back(static_cast<uint32_t>(frame_offset));
+        response.wire.resize(frame_offset + FRAME_HEADER_SIZE);
+        pack_frame_header(response.wire.data() + frame_offset, header);
+        response.wire.insert(response.wire.end(), this->block_scratch.begin() + block_offset, this->block_scratch.begin() + block_offset + slice);
+
+        block_offset += slice;
+    }
+
+    // Body: DATA frames of at most the default max frame size, END_STREAM on the last.
+    size_t body_offset = 0UL;
+
+    for (size_t frame_i = 0UL; frame_i < data_frames; frame_i++) {
+        size_t slice = body_length - body_offset;
+        slice = (slice > max_payload) ? max_payload : slice;
+
+        uint8_t flags = (frame_i + 1UL == data_frames) ? FLAG_END_STREAM : 0;
+        FrameHeader header {static_cast<uint32_t>(slice), FrameType::data, flags, 0U};
+        size_t frame_offset = response.wire.size();
+
+        response.frame_offsets.push_back(static_cast<uint32_t>(frame_offset));
+        response.wire.resize(frame_offset + FRAME_HEADER_SIZE);
+        pack_frame_header(response.wire.data() + frame_offset, header);
+        response.wire.insert(response.wire.end(), body + body_offset, body + body_offset + slice);
+
+        body_offset += slice;
+    }
+}
+
+void ResponseCache::evict_until(size_t wanted_free) {
+    while (!this->lru_entries.empty() && this->memory_used + wanted_free > this->memory_limit) {
+        Entry& victim = this->lru_entries.back();
+
+        this->memory_used -= victim.response.get_footprint() + victim.path.capacity();
+        this->path_index.erase(victim.path);
+        this->lru_entries.pop_back();
+        this->eviction_count++;
+    }
+}
+
+/* ResponseCache Public Impl. */
+
+ResponseCache::ResponseCache(size_t memory_limit_octets)
+: lru_entries {}, path_index {}, encoder {}, block_scratch {} {
+    this->memory_limit = memory_limit_octets;
+    this->memory_used = 0UL;
+    this->hit_count = 0UL;
+    this->miss_count = 0UL;
+    this->eviction_count = 0UL;
+}
+
+size_t ResponseCache::get_memory_limit() const {
+    return this->memory_limit;
+}
+
+size_t ResponseCache::get_memory_used() const {
+    return this->memory_used;
+}
+
+uint32_t ResponseCache::get_entry_count() const {
+    return static_cast<uint32_t>(this->path_index.size());
+}
+
+uint64_t ResponseCache::get_hit_count() const {
+    return this->hit_count;
+}
+
+uint64_t ResponseCache::get_miss_count() const {
+    return this->miss_count;
+}
+
+uint64_t ResponseCache::get_eviction_count() const {
+    return this->eviction_count;
+}
+
+void ResponseCache::set_memory_limit(size_t memory_limit_octets) {
+    this->memory_limit = memory_limit_octets;
+    evict_until(0UL);
+}
+
+bool ResponseCache::insert(const std::string& path, const std::vector<HeaderTablePair>& headers, const uint8_t* body, size_t body_length) {
+    erase(path);
+
+    this->block_scratch.clear();
+
+    for (const auto& field : headers) {
+        this->encoder.encode_field(this->block_scratch, field.get_name(), field.get_value());
+    }
+
+    Entry fresh {path, {}};
+    build_frames(fresh.response, body, body_length);
+
+    size_t footprint = fresh.response.get_footprint() + fresh.path.capacity();
+
+    // An entry bigger than the whole budget would only flush everything else for nothing.
+    if (footprint > this->memory_limit) {
+        return false;
+    }
+
+    evict_until(footprint);
+
+    this->lru_entries.push_front(std::move(fresh));
+    this->path_index.emplace(this->lru_entries.front().path, this->lru_entries.begin());
+    this->memory_used += footprint;
+
+    return true;
+}
+
+bool ResponseCache::erase(std::string_view path) {
+    auto index_it = this->path_index.find(path);
+
+    if (index_it == this->path_index.end()) {
+        return false;
+    }
+
+    auto entry_it = index_it->second;
+
+    this->memory_used -= entry_it->response.get_footprint() + entry_it->path.capacity();
+    this->path_index.erase(index_it);
+    this->lru_entries.erase(entry_it);
+
+    return true;
+}
+
+/**
+ * @brief Looks an entry up and counts the hit or miss, so a caller can check `body_length` against its send windows before serving.
+ */
+const CachedResponse* ResponseCache::find(std::string_view path) {
+    auto index_it = this->path_index.find(path);
+
+    if (index_it == this->path_index.end()) {
+        this->miss_count++;
+        return nullptr;
+    }
+
+    auto entry_it = index_it->second;
+
+    // Refresh recency without moving the node, so the string_view key stays valid.
+    this->lru_entries.splice(this->lru_entries.begin(), this->lru_entries, entry_it);
+    this->hit_count++;
+
+    return &entry_it->response;
+}
+
+/**
+ * @brief Appends a hit's frames to `out` with `stream_id` patched into the copy, leaving the shared entry untouched.
+ */
+const CachedResponse* ResponseCache::serve(std::string_view path, uint32_t stream_id, std::vector<uint8_t>& out) {
+    const CachedResponse* hit = find(path);
+
+    if (hit) {
+        hit->append_wire(out, stream_id);
+    }
+
+    return hit;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file router.cpp
+ * @author Derek Tan
+ * @brief Implements the radix trie router.
+ * @date 2026-10-19
+ */
+
+#include "server/router.hpp"
+
+/* RouteParams Impl. */
+
+std::string_view RouteParams::get(std::string_view name) const {
+    for (uint32_t param_i = 0U; param_i < this->count; param_i++) {
+        if (this->names[param_i] == name) {
+            return this->values[param_i];
+        }
+    }
+
+    return {};
+}
+
+/* Router::Node Impl. */
+
+Router::Node::Node(std::string_view edge_text)
+: prefix {edge_text}, children {}, param_child {}, wildcard_child {}, param_name {}, wildcard_name {} {
+    for (auto& target : this->targets) {
+        target = ROUTE_NO_TARGET;
+    }
+}
+
+uint32_t Router::Node::get_allowed_mask() const {
+    uint32_t mask = 0U;
+
+    for (uint32_t method_i = 0U; method_i < static_cast<uint32_t>(HttpMethod::count); method_i++) {
+        if (this->targets[method_i] != ROUTE_NO_TARGET) {
+            mask |= 1U << method_i;
+        }
+    }
+
+    return mask;
+}
+
+/* Router Private Impl. */
+
+Router::Node* Router::insert_static(Node* node, std::string_view text) {
+    while (!text.empty()) {
+        std::unique_ptr<Node>* edge = nullptr;
+
+        for (auto& child : node->children) {
+            if (child->prefix[0] == text[0]) {
+                edge = &child;
+                break;
+            }
+        }
+
+        if (!edge) {
+            node->children.push_back(std::make_unique<Node>(text));
+            return node->children.back().get();
+        }
+
+        std::string& edge_prefix = (*edge)->prefix;
+        size_t common_length = 0UL;
+
+        while (common_length < edge_prefix.length() && common_length < text.length() && edge_prefix[common_length] == text[common_length]) {
+            common_length++;
+        }
+
+        // Split the edge where the new text diverges: the shared part becomes a new inner node.
+        if (common_length < edge_prefix.length()) {
+            auto middle = std::make_unique<Node>(std::string_view {edge_prefix}.substr(0, common_length));
+
+            edge_prefix.erase(0, common_length);
+            middle->children.push_back(std::move(*edge));
+            *edge = std::move(middle);
+        }
+
+        node = edge->get();
+        text.remove_prefix(common_length);
+    }
+
+    return node;
+}
+
+bool Router::match_node(const Node* node, std::string_view rest, HttpMethod method, RouteMatch& result) {
+    RouteParams& params = result.params;
+
+    if (rest.empty()) {
+        int32_t target = node->targets[static_cast<size_t>(method)];
+
+        if (target != ROUTE_NO_TARGET) {
+            result.target = target;
+            result.allowed_mask = node->get_allowed_mask();
+            return true;
+        }
+
+        // Remember that the path exists for other methods, so a miss becomes 405 instead of 404.
+        result.allowed_mask |= node->get_allowed_mask();
+    } else {
+        for (const auto& child : node->children) {
+            const std::string& edge_prefix = child->prefix;
+
+            if (edge_prefix[0] != rest[0]) {
+                continue;
+            }
+
+            if (rest.substr(0, edge_prefix.length()) == edge_prefix && match_node(child.get(), rest.substr(edge_prefix.length()), method, result)) {
+                return true;
+            }
+
+            break;
+        }
+
+        const size_t segment_end = rest.find('/');
+
+        if (node->param_child && segment_end != 0UL) {
+            const uint32_t param_i = params.count;
+
+            params.names[param_i] = node->param_name;
+            params.values[param_i] = rest.substr(0, segment_end);
+            params.count++;
+
+            if (match_node(node->param_child.get(), (segment_end == std::string_view::npos) ? std::string_view {} : rest.substr(segment_end), method, result)) {
+                return true;
+            }
+
+            params.count = param_i;
+        }
+    }
+
+    if (node->wildcard_child) {
+        const Node* wildcard = node->wildcard_child.get();
+        int32_t target = wildcard->targets[static_cast<size_t>(method)];
+
+        if (target != ROUTE_NO_TARGET) {
+            params.names[params.count] = node->wildcard_name;
+            params.values[params.count] = rest;
+            params.count++;
+            result.target = target;
+            result.allowed_mask = wildcard->get_allowed_mask();
+            return true;
+        }
+
+        result.allowed_mask |= wildcard->get_allowed_mask();
+    }
+
+    return false;
+}
+
+/* Router Public Impl. */
+
+Router::Router() : root {std::make_unique<Node>(std::string_view {})} {
+    this->route_count = 0U;
+}
+
+bool Router::add_route(HttpMethod method, std::string_view pattern, int32_t target) {
+    if (method == HttpMethod::count || target == ROUTE_NO_TARGET || pattern.empty() || pattern[0] != '/') {
+        return false;
+    }
+
+    Node* node = this->root.get();
+    uint32_t param_count = 0U;
+
+    while (!pattern.empty()) {
+        size_t marker_pos = pattern.find_first_of(":*");
+
+        node = insert_static(node, pattern.substr(0, marker_pos));
+
+        if (marker_pos == std::string_view::npos) {
+            break;
+        }
+
+        // Parameters must fill whole segments, and a route may capture at most `ROUTER_MAX_PARAMS` of them.
+        if (marker_pos == 0UL || pattern[marker_pos - 1UL] != '/' || ++param_count > ROUTER_MAX_PARAMS) {
+            return false;
+        }
+
+        const bool is_wildcard = pattern[marker_pos] == '*';
+        size_t name_end = pattern.find('/', marker_pos);
+        std::string_view name = pattern.substr(marker_pos + 1UL, (name_end == std::string_view::npos) ? std::string_view::npos : name_end - marker_pos - 1UL);
+
+        if (name.empty() || (is_wildcard && name_end != std::string_view::npos)) {
+            return false;
+        }
+
+        std::unique_ptr<Node>& capture_child = (is_wildcard) ? node->wildcard_child : node->param_child;
+        std::string& capture_name = (is_wildcard) ? node->wildcard_name : node->param_name;
+
+        if (!capture_child) {
+            capture_child = std::make_unique<Node>(std::string_view {});
+            capture_name.assign(name);
+        } else if (capture_name != name) {
+            // Two routes naming the same segment differently would make the captured names ambiguous.
+            return false;
+        }
+
+        node = capture_child.get();
+        pattern = (name_end == std::string_view::npos) ? std::string_view {} : pattern.substr(name_end);
+    }
+
+    int32_t& slot = node->targets[static_cast<size_t>(method)];
+
+    if (slot != ROUTE_NO_TARGET) {
+        return false;
+    }
+
+    slot = target;
+    this->route_count++;
+
+    return true;
+}
+
+RouteMatch Router::match(HttpMethod method, std::string_view path) const {
+    RouteMatch result {RouteStatus::not_found, ROUTE_NO_TARGET, 0U, {}};
+
+    if (method == HttpMethod::count) {
+        return result;
+    }
+
+    if (match_node(this->root.get(), strip_query(path), method, result)) {
+        result.status = RouteStatus::found;
+    } else if (result.allowed_mask != 0U) {
+        result.status = RouteStatus::method_not_allowed;
+    }
+
+    return result;
+}
+
+uint32_t Router::get_route_count() const {
+    return this->route_count;
+}
+
+/* Allow Impl. */
+
+std::string format_allowed_methods(uint32_t allowed_mask) {
+    std::string value {};
+
+    for (uint32_t method_i = 0U; method_i < static_cast<uint32_t>(HttpMethod::count); method_i++) {
+        if ((allowed_mask & (1U << method_i)) == 0U) {
+            continue;
+        }
+
+        if (!value.empty()) {
+            value.append(", ");
+        }
+
+        value.append(HTTP_METHOD_NAMES[method_i]);
+    }
+
+    return value;
+}
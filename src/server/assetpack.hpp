@@ -0,0 +1,121 @@
+#ifndef ASSETPACK_HPP
+#define ASSETPACK_HPP
+
+/**
+ * @file assetpack.hpp
+ * @author Derek Tan
+ * @brief Declares the packed static asset archive: an offline writer and a memory-mapped reader with a perfect-hash path index.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "hpack/hpackencoder.hpp"
+#include "server/contentcoding.hpp"
+
+constexpr char ASSET_PACK_MAGIC[8] = {'H', '2', 'P', 'A', 'C', 'K', '0', '1'};
+constexpr uint32_t ASSET_PACK_VERSION = 1U;
+constexpr uint32_t ASSET_VARIANT_COUNT = CONTENT_CODING_COUNT;
+
+/**
+ * @brief One stored representation of an asset. Offsets are from the archive start.
+ */
+struct PackedAssetVariant {
+    uint64_t data_offset;
+    uint64_t data_length;
+    uint32_t etag_offset;   // quoted strong ETag in the string pool
+    uint32_t etag_length;
+};
+
+/**
+ * @brief Fixed size index record. Records are stored in perfect-hash slot order.
+ */
+struct PackedAssetEntry {
+    uint32_t path_offset;   // URL path in the string pool e.g "/css/site.css"
+    uint32_t path_length;
+    uint32_t type_offset;   // content-type in the string pool
+    uint32_t type_length;
+    uint32_t variant_mask;  // bit N set when variant N exists
+    uint32_t reserved;
+    PackedAssetVariant variants[ASSET_VARIANT_COUNT];
+};
+
+/**
+ * @brief Archive header. Layout on disk: header, payload blobs, string pool, bucket seeds, entry records. Fields are in host byte order, so archives are packed on the serving architecture.
+ */
+struct PackedAssetHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t bucket_count;
+    uint32_t reserved;
+    uint64_t strings_offset;
+    uint64_t strings_length;
+    uint64_t seeds_offset;
+    uint64_t entries_offset;
+    uint64_t archive_length;
+};
+
+static_assert(sizeof(PackedAssetVariant) == 24, "PackedAssetVariant layout changed");
+static_assert(sizeof(PackedAssetEntry) == 120, "PackedAssetEntry layout changed");
+static_assert(sizeof(PackedAssetHeader) == 64, "PackedAssetHeader layout changed");
+
+/**
+ * @brief Seeded FNV-1a hash used by both the packer and the reader's perfect-hash index.
+ */
+uint64_t asset_path_hash(std::string_view text, uint32_t seed);
+
+/**
+ * @brief Maps a file extension to its media type, defaulting to `application/octet-stream`.
+ */
+const char* guess_content_type(std::string_view path);
+
+/**
+ * @brief Packs every regular file under `doc_root` into one archive at `archive_path`. Sidecar files ending in `.br`, `.gz` or `.zst` become precompressed variants of their base file when it exists.
+ * @returns Number of packed assets, or -1 on any I/O or indexing failure.
+ */
+int32_t pack_asset_directory(const char* doc_root, const char* archive_path);
+
+/**
+ * @brief Read-only view of a packed archive. Startup is one `mmap`, and lookups touch no filesystem metadata.
+ */
+class AssetPack {
+private:
+    const uint8_t* mapping;
+    size_t mapping_length;
+    const PackedAssetHeader* header;
+    const uint32_t* bucket_seeds;
+    const PackedAssetEntry* entries;
+    const char* strings;
+    int archive_fd;
+
+    bool validate() const;
+    std::string_view get_string(uint32_t offset, uint32_t length) const;
+
+public:
+    AssetPack();
+    ~AssetPack();
+
+    AssetPack(const AssetPack& other) = delete;
+    AssetPack& operator=(const AssetPack& other) = delete;
+
+    bool open_archive(const char* archive_path);
+    void close_archive();
+    bool is_open() const;
+    int get_fd() const;
+    uint32_t get_entry_count() const;
+
+    const PackedAssetEntry* find(std::string_view path) const;
+    bool has_variant(const PackedAssetEntry& entry, ContentCoding coding) const;
+    ContentCoding negotiate(const PackedAssetEntry& entry, std::string_view accept_encoding) const;
+    std::string_view get_path(const PackedAssetEntry& entry) const;
+    std::string_view get_content_type(const PackedAssetEntry& entry) const;
+    std::string_view get_etag(const PackedAssetEntry& entry, ContentCoding coding) const;
+    std::string_view get_body(const PackedAssetEntry& entry, ContentCoding coding) const;
+    bool is_not_modified(const PackedAssetEntry& entry, ContentCoding coding, std::string_view if_none_match) const;
+    void encode_not_modified(std::vector<uint8_t>& block, HpackEncoder& encoder, const PackedAssetEntry& entry, ContentCoding coding) const;
+};
+
+#endif
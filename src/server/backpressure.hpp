@@ -0,0 +1,84 @@
+#ifndef BACKPRESSURE_HPP
+#define BACKPRESSURE_HPP
+
+/**
+ * @file backpressure.hpp
+ * @author Derek Tan
+ * @brief Declares per-connection and per-stream buffer accounting with high and low water marks.
+ * @date 2026-10-19
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+constexpr size_t DEFAULT_CONN_OUT_HIGH = 256UL * 1024UL;
+constexpr size_t DEFAULT_CONN_OUT_LOW = 64UL * 1024UL;
+constexpr size_t DEFAULT_STREAM_OUT_HIGH = 64UL * 1024UL;
+constexpr size_t DEFAULT_STREAM_OUT_LOW = 16UL * 1024UL;
+constexpr size_t DEFAULT_CONN_IN_HIGH = 256UL * 1024UL;
+constexpr size_t DEFAULT_CONN_IN_LOW = 64UL * 1024UL;
+
+/**
+ * @brief Water marks in octets. A high mark stops producers (or socket reads), and the matching low mark lets them go again.
+ */
+struct BufferLimits {
+    size_t conn_out_high;
+    size_t conn_out_low;
+    size_t stream_out_high;
+    size_t stream_out_low;
+    size_t conn_in_high;
+    size_t conn_in_low;
+
+    BufferLimits();
+};
+
+/**
+ * @brief Tracks octets a connection has buffered in both directions and decides who may produce more.
+ * @note Outbound space is handed out by `reserve`, which never grants past a high mark. Octets that already exist, such as frames the connection queued itself, are counted with `charge` instead and may pass the marks. Stream 0 stands for the connection's write queue: reading stops while it is over `conn_out_high`, because a peer that does not take its answers should not be asked for more work. Inbound request bodies can overshoot `conn_in_high` by at most one socket read, because reading stops as soon as the mark is crossed.
+ */
+class ConnectionBudget {
+private:
+    struct StreamBudget {
+        size_t outbound;
+        bool paused_by_stream;
+        bool paused_by_conn;
+    };
+
+    using StreamMap = std::unordered_map<uint32_t, StreamBudget>;
+
+    StreamMap streams;
+    std::vector<StreamMap::node_type> spare_streams; // closed streams' nodes, reused so steady traffic stops allocating
+    std::vector<uint32_t> resumed_streams;  // paused streams whose marks have drained
+    BufferLimits limits;
+    size_t outbound_total;
+    size_t inbound_total;
+    size_t outbound_peak;
+    uint32_t paused_count;
+    bool is_inbound_full;                   // inbound crossed `conn_in_high` and has not drained to `conn_in_low`
+    bool is_queue_full;                     // stream 0 crossed `conn_out_high` and has not drained to `conn_out_low`
+
+    StreamBudget& get_stream(uint32_t stream_id);
+    void check_resumes();
+
+public:
+    ConnectionBudget(const BufferLimits& buffer_limits);
+
+    size_t get_outbound() const;
+    size_t get_outbound(uint32_t stream_id) const;
+    size_t get_inbound() const;
+    size_t get_outbound_peak() const;
+    bool should_read() const;
+    bool is_outbound_full() const;
+
+    size_t reserve(uint32_t stream_id, size_t wanted);
+    void charge(uint32_t stream_id, size_t octets);
+    void on_flushed(uint32_t stream_id, size_t octets);
+    void on_inbound(size_t octets);
+    void on_consumed(size_t octets);
+    void close_stream(uint32_t stream_id);
+    uint32_t collect_resumed(std::vector<uint32_t>& out);
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef CONTENTCODING_HPP
+#define CONTENTCODING_HPP
+
+/**
+ * @file contentcoding.hpp
+ * @author Derek Tan
+ * @brief Declares content codings and `accept-encoding` negotiation for precompressed static responses.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "hpack/headerlist.hpp"
+#include "hpack/hpackencoder.hpp"
+
+constexpr uint32_t CONTENT_CODING_COUNT = 4U;
+constexpr uint16_t QVALUE_MAX = 1000U; // q-values are kept in thousandths (RFC 9110 12.4.2)
+constexpr uint32_t CONTENT_CODING_FIELD_MAX = 2U; // content-encoding and vary
+
+/**
+ * @brief Content codings a static resource may be stored in. Values index `PackedAssetEntry::variants` and the sidecar suffix table.
+ */
+enum class ContentCoding : uint8_t {
+    identity = 0,
+    br = 1,
+    gzip = 2,
+    zstd = 3
+};
+
+/// @brief Token for `content-encoding`, e.g "br".
+std::string_view get_coding_token(ContentCoding coding);
+
+/// @brief Precompressed sidecar suffix, e.g ".br". Identity has none.
+std::string_view get_coding_suffix(ContentCoding coding);
+
+/**
+ * @brief Parsed `accept-encoding` preferences: one q-value per known coding.
+ */
+struct AcceptEncoding {
+    uint16_t qvalues[CONTENT_CODING_COUNT];
+
+    AcceptEncoding();
+    void parse(std::string_view header_value);
+    bool is_acceptable(ContentCoding coding) const;
+};
+
+/**
+ * @brief Picks the coding to serve from those present in `available_mask` (bit per `ContentCoding`).
+ * @note Highest q-value wins, and ties go to the smaller coding (br, zstd, gzip, then identity). Identity is the fallback even when the client refused it, since serving it beats a 406 for static files.
+ */
+ContentCoding negotiate_coding(std::string_view accept_encoding, uint32_t available_mask);
+
+/**
+ * @brief Appends `content-encoding` for a non-identity coding and `vary: accept-encoding` whenever the resource has other codings, so shared caches key on it.
+ */
+void encode_coding_fields(std::vector<uint8_t>& block, HpackEncoder& encoder, ContentCoding coding, uint32_t available_mask);
+
+/**
+ * @brief The same fields as `encode_coding_fields`, as `HeaderField`s for a response handed to `Http2Connection`.
+ * @returns How many fields were written to `out`, which must have room for `CONTENT_CODING_FIELD_MAX`.
+ */
+uint32_t put_coding_fields(HeaderField* out, ContentCoding coding, uint32_t available_mask);
+
+#endif
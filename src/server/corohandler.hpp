@@ -0,0 +1,190 @@
+#ifndef COROHANDLER_HPP
+#define COROHANDLER_HPP
+
+/**
+ * @file corohandler.hpp
+ * @author Derek Tan
+ * @brief Declares the opt-in C++20 coroutine request handler API. Build with `make CPP20_BUILD=1` to enable it.
+ * @date 2026-10-19
+ */
+
+#if defined(H2PLUS_COROUTINES)
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <vector>
+#include "server/threadpool.hpp"
+#include "utils/framearena.hpp"
+
+constexpr size_t CORO_FRAME_PREFIX = alignof(std::max_align_t); // room to stash the owning arena before each frame
+constexpr uint32_t BODY_CHANNEL_SLOTS = 8U;
+
+/**
+ * @brief Owning handle of a running coroutine handler. Its frame comes from the `FrameArena` passed as the handler's first parameter.
+ * @note Handlers must look like `HandlerTask name(FrameArena& arena, CoroStream& stream, ...)`. Any other first parameter fails to compile instead of silently using `malloc`.
+ */
+class HandlerTask {
+public:
+    struct promise_type {
+        template <typename... Args>
+        static void* operator new(size_t frame_size, FrameArena& arena, Args&...) noexcept {
+            uint8_t* raw = static_cast<uint8_t*>(arena.allocate(frame_size + CORO_FRAME_PREFIX));
+
+            if (!raw) {
+                return nullptr;
+            }
+
+            *reinterpret_cast<FrameArena**>(raw) = &arena;
+
+            return raw + CORO_FRAME_PREFIX;
+        }
+
+        static void operator delete(void* frame, size_t frame_size) {
+            uint8_t* raw = static_cast<uint8_t*>(frame) - CORO_FRAME_PREFIX;
+            FrameArena* arena = *reinterpret_cast<FrameArena**>(raw);
+
+            arena->deallocate(raw, frame_size + CORO_FRAME_PREFIX);
+        }
+
+        static HandlerTask get_return_object_on_allocation_failure() {
+            return HandlerTask {nullptr};
+        }
+
+        HandlerTask get_return_object() {
+            return HandlerTask {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        /// @note Handlers start eagerly on the event loop and stay suspended at the end so the connection can observe `done()`.
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit HandlerTask(std::coroutine_handle<promise_type> coro_handle);
+
+public:
+    HandlerTask(std::nullptr_t);
+    ~HandlerTask();
+
+    HandlerTask(const HandlerTask& other) = delete;
+    HandlerTask& operator=(const HandlerTask& other) = delete;
+    HandlerTask(HandlerTask&& other) noexcept;
+    HandlerTask& operator=(HandlerTask&& other) noexcept;
+
+    bool is_valid() const;
+    bool done() const;
+};
+
+/**
+ * @brief A view of one request DATA payload. `data` stays valid until the handler awaits the next chunk.
+ */
+struct BodyChunk {
+    const uint8_t* data;
+    uint32_t length;
+    bool is_last;
+};
+
+/**
+ * @brief Single-consumer channel of request body chunks from a connection to its stream's handler.
+ * @note Chunks are copied in, since the connection's receive buffer moves on before a busy handler gets to them. One slot is kept for the chunk the handler holds, and once the rest fill up, new data is appended to the newest chunk, so pushing never fails before `finish`.
+ */
+class BodyChannel {
+private:
+    std::vector<uint8_t> slots[BODY_CHANNEL_SLOTS];
+    uint32_t head;
+    uint32_t count;
+    bool is_finished;
+    std::coroutine_handle<> waiter;
+
+    void wake();
+
+public:
+    class NextChunk {
+    private:
+        BodyChannel& channel;
+    public:
+        NextChunk(BodyChannel& source);
+        bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> caller) noexcept;
+        BodyChunk await_resume() noexcept;
+    };
+
+    BodyChannel();
+
+    bool is_full() const;
+    bool push_chunk(const uint8_t* data, uint32_t length);
+    void finish();
+    NextChunk next_chunk();
+};
+
+/**
+ * @brief A send flow-control window that handlers can await when it runs dry. Kept signed since a SETTINGS change may drive it negative (RFC 7540 6.9.2).
+ */
+class FlowWindow {
+private:
+    int64_t available;
+    std::coroutine_handle<> waiter;
+
+public:
+    class Reserve {
+    private:
+        FlowWindow& window;
+        uint32_t wanted;
+    public:
+        Reserve(FlowWindow& target, uint32_t want);
+        bool await_ready() const noexcept;
+        void await_suspend(std::coroutine_handle<> caller) noexcept;
+        uint32_t await_resume() noexcept;
+    };
+
+    FlowWindow(int64_t initial);
+
+    int64_t get_available() const;
+    void grant(int64_t increment);
+    Reserve reserve(uint32_t want);
+};
+
+/**
+ * @brief Suspends a handler while `work` runs on the offload pool, resuming it on the event loop once the completion queue is drained.
+ * @note Given an `Offloader` instead of a pool, the resume goes through it, so a connection can drop it for a stream that closed meanwhile.
+ */
+class OffloadAwaiter {
+private:
+    ThreadPool* pool;
+    CompletionQueue* replies;
+    const Offloader* offloader;
+    std::function<void()> work;
+    bool submitted;
+public:
+    OffloadAwaiter(ThreadPool& target_pool, CompletionQueue& reply_queue, std::function<void()> job);
+    OffloadAwaiter(const Offloader& target_offloader, std::function<void()> job);
+    bool await_ready() const noexcept;
+    bool await_suspend(std::coroutine_handle<> caller);
+    bool await_resume() const noexcept;
+};
+
+/**
+ * @brief Per-stream state a coroutine handler awaits on.
+ * @note `Http2Connection` builds these with an `Offloader`: it feeds `body` with the stream's DATA and grants `send_window` the peer's WINDOW_UPDATE increments.
+ */
+struct CoroStream {
+    BodyChannel body;
+    FlowWindow send_window;
+    Offloader offloader;
+    ThreadPool* pool;
+    CompletionQueue* replies;
+
+    CoroStream(int64_t initial_window, ThreadPool* offload_pool, CompletionQueue* reply_queue);
+    CoroStream(int64_t initial_window, Offloader stream_offloader);
+    OffloadAwaiter offload(std::function<void()> job);
+};
+
+#endif
+
+#endif
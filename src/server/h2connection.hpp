@@ -0,0 +1,348 @@
+#ifndef H2CONNECTION_HPP
+#define H2CONNECTION_HPP
+
+/**
+ * @file h2connection.hpp
+ * @author Derek Tan
+ * @brief Declares the sans-I/O HTTP/2 server connection: frames in, frames out, requests handed to a callback.
+ * @date 2026-10-19
+ */
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "hpack/hpackdecoder.hpp"
+#include "hpack/hpackencoder.hpp"
+#include "http1/h1parser.hpp"
+#include "http2/settings.hpp"
+#include "server/backpressure.hpp"
+#include "server/corohandler.hpp"
+#include "server/respcache.hpp"
+#include "server/staticfile.hpp"
+#include "server/threadpool.hpp"
+
+constexpr uint32_t H2_LOCAL_MAX_STREAMS = 100U;                            // our SETTINGS_MAX_CONCURRENT_STREAMS
+constexpr uint32_t H2_DEFAULT_RECV_WINDOW_LIMIT = 16U * 1024U * 1024U;           // autotuned receive windows stop growing here
+constexpr size_t H2_SPARE_BODY_LIMIT = 64UL * 1024UL;                          // bigger pending body buffers are freed, not kept on spare streams
+constexpr size_t H2_OUTPUT_LOW_WATER = 16UL * 1024UL;                          // DATA is only framed while less than this waits in the output
+constexpr uint8_t H2_DEFAULT_URGENCY = 3U;                                     // RFC 9218 4.1
+constexpr size_t H2_HEADER_BLOCK_SLACK = 4096UL;                               // encoded header blocks may exceed SETTINGS_MAX_HEADER_LIST_SIZE by this much
+
+class Http2Connection;
+
+/**
+ * @brief Called once per request when its header block is complete. The handler may answer at once with `send_response` or keep the stream ID and answer later.
+ */
+using RequestHandler = std::function<void(Http2Connection& connection, uint32_t stream_id, const HeaderList& request)>;
+
+/**
+ * @brief Called for each request DATA payload of a stream whose handler asked for its body with `read_body`, padding stripped. `is_last` marks the end of the body, which may come with no data.
+ * @note `data` views the connection's receive buffer and is only valid during the call. Its octets hold the flow-control windows shut until they are given back with `consume_body`.
+ */
+using BodyHandler = std::function<void(Http2Connection& connection, uint32_t stream_id, std::string_view data, bool is_last)>;
+
+#if defined(H2PLUS_COROUTINES)
+/**
+ * @brief Starts a coroutine handler for one request; it runs until its first suspension before this returns. Wrap a free function of this shape, since a lambda coroutine's first parameter is its closure rather than the arena.
+ * @note `request` is reused for the next request, so copy what is needed before the first `co_await`. `stream` lives until the stream closes; its body chunks count against the receive windows until given back with `Http2Connection::consume_body`.
+ */
+using CoroHandler = std::function<HandlerTask(FrameArena& arena, CoroStream& stream, Http2Connection& connection, uint32_t stream_id, const HeaderList& request)>;
+#endif
+
+/**
+ * @brief Server side stream state. Closed streams are erased, so a stream in the map is open or half-closed.
+ */
+struct Http2Stream {
+    std::string pending_body;   // response octets still waiting for send window
+    std::unique_ptr<StaticFileSender> file_body; // response DATA sent straight from a file by `write_file_output`
+    size_t pending_offset;
+    int64_t send_window;        // signed: a SETTINGS change may drive it negative (RFC 7540 6.9.2)
+    int64_t recv_window;
+    uint32_t recv_consumed;     // DATA octets taken since the last stream WINDOW_UPDATE
+    uint32_t recv_unconsumed;   // body octets passed to the body handler and not given back yet
+    bool is_reading_body;       // DATA goes to the body handler rather than being dropped
+    bool is_coroutine;          // served by the coroutine handler, which takes the body through its `CoroStream`
+    bool is_remote_closed;      // client sent END_STREAM
+    bool is_local_closed;       // our END_STREAM is queued
+    bool has_pending_end;       // END_STREAM rides on the last pending DATA frame
+    bool is_head;               // HEAD request: the response goes out as its head only (RFC 9110 9.3.2)
+    uint8_t urgency;            // from the request's `priority` field, 0 is most urgent
+};
+
+/**
+ * @brief One cleartext connection: prior-knowledge h2c (RFC 7540 3.4), an HTTP/1.1 `Upgrade: h2c` (RFC 7540 3.2), or plain HTTP/1.1 keep-alive served through the same handlers. Feed it whatever the socket read; it queues whatever must be written.
+ * @note Nothing here touches a socket. The owner drains `get_output()` after every `feed` or handler reply, stops reading while `should_read()` is false, and closes once `should_close()` holds. Request bodies are dropped and credited back to the flow-control windows unless the handler reads them.
+ */
+class Http2Connection {
+private:
+    /// @brief End of one queued response in the output stream, for timing how long it waits on the socket.
+    struct OutputMark {
+        uint64_t end_offset;
+        uint64_t queued_ticks;
+    };
+
+    enum class Phase {
+        preface,   // waiting for the 24 octet client preface
+        settings,  // preface seen: the next frame must be SETTINGS
+        frames,
+        http1,     // HTTP/1.1 requests, read one at a time
+        closing    // GOAWAY queued or the peer is gone: no more input is read
+    };
+
+    using StreamMap = std::unordered_map<uint32_t, Http2Stream>;
+
+#if defined(H2PLUS_COROUTINES)
+    /// @brief A running coroutine handler and the stream state it awaits on, which must stay put while it is suspended.
+    struct CoroSlot {
+        CoroStream stream;
+        HandlerTask task;
+
+        CoroSlot(int64_t initial_window, Offloader stream_offloader);
+    };
+#endif
+
+    StreamMap streams;
+    std::vector<StreamMap::node_type> spare_streams; // closed streams' nodes, reused so opening a stream stops allocating
+    RequestHandler handler;
+    BodyHandler body_handler;
+    Offloader offloader;                // unset: `offload` runs work inline
+#if defined(H2PLUS_COROUTINES)
+    CoroHandler coro_handler;           // set: requests go here instead of `handler`
+    FrameArena coro_arena;              // handler frames; declared before the slots so it outlives them
+    std::unordered_map<uint32_t, std::unique_ptr<CoroSlot>> coro_slots;
+    std::vector<std::unique_ptr<CoroSlot>> retired_coros; // handlers of closed streams, destroyed once no handler is running
+    uint32_t coro_depth;                // handlers running on the stack right now
+#endif
+    HpackDecoder decoder;
+    HpackEncoder encoder;
+    HeaderList request_fields;
+    ConnectionBudget budget;            // stream 0 is `out`, other streams their held request body
+    Http2Settings local_settings;
+    Http2Settings peer_settings;
+    std::vector<uint8_t> in;            // unparsed input
+    std::vector<uint8_t> out;           // frames waiting for the socket
+    std::vector<uint8_t> header_block;  // HEADERS plus CONTINUATION fragments
+    std::vector<OutputMark> output_marks;
+    std::vector<uint64_t> send_order;   // scratch for `fill_output`: urgency, then stream ID
+    std::vector<H1Field> h1_fields;     // scratch for HTTP/1.1 response heads
+    std::unique_ptr<StaticFileSender> orphan_file; // file of a closed stream whose DATA frame is partly written
+    size_t out_consumed;                // octets of `out` already written
+    size_t out_charged;                 // unwritten octets of `out` counted in `budget`
+    size_t block_frame_start;           // offset in `out` of the header block frame being encoded into
+    size_t marks_consumed;              // entries of `output_marks` already recorded
+    uint64_t out_written_total;         // octets written over the connection's life
+    uint64_t read_ticks;                // when the input now being parsed arrived
+    uint64_t h1_body_left;              // body octets of the latest HTTP/1.1 request still to arrive
+    int64_t conn_send_window;
+    int64_t conn_recv_window;
+    uint64_t bdp_ping_ticks;            // when the outstanding BDP PING left, 0 when none is out
+    uint64_t min_rtt_ticks;             // shortest BDP PING round trip, 0 before the first
+    uint32_t bdp_sample;                // octets given back to the connection window since the BDP PING left
+    uint32_t conn_recv_target;          // connection window granted so far; streams get the same through SETTINGS
+    uint32_t recv_window_limit;         // cap on `conn_recv_target`
+    uint32_t conn_recv_consumed;
+    uint32_t unacked_settings;          // SETTINGS frames we sent that the client has not acknowledged
+    uint32_t header_stream_id;          // stream of an unfinished header block, 0 when none
+    uint32_t file_frame_stream_id;      // stream whose file DATA frame is partly written, 0 when none
+    uint32_t last_stream_id;            // highest client stream ID seen; HTTP/1.1 requests take odd IDs too
+    uint32_t h1_stream_id;              // HTTP/1.1 request whose response is unfinished, 0 when none
+    uint32_t trace_id;                  // process-unique, tags this connection's trace events
+    uint8_t header_flags;               // flags of the HEADERS frame that opened `header_block`
+    uint8_t block_frame_flags;          // flags of the frame at `block_frame_start`, END_HEADERS aside
+    FrameType block_frame_type;
+    Phase phase;
+    bool is_peer_going_away;
+    bool is_http1;                      // responses go out as HTTP/1.1 messages
+    bool is_upgraded;                   // h2c Upgrade accepted: the preface must follow, and our SETTINGS already went out
+    bool is_parsing_h1;                 // `on_h1_input` is on the stack and picks up the next request itself
+    bool h1_keep_alive;
+
+    void put_frame_header(uint32_t length, FrameType type, uint8_t flags, uint32_t stream_id);
+    void put_frame(FrameType type, uint8_t flags, uint32_t stream_id, const uint8_t* payload, uint32_t length);
+    void put_u32_frame(FrameType type, uint32_t stream_id, uint32_t value);
+    void charge_output();
+    void begin_header_block(bool end_stream);
+    void seal_header_frame(uint32_t stream_id, uint32_t length, bool is_last);
+    void roll_header_block(uint32_t stream_id);
+    void end_header_block(uint32_t stream_id);
+    void put_local_settings();
+    void credit_connection(uint32_t octets);
+    void credit_stream(uint32_t stream_id, Http2Stream& stream, uint32_t octets);
+    void end_bdp_sample();
+    void grow_recv_windows(uint32_t window_size);
+    void send_goaway(H2Error error);
+    Http2Stream& open_stream(uint32_t stream_id);
+    Http2Stream& start_stream(uint32_t stream_id, bool end_stream);
+    void dispatch_request(uint32_t stream_id, Http2Stream& stream);
+    void close_stream(uint32_t stream_id);
+    void end_local_side(uint32_t stream_id);
+    bool has_body_reader(const Http2Stream& stream) const;
+    void deliver_body(uint32_t stream_id, std::string_view data, bool is_last);
+#if defined(H2PLUS_COROUTINES)
+    void start_coroutine(uint32_t stream_id, Http2Stream& stream);
+    void resume_coroutine(uint32_t stream_id, const std::function<void()>& resume);
+    void reap_coroutines();
+#endif
+    size_t put_data_frames(uint32_t stream_id, Http2Stream& stream, std::string_view data, bool is_final, size_t max_octets);
+    void flush_stream(uint32_t stream_id, Http2Stream& stream, size_t max_octets);
+    void put_response_head(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, uint64_t content_length, bool end_stream);
+    void mark_response_queued();
+    uint32_t pick_file_stream() const;
+    void queue_response(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, std::string_view body, std::string* owned_body);
+    void finish_h1_response(uint32_t stream_id);
+    void refuse_h1(uint32_t status);
+
+    bool on_preface();
+    bool on_h1_input();
+    void on_h1_body();
+    bool on_h1_request(const H1Request& request);
+    bool on_frame(const FrameHeader& header, const uint8_t* payload);
+    bool on_data(const FrameHeader& header, const uint8_t* payload);
+    bool on_headers(const FrameHeader& header, const uint8_t* payload);
+    bool on_header_block(uint32_t stream_id, bool end_stream);
+    bool append_header_fragment(const uint8_t* fragment, uint32_t length);
+    bool on_settings(const FrameHeader& header, const uint8_t* payload);
+    bool on_window_update(const FrameHeader& header, const uint8_t* payload);
+
+public:
+    Http2Connection(RequestHandler request_handler, BodyHandler request_body_handler = nullptr);
+
+    Http2Connection(const Http2Connection& other) = delete;
+    Http2Connection& operator=(const Http2Connection& other) = delete;
+
+    /**
+     * @brief Picks how response fields are indexed in the HPACK dynamic table. Connections start with `IndexingPolicy::frequency`.
+     */
+    void set_indexing_policy(IndexingPolicy policy);
+
+    /**
+     * @brief Caps receive window autotuning. Connections start at `H2_DEFAULT_RECV_WINDOW_LIMIT`; a limit of 65535 or less keeps the RFC default windows.
+     * @note While the peer keeps over half the connection window in flight, a PING times one round trip and counts the octets the handlers gave back meanwhile. When that drain rate comes near half the window per shortest round trip, the window is the limit and the connection and stream windows double toward the bandwidth-delay product. Held body octets count against the connection window, so the cap bounds what one connection can make a slow handler buffer. It bounds inbound memory only; see `send_response` for the outbound side.
+     */
+    void set_recv_window_limit(uint32_t limit);
+
+    /**
+     * @brief Replaces the buffer water marks, `BufferLimits` defaults until then. Call it before the first `feed`.
+     */
+    void set_buffer_limits(const BufferLimits& limits);
+
+    /**
+     * @brief Gives the connection somewhere to run blocking handler work. The event loop installs one backed by its thread pool.
+     */
+    void set_offloader(Offloader blocking_offloader);
+
+#if defined(H2PLUS_COROUTINES)
+    /**
+     * @brief Serves every later request with a coroutine handler instead of the request and body handlers. Its frames come from a per-connection `FrameArena`, its body arrives through `CoroStream::body`, and `CoroStream::offload` uses this connection's offloader.
+     * @note A handler suspended when its stream closes is destroyed without resuming, and pending offload completions for it are dropped.
+     */
+    void set_coro_handler(CoroHandler handler);
+#endif
+
+    /**
+     * @brief Runs blocking `work` (file reads, database calls) without stalling the event loop, then `on_complete` on the loop thread, where it may reply.
+     * @note `on_complete` only runs while the connection lives, so capturing the connection by reference is safe. The stream may have been reset meanwhile, and replies to it are then dropped. Without an offloader both run inline.
+     */
+    void offload(std::function<void()> work, std::function<void()> on_complete);
+
+    /**
+     * @brief Parses as many complete frames as the buffer limits allow, keeping the rest for later.
+     * @returns False once the connection is closing.
+     * @note While `should_read()` is false, parsing stops and input stays buffered. Once it holds again, `feed(nullptr, 0)` parses what was left.
+     */
+    bool feed(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Checks whether the socket should be read. False while unwritten output is over `conn_out_high` or held request body over `conn_in_high`, until it drains to the matching low mark.
+     * @note A client that never reads its responses thus stops being read too, so its output stays near one high mark instead of growing with every request it sends.
+     */
+    bool should_read();
+    void on_peer_closed();
+
+    const uint8_t* get_output() const;
+    size_t get_output_size() const;
+    void consume_output(size_t octets);
+
+    /**
+     * @brief Frames pending response DATA, most urgent stream first, until `target_octets` wait in the output or the send windows close.
+     * @returns True when anything was framed.
+     * @note Call it when the output has drained and the socket can take more, so the choice of stream is made as late as possible. `feed` calls it with `H2_OUTPUT_LOW_WATER`.
+     */
+    bool fill_output(size_t target_octets);
+    bool should_close() const;
+    uint32_t get_stream_count() const;
+
+    /**
+     * @brief Checks whether the client still owes its preface, its first SETTINGS, or an ACK for SETTINGS we sent. The owner bounds this with a timer.
+     */
+    bool is_handshaking() const;
+
+    /**
+     * @brief Checks whether a header block was started and not finished, which holds every other frame back (RFC 7540 6.10).
+     */
+    bool has_partial_header_block() const;
+
+    /**
+     * @brief Ends the connection from outside, e.g. when a timer runs out: GOAWAY with `error` once the client has sent its preface, nothing before. The owner flushes what it can and closes.
+     */
+    void expire(H2Error error);
+    uint32_t get_trace_id() const;
+    const Http2Settings& get_peer_settings() const;
+
+    /**
+     * @brief Queues a complete response: `:status`, the given fields, `content-length`, then the body as DATA within the send windows.
+     * @note `fields` hold lowercase names. Only as much body as fits the send windows and `H2_OUTPUT_LOW_WATER` is framed at once; the rest is copied, so the caller's buffer may go away on return.
+     * Bodies waiting for send window are charged to the buffer budget. Once queued output reaches `conn_out_high`, new streams are refused with REFUSED_STREAM until it drains, so a connection holds at most that mark plus the bodies of the requests already accepted. One response is never cut short, so a single large body can still pass the mark.
+     */
+    void send_response(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, std::string_view body);
+
+    /**
+     * @brief Same as `send_response`, but a body that cannot go out at once is moved in instead of copied.
+     */
+    void send_owned_response(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, std::string&& body);
+
+    /**
+     * @brief Queues a pre-framed response from a `ResponseCache` as it is, with no HPACK or DATA framing work.
+     * @returns False, queuing nothing, when the stream cannot take a response, the send windows cannot cover the whole body, or the encoder owes the peer a table size update; the caller then sends the response the usual way.
+     */
+    bool send_cached_response(uint32_t stream_id, const CachedResponse& response);
+
+    /**
+     * @brief Queues a response whose body is an opened file, or a range of one, sent with `sendfile` so its octets never pass through user space or count against the buffer budget.
+     * @note `content-length` comes from the file; content coding fields are the caller's. The DATA frames bypass the output buffer: the owner calls `write_file_output` once the output is drained.
+     */
+    void send_file_response(uint32_t stream_id, uint32_t status, const HeaderField* fields, uint32_t field_count, std::unique_ptr<StaticFileSender> file);
+
+    /**
+     * @brief Writes file DATA to `socket_fd`, up to `max_octets` and within the send windows, most urgent stream first. The one call that touches the socket, since `sendfile` must.
+     * @returns `done` after any progress, so call again; `window_empty` when no file can send now; `blocked` when the socket is full; `error` when the connection must close, as a frame may be cut short.
+     * @note Call it only with the output drained, or while `has_file_frame_pending`: a frame the socket cut short must be finished before anything else is written.
+     */
+    SendStatus write_file_output(int socket_fd, size_t max_octets);
+    bool has_file_frame_pending() const;
+    void reset_stream(uint32_t stream_id, H2Error error);
+
+    /**
+     * @brief Asks for the rest of this stream's request body to go to the body handler. Call it from the request handler.
+     * @returns False when nothing will follow: no body handler, or the request had no body.
+     * @note A response sent before the body ends leaves the stream open until the client finishes, unless `discard_body` is called.
+     */
+    bool read_body(uint32_t stream_id);
+
+    /**
+     * @brief Gives `octets` of delivered body back to the stream and connection receive windows. WINDOW_UPDATE goes out once half a window is back, so an upload only ever runs as fast as the handler drains it.
+     * @note Octets still held when the stream closes are given back then.
+     */
+    void consume_body(uint32_t stream_id, uint32_t octets);
+
+    /**
+     * @brief Stops reading this stream's body: held octets are given back and later DATA is dropped on arrival. Once the response is complete the upload is stopped with RST_STREAM(NO_ERROR) (RFC 7540 8.1).
+     */
+    void discard_body(uint32_t stream_id);
+};
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef H2SERVER_HPP
+#define H2SERVER_HPP
+
+/**
+ * @file h2server.hpp
+ * @author Derek Tan
+ * @brief Declares the epoll event loops that drive `Http2Connection`s over plain TCP.
+ * @date 2026-10-19
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "server/h2connection.hpp"
+#include "server/threadpool.hpp"
+#include "server/timerwheel.hpp"
+
+constexpr uint32_t SERVER_MAX_EVENTS = 64U;
+constexpr int SERVER_POLL_TIMEOUT_MS = 200;   // longest a loop sleeps between shutdown checks, timers aside
+constexpr size_t SERVER_READ_CHUNK = 16384UL;
+constexpr int SERVER_LISTEN_BACKLOG = 511;
+constexpr size_t SERVER_NOTSENT_LOWAT = 16384UL;          // unsent octets the kernel may hold per socket
+constexpr size_t SERVER_WRITE_QUANTUM = 64UL * 1024UL;    // DATA framed per write: enough to keep syscalls few, small enough to stay reorderable
+constexpr uint32_t SERVER_IDLE_TIMEOUT_MS = 60000U;       // no request in flight and no traffic
+constexpr uint32_t SERVER_HANDSHAKE_TIMEOUT_MS = 10000U;  // client preface, first SETTINGS, or an ACK for our SETTINGS
+constexpr uint32_t SERVER_HEADER_TIMEOUT_MS = 10000U;     // HEADERS to END_HEADERS of one header block
+constexpr uint32_t SERVER_POOL_WORKERS = 4U;              // threads shared by all loops for `Http2Connection::offload`
+
+struct ServerConfig {
+    std::string host;
+    uint16_t port;
+    uint32_t loop_count;
+    uint32_t recv_window_limit;   // see `Http2Connection::set_recv_window_limit`
+    uint32_t idle_timeout_ms;
+    uint32_t handshake_timeout_ms;
+    uint32_t header_timeout_ms;
+    uint32_t pool_workers;        // 0 runs offloaded work inline on the loop
+};
+
+/**
+ * @brief Which per-connection timer ran out.
+ */
+enum class SessionTimeout {
+    idle,
+    handshake,
+    header
+};
+
+/**
+ * @brief One thread's event loop. Every loop owns a listening socket bound with `SO_REUSEPORT`, so the kernel spreads new connections and loops share nothing.
+ * @note Each loop has one `TimerWheel`. Its next deadline is the `epoll_wait` timeout, and each session embeds its idle, handshake and header timers, so arming them never allocates.
+ * Work a handler offloads runs on the server's `ThreadPool`, and its completion comes back through the loop's `CompletionQueue`, whose eventfd sits in the same epoll set.
+ */
+class ServerLoop {
+private:
+    struct Session {
+        Http2Connection connection;
+        TimerNode idle_timer;       // armed while no request is in flight, pushed back by every event
+        TimerNode handshake_timer;  // armed while `Http2Connection::is_handshaking`
+        TimerNode header_timer;     // armed while `Http2Connection::has_partial_header_block`
+        uint64_t serial;    // tells a completion for a closed session from one for a later session on the same fd
+        int socket_fd;
+        bool wants_read;    // EPOLLIN is armed: the connection's buffers are under their high marks
+        bool wants_write;   // EPOLLOUT is armed
+
+        Session(const RequestHandler& handler, const BodyHandler& body_handler, uint64_t session_serial, int fd);
+    };
+
+    /// @brief A timer that ran out during `TimerWheel::advance`. Sessions are only expired afterwards, so no timer callback ever closes one.
+    struct ExpiredTimer {
+        int socket_fd;
+        SessionTimeout kind;
+    };
+
+    std::unordered_map<int, std::unique_ptr<Session>> sessions;
+    TimerWheel timers;
+    std::vector<ExpiredTimer> expired_timers;
+    CompletionQueue completions;
+    const RequestHandler& handler;
+    const BodyHandler& body_handler;
+    const std::atomic<bool>& is_running;
+    ThreadPool* pool;
+#if defined(H2PLUS_COROUTINES)
+    const CoroHandler* coro_handler;
+#endif
+    uint64_t next_serial;
+    int listen_fd;
+    int epoll_fd;
+    uint32_t recv_window_limit;
+    uint32_t idle_timeout_ms;
+    uint32_t handshake_timeout_ms;
+    uint32_t header_timeout_ms;
+
+    void accept_clients();
+    void on_readable(Session& session);
+    bool flush(Session& session);
+    void update_interest(Session& session, bool wants_read, bool wants_write);
+    void refresh_timers(Session& session);
+    void expire_session(const ExpiredTimer& expired);
+    void complete_offload(int socket_fd, uint64_t serial, const std::function<void()>& on_complete);
+    void close_session(int socket_fd);
+
+public:
+    ServerLoop(const RequestHandler& request_handler, const BodyHandler& request_body_handler, const std::atomic<bool>& running_flag, ThreadPool* offload_pool);
+    ~ServerLoop();
+
+    ServerLoop(const ServerLoop& other) = delete;
+    ServerLoop& operator=(const ServerLoop& other) = delete;
+
+#if defined(H2PLUS_COROUTINES)
+    void set_coro_handler(const CoroHandler* handler);
+#endif
+    bool listen_on(const ServerConfig& config);
+    void run();
+};
+
+/**
+ * @brief Starts `loop_count` event loops on their own threads and stops them together, with one offload pool shared between them.
+ */
+class Server {
+private:
+    std::vector<std::unique_ptr<ServerLoop>> loops;
+    std::vector<std::thread> threads;
+    std::unique_ptr<ThreadPool> pool;   // joined before the loops go, as its workers post into their completion queues
+    RequestHandler handler;
+    BodyHandler body_handler;
+#if defined(H2PLUS_COROUTINES)
+    CoroHandler coro_handler;
+#endif
+    std::atomic<bool> is_running;
+
+public:
+    Server(RequestHandler request_handler, BodyHandler request_body_handler = nullptr);
+    ~Server();
+
+    Server(const Server& other) = delete;
+    Server& operator=(const Server& other) = delete;
+
+#if defined(H2PLUS_COROUTINES)
+    /**
+     * @brief Serves requests with a coroutine handler instead; see `Http2Connection::set_coro_handler`. Call it before `start`.
+     */
+    void set_coro_handler(CoroHandler handler);
+#endif
+
+    bool start(const ServerConfig& config);
+    void stop();
+    void wait();
+};
+
+#endif
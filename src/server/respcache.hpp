@@ -0,0 +1,75 @@
+#ifndef RESPCACHE_HPP
+#define RESPCACHE_HPP
+
+/**
+ * @file respcache.hpp
+ * @author Derek Tan
+ * @brief Declares the in-memory cache of pre-framed responses for small hot resources.
+ * @date 2026-10-19
+ */
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "hpack/hpackencoder.hpp"
+#include "http2/frames.hpp"
+
+constexpr size_t RESPONSE_CACHE_ENTRY_OVERHEAD = 128UL; // rough bookkeeping cost per entry charged against the limit
+
+/**
+ * @brief A complete response as wire octets: HEADERS (plus any CONTINUATION) followed by DATA frames. Only the stream IDs differ between hits.
+ * @note `wire` is shared by every hit and keeps stream ID 0. Each hit copies it out and patches the copy, since a connection may still be writing an earlier hit when the next one arrives.
+ */
+struct CachedResponse {
+    std::vector<uint8_t> wire;            // frames back to back
+    std::vector<uint32_t> frame_offsets;  // offset of every frame header in `wire`
+    size_t body_length;                   // DATA payload octets, which the stream and connection send windows must cover
+
+    size_t get_footprint() const;
+    void append_wire(std::vector<uint8_t>& out, uint32_t stream_id) const;
+};
+
+/**
+ * @brief LRU and size bounded map of request paths to pre-framed responses. Header blocks are pre-encoded statelessly (static table references and literals), so any connection can replay them.
+ * @note Bodies are split at the 16384 octet default max frame size, which every peer must accept (RFC 7540 6.5.2). Not thread safe: keep one cache per event loop.
+ */
+class ResponseCache {
+private:
+    struct Entry {
+        std::string path;
+        CachedResponse response;
+    };
+
+    std::list<Entry> lru_entries; // most recently served at front
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> path_index; // keys view into `Entry::path`
+    HpackEncoder encoder;
+    std::vector<uint8_t> block_scratch;
+    size_t memory_limit;
+    size_t memory_used;
+    uint64_t hit_count;
+    uint64_t miss_count;
+    uint64_t eviction_count;
+
+    void build_frames(CachedResponse& response, const uint8_t* body, size_t body_length);
+    void evict_until(size_t wanted_free);
+
+public:
+    ResponseCache(size_t memory_limit_octets);
+
+    size_t get_memory_limit() const;
+    size_t get_memory_used() const;
+    uint32_t get_entry_count() const;
+    uint64_t get_hit_count() const;
+    uint64_t get_miss_count() const;
+    uint64_t get_eviction_count() const;
+
+    void set_memory_limit(size_t memory_limit_octets);
+    bool insert(const std::string& path, const std::vector<HeaderTablePair>& headers, const uint8_t* body, size_t body_length);
+    bool erase(std::string_view path);
+    const CachedResponse* find(std::string_view path);
+    const CachedResponse* serve(std::string_view path, uint32_t stream_id, std::vector<uint8_t>& out);
+};
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef ROUTER_HPP
+#define ROUTER_HPP
+
+/**
+ * @file router.hpp
+ * @author Derek Tan
+ * @brief Declares request routing on `:method` and `:path`: a radix trie for patterns and a compile-time table for fixed paths.
+ * @date 2026-10-19
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr uint32_t ROUTER_MAX_PARAMS = 6U;
+constexpr int32_t ROUTE_NO_TARGET = -1;
+
+enum class HttpMethod : uint8_t {
+    get,
+    head,
+    post,
+    put,
+    del,
+    patch,
+    options,
+    count    // also returned for methods the router does not know
+};
+
+constexpr std::string_view HTTP_METHOD_NAMES[] = {"GET", "HEAD", "POST", "PUT", "DELETE", "PATCH", "OPTIONS"};
+
+constexpr HttpMethod parse_http_method(std::string_view text) {
+    for (size_t method_i = 0UL; method_i < static_cast<size_t>(HttpMethod::count); method_i++) {
+        if (HTTP_METHOD_NAMES[method_i] == text) {
+            return static_cast<HttpMethod>(method_i);
+        }
+    }
+
+    return HttpMethod::count;
+}
+
+/// @brief `allow` value for a 405 from `RouteMatch::allowed_mask`, e.g "GET, HEAD" (RFC 9110 10.2.1).
+std::string format_allowed_methods(uint32_t allowed_mask);
+
+/// @brief 64-bit FNV-1a, usable in constant expressions so fixed routes are hashed at compile time.
+constexpr uint64_t route_hash(std::string_view text) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (char c : text) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/// @brief Drops the query part of a `:path`, since routes only match on the path part.
+constexpr std::string_view strip_query(std::string_view path) {
+    size_t query_pos = path.find('?');
+
+    return (query_pos == std::string_view::npos) ? path : path.substr(0, query_pos);
+}
+
+/**
+ * @brief Path parameters captured by a match. Views point into the matched `:path`.
+ */
+struct RouteParams {
+    std::string_view names[ROUTER_MAX_PARAMS];
+    std::string_view values[ROUTER_MAX_PARAMS];
+    uint32_t count;
+
+    std::string_view get(std::string_view name) const;
+};
+
+enum class RouteStatus {
+    found,
+    not_found,
+    method_not_allowed   // the path has routes, none for this method: reply 405 with `allowed_mask` as Allow
+};
+
+struct RouteMatch {
+    RouteStatus status;
+    int32_t target;        // caller-defined handler index, or `ROUTE_NO_TARGET`
+    uint32_t allowed_mask; // bit per `HttpMethod` routed on the matched path
+    RouteParams params;
+};
+
+/**
+ * @brief Fixed route for `StaticRouteTable`.
+ */
+struct StaticRoute {
+    HttpMethod method;
+    std::string_view path;
+    int32_t target;
+};
+
+/**
+ * @brief Fixed method and path pairs, hashed and sorted at compile time. Lookups binary-search the hashes and compare one path, so a `constexpr` table can even be queried inside `static_assert`.
+ */
+template <size_t N>
+class StaticRouteTable {
+private:
+    std::array<StaticRoute, N> routes;
+    std::array<uint64_t, N> hashes;
+
+public:
+    constexpr StaticRouteTable(const StaticRoute (&route_list)[N]) : routes {}, hashes {} {
+        for (size_t route_i = 0UL; route_i < N; route_i++) {
+            StaticRoute route = route_list[route_i];
+            uint64_t hash = route_hash(route.path);
+            size_t slot_i = route_i;
+
+            // Insertion sort by hash: fine at compile time and keeps lookups logarithmic.
+            while (slot_i > 0UL && this->hashes[slot_i - 1UL] > hash) {
+                this->hashes[slot_i] = this->hashes[slot_i - 1UL];
+                this->routes[slot_i] = this->routes[slot_i - 1UL];
+                slot_i--;
+            }
+
+            this->hashes[slot_i] = hash;
+            this->routes[slot_i] = route;
+        }
+    }
+
+    constexpr RouteMatch find(HttpMethod method, std::string_view path) const {
+        std::string_view route_path = strip_query(path);
+        uint64_t hash = route_hash(route_path);
+        size_t low = 0UL;
+        size_t high = N;
+        RouteMatch result {RouteStatus::not_found, ROUTE_NO_TARGET, 0U, {}};
+
+        while (low < high) {
+            size_t middle = low + (high - low) / 2UL;
+
+            if (this->hashes[middle] < hash) {
+                low = middle + 1UL;
+            } else {
+                high = middle;
+            }
+        }
+
+        // Routes with the same path share a hash, so every method of that path is adjacent here.
+        for (size_t route_i = low; route_i < N && this->hashes[route_i] == hash; route_i++) {
+            const StaticRoute& route = this->routes[route_i];
+
+            if (route.path != route_path) {
+                continue;
+            }
+
+            result.allowed_mask |= 1U << static_cast<uint32_t>(route.method);
+
+            if (route.method == method) {
+                result.status = RouteStatus::found;
+                result.target = route.target;
+                return result;
+            }
+        }
+
+        if (result.allowed_mask != 0U) {
+            result.status = RouteStatus::method_not_allowed;
+        }
+
+        return result;
+    }
+};
+
+/**
+ * @brief Radix trie of route patterns. Patterns are static text plus `:name` segments (one path segment) and an optional trailing `*name` (the rest of the path).
+ * @note Static edges win over parameters, which win over wildcards; matching backtracks across them. Matching only reads the `:path` view and never allocates.
+ */
+class Router {
+private:
+    struct Node {
+        std::string prefix;                          // static text of the edge into this node
+        std::vector<std::unique_ptr<Node>> children; // static edges, each with a distinct first octet
+        std::unique_ptr<Node> param_child;
+        std::unique_ptr<Node> wildcard_child;
+        std::string param_name;
+        std::string wildcard_name;
+        int32_t targets[static_cast<size_t>(HttpMethod::count)];
+
+        Node(std::string_view edge_text);
+        uint32_t get_allowed_mask() const;
+    };
+
+    std::unique_ptr<Node> root;
+    uint32_t route_count;
+
+    static Node* insert_static(Node* node, std::string_view text);
+    static bool match_node(const Node* node, std::string_view rest, HttpMethod method, RouteMatch& result);
+
+public:
+    Router();
+
+    bool add_route(HttpMethod method, std::string_view pattern, int32_t target);
+    RouteMatch match(HttpMethod method, std::string_view path) const;
+    uint32_t get_route_count() const;
+};
+
+#endif
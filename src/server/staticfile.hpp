@@ -0,0 +1,84 @@
+#ifndef STATICFILE_HPP
+#define STATICFILE_HPP
+
+/**
+ * @file staticfile.hpp
+ * @author Derek Tan
+ * @brief Declares the zero-copy static file DATA frame sender.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "http2/frames.hpp"
+#include "server/contentcoding.hpp"
+
+constexpr size_t STATIC_PATH_MAX = 4096UL;
+
+/**
+ * @brief Turns a request `:path` into a clean absolute path that stays inside whatever root it is appended to: the query is cut, escapes are decoded, empty and `.` segments dropped and `..` resolved.
+ * @returns False for a path that would climb above the root, or holds a bad escape, an encoded `/`, a backslash or a NUL. A trailing `/` is kept, so the caller can add an index file.
+ */
+bool normalize_request_path(std::string_view target, std::string& out);
+
+/**
+ * @brief Outcome of one `StaticFileSender::send_frames` call.
+ */
+enum class SendStatus {
+    blocked,      // socket buffer is full: wait for writability
+    window_empty, // flow-control window exhausted: wait for WINDOW_UPDATE
+    done,         // last DATA frame (END_STREAM) fully written
+    error         // I/O failure: reset the stream
+};
+
+/**
+ * @brief Streams one file as DATA frames. Each 9 octet frame header is written from user space, while payload octets go straight from the page cache to the socket via `sendfile`.
+ * @note Frames are sliced to the smaller of the send window and the peer's max frame size. Partial writes are resumed exactly where they stopped. A byte range of a borrowed descriptor, such as one asset inside a packed archive, can be sent the same way.
+ * `open_negotiated` serves a precompressed sidecar (`.br`, `.zst`, `.gz`) next to the file when the client accepts it; nothing is compressed at request time.
+ */
+class StaticFileSender {
+private:
+    uint8_t frame_header[FRAME_HEADER_SIZE]; // header of the frame now in flight
+    uint64_t range_start;    // first payload octet in the file
+    uint64_t range_end;      // one past the last payload octet
+    uint64_t file_offset;    // next payload octet to hand to sendfile
+    uint32_t header_sent;    // octets of `frame_header` already written
+    uint32_t payload_left;   // payload octets of the in-flight frame not yet sent
+    uint32_t stream_id;
+    uint32_t available_mask; // codings found on disk for the last opened file, bit per `ContentCoding`
+    ContentCoding coding;    // coding of the octets being sent
+    int file_fd;
+    bool owns_fd;            // false for ranges of a borrowed descriptor
+    bool is_unframed;        // HTTP/1.1 body: payload octets only, no frame headers
+    bool has_frame;          // a frame header was built and is not fully sent
+    bool is_finished;
+
+    void begin_frame(uint32_t payload_length, bool is_last);
+    bool adopt_file(int temp_fd, uint64_t file_size);
+
+public:
+    StaticFileSender();
+    ~StaticFileSender();
+
+    StaticFileSender(const StaticFileSender& other) = delete;
+    StaticFileSender& operator=(const StaticFileSender& other) = delete;
+
+    bool open_file(const char* path);
+    bool open_negotiated(const char* path, std::string_view accept_encoding);
+    void attach_range(int shared_fd, uint64_t offset, uint64_t length);
+    void close_file();
+    void bind_stream(uint32_t target_stream_id);
+
+    /**
+     * @brief Sends the payload bare, as an HTTP/1.1 body whose length the response head already gave. Windows and frame sizes passed to `send_frames` then only bound each write.
+     */
+    void set_unframed(bool unframed);
+    uint64_t get_file_size() const;
+    uint64_t get_remaining() const;
+    ContentCoding get_coding() const;
+    uint32_t get_available_mask() const;
+    SendStatus send_frames(int socket_fd, int64_t& send_window, uint32_t max_frame_size);
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+/**
+ * @file threadpool.hpp
+ * @author Derek Tan
+ * @brief Declares the work-stealing pool for blocking or CPU-heavy request handlers.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+constexpr uint32_t WORKER_DEQUE_CAPACITY = 1024U;   // power of two; more waiting tasks stay in the worker's inbox
+constexpr size_t POOL_CACHE_LINE = 64UL;
+
+class CompletionQueue;
+
+/**
+ * @brief Runs `work` off the event loop, then `on_complete` back on it. The owner drops `on_complete` if whatever it belongs to is gone by then.
+ * @note Event loops build one per connection over their `ThreadPool` and `CompletionQueue`; see `Http2Connection::offload`.
+ */
+using Offloader = std::function<void(std::function<void()> work, std::function<void()> on_complete)>;
+
+/**
+ * @brief One offloaded handler job. The `work` runs on a pool worker, then the same object travels back to its event loop's `CompletionQueue` where `on_complete` runs, and waits there to carry the loop's next job.
+ */
+struct PoolTask {
+    std::atomic<PoolTask*> next;       // link for the lock-free inboxes and the loop's spare list
+    std::function<void()> work;        // runs on a pool worker
+    std::function<void()> on_complete; // runs on the submitting event loop
+    CompletionQueue* reply_queue;      // where the finished task is posted
+};
+
+/**
+ * @brief Lock-free MPSC queue of `PoolTask`s linked through `PoolTask::next`: any thread may push, one thread at a time may pop.
+ * @note Based on the intrusive Vyukov MPSC queue, so pushing never allocates or waits.
+ */
+class TaskInbox {
+private:
+    std::atomic<PoolTask*> head; // last pushed task (producers)
+    PoolTask* tail;              // next task to pop (consumer only)
+    PoolTask stub;               // sentinel node
+
+public:
+    TaskInbox();
+
+    TaskInbox(const TaskInbox& other) = delete;
+    TaskInbox& operator=(const TaskInbox& other) = delete;
+
+    void push(PoolTask* task);
+    PoolTask* pop();
+};
+
+/**
+ * @brief Finished `PoolTask`s for one event loop. Producers are pool workers and the only consumer is the owning loop, which polls `get_wakeup_fd()` for readability.
+ * @note Wakeups are coalesced so a burst of completions costs one `eventfd` write. Drained tasks are kept on a spare list for the loop's later submissions, so steady offloading allocates nothing.
+ */
+class CompletionQueue {
+private:
+    TaskInbox finished;
+    PoolTask* spare_tasks;       // drained tasks linked through `next` (consumer only)
+    std::atomic<bool> wakeup_pending;
+    int wakeup_fd;
+
+public:
+    CompletionQueue();
+    ~CompletionQueue();
+
+    CompletionQueue(const CompletionQueue& other) = delete;
+    CompletionQueue& operator=(const CompletionQueue& other) = delete;
+
+    bool is_ready() const;
+    int get_wakeup_fd() const;
+
+    /**
+     * @brief Takes a spare task for a new submission, or allocates one when none is left. Consumer thread only.
+     */
+    PoolTask* take_task();
+    void push(PoolTask* task);
+    uint32_t drain();
+};
+
+/**
+ * @brief One worker's Chase-Lev deque: the owner pushes and pops newest-first at the bottom for cache warmth, thieves take oldest-first from the top with one CAS.
+ * @note Submitters are not the owner, so they post into `inbox`. Whichever worker claims the inbox moves its tasks into its own deque, so tasks queued behind a busy owner are still picked up.
+ */
+class WorkerQueue {
+private:
+    alignas(POOL_CACHE_LINE) std::atomic<int64_t> top;
+    alignas(POOL_CACHE_LINE) std::atomic<int64_t> bottom;
+    std::atomic<PoolTask*> slots[WORKER_DEQUE_CAPACITY];
+
+public:
+    TaskInbox inbox;
+    std::atomic<bool> is_inbox_claimed;   // held by the worker moving `inbox` into its own deque
+
+    WorkerQueue();
+
+    bool has_room() const;
+    void push(PoolTask* task);
+    PoolTask* pop();
+    PoolTask* steal();
+};
+
+/**
+ * @brief Fixed set of worker threads with per-worker deques. Idle workers steal from their peers before sleeping.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::vector<WorkerQueue> queues;
+    std::mutex sleep_guard;
+    std::condition_variable sleep_signal;
+    std::atomic<uint64_t> pending_count;  // submitted tasks not yet taken by a worker
+    std::atomic<uint64_t> steal_count;    // tasks run by a worker other than their queue's owner
+    std::atomic<uint32_t> submit_cursor;  // round robin pick of target inbox
+    std::atomic<uint32_t> sleeper_count;
+    std::atomic<bool> is_running;
+
+    bool claim_inbox(WorkerQueue& source, WorkerQueue& own);
+    PoolTask* find_task(uint32_t worker_id);
+    void run_worker(uint32_t worker_id);
+
+public:
+    ThreadPool(uint32_t worker_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    uint32_t get_worker_count() const;
+    uint64_t get_steal_count() const;
+
+    /**
+     * @brief Queues `work` for a worker; `on_complete` then runs from `reply_queue.drain()`.
+     * @note Call it on the thread that drains `reply_queue`, whose spare tasks it reuses.
+     */
+    bool submit(std::function<void()> work, std::function<void()> on_complete, CompletionQueue& reply_queue);
+    void shutdown();
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+/**
+ * @file timerwheel.hpp
+ * @author Derek Tan
+ * @brief Declares the hashed hierarchical timer wheel driving per-loop timeouts.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <functional>
+
+constexpr uint32_t TIMER_WHEEL_LEVELS = 4U;
+constexpr uint32_t TIMER_WHEEL_SLOT_BITS = 6U;
+constexpr uint32_t TIMER_WHEEL_SLOTS = 1U << TIMER_WHEEL_SLOT_BITS;  // 64 slots per level
+constexpr uint64_t TIMER_WHEEL_MAX_TICKS = (1UL << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) - 1UL;
+constexpr uint32_t TIMER_WHEEL_DEFAULT_TICK_MS = 10U;
+
+/**
+ * @brief Intrusive timer embedded in its owner (a connection or stream). Arming and cancelling never allocate.
+ * @note Set `on_expire` once when the owner is created. A callback may re-arm or cancel any timer, including its own.
+ */
+struct TimerNode {
+    TimerNode* prev;
+    TimerNode* next;
+    uint64_t expires_tick;
+    std::function<void()> on_expire;
+    uint8_t level;
+    uint8_t slot;
+    bool is_armed;
+
+    TimerNode();
+    TimerNode(const TimerNode& other) = delete;
+    TimerNode& operator=(const TimerNode& other) = delete;
+    ~TimerNode();
+};
+
+/**
+ * @brief One event loop's timers: idle, SETTINGS ACK, slow header, stream deadline and PING keepalive timeouts.
+ * @note Four levels of 64 slots cover 2^24 ticks (about 46 hours at 10 ms). Insert and cancel are O(1) list splices. Far timers move down a level only when their slot comes up. Per-level occupancy bitmaps give the loop its poll timeout without scanning slots.
+ */
+class TimerWheel {
+private:
+    TimerNode* slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint64_t occupied[TIMER_WHEEL_LEVELS]; // bit N set when slot N of a level has timers
+    uint64_t start_ms;
+    uint64_t current_tick;
+    uint32_t tick_ms;
+    uint32_t armed_count;
+
+    void link(TimerNode& node);
+    void unlink(TimerNode& node);
+    void cascade(uint32_t level);
+    uint32_t step();
+
+public:
+    TimerWheel(uint32_t tick_length_ms, uint64_t now_ms);
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel& other) = delete;
+    TimerWheel& operator=(const TimerWheel& other) = delete;
+
+    uint32_t get_armed_count() const;
+    uint64_t get_current_tick() const;
+
+    void schedule(TimerNode& node, uint64_t delay_ms);
+    void cancel(TimerNode& node);
+    uint32_t advance(uint64_t now_ms);
+    int next_timeout_ms(uint64_t now_ms) const;
+};
+
+/**
+ * @brief Monotonic coarse clock in milliseconds for driving a `TimerWheel`.
+ */
+uint64_t timer_clock_ms();
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file settings.cpp
+ * @author Derek Tan
+ * @brief Implements HTTP/2 SETTINGS parameter validation and parsing.
+ * @date 2026-10-19
+ */
+
+#include "http2/settings.hpp"
+
+/* Http2Settings Impl. */
+
+Http2Settings::Http2Settings() {
+    this->header_table_size = 4096U;
+    this->enable_push = 1U;
+    this->max_concurrent_streams = UINT32_MAX;
+    this->initial_window_size = DEFAULT_INITIAL_WINDOW_SIZE;
+    this->max_frame_size = FRAME_DEFAULT_MAX_SIZE;
+    this->max_header_list_size = UINT32_MAX;
+}
+
+H2Error Http2Settings::apply(uint16_t id, uint32_t value) {
+    switch (static_cast<SettingsId>(id)) {
+        case SettingsId::header_table_size:
+            this->header_table_size = value;
+            break;
+        case SettingsId::enable_push:
+            if (value > 1U) {
+                return H2Error::protocol_error;
+            }
+
+            this->enable_push = value;
+            break;
+        case SettingsId::max_concurrent_streams:
+            this->max_concurrent_streams = value;
+            break;
+        case SettingsId::initial_window_size:
+            if (value > MAX_WINDOW_SIZE) {
+                return H2Error::flow_control_error;
+            }
+
+            this->initial_window_size = value;
+            break;
+        case SettingsId::max_frame_size:
+            if (value < FRAME_DEFAULT_MAX_SIZE || value > FRAME_MAX_SIZE_LIMIT) {
+                return H2Error::protocol_error;
+            }
+
+            this->max_frame_size = value;
+            break;
+        case SettingsId::max_header_list_size:
+            this->max_header_list_size = value;
+            break;
+        default:
+            break;
+    }
+
+    return H2Error::no_error;
+}
+
+/* Payload Parsing Impl. */
+
+H2Error parse_settings_payload(Http2Settings& settings, const uint8_t* payload, uint32_t payload_length) {
+    if (payload_length % SETTINGS_ENTRY_SIZE != 0U) {
+        return H2Error::frame_size_error;
+    }
+
+    for (uint32_t entry_pos = 0U; entry_pos < payload_length; entry_pos += SETTINGS_ENTRY_SIZE) {
+        const uint8_t* entry = payload + entry_pos;
+        uint16_t id = static_cast<uint16_t>((entry[0] << 8) | entry[1]);
+        uint32_t value = (static_cast<uint32_t>(entry[2]) << 24) | (static_cast<uint32_t>(entry[3]) << 16)
+            | (static_cast<uint32_t>(entry[4]) << 8) | entry[5];
+        H2Error apply_status = settings.apply(id, value);
+
+        if (apply_status != H2Error::no_error) {
+            return apply_status;
+        }
+    }
+
+    return H2Error::no_error;
+}
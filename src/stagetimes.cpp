@@ -0,0 +1,148 @@
+/**
+ * @file stagetimes.cpp
+ * @author Derek Tan
+ * @brief Implements the per-thread stage latency histograms and their rendering.
+ * @date 2026-10-19
+ */
+
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "utils/hdrhistogram.hpp"
+#include "utils/stagetimes.hpp"
+
+constexpr uint64_t STAGE_CALIBRATE_NS = 5UL * 1000UL * 1000UL;
+
+static constexpr const char* STAGE_NAMES[STAGE_COUNT] = {
+    "frame_parse", "hpack_decode", "routing", "handler", "hpack_encode", "write_queue", "socket_flush"
+};
+
+static constexpr double REPORT_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+/**
+ * @brief One thread's histograms. Shards live until exit so samples from finished threads are still reported.
+ */
+struct StageShard {
+    std::mutex guard;
+    std::vector<HdrHistogram> latencies;
+
+    StageShard() : guard {}, latencies {} {
+        this->latencies.reserve(STAGE_COUNT);
+
+        for (uint32_t stage_i = 0U; stage_i < STAGE_COUNT; stage_i++) {
+            this->latencies.emplace_back(1UL, STAGE_HIGHEST_TICKS, STAGE_SIG_FIGURES);
+        }
+    }
+};
+
+static std::mutex registry_guard;
+static std::vector<std::unique_ptr<StageShard>> registry;
+
+static StageShard& get_stage_shard() {
+    thread_local StageShard* local_shard = nullptr;
+
+    if (!local_shard) {
+        std::lock_guard<std::mutex> registry_lock {registry_guard};
+
+        registry.push_back(std::make_unique<StageShard>());
+        local_shard = registry.back().get();
+    }
+
+    return *local_shard;
+}
+
+static uint64_t monotonic_ns() {
+    timespec now {};
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000UL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static double calibrate_tick_ns() {
+#if defined(__x86_64__) || defined(__i386__)
+    const uint64_t start_ns = monotonic_ns();
+    const uint64_t start_ticks = stage_clock_ticks();
+    uint64_t now_ns = start_ns;
+
+    while (now_ns - start_ns < STAGE_CALIBRATE_NS) {
+        now_ns = monotonic_ns();
+    }
+
+    return static_cast<double>(now_ns - start_ns) / static_cast<double>(stage_clock_ticks() - start_ticks);
+#else
+    return 1.0;
+#endif
+}
+
+/* Recording Impl. */
+
+void record_stage(Stage stage, uint64_t ticks) {
+    StageShard& shard = get_stage_shard();
+    std::lock_guard<std::mutex> shard_lock {shard.guard};
+
+    shard.latencies[static_cast<uint32_t>(stage)].record(ticks);
+}
+
+double get_stage_tick_ns() {
+    static const double tick_ns = calibrate_tick_ns();
+
+    return tick_ns;
+}
+
+/* Rendering Impl. */
+
+static void append_number(std::string& out, double value) {
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%.9g", value);
+
+    out.append(digits, static_cast<size_t>(length));
+}
+
+void render_stage_times(std::string& out) {
+    const double tick_seconds = get_stage_tick_ns() / 1e9;
+    std::vector<HdrHistogram> totals {};
+
+    totals.reserve(STAGE_COUNT);
+
+    for (uint32_t stage_i = 0U; stage_i < STAGE_COUNT; stage_i++) {
+        totals.emplace_back(1UL, STAGE_HIGHEST_TICKS, STAGE_SIG_FIGURES);
+    }
+
+    {
+        std::lock_guard<std::mutex> registry_lock {registry_guard};
+
+        for (const auto& shard : registry) {
+            std::lock_guard<std::mutex> shard_lock {shard->guard};
+
+            for (uint32_t stage_i = 0U; stage_i < STAGE_COUNT; stage_i++) {
+                totals[stage_i].merge(shard->latencies[stage_i]);
+            }
+        }
+    }
+
+    out.append("# HELP h2plus_stage_latency_seconds Time spent in each request pipeline stage.\n");
+    out.append("# TYPE h2plus_stage_latency_seconds summary\n");
+
+    for (uint32_t stage_i = 0U; stage_i < STAGE_COUNT; stage_i++) {
+        const HdrHistogram& latency = totals[stage_i];
+        const std::string stage_label = std::string {"stage=\""} + STAGE_NAMES[stage_i] + "\"";
+
+        for (double quantile : REPORT_QUANTILES) {
+            double seconds = static_cast<double>(latency.get_value_at_percentile(quantile * 100.0)) * tick_seconds;
+
+            out.append("h2plus_stage_latency_seconds{").append(stage_label).append(",quantile=\"");
+            append_number(out, quantile);
+            out.append("\"} ");
+            append_number(out, seconds);
+            out.push_back('\n');
+        }
+
+        out.append("h2plus_stage_latency_seconds_sum{").append(stage_label).append("} ");
+        append_number(out, latency.get_mean() * static_cast<double>(latency.get_count()) * tick_seconds);
+        out.push_back('\n');
+        out.append("h2plus_stage_latency_seconds_count{").append(stage_label).append("} ").append(std::to_string(latency.get_count())).append("\n");
+    }
+}
@@ -0,0 +1,349 @@
+/**
+ * @file staticfile.cpp
+ * @author Derek Tan
+ * @brief Implements the zero-copy static file DATA frame sender.
+ * @date 2026-10-19
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "server/staticfile.hpp"
+
+/* Helper Impl. */
+
+static bool build_sidecar_path(char* out, const char* path, size_t path_length, ContentCoding coding) {
+    std::string_view suffix = get_coding_suffix(coding);
+
+    if (path_length + suffix.length() >= STATIC_PATH_MAX) {
+        return false;
+    }
+
+    std::memcpy(out, path, path_length);
+    std::memcpy(out + path_length, suffix.data(), suffix.length());
+    out[path_length + suffix.length()] = '\0';
+
+    return true;
+}
+
+static int decode_hex_digit(char digit) {
+    if (digit >= '0' && digit <= '9') {
+        return digit - '0';
+    }
+
+    if (digit >= 'a' && digit <= 'f') {
+        return digit - 'a' + 10;
+    }
+
+    if (digit >= 'A' && digit <= 'F') {
+        return digit - 'A' + 10;
+    }
+
+    return -1;
+}
+
+bool normalize_request_path(std::string_view target, std::string& out) {
+    target = target.substr(0UL, target.find_first_of("?#"));
+    out.clear();
+
+    if (target.empty() || target.front() != '/') {
+        return false;
+    }
+
+    size_t cursor = 1UL;
+
+    while (cursor <= target.length()) {
+        size_t segment_end = target.find('/', cursor);
+
+        segment_end = (segment_end == std::string_view::npos) ? target.length() : segment_end;
+
+        std::string segment {};
+
+        for (size_t char_i = cursor; char_i < segment_end; char_i++) {
+            char letter = target[char_i];
+
+            if (letter == '%') {
+                if (char_i + 2UL >= segment_end) {
+                    return false;
+                }
+
+                const int high = decode_hex_digit(target[char_i + 1UL]);
+                const int low = decode_hex_digit(target[char_i + 2UL]);
+
+                if (high == -1 || low == -1) {
+                    return false;
+                }
+
+                letter = static_cast<char>((high << 4) | low);
+                char_i += 2UL;
+            }
+
+            // Decoded separators would let a segment smuggle a `..` past the checks below.
+            if (letter == '/' || letter == '\\' || letter == '\0') {
+                return false;
+            }
+
+            segment.push_back(letter);
+        }
+
+        if (segment == "..") {
+            const size_t parent_end = out.rfind('/');
+
+            if (parent_end == std::string::npos) {
+                return false;
+            }
+
+            out.resize(parent_end);
+        } else if (!segment.empty() && segment != ".") {
+            out.push_back('/');
+            out.append(segment);
+        }
+
+        cursor = segment_end + 1UL;
+    }
+
+    const char last = target.back();
+    const bool is_directory = last == '/' || (target.length() >= 2UL && target.substr(target.length() - 2UL) == "/.")
+        || (target.length() >= 3UL && target.substr(target.length() - 3UL) == "/..");
+
+    if (out.empty() || is_directory) {
+        out.push_back('/');
+    }
+
+    return out.length() < STATIC_PATH_MAX;
+}
+
+/* StaticFileSender Private Impl. */
+
+void StaticFileSender::begin_frame(uint32_t payload_length, bool is_last) {
+    FrameHeader header {payload_length, FrameType::data, static_cast<uint8_t>(is_last ? FLAG_END_STREAM : 0), this->stream_id};
+
+    pack_frame_header(this->frame_header, header);
+
+    // An unframed body keeps the header only for its END_STREAM flag.
+    this->header_sent = (this->is_unframed) ? FRAME_HEADER_SIZE : 0U;
+    this->payload_left = payload_length;
+    this->has_frame = true;
+}
+
+bool StaticFileSender::adopt_file(int temp_fd, uint64_t file_size) {
+    this->file_fd = temp_fd;
+    this->owns_fd = true;
+    this->range_start = 0UL;
+    this->range_end = file_size;
+    this->file_offset = 0UL;
+    this->has_frame = false;
+    this->is_finished = false;
+
+    return true;
+}
+
+/* StaticFileSender Public Impl. */
+
+StaticFileSender::StaticFileSender() {
+    this->range_start = 0UL;
+    this->range_end = 0UL;
+    this->file_offset = 0UL;
+    this->header_sent = 0U;
+    this->payload_left = 0U;
+    this->stream_id = 0U;
+    this->available_mask = 1U;
+    this->coding = ContentCoding::identity;
+    this->file_fd = -1;
+    this->owns_fd = false;
+    this->is_unframed = false;
+    this->has_frame = false;
+    this->is_finished = false;
+}
+
+StaticFileSender::~StaticFileSender() {
+    close_file();
+}
+
+bool StaticFileSender::open_file(const char* path) {
+    close_file();
+
+    int temp_fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (temp_fd == -1) {
+        return false;
+    }
+
+    struct stat file_info {};
+
+    // Only regular files can be sent: directories and devices would stall or fail inside sendfile.
+    if (fstat(temp_fd, &file_info) == -1 || !S_ISREG(file_info.st_mode)) {
+        close(temp_fd);
+        return false;
+    }
+
+    this->available_mask = 1U;
+    this->coding = ContentCoding::identity;
+
+    return adopt_file(temp_fd, static_cast<uint64_t>(file_info.st_size));
+}
+
+bool StaticFileSender::open_negotiated(const char* path, std::string_view accept_encoding) {
+    struct stat base_info {};
+    char sidecar_path[STATIC_PATH_MAX];
+    size_t path_length = std::strlen(path);
+    uint32_t found_mask = 1U;
+
+    if (stat(path, &base_info) == -1 || !S_ISREG(base_info.st_mode)) {
+        close_file();
+        return false;
+    }
+
+    // Look for sidecars next to the file. One older than its source is stale and ignored, so an edited file never serves old compressed octets.
+    for (uint32_t coding_i = 1U; coding_i < CONTENT_CODING_COUNT; coding_i++) {
+        struct stat sidecar_info {};
+
+        if (!build_sidecar_path(sidecar_path, path, path_length, static_cast<ContentCoding>(coding_i))) {
+            continue;
+        }
+
+        if (stat(sidecar_path, &sidecar_info) == 0 && S_ISREG(sidecar_info.st_mode) && sidecar_info.st_mtime >= base_info.st_mtime) {
+            found_mask |= 1U << coding_i;
+        }
+    }
+
+    ContentCoding chosen = negotiate_coding(accept_encoding, found_mask);
+
+    if (chosen != ContentCoding::identity && build_sidecar_path(sidecar_path, path, path_length, chosen)) {
+        if (open_file(sidecar_path)) {
+            this->available_mask = found_mask;
+            this->coding = chosen;
+            return true;
+        }
+    }
+
+    // Identity, or the sidecar vanished between stat and open.
+    if (!open_file(path)) {
+        return false;
+    }
+
+    this->available_mask = found_mask;
+
+    return true;
+}
+
+void StaticFileSender::attach_range(int shared_fd, uint64_t offset, uint64_t length) {
+    close_file();
+
+    this->file_fd = shared_fd;
+    this->owns_fd = false;
+    this->range_start = offset;
+    this->range_end = offset + length;
+    this->file_offset = offset;
+    this->has_frame = false;
+    this->is_finished = false;
+}
+
+void StaticFileSender::close_file() {
+    if (this->file_fd != -1 && this->owns_fd) {
+        close(this->file_fd);
+    }
+
+    this->file_fd = -1;
+    this->owns_fd = false;
+}
+
+void StaticFileSender::bind_stream(uint32_t target_stream_id) {
+    this->stream_id = target_stream_id;
+}
+
+void StaticFileSender::set_unframed(bool unframed) {
+    this->is_unframed = unframed;
+}
+
+uint64_t StaticFileSender::get_file_size() const {
+    return this->range_end - this->range_start;
+}
+
+uint64_t StaticFileSender::get_remaining() const {
+    return this->range_end - this->file_offset;
+}
+
+ContentCoding StaticFileSender::get_coding() const {
+    return this->coding;
+}
+
+uint32_t StaticFileSender::get_available_mask() const {
+    return this->available_mask;
+}
+
+SendStatus StaticFileSender::send_frames(int socket_fd, int64_t& send_window, uint32_t max_frame_size) {
+    if (this->file_fd == -1 || max_frame_size == 0U) {
+        return SendStatus::error;
+    }
+
+    while (!this->is_finished) {
+        if (!this->has_frame) {
+            uint64_t unsent = this->range_end - this->file_offset;
+
+            /// @note An empty payload still needs one zero length DATA frame to carry END_STREAM, which costs no window.
+            if (unsent > 0UL && send_window <= 0) {
+                return SendStatus::window_empty;
+            }
+
+            uint64_t slice = unsent;
+
+            if (slice > static_cast<uint64_t>(send_window)) {
+                slice = static_cast<uint64_t>(send_window);
+            }
+
+            if (slice > max_frame_size) {
+                slice = max_frame_size;
+            }
+
+            begin_frame(static_cast<uint32_t>(slice), slice == unsent);
+            send_window -= static_cast<int64_t>(slice);
+        }
+
+        // Write what is left of the frame header. MSG_MORE lets the kernel pack it with the payload that follows.
+        while (this->header_sent < FRAME_HEADER_SIZE) {
+            int send_flags = MSG_NOSIGNAL | ((this->payload_left > 0U) ? MSG_MORE : 0);
+            ssize_t sent = send(socket_fd, this->frame_header + this->header_sent, FRAME_HEADER_SIZE - this->header_sent, send_flags);
+
+            if (sent == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? SendStatus::blocked : SendStatus::error;
+            }
+
+            this->header_sent += static_cast<uint32_t>(sent);
+        }
+
+        while (this->payload_left > 0U) {
+            off_t temp_offset = static_cast<off_t>(this->file_offset);
+            ssize_t sent = sendfile(socket_fd, this->file_fd, &temp_offset, this->payload_left);
+
+            if (sent == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? SendStatus::blocked : SendStatus::error;
+            }
+
+            if (sent == 0) {
+                // The file shrank under us: the promised octets can never be sent.
+                return SendStatus::error;
+            }
+
+            this->file_offset = static_cast<uint64_t>(temp_offset);
+            this->payload_left -= static_cast<uint32_t>(sent);
+        }
+
+        this->has_frame = false;
+        this->is_finished = (this->frame_header[4] & FLAG_END_STREAM) != 0;
+    }
+
+    return SendStatus::done;
+}
@@ -65,10 +65,15 @@ bool SymbolTree::put_symbol(uint32_t code, uint32_t code_length, uint8_t symbol_
     bool has_new_eos = code == HPACK_HUFFCODE_EOS;
     uint32_t code_bitmask = 1U << (code_length - 1U);
 
-    // Special Case: place new root if no root is found!
+    // Special Case: place an empty root if no root is found, then insert the code path under it.
     if (!temp_cursor) {
-        this->root = symbol_node_create(symbol_octet, has_new_eos, nullptr, nullptr);
-        return this->root != nullptr;
+        this->root = symbol_node_create(0, false, nullptr, nullptr);
+
+        if (!this->root) {
+            return false;
+        }
+
+        temp_cursor = this->root;
     }
 
     for (uint32_t i = 0; i < code_length; i++) {
@@ -0,0 +1,375 @@
+/**
+ * @file threadpool.cpp
+ * @author Derek Tan
+ * @brief Implements the work-stealing handler pool and its completion queue.
+ * @date 2026-10-19
+ */
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "server/threadpool.hpp"
+
+/* Constants */
+
+constexpr uint32_t POOL_MIN_WORKERS = 1U;
+
+/* TaskInbox Impl. */
+
+TaskInbox::TaskInbox() : head {&stub}, tail {&stub}, stub {} {
+    this->stub.next.store(nullptr, std::memory_order_relaxed);
+    this->stub.reply_queue = nullptr;
+}
+
+void TaskInbox::push(PoolTask* task) {
+    task->next.store(nullptr, std::memory_order_relaxed);
+    PoolTask* prev = this->head.exchange(task, std::memory_order_acq_rel);
+    prev->next.store(task, std::memory_order_release);
+}
+
+PoolTask* TaskInbox::pop() {
+    PoolTask* temp_tail = this->tail;
+    PoolTask* temp_next = temp_tail->next.load(std::memory_order_acquire);
+
+    if (temp_tail == &this->stub) {
+        if (!temp_next) {
+            return nullptr;
+        }
+
+        this->tail = temp_next;
+        temp_tail = temp_next;
+        temp_next = temp_next->next.load(std::memory_order_acquire);
+    }
+
+    if (temp_next != nullptr) {
+        this->tail = temp_next;
+        return temp_tail;
+    }
+
+    /// @note A producer may be between its exchange and link store, so leave that task for the next pop.
+    if (temp_tail != this->head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    push(&this->stub);
+    temp_next = temp_tail->next.load(std::memory_order_acquire);
+
+    if (temp_next != nullptr) {
+        this->tail = temp_next;
+        return temp_tail;
+    }
+
+    return nullptr;
+}
+
+/* CompletionQueue Impl. */
+
+CompletionQueue::CompletionQueue() : finished {}, spare_tasks {nullptr}, wakeup_pending {false} {
+    this->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+CompletionQueue::~CompletionQueue() {
+    // Drop any completions the loop never collected.
+    PoolTask* task = nullptr;
+
+    while ((task = this->finished.pop()) != nullptr) {
+        delete task;
+    }
+
+    while (this->spare_tasks != nullptr) {
+        task = this->spare_tasks;
+        this->spare_tasks = task->next.load(std::memory_order_relaxed);
+        delete task;
+    }
+
+    if (this->wakeup_fd != -1) {
+        close(this->wakeup_fd);
+        this->wakeup_fd = -1;
+    }
+}
+
+bool CompletionQueue::is_ready() const {
+    return this->wakeup_fd != -1;
+}
+
+int CompletionQueue::get_wakeup_fd() const {
+    return this->wakeup_fd;
+}
+
+PoolTask* CompletionQueue::take_task() {
+    PoolTask* task = this->spare_tasks;
+
+    if (task == nullptr) {
+        return new PoolTask {};
+    }
+
+    this->spare_tasks = task->next.load(std::memory_order_relaxed);
+
+    return task;
+}
+
+void CompletionQueue::push(PoolTask* task) {
+    this->finished.push(task);
+
+    // Only the first completion after a drain pays for the eventfd write.
+    if (!this->wakeup_pending.exchange(true, std::memory_order_acq_rel)) {
+        uint64_t signal = 1U;
+        ssize_t write_count = write(this->wakeup_fd, &signal, sizeof(signal));
+        (void)write_count;
+    }
+}
+
+uint32_t CompletionQueue::drain() {
+    uint64_t signal_sum = 0U;
+    ssize_t read_count = read(this->wakeup_fd, &signal_sum, sizeof(signal_sum));
+    (void)read_count;
+
+    /// @note Clear the flag before popping so that a push racing with this drain re-arms the eventfd. The exchange also acquires every link published before the flag was set.
+    this->wakeup_pending.exchange(false, std::memory_order_acq_rel);
+
+    uint32_t completed_count = 0U;
+    PoolTask* task = nullptr;
+
+    while ((task = this->finished.pop()) != nullptr) {
+        if (task->on_complete) {
+            task->on_complete();
+        }
+
+        // Release the captures now and keep the node for the loop's next submission.
+        task->work = nullptr;
+        task->on_complete = nullptr;
+        task->next.store(this->spare_tasks, std::memory_order_relaxed);
+        this->spare_tasks = task;
+        completed_count++;
+    }
+
+    return completed_count;
+}
+
+/* WorkerQueue Impl. */
+
+WorkerQueue::WorkerQueue() : top {0}, bottom {0}, slots {}, inbox {}, is_inbox_claimed {false} {}
+
+bool WorkerQueue::has_room() const {
+    int64_t temp_bottom = this->bottom.load(std::memory_order_relaxed);
+    int64_t temp_top = this->top.load(std::memory_order_acquire);
+
+    return temp_bottom - temp_top < static_cast<int64_t>(WORKER_DEQUE_CAPACITY);
+}
+
+void WorkerQueue::push(PoolTask* task) {
+    int64_t temp_bottom = this->bottom.load(std::memory_order_relaxed);
+
+    this->slots[temp_bottom & (WORKER_DEQUE_CAPACITY - 1U)].store(task, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    this->bottom.store(temp_bottom + 1, std::memory_order_relaxed);
+}
+
+PoolTask* WorkerQueue::pop() {
+    int64_t temp_bottom = this->bottom.load(std::memory_order_relaxed) - 1;
+    this->bottom.store(temp_bottom, std::memory_order_relaxed);
+
+    /// @note The full fence orders the bottom claim against a thief's top read, so the owner and a thief never both take the last task.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t temp_top = this->top.load(std::memory_order_relaxed);
+
+    if (temp_top > temp_bottom) {
+        this->bottom.store(temp_bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    PoolTask* task = this->slots[temp_bottom & (WORKER_DEQUE_CAPACITY - 1U)].load(std::memory_order_relaxed);
+
+    if (temp_top == temp_bottom) {
+        // Last task: race thieves for it through top like they do.
+        if (!this->top.compare_exchange_strong(temp_top, temp_top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+
+        this->bottom.store(temp_bottom + 1, std::memory_order_relaxed);
+    }
+
+    return task;
+}
+
+PoolTask* WorkerQueue::steal() {
+    int64_t temp_top = this->top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t temp_bottom = this->bottom.load(std::memory_order_acquire);
+
+    if (temp_top >= temp_bottom) {
+        return nullptr;
+    }
+
+    PoolTask* task = this->slots[temp_top & (WORKER_DEQUE_CAPACITY - 1U)].load(std::memory_order_relaxed);
+
+    if (!this->top.compare_exchange_strong(temp_top, temp_top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+
+    return task;
+}
+
+/* ThreadPool Impl. */
+
+ThreadPool::ThreadPool(uint32_t worker_count)
+: workers {}, queues ((worker_count < POOL_MIN_WORKERS) ? POOL_MIN_WORKERS : worker_count), sleep_guard {}, sleep_signal {}, pending_count {0U}, steal_count {0U}, submit_cursor {0U}, sleeper_count {0U}, is_running {true} {
+    uint32_t checked_count = static_cast<uint32_t>(this->queues.size());
+
+    this->workers.reserve(checked_count);
+
+    for (uint32_t worker_i = 0U; worker_i < checked_count; worker_i++) {
+        this->workers.emplace_back(&ThreadPool::run_worker, this, worker_i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    shutdown();
+}
+
+uint32_t ThreadPool::get_worker_count() const {
+    return static_cast<uint32_t>(this->queues.size());
+}
+
+uint64_t ThreadPool::get_steal_count() const {
+    return this->steal_count.load(std::memory_order_relaxed);
+}
+
+bool ThreadPool::submit(std::function<void()> work, std::function<void()> on_complete, CompletionQueue& reply_queue) {
+    if (!this->is_running.load(std::memory_order_acquire) || !reply_queue.is_ready()) {
+        return false;
+    }
+
+    PoolTask* task = reply_queue.take_task();
+    task->work = std::move(work);
+    task->on_complete = std::move(on_complete);
+    task->reply_queue = &reply_queue;
+
+    uint32_t target = this->submit_cursor.fetch_add(1U, std::memory_order_relaxed) % get_worker_count();
+
+    /// @note Count before publishing so a worker never sees the task without its pending mark. These use seq_cst to pair with the sleeper check below.
+    this->pending_count.fetch_add(1U);
+    this->queues[target].inbox.push(task);
+
+    /// @note Skip the sleep mutex entirely while every worker is busy, keeping submission cheap for the event loop.
+    if (this->sleeper_count.load() > 0U) {
+        std::lock_guard<std::mutex> lock {this->sleep_guard};
+        this->sleep_signal.notify_one();
+    }
+
+    return true;
+}
+
+void ThreadPool::shutdown() {
+    if (!this->is_running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock {this->sleep_guard};
+        this->sleep_signal.notify_all();
+    }
+
+    for (auto& worker : this->workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // Tasks never started are dropped along with their completions.
+    for (auto& queue : this->queues) {
+        PoolTask* task = nullptr;
+
+        while ((task = queue.pop()) != nullptr) {
+            delete task;
+        }
+
+        while ((task = queue.inbox.pop()) != nullptr) {
+            delete task;
+        }
+    }
+}
+
+bool ThreadPool::claim_inbox(WorkerQueue& source, WorkerQueue& own) {
+    /// @note The inbox has a single-consumer pop, so the claim flag hands that role between workers. Its acquire and release carry the consumer state along.
+    if (source.is_inbox_claimed.exchange(true, std::memory_order_acquire)) {
+        return false;
+    }
+
+    bool moved_any = false;
+
+    while (own.has_room()) {
+        PoolTask* task = source.inbox.pop();
+
+        if (task == nullptr) {
+            break;
+        }
+
+        own.push(task);
+        moved_any = true;
+    }
+
+    source.is_inbox_claimed.store(false, std::memory_order_release);
+
+    return moved_any;
+}
+
+PoolTask* ThreadPool::find_task(uint32_t worker_id) {
+    WorkerQueue& own = this->queues[worker_id];
+    PoolTask* task = own.pop();
+
+    if (task != nullptr) {
+        return task;
+    }
+
+    if (claim_inbox(own, own) && (task = own.pop()) != nullptr) {
+        return task;
+    }
+
+    uint32_t queue_count = get_worker_count();
+
+    // Visit peers starting after this worker so thieves spread over different victims.
+    for (uint32_t offset = 1U; offset < queue_count; offset++) {
+        task = this->queues[(worker_id + offset) % queue_count].steal();
+
+        if (task != nullptr) {
+            this->steal_count.fetch_add(1U, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    // Then take over submissions waiting behind a busy peer.
+    for (uint32_t offset = 1U; offset < queue_count; offset++) {
+        if (claim_inbox(this->queues[(worker_id + offset) % queue_count], own) && (task = own.pop()) != nullptr) {
+            this->steal_count.fetch_add(1U, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+void ThreadPool::run_worker(uint32_t worker_id) {
+    while (this->is_running.load(std::memory_order_acquire)) {
+        PoolTask* task = find_task(worker_id);
+
+        if (task != nullptr) {
+            this->pending_count.fetch_sub(1U, std::memory_order_acq_rel);
+
+            if (task->work) {
+                task->work();
+            }
+
+            task->reply_queue->push(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock {this->sleep_guard};
+        this->sleeper_count.fetch_add(1U);
+
+        this->sleep_signal.wait(lock, [this]() {
+            return !this->is_running.load(std::memory_order_acquire) || this->pending_count.load() > 0U;
+        });
+
+        this->sleeper_count.fetch_sub(1U, std::memory_order_acq_rel);
+    }
+}
@@ -0,0 +1,251 @@
+/**
+ * @file timerwheel.cpp
+ * @author Derek Tan
+ * @brief Implements the hashed hierarchical timer wheel.
+ * @date 2026-10-19
+ */
+
+#include <ctime>
+#include "server/timerwheel.hpp"
+
+constexpr uint64_t TIMER_SLOT_MASK = TIMER_WHEEL_SLOTS - 1U;
+
+/* Helper Impl. */
+
+uint64_t timer_clock_ms() {
+    timespec now {};
+
+    // The coarse clock is read from the vDSO without a syscall, and a few ms of slop is fine for these timeouts.
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000UL + static_cast<uint64_t>(now.tv_nsec) / 1000000UL;
+}
+
+/* TimerNode Impl. */
+
+TimerNode::TimerNode() : prev {nullptr}, next {nullptr}, expires_tick {0UL}, on_expire {}, level {0}, slot {0}, is_armed {false} {}
+
+TimerNode::~TimerNode() {
+    /// @note Owners must cancel before destruction: a node has no back pointer to its wheel.
+    this->prev = nullptr;
+    this->next = nullptr;
+}
+
+/* TimerWheel Private Impl. */
+
+void TimerWheel::link(TimerNode& node) {
+    uint64_t delta = node.expires_tick - this->current_tick;
+    uint32_t level = 0U;
+
+    if (delta > TIMER_WHEEL_MAX_TICKS) {
+        // Past the wheel's range: park in the farthest slot and let cascading bring it back down.
+        delta = TIMER_WHEEL_MAX_TICKS;
+        node.expires_tick = this->current_tick + delta;
+    }
+
+    while (level + 1U < TIMER_WHEEL_LEVELS && delta >= (1UL << ((level + 1U) * TIMER_WHEEL_SLOT_BITS))) {
+        level++;
+    }
+
+    uint32_t slot = static_cast<uint32_t>((node.expires_tick >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_SLOT_MASK);
+    TimerNode*& head = this->slots[level][slot];
+
+    node.level = static_cast<uint8_t>(level);
+    node.slot = static_cast<uint8_t>(slot);
+    node.prev = nullptr;
+    node.next = head;
+
+    if (head != nullptr) {
+        head->prev = &node;
+    }
+
+    head = &node;
+    this->occupied[level] |= 1UL << slot;
+}
+
+void TimerWheel::unlink(TimerNode& node) {
+    TimerNode*& head = this->slots[node.level][node.slot];
+
+    if (node.prev != nullptr) {
+        node.prev->next = node.next;
+    } else {
+        head = node.next;
+    }
+
+    if (node.next != nullptr) {
+        node.next->prev = node.prev;
+    }
+
+    if (!head) {
+        this->occupied[node.level] &= ~(1UL << node.slot);
+    }
+
+    node.prev = nullptr;
+    node.next = nullptr;
+}
+
+void TimerWheel::cascade(uint32_t level) {
+    uint32_t slot = static_cast<uint32_t>((this->current_tick >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_SLOT_MASK);
+    TimerNode* cursor = this->slots[level][slot];
+
+    this->slots[level][slot] = nullptr;
+    this->occupied[level] &= ~(1UL << slot);
+
+    // Every node here now expires within the next `64^level` ticks, so each lands on a lower level.
+    while (cursor != nullptr) {
+        TimerNode* temp_next = cursor->next;
+
+        link(*cursor);
+        cursor = temp_next;
+    }
+}
+
+uint32_t TimerWheel::step() {
+    this->current_tick++;
+
+    // Whenever a level wraps, pull the next slot of the level above down before expiring anything.
+    for (uint32_t level = 1U; level < TIMER_WHEEL_LEVELS; level++) {
+        if ((this->current_tick & ((1UL << (level * TIMER_WHEEL_SLOT_BITS)) - 1UL)) != 0UL) {
+            break;
+        }
+
+        cascade(level);
+    }
+
+    uint32_t slot = static_cast<uint32_t>(this->current_tick & TIMER_SLOT_MASK);
+    uint32_t fired_count = 0U;
+
+    /// @note Take one node at a time from the live list, since a callback may cancel or re-arm other nodes in this slot.
+    while (this->slots[0][slot] != nullptr) {
+        TimerNode& node = *this->slots[0][slot];
+
+        unlink(node);
+        node.is_armed = false;
+        this->armed_count--;
+        fired_count++;
+
+        if (node.on_expire) {
+            node.on_expire();
+        }
+    }
+
+    return fired_count;
+}
+
+/* TimerWheel Public Impl. */
+
+TimerWheel::TimerWheel(uint32_t tick_length_ms, uint64_t now_ms) {
+    for (uint32_t level = 0U; level < TIMER_WHEEL_LEVELS; level++) {
+        for (uint32_t slot = 0U; slot < TIMER_WHEEL_SLOTS; slot++) {
+            this->slots[level][slot] = nullptr;
+        }
+
+        this->occupied[level] = 0UL;
+    }
+
+    this->start_ms = now_ms;
+    this->current_tick = 0UL;
+    this->tick_ms = (tick_length_ms > 0U) ? tick_length_ms : 1U;
+    this->armed_count = 0U;
+}
+
+TimerWheel::~TimerWheel() {
+    // Disarm leftovers so their owners do not think they are still linked.
+    for (uint32_t level = 0U; level < TIMER_WHEEL_LEVELS; level++) {
+        for (uint32_t slot = 0U; slot < TIMER_WHEEL_SLOTS; slot++) {
+            while (this->slots[level][slot] != nullptr) {
+                TimerNode& node = *this->slots[level][slot];
+
+                unlink(node);
+                node.is_armed = false;
+            }
+        }
+    }
+}
+
+uint32_t TimerWheel::get_armed_count() const {
+    return this->armed_count;
+}
+
+uint64_t TimerWheel::get_current_tick() const {
+    return this->current_tick;
+}
+
+void TimerWheel::schedule(TimerNode& node, uint64_t delay_ms) {
+    cancel(node);
+
+    // Round up, and never less than one tick: the current slot has already been processed.
+    uint64_t delay_ticks = (delay_ms + this->tick_ms - 1UL) / this->tick_ms;
+
+    node.expires_tick = this->current_tick + ((delay_ticks > 0UL) ? delay_ticks : 1UL);
+    node.is_armed = true;
+    this->armed_count++;
+    link(node);
+}
+
+void TimerWheel::cancel(TimerNode& node) {
+    if (!node.is_armed) {
+        return;
+    }
+
+    unlink(node);
+    node.is_armed = false;
+    this->armed_count--;
+}
+
+uint32_t TimerWheel::advance(uint64_t now_ms) {
+    uint64_t target_tick = (now_ms > this->start_ms) ? (now_ms - this->start_ms) / this->tick_ms : 0UL;
+    uint32_t fired_count = 0U;
+
+    while (this->current_tick < target_tick) {
+        if (this->armed_count == 0U) {
+            // Nothing to expire or cascade, so jump straight to the present.
+            this->current_tick = target_tick;
+            break;
+        }
+
+        fired_count += step();
+    }
+
+    return fired_count;
+}
+
+int TimerWheel::next_timeout_ms(uint64_t now_ms) const {
+    if (this->armed_count == 0U) {
+        return -1;
+    }
+
+    uint64_t next_tick = UINT64_MAX;
+
+    for (uint32_t level = 0U; level < TIMER_WHEEL_LEVELS; level++) {
+        uint64_t level_bits = this->occupied[level];
+
+        if (level_bits == 0UL) {
+            continue;
+        }
+
+        uint32_t shift = level * TIMER_WHEEL_SLOT_BITS;
+        uint64_t block = this->current_tick >> shift;
+        uint32_t current_slot = static_cast<uint32_t>(block & TIMER_SLOT_MASK);
+
+        // Rotate so bit 0 is the slot after the current one, then the lowest set bit is the nearest occupied slot.
+        uint32_t rotate = (current_slot + 1U) & TIMER_SLOT_MASK;
+        uint64_t rotated = (rotate == 0U) ? level_bits : ((level_bits >> rotate) | (level_bits << (TIMER_WHEEL_SLOTS - rotate)));
+        uint64_t blocks_ahead = static_cast<uint64_t>(__builtin_ctzll(rotated)) + 1UL;
+        uint64_t candidate = (block + blocks_ahead) << shift;
+
+        if (candidate < next_tick) {
+            next_tick = candidate;
+        }
+    }
+
+    uint64_t due_ms = this->start_ms + next_tick * this->tick_ms;
+
+    if (due_ms <= now_ms) {
+        return 0;
+    }
+
+    uint64_t wait_ms = due_ms - now_ms;
+
+    return (wait_ms > static_cast<uint64_t>(INT32_MAX)) ? INT32_MAX : static_cast<int>(wait_ms);
+}
@@ -0,0 +1,197 @@
+/**
+ * @file tracer.cpp
+ * @author Derek Tan
+ * @brief Implements the ring-buffer tracer's registry, binary dumps and Chrome trace rendering.
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include "utils/tracer.hpp"
+
+static constexpr const char* TRACE_EVENT_NAMES[static_cast<uint32_t>(TraceEvent::count)] = {
+    "conn_accepted", "frame_received", "stream_opened", "hpack_decode", "hpack_decode", "flush"
+};
+
+static std::mutex registry_guard;
+static std::vector<std::unique_ptr<TraceRing>> registry;
+
+/* TraceRing Impl. */
+
+TraceRing::TraceRing(uint32_t index) : records {}, head {0UL}, thread_index {index} {}
+
+void TraceRing::snapshot(std::vector<TraceRecord>& out) const {
+    const uint64_t end = this->head.load(std::memory_order_acquire);
+    // One slot short of the ring: the slot after `end` is the one a running writer may be filling.
+    const uint64_t begin = (end >= TRACE_RING_CAPACITY) ? end - TRACE_RING_CAPACITY + 1UL : 0UL;
+    const size_t first_out = out.size();
+
+    for (uint64_t slot = begin; slot < end; slot++) {
+        out.push_back(this->records[slot & (TRACE_RING_CAPACITY - 1U)]);
+    }
+
+    // Slots up to `later - capacity` may have been rewritten during the copy, counting the one being written now.
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    const uint64_t later = this->head.load(std::memory_order_relaxed);
+
+    if (later >= TRACE_RING_CAPACITY && later - TRACE_RING_CAPACITY + 1UL > begin) {
+        uint64_t stale = std::min(later - TRACE_RING_CAPACITY + 1UL, end) - begin;
+
+        out.erase(out.begin() + static_cast<std::ptrdiff_t>(first_out), out.begin() + static_cast<std::ptrdiff_t>(first_out + stale));
+    }
+}
+
+uint32_t TraceRing::get_thread_index() const {
+    return this->thread_index;
+}
+
+TraceRing& get_trace_ring() {
+    thread_local TraceRing* local_ring = nullptr;
+
+    if (!local_ring) {
+        std::lock_guard<std::mutex> registry_lock {registry_guard};
+
+        registry.push_back(std::make_unique<TraceRing>(static_cast<uint32_t>(registry.size())));
+        local_ring = registry.back().get();
+    }
+
+    return *local_ring;
+}
+
+/* Dump Impl. */
+
+bool dump_traces(const char* path) {
+    std::vector<TraceThread> threads {};
+
+    {
+        std::lock_guard<std::mutex> registry_lock {registry_guard};
+
+        for (const auto& ring : registry) {
+            threads.push_back(TraceThread {ring->get_thread_index(), {}});
+            ring->snapshot(threads.back().records);
+        }
+    }
+
+    FILE* dump = std::fopen(path, "wb");
+
+    if (!dump) {
+        return false;
+    }
+
+    const double tick_ns = get_stage_tick_ns();
+    const uint32_t thread_count = static_cast<uint32_t>(threads.size());
+    bool dump_ok = std::fwrite(TRACE_DUMP_MAGIC, sizeof(TRACE_DUMP_MAGIC), 1UL, dump) == 1UL
+        && std::fwrite(&tick_ns, sizeof(tick_ns), 1UL, dump) == 1UL
+        && std::fwrite(&thread_count, sizeof(thread_count), 1UL, dump) == 1UL;
+
+    for (const auto& thread : threads) {
+        const uint32_t record_count = static_cast<uint32_t>(thread.records.size());
+
+        dump_ok = dump_ok && std::fwrite(&thread.thread_index, sizeof(uint32_t), 1UL, dump) == 1UL
+            && std::fwrite(&record_count, sizeof(record_count), 1UL, dump) == 1UL
+            && std::fwrite(thread.records.data(), sizeof(TraceRecord), record_count, dump) == record_count;
+    }
+
+    return std::fclose(dump) == 0 && dump_ok;
+}
+
+bool load_trace_dump(const char* path, double& tick_ns, std::vector<TraceThread>& threads) {
+    FILE* dump = std::fopen(path, "rb");
+    char magic[sizeof(TRACE_DUMP_MAGIC)] {};
+    uint32_t thread_count = 0U;
+
+    if (!dump) {
+        return false;
+    }
+
+    bool load_ok = std::fread(magic, sizeof(magic), 1UL, dump) == 1UL
+        && std::memcmp(magic, TRACE_DUMP_MAGIC, sizeof(magic)) == 0
+        && std::fread(&tick_ns, sizeof(tick_ns), 1UL, dump) == 1UL && tick_ns > 0.0
+        && std::fread(&thread_count, sizeof(thread_count), 1UL, dump) == 1UL;
+
+    for (uint32_t thread_i = 0U; load_ok && thread_i < thread_count; thread_i++) {
+        TraceThread thread {};
+        uint32_t record_count = 0U;
+
+        load_ok = std::fread(&thread.thread_index, sizeof(uint32_t), 1UL, dump) == 1UL
+            && std::fread(&record_count, sizeof(record_count), 1UL, dump) == 1UL && record_count <= TRACE_RING_CAPACITY;
+
+        if (load_ok) {
+            thread.records.resize(record_count);
+            load_ok = std::fread(thread.records.data(), sizeof(TraceRecord), record_count, dump) == record_count;
+            threads.push_back(std::move(thread));
+        }
+    }
+
+    std::fclose(dump);
+
+    return load_ok;
+}
+
+/* Chrome Trace Impl. */
+
+static void append_timestamp(std::string& out, double micros) {
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%.3f", micros);
+
+    out.append(digits, static_cast<size_t>(length));
+}
+
+void render_chrome_trace(std::string& out, double tick_ns, const std::vector<TraceThread>& threads) {
+    uint64_t origin_ticks = UINT64_MAX;
+    bool is_first = true;
+
+    for (const auto& thread : threads) {
+        if (!thread.records.empty()) {
+            origin_ticks = std::min(origin_ticks, thread.records.front().ticks);
+        }
+    }
+
+    out.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    for (const auto& thread : threads) {
+        for (const auto& record : thread.records) {
+            if (record.event >= static_cast<uint8_t>(TraceEvent::count)) {
+                continue;
+            }
+
+            const TraceEvent event = static_cast<TraceEvent>(record.event);
+            const char* phase = "i";
+
+            // Decode begin and end pair up into one slice; everything else is an instant on its thread.
+            if (event == TraceEvent::hpack_decode_begin) {
+                phase = "B";
+            } else if (event == TraceEvent::hpack_decode_end) {
+                phase = "E";
+            }
+
+            out.append((is_first) ? "\n" : ",\n");
+            out.append("{\"name\":\"").append(TRACE_EVENT_NAMES[record.event]).append("\",\"ph\":\"").append(phase);
+            out.append("\",\"pid\":1,\"tid\":").append(std::to_string(thread.thread_index)).append(",\"ts\":");
+            append_timestamp(out, static_cast<double>(record.ticks - origin_ticks) * tick_ns / 1000.0);
+
+            if (phase[0] == 'i') {
+                out.append(",\"s\":\"t\"");
+            }
+
+            out.append(",\"args\":{\"conn\":").append(std::to_string(record.conn_id));
+            out.append(",\"stream\":").append(std::to_string(record.stream_id));
+
+            if (event == TraceEvent::frame_received) {
+                out.append(",\"type\":").append(std::to_string(record.arg >> 24));
+                out.append(",\"length\":").append(std::to_string(record.arg & 0xffffffU));
+            } else {
+                out.append(",\"arg\":").append(std::to_string(record.arg));
+            }
+
+            out.append("}}");
+            is_first = false;
+        }
+    }
+
+    out.append("\n]}\n");
+}
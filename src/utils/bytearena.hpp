@@ -0,0 +1,48 @@
+#ifndef BYTEARENA_HPP
+#define BYTEARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+constexpr size_t BYTE_ARENA_CHUNK_SIZE = 4096UL;
+
+/**
+ * @brief Bump allocator for variable-length bytes such as decoded header text. Memory is only released all at once by `reset`, which keeps the chunks for the next user.
+ * @note Not thread safe: owned by one stream on its connection's event loop.
+ */
+class ByteArena {
+private:
+    struct Chunk {
+        uint8_t* data;
+        size_t capacity;
+    };
+
+    std::vector<Chunk> chunks;
+    size_t chunk_index;   // chunk currently bumped from
+    size_t chunk_used;    // octets taken from that chunk
+    size_t used_total;
+
+public:
+    ByteArena();
+    ~ByteArena();
+
+    ByteArena(const ByteArena& other) = delete;
+    ByteArena& operator=(const ByteArena& other) = delete;
+
+    uint8_t* allocate(size_t size);
+    std::string_view copy(std::string_view text);
+
+    /**
+     * @brief Returns `head`, `separator` and `tail` back to back in arena memory. When `head` is the newest allocation and its chunk has room, it grows in place instead of being copied.
+     * @note Returns an empty view when out of memory.
+     */
+    std::string_view join(std::string_view head, std::string_view separator, std::string_view tail);
+
+    void reset();
+    size_t get_used() const;
+    uint32_t get_chunk_count() const;
+};
+
+#endif
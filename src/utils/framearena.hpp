@@ -0,0 +1,46 @@
+#ifndef FRAMEARENA_HPP
+#define FRAMEARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint32_t FRAME_ARENA_CLASS_COUNT = 6U;    // size classes: 64, 128, ..., 2048 octets
+constexpr size_t FRAME_ARENA_MIN_BLOCK = 64UL;
+constexpr size_t FRAME_ARENA_MAX_BLOCK = FRAME_ARENA_MIN_BLOCK << (FRAME_ARENA_CLASS_COUNT - 1U);
+constexpr size_t FRAME_ARENA_CHUNK_SIZE = 16384UL;
+
+/**
+ * @brief Per-connection slab allocator for small short-lived objects such as coroutine frames. Freed blocks go onto size-class free lists, so a steady stream of same-sized frames is served without touching `malloc`.
+ * @note Not thread safe: owned and used only by its connection's event loop. Blocks above `FRAME_ARENA_MAX_BLOCK` fall back to global `operator new`. Nothing here throws: a failed allocation returns `nullptr`, as a coroutine promise's `noexcept operator new` needs.
+ */
+class FrameArena {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    uint8_t* newest_chunk;                            // raw slabs owned by this arena, linked through their first block
+    FreeBlock* free_lists[FRAME_ARENA_CLASS_COUNT];   // recycled blocks per size class
+    uint8_t* bump_cursor;                             // unused tail of the newest chunk
+    size_t bump_left;
+    uint32_t live_count;                              // blocks handed out and not yet returned
+    uint32_t fallback_count;                          // oversized requests passed to operator new
+    uint32_t chunk_count;
+
+    static uint32_t get_size_class(size_t size);
+
+public:
+    FrameArena();
+    ~FrameArena();
+
+    FrameArena(const FrameArena& other) = delete;
+    FrameArena& operator=(const FrameArena& other) = delete;
+
+    void* allocate(size_t size);
+    void deallocate(void* block, size_t size);
+    uint32_t get_live_count() const;
+    uint32_t get_fallback_count() const;
+    uint32_t get_chunk_count() const;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef HDRHISTOGRAM_HPP
+#define HDRHISTOGRAM_HPP
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief High dynamic range histogram: records integer values between `lowest` and `highest` with a fixed number of significant decimal digits, using log-linear buckets as in Gil Tene's HdrHistogram.
+ * @note Recording is O(1) with no allocation. Values above `highest` are clamped into the top bucket and counted in `get_clamped_count`. Not thread safe: keep one per thread and `merge` them.
+ */
+class HdrHistogram {
+private:
+    std::vector<uint64_t> counts;
+    uint64_t lowest_trackable;
+    uint64_t highest_trackable;
+    uint64_t total_count;
+    uint64_t clamped_count;
+    uint64_t min_value;
+    uint64_t max_value;
+    double value_sum;
+    int32_t unit_magnitude;                  // log2 of the lowest trackable value
+    int32_t sub_bucket_half_count_magnitude;
+    int32_t sub_bucket_count;
+    int32_t sub_bucket_half_count;
+    uint64_t sub_bucket_mask;
+    uint32_t significant_figures;
+
+    int32_t get_bucket_index(uint64_t value) const;
+    int32_t get_sub_bucket_index(uint64_t value, int32_t bucket_index) const;
+    size_t get_counts_index(int32_t bucket_index, int32_t sub_bucket_index) const;
+    uint64_t get_value_at_index(size_t index) const;
+    uint64_t get_highest_equivalent(uint64_t value) const;
+
+public:
+    HdrHistogram(uint64_t lowest, uint64_t highest, uint32_t sig_figures);
+
+    void record(uint64_t value);
+    void record_n(uint64_t value, uint64_t count);
+    void merge(const HdrHistogram& other);
+    void reset();
+
+    uint64_t get_count() const;
+    uint64_t get_clamped_count() const;
+    uint64_t get_min() const;
+    uint64_t get_max() const;
+    double get_mean() const;
+    uint64_t get_value_at_percentile(double percentile) const;
+    size_t get_footprint() const;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+/**
+ * @file metrics.hpp
+ * @author Derek Tan
+ * @brief Declares per-thread counters for HPACK and connection activity, plus their Prometheus text rendering.
+ * @date 2026-10-19
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+constexpr uint32_t METRICS_MAX_SHARDS = 256U;   // the last shard is shared by any threads past this count
+constexpr uint32_t METRICS_FRAME_SLOTS = 11U;   // 10 RFC 7540 frame types plus one slot for unknown types
+
+/**
+ * @brief Every scalar metric. Gauges are kept as wrapping sums of increments and decrements, so shards can be added up in any order.
+ */
+enum class Metric : uint32_t {
+    hpack_encode_static_hits,    // fields sent as a full static table reference
+    hpack_encode_dynamic_hits,   // fields sent as a full dynamic table reference
+    hpack_encode_literal_fields, // fields that missed the tables and went out as literals
+    hpack_decode_static_hits,    // fields received as a full static table reference
+    hpack_decode_dynamic_hits,
+    hpack_decode_literal_fields,
+    hpack_table_inserts,
+    hpack_table_evictions,
+    hpack_table_octets,      // gauge: RFC 7541 size of every live dynamic table
+    hpack_table_entries,     // gauge
+    hpack_encode_plain_octets,
+    hpack_encode_block_octets,
+    hpack_decode_block_octets,
+    hpack_decode_plain_octets,
+    hpack_encode_huffman_strings,
+    hpack_encode_raw_strings,
+    hpack_decode_huffman_strings,
+    hpack_decode_raw_strings,
+    connections_accepted,
+    connections_active,      // gauge
+    streams_opened,
+    streams_reset,
+    streams_active,          // gauge
+    recv_window_grows,       // receive windows autotuned upward
+    count
+};
+
+constexpr uint32_t METRIC_COUNT = static_cast<uint32_t>(Metric::count);
+
+/**
+ * @brief One thread's counters on their own cache lines. Only the owning thread writes, so updates are a plain relaxed load and store; readers just sum relaxed loads.
+ */
+struct alignas(64) MetricsShard {
+    std::atomic<uint64_t> values[METRIC_COUNT];
+    std::atomic<uint64_t> frames_in[METRICS_FRAME_SLOTS];
+    std::atomic<uint64_t> frames_out[METRICS_FRAME_SLOTS];
+    std::atomic<bool> is_shared;   // overflow shard written by several threads: updates must be atomic adds
+};
+
+/**
+ * @brief Claims this thread's shard on first use. Shards are never recycled, so counts from finished threads stay in the totals.
+ */
+MetricsShard& claim_metrics_shard();
+
+inline MetricsShard& get_metrics_shard() {
+    thread_local MetricsShard* local_shard = nullptr;
+
+    if (!local_shard) {
+        local_shard = &claim_metrics_shard();
+    }
+
+    return *local_shard;
+}
+
+inline void bump_counter(std::atomic<uint64_t>& counter, uint64_t amount, const std::atomic<bool>& is_shared) {
+    if (is_shared.load(std::memory_order_relaxed)) {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    } else {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+inline void metrics_add(Metric metric, uint64_t amount = 1UL) {
+    MetricsShard& shard = get_metrics_shard();
+
+    bump_counter(shard.values[static_cast<uint32_t>(metric)], amount, shard.is_shared);
+}
+
+/// @brief Lowers a gauge. The unsigned wrap cancels out once every shard is summed.
+inline void metrics_sub(Metric metric, uint64_t amount = 1UL) {
+    metrics_add(metric, ~amount + 1UL);
+}
+
+inline void metrics_count_frame(uint8_t frame_type, bool is_outbound) {
+    MetricsShard& shard = get_metrics_shard();
+    uint32_t slot = (frame_type < METRICS_FRAME_SLOTS - 1U) ? frame_type : METRICS_FRAME_SLOTS - 1U;
+
+    bump_counter((is_outbound) ? shard.frames_out[slot] : shard.frames_in[slot], 1UL, shard.is_shared);
+}
+
+/**
+ * @brief Sums one metric over every claimed shard. Gauges come back as a two's complement `int64_t` cast to `uint64_t`.
+ */
+uint64_t metrics_total(Metric metric);
+
+uint64_t metrics_frame_total(uint8_t frame_type, bool is_outbound);
+
+/**
+ * @brief Appends every metric in the Prometheus text exposition format (version 0.0.4).
+ */
+void render_metrics(std::string& out);
+
+#endif
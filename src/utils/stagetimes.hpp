@@ -0,0 +1,84 @@
+#ifndef STAGETIMES_HPP
+#define STAGETIMES_HPP
+
+/**
+ * @file stagetimes.hpp
+ * @author Derek Tan
+ * @brief Declares per-thread latency histograms for each stage of the request pipeline.
+ * @date 2026-10-19
+ */
+
+#include <cstdint>
+#include <string>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+constexpr uint64_t STAGE_HIGHEST_TICKS = 100UL * 1000UL * 1000UL * 1000UL; // ~25 s at 4 GHz, anything slower is clamped
+constexpr uint32_t STAGE_SIG_FIGURES = 2U;                                  // 1% buckets keep each histogram near 30 KiB
+
+enum class Stage : uint32_t {
+    frame_parse,   // socket read until the frame ending a header block is dispatched
+    hpack_decode,
+    routing,
+    handler,       // whole request callback, routing included
+    hpack_encode,
+    write_queue,   // response queued until the kernel took its last queued octet
+    socket_flush,  // one flush of a connection's output to its socket
+    count
+};
+
+constexpr uint32_t STAGE_COUNT = static_cast<uint32_t>(Stage::count);
+
+/**
+ * @brief Cheap monotonic timestamp: the TSC on x86, `CLOCK_MONOTONIC` nanoseconds elsewhere. Ticks become seconds only when a report is rendered.
+ */
+inline uint64_t stage_clock_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    timespec now {};
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000UL + static_cast<uint64_t>(now.tv_nsec);
+#endif
+}
+
+/**
+ * @brief Adds one sample, in ticks, to this thread's histogram for `stage`.
+ * @note Each thread owns its histograms. The per-thread lock is only ever contended by a report being rendered.
+ */
+void record_stage(Stage stage, uint64_t ticks);
+
+/**
+ * @brief Times its own scope into one stage.
+ */
+class StageProbe {
+private:
+    uint64_t start_ticks;
+    Stage stage;
+
+public:
+    explicit StageProbe(Stage timed_stage) : start_ticks {stage_clock_ticks()}, stage {timed_stage} {}
+    ~StageProbe() {
+        record_stage(this->stage, stage_clock_ticks() - this->start_ticks);
+    }
+
+    StageProbe(const StageProbe& other) = delete;
+    StageProbe& operator=(const StageProbe& other) = delete;
+};
+
+/**
+ * @brief Nanoseconds per tick of `stage_clock_ticks`, measured once against `CLOCK_MONOTONIC` on first call.
+ */
+double get_stage_tick_ns();
+
+/**
+ * @brief Merges every thread's histograms and appends them as Prometheus summaries (p50, p90, p99, p99.9 in seconds, plus count and sum).
+ */
+void render_stage_times(std::string& out);
+
+#endif
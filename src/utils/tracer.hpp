@@ -0,0 +1,111 @@
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+/**
+ * @file tracer.hpp
+ * @author Derek Tan
+ * @brief Declares the per-thread ring-buffer event tracer and its dump format.
+ * @note `trace_event` compiles to nothing unless the build defines `H2PLUS_TRACE` (`make TRACE_BUILD=1`).
+ * @date 2026-10-19
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "utils/stagetimes.hpp"
+
+constexpr char TRACE_DUMP_MAGIC[8] = {'H', '2', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr uint32_t TRACE_RING_CAPACITY = 1U << 16; // per thread: 1.5 MiB, a few seconds of a busy loop
+
+enum class TraceEvent : uint8_t {
+    conn_accepted,       // arg: socket fd
+    frame_received,      // arg: frame type << 24 | payload length
+    stream_opened,
+    hpack_decode_begin,  // arg: header block octets
+    hpack_decode_end,    // arg: decoded field count
+    flush,               // arg: octets the socket took
+    count
+};
+
+/**
+ * @brief One fixed-size binary event, written as-is into dumps.
+ */
+struct TraceRecord {
+    uint64_t ticks;      // `stage_clock_ticks` when recorded
+    uint32_t conn_id;
+    uint32_t stream_id;
+    uint32_t arg;
+    uint8_t event;
+    uint8_t reserved[3];
+};
+
+static_assert(sizeof(TraceRecord) == 24UL, "TraceRecord is a dump format and must not change size");
+
+/**
+ * @brief Single-producer ring keeping the newest `TRACE_RING_CAPACITY - 1` events. The owning thread writes without locks; readers take consistent snapshots.
+ */
+class TraceRing {
+private:
+    TraceRecord records[TRACE_RING_CAPACITY];
+    std::atomic<uint64_t> head;  // events ever written, published with release
+    uint32_t thread_index;
+
+public:
+    explicit TraceRing(uint32_t index);
+
+    TraceRing(const TraceRing& other) = delete;
+    TraceRing& operator=(const TraceRing& other) = delete;
+
+    void push(TraceEvent event, uint32_t conn_id, uint32_t stream_id, uint32_t arg) {
+        const uint64_t slot = this->head.load(std::memory_order_relaxed);
+        TraceRecord& record = this->records[slot & (TRACE_RING_CAPACITY - 1U)];
+
+        record.ticks = stage_clock_ticks();
+        record.conn_id = conn_id;
+        record.stream_id = stream_id;
+        record.arg = arg;
+        record.event = static_cast<uint8_t>(event);
+        this->head.store(slot + 1UL, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the retained events oldest first into `out`.
+     * @note The writer keeps running, so events it may have overwritten during the copy are dropped from the front instead of returned torn.
+     */
+    void snapshot(std::vector<TraceRecord>& out) const;
+
+    uint32_t get_thread_index() const;
+};
+
+/**
+ * @brief The calling thread's ring, registered on first use and kept until exit.
+ */
+TraceRing& get_trace_ring();
+
+inline void trace_event([[maybe_unused]] TraceEvent event, [[maybe_unused]] uint32_t conn_id, [[maybe_unused]] uint32_t stream_id = 0U, [[maybe_unused]] uint32_t arg = 0U) {
+#ifdef H2PLUS_TRACE
+    get_trace_ring().push(event, conn_id, stream_id, arg);
+#endif
+}
+
+/**
+ * @brief Per-thread events read back from a dump.
+ */
+struct TraceThread {
+    uint32_t thread_index;
+    std::vector<TraceRecord> records;
+};
+
+/**
+ * @brief Snapshots every ring into one binary dump: magic, tick length in ns, thread count, then per thread its index, record count and records.
+ */
+bool dump_traces(const char* path);
+bool load_trace_dump(const char* path, double& tick_ns, std::vector<TraceThread>& threads);
+
+/**
+ * @brief Renders loaded events as Chrome trace event JSON, viewable in Perfetto or `chrome://tracing`. Timestamps are µs from the earliest event.
+ */
+void render_chrome_trace(std::string& out, double tick_ns, const std::vector<TraceThread>& threads);
+
+#endif